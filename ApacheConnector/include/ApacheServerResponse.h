@@ -69,6 +69,18 @@ public:
 		/// cannot be found, or an OpenFileException if
 		/// the file cannot be opened.
 		
+	void sendFile(const std::string& path, const std::string& mediaType, Poco::UInt64 offset, Poco::UInt64 length);
+		/// Sends the response header to the client, followed
+		/// by length bytes of the given file, starting at offset.
+		///
+		/// Must not be called after send(), sendBuffer()
+		/// or redirect() has been called.
+		///
+		/// Throws a FileNotFoundException if the file
+		/// cannot be found, an OpenFileException if
+		/// the file cannot be opened, or an InvalidArgumentException
+		/// if the range exceeds the size of the file.
+
 	void sendBuffer(const void* pBuffer, std::size_t length);
 		/// Sends the response header to the client, followed
 		/// by the contents of the given buffer.
@@ -15,12 +15,15 @@
 #include "Poco/Net/HTTPCookie.h"
 #include "Poco/File.h"
 #include "Poco/Exception.h"
+#include "Poco/FileStream.h"
+#include "Poco/Buffer.h"
 #include <fstream>
 #include <vector>
 
 
 using Poco::File;
 using Poco::OpenFileException;
+using Poco::InvalidArgumentException;
 using Poco::Net::HTTPCookie;
 
 
@@ -96,6 +99,36 @@ void ApacheServerResponse::sendFile(const std::string& path, const std::string&
 }
 
 
+void ApacheServerResponse::sendFile(const std::string& path, const std::string& mediaType, Poco::UInt64 offset, Poco::UInt64 length)
+{
+	poco_assert (!_pStream);
+
+	File f(path);
+	Poco::UInt64 size = f.getSize();
+	if (offset > size || length > size - offset)
+		throw InvalidArgumentException("File range exceeds file size", path);
+
+	Poco::FileInputStream istr(path);
+	if (!istr.good()) throw OpenFileException(path);
+	istr.seekg(static_cast<std::streamoff>(offset), std::ios::beg);
+
+	setContentType(mediaType);
+	setContentLength64(length);
+	initApacheOutputStream();
+
+	Poco::Buffer<char> buffer(8192);
+	while (length > 0 && istr.good())
+	{
+		std::streamsize n = static_cast<std::streamsize>(length < buffer.size() ? length : buffer.size());
+		istr.read(buffer.begin(), n);
+		n = istr.gcount();
+		if (n <= 0) break;
+		_pStream->write(buffer.begin(), n);
+		length -= n;
+	}
+}
+
+
 void ApacheServerResponse::sendBuffer(const void* pBuffer, std::size_t length)
 {
 	poco_assert (!_pStream);
@@ -24,6 +24,7 @@
 #include "Poco/ActiveResult.h"
 #include "Poco/ActiveMethod.h"
 #include "Poco/Mutex.h"
+#include "Poco/AtomicSnapshot.h"
 
 
 namespace Poco {
@@ -94,6 +95,12 @@ class AbstractEvent
 	/// delegate throws an exception, notifying is immediately aborted and the exception is propagated
 	/// back to the caller.
 	///
+	/// Whenever delegates are added or removed, a copy of the TStrategy is made
+	/// and published atomically, so that notify() neither locks the event nor
+	/// copies the delegates. Multiple threads may therefore call notify() on the
+	/// same TStrategy object at the same time; TStrategy::notify() must not
+	/// modify the strategy.
+	///
 	/// Delegates can register methods at the event. In the case of a BasicEvent
 	/// the Delegate template is used, in case of an PriorityEvent a PriorityDelegate is used.
 	/// Mixing of delegates, e.g. using a PriorityDelegate with a BasicEvent is not allowed and
@@ -163,6 +170,7 @@ public:
 		_strategy(strat),
 		_enabled(true)
 	{
+		updateSnapshot();
 	}
 
 	virtual ~AbstractEvent()
@@ -176,6 +184,7 @@ public:
 	{
 		typename TMutex::ScopedLock lock(_mutex);
 		_strategy.add(aDelegate);
+		updateSnapshot();
 	}
 
 	void operator -= (const TDelegate& aDelegate)
@@ -185,6 +194,7 @@ public:
 	{
 		typename TMutex::ScopedLock lock(_mutex);
 		_strategy.remove(aDelegate);
+		updateSnapshot();
 	}
 
 	DelegateHandle add(const TDelegate& aDelegate)
@@ -196,7 +206,9 @@ public:
 		/// remove() to remove the delegate.
 	{
 		typename TMutex::ScopedLock lock(_mutex);
-		return _strategy.add(aDelegate);
+		DelegateHandle handle = _strategy.add(aDelegate);
+		updateSnapshot();
+		return handle;
 	}
 
 	void remove(DelegateHandle delegateHandle)
@@ -207,6 +219,7 @@ public:
 	{
 		typename TMutex::ScopedLock lock(_mutex);
 		_strategy.remove(delegateHandle);
+		updateSnapshot();
 	}
 
 	void operator () (const void* pSender, TArgs& args)
@@ -232,15 +245,10 @@ public:
 		/// the notify method is immediately aborted and the exception is propagated
 		/// to the caller.
 	{
-		Poco::ScopedLockWithUnlock<TMutex> lock(_mutex);
-		if (!_enabled) return;
-
-		// thread-safeness:
-		// copy should be faster and safer than blocking until
-		// execution ends
-		TStrategy strategy(_strategy);
-		lock.unlock();
-		strategy.notify(pSender, args);
+		// The snapshot is a copy of the strategy that is replaced
+		// whenever the delegates change, so no lock is needed here.
+		typename AtomicSnapshot<TStrategy>::ReadGuard strategy(_snapshot);
+		if (strategy.get()) strategy->notify(pSender, args);
 	}
 
 	bool hasDelegates() const
@@ -283,6 +291,7 @@ public:
 	{
 		typename TMutex::ScopedLock lock(_mutex);
 		_enabled = true;
+		updateSnapshot();
 	}
 
 	void disable()
@@ -291,6 +300,7 @@ public:
 	{
 		typename TMutex::ScopedLock lock(_mutex);
 		_enabled = false;
+		updateSnapshot();
 	}
 
 	bool isEnabled() const
@@ -305,6 +315,7 @@ public:
 	{
 		typename TMutex::ScopedLock lock(_mutex);
 		_strategy.clear();
+		updateSnapshot();
 	}
 
 	bool empty() const
@@ -315,6 +326,14 @@ public:
 	}
 
 protected:
+	void updateSnapshot()
+		/// Publishes a copy of the strategy for notify(), or no
+		/// copy if the event is disabled or has no delegates.
+		/// Must be called with the mutex locked.
+	{
+		_snapshot.publish(_enabled && !_strategy.empty() ? new TStrategy(_strategy) : 0);
+	}
+
 	struct NotifyAsyncParams
 	{
 		SharedPtr<TStrategy> ptrStrat;
@@ -347,6 +366,7 @@ protected:
 	bool      _enabled;  /// Stores if an event is enabled. Notifies on disabled events have no effect
 	                     /// but it is possible to change the observers.
 	mutable TMutex _mutex;
+	AtomicSnapshot<TStrategy> _snapshot; /// The copy of the strategy used by notify().
 
 private:
 	AbstractEvent(const AbstractEvent& other);
@@ -371,6 +391,7 @@ public:
 		_strategy(strat),
 		_enabled(true)
 	{
+		updateSnapshot();
 	}
 
 	virtual ~AbstractEvent()
@@ -384,6 +405,7 @@ public:
 	{
 		typename TMutex::ScopedLock lock(_mutex);
 		_strategy.add(aDelegate);
+		updateSnapshot();
 	}
 
 	void operator -= (const TDelegate& aDelegate)
@@ -393,6 +415,7 @@ public:
 	{
 		typename TMutex::ScopedLock lock(_mutex);
 		_strategy.remove(aDelegate);
+		updateSnapshot();
 	}
 
 	DelegateHandle add(const TDelegate& aDelegate)
@@ -404,7 +427,9 @@ public:
 		/// remove() to remove the delegate.
 	{
 		typename TMutex::ScopedLock lock(_mutex);
-		return _strategy.add(aDelegate);
+		DelegateHandle handle = _strategy.add(aDelegate);
+		updateSnapshot();
+		return handle;
 	}
 
 	void remove(DelegateHandle delegateHandle)
@@ -415,6 +440,7 @@ public:
 	{
 		typename TMutex::ScopedLock lock(_mutex);
 		_strategy.remove(delegateHandle);
+		updateSnapshot();
 	}
 
 	void operator () (const void* pSender)
@@ -440,16 +466,10 @@ public:
 		/// the notify method is immediately aborted and the exception is propagated
 		/// to the caller.
 	{
-		Poco::ScopedLockWithUnlock<TMutex> lock(_mutex);
-
-		if (!_enabled) return;
-
-		// thread-safeness:
-		// copy should be faster and safer than blocking until
-		// execution ends
-		TStrategy strategy(_strategy);
-		lock.unlock();
-		strategy.notify(pSender);
+		// The snapshot is a copy of the strategy that is replaced
+		// whenever the delegates change, so no lock is needed here.
+		typename AtomicSnapshot<TStrategy>::ReadGuard strategy(_snapshot);
+		if (strategy.get()) strategy->notify(pSender);
 	}
 
 	ActiveResult<void> notifyAsync(const void* pSender)
@@ -486,6 +506,7 @@ public:
 	{
 		typename TMutex::ScopedLock lock(_mutex);
 		_enabled = true;
+		updateSnapshot();
 	}
 
 	void disable()
@@ -494,6 +515,7 @@ public:
 	{
 		typename TMutex::ScopedLock lock(_mutex);
 		_enabled = false;
+		updateSnapshot();
 	}
 
 	bool isEnabled() const
@@ -507,6 +529,7 @@ public:
 	{
 		typename TMutex::ScopedLock lock(_mutex);
 		_strategy.clear();
+		updateSnapshot();
 	}
 
 	bool empty() const
@@ -517,6 +540,14 @@ public:
 	}
 
 protected:
+	void updateSnapshot()
+		/// Publishes a copy of the strategy for notify(), or no
+		/// copy if the event is disabled or has no delegates.
+		/// Must be called with the mutex locked.
+	{
+		_snapshot.publish(_enabled && !_strategy.empty() ? new TStrategy(_strategy) : 0);
+	}
+
 	struct NotifyAsyncParams
 	{
 		SharedPtr<TStrategy> ptrStrat;
@@ -547,6 +578,7 @@ protected:
 	bool      _enabled;  /// Stores if an event is enabled. Notifies on disabled events have no effect
 	                     /// but it is possible to change the observers.
 	mutable TMutex _mutex;
+	AtomicSnapshot<TStrategy> _snapshot; /// The copy of the strategy used by notify().
 
 private:
 	AbstractEvent(const AbstractEvent& other);
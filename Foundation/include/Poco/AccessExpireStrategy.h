@@ -56,7 +56,7 @@ public:
 		if (it != this->_keys.end())
 		{
 			this->_keyIndex.erase(it->second);
-			Timestamp now;
+			Timestamp now = CoarseClock::now();
 			typename ExpireStrategy<TKey, TValue>::IndexIterator itIdx =
 				this->_keyIndex.insert(typename ExpireStrategy<TKey, TValue>::TimeIndex::value_type(now, key));
 			it->second = itIdx;
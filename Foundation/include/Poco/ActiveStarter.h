@@ -20,6 +20,7 @@
 
 #include "Poco/Foundation.h"
 #include "Poco/ThreadPool.h"
+#include "Poco/WorkStealingPool.h"
 #include "Poco/ActiveRunnable.h"
 
 
@@ -42,6 +43,34 @@ public:
 };
 
 
+template <class OwnerType>
+class WorkStealingStarter
+	/// An alternative implementation of the StarterType
+	/// policy for ActiveMethod. It queues the method
+	/// for execution in the default WorkStealingPool,
+	/// which is better suited for many short-lived
+	/// activities than a thread per invocation.
+	///
+	/// Usage:
+	///     ActiveMethod<std::string, std::string, MyClass, WorkStealingStarter<MyClass>> exampleActiveMethod;
+{
+public:
+	static void start(OwnerType* /*pOwner*/, ActiveRunnableBase::Ptr pRunnable)
+	{
+		pRunnable->duplicate(); // The runnable will release itself.
+		try
+		{
+			WorkStealingPool::defaultPool().start(*pRunnable);
+		}
+		catch (...)
+		{
+			pRunnable->release();
+			throw;
+		}
+	}
+};
+
+
 } // namespace Poco
 
 
@@ -20,6 +20,8 @@
 #include "Poco/MetaProgramming.h"
 #include <algorithm>
 #include <typeinfo>
+#include <type_traits>
+#include <new>
 #include <cstring>
 
 
@@ -39,16 +41,18 @@ template <class, class Enable = void> class VarHolderImpl;
 
 #ifndef POCO_NO_SOO
 
+
 template <typename PlaceholderT, unsigned int SizeV = POCO_SMALL_OBJECT_SIZE>
-union Placeholder
-	/// ValueHolder union (used by Poco::Any and Poco::Dynamic::Var for small
+class Placeholder
+	/// ValueHolder storage (used by Poco::Any and Poco::Dynamic::Var for small
 	/// object optimization, when enabled).
 	///
-	/// If Holder<Type> fits into POCO_SMALL_OBJECT_SIZE bytes of storage,
-	/// it will be placement-new-allocated into the local buffer
-	/// (i.e. there will be no heap-allocation). The local buffer size is one byte
-	/// larger - [POCO_SMALL_OBJECT_SIZE + 1], additional byte value indicating
-	/// where the object was allocated (0 => heap, 1 => local).
+	/// If a holder fits into POCO_SMALL_OBJECT_SIZE bytes of storage,
+	/// it is placement-new-allocated into the local buffer, i.e. there is
+	/// no heap allocation. Larger holders are allocated on the heap.
+	/// In both cases, content() returns a pointer to the holder, so that
+	/// accessing the held value does not need to check where the holder
+	/// has been allocated.
 {
 public:
 	struct Size
@@ -56,48 +60,99 @@ public:
 		static const unsigned int value = SizeV;
 	};
 
-	Placeholder ()
+	Placeholder():
+		_pHolder(0)
+	{
+	}
+
+	~Placeholder()
 	{
 		erase();
 	}
 
+	template <typename HolderT, typename ValueType>
+	PlaceholderT* assign(const ValueType& value)
+		/// Destroys the current holder, if any, and creates a
+		/// HolderT holding a copy of the given value, which may
+		/// refer to a value owned by the current holder.
+		///
+		/// If the construction of the holder throws an exception,
+		/// the Placeholder is empty.
+	{
+		typedef std::integral_constant<bool, sizeof(HolderT) <= SizeV && alignof(HolderT) <= alignof(Storage)> IsLocal;
+		return assign<HolderT>(value, IsLocal());
+	}
+
 	void erase()
+		/// Destroys the holder, if any.
 	{
-		std::memset(holder, 0, sizeof(Placeholder));
+		if (isLocal())
+			_pHolder->~PlaceholderT();
+		else
+			delete _pHolder;
+		_pHolder = 0;
 	}
 
-	bool isLocal() const
+	bool isEmpty() const
 	{
-		return holder[SizeV] != 0;
+		return _pHolder == 0;
 	}
 
-	void setLocal(bool local) const
+	bool isLocal() const
 	{
-		holder[SizeV] = local ? 1 : 0;
+		return _pHolder == reinterpret_cast<const PlaceholderT*>(&_storage);
 	}
 
 	PlaceholderT* content() const
+	{
+		return _pHolder;
+	}
+
+	void swap(Placeholder& other)
+		/// Swaps two heap allocated holders.
+	{
+		poco_assert_dbg (!isLocal() && !other.isLocal());
+
+		std::swap(_pHolder, other._pHolder);
+	}
+
+private:
+	typedef typename std::aligned_storage<SizeV, (alignof(double) > alignof(void*) ? alignof(double) : alignof(void*))>::type Storage;
+
+	template <typename HolderT, typename ValueType>
+	PlaceholderT* assign(const ValueType& value, std::true_type)
 	{
 		if (isLocal())
-			return reinterpret_cast<PlaceholderT*>(holder);
+		{
+			// the value may be owned by the current holder,
+			// which must be destroyed before the buffer is reused
+			ValueType copy(value);
+			erase();
+			_pHolder = new (&_storage) HolderT(copy);
+		}
 		else
-			return pHolder;
+		{
+			PlaceholderT* pOld = _pHolder;
+			_pHolder = new (&_storage) HolderT(value);
+			delete pOld;
+		}
+		return _pHolder;
 	}
 
-// MSVC71,80 won't extend friendship to nested class (Any::Holder)
-#if !defined(POCO_MSVC_VERSION) || (defined(POCO_MSVC_VERSION) && (POCO_MSVC_VERSION > 80))
-private:
-#endif
-	typedef typename std::aligned_storage<SizeV + 1>::type AlignerType;
-	
-	PlaceholderT* pHolder;
-	mutable char  holder [SizeV + 1];
-	AlignerType   aligner;
+	template <typename HolderT, typename ValueType>
+	PlaceholderT* assign(const ValueType& value, std::false_type)
+	{
+		PlaceholderT* pHolder = new HolderT(value);
+		erase();
+		_pHolder = pHolder;
+		return _pHolder;
+	}
 
-	friend class Any;
-	friend class Dynamic::Var;
-	friend class Dynamic::VarHolder;
-	template <class> friend class Dynamic::VarHolderImpl;
+	Placeholder(const Placeholder&);
+	Placeholder& operator = (const Placeholder&);
+
+	Storage _storage;
+	PlaceholderT* _pHolder;
 };
 
 
@@ -170,27 +225,19 @@ public:
 		///   Any a(13);
 		///   Any a(string("12345"));
 	{
-		construct(value);
+		_valueHolder.template assign<Holder<ValueType> >(value);
 	}
 
 	Any(const Any& other)
 		/// Copy constructor, works with both empty and initialized Any values.
 	{
-		if ((this != &other) && !other.empty())
-			construct(other);
+		if (!other.empty()) other.content()->clone(&_valueHolder);
 	}
 
 	~Any()
 		/// Destructor. If Any is locally held, calls ValueHolder destructor;
 		/// otherwise, deletes the placeholder from the heap.
 	{
-		if (!empty())
-		{
-			if (_valueHolder.isLocal())
-				destruct();
-			else
-				delete content();
-		}
 	}
 
 	Any& swap(Any& other)
@@ -204,22 +251,13 @@ public:
 
 		if (!_valueHolder.isLocal() && !other._valueHolder.isLocal())
 		{
-			std::swap(_valueHolder.pHolder, other._valueHolder.pHolder);
+			_valueHolder.swap(other._valueHolder);
 		}
 		else
 		{
 			Any tmp(*this);
-			try
-			{
-				if (_valueHolder.isLocal()) destruct();
-				construct(other);
-				other = tmp;
-			}
-			catch (...)
-			{
-				construct(tmp);
-				throw;
-			}
+			*this = other;
+			other = tmp;
 		}
 
 		return *this;
@@ -233,26 +271,27 @@ public:
 		///   Any a = 13;
 		///   Any a = string("12345");
 	{
-		construct(rhs);
+		_valueHolder.template assign<Holder<ValueType> >(rhs);
 		return *this;
 	}
 	
 	Any& operator = (const Any& rhs)
 		/// Assignment operator for Any.
 	{
-		if ((this != &rhs) && !rhs.empty())
-			construct(rhs);
-		else if ((this != &rhs) && rhs.empty())
-			_valueHolder.erase();
-
+		if (this != &rhs)
+		{
+			if (rhs.empty())
+				_valueHolder.erase();
+			else
+				rhs.content()->clone(&_valueHolder);
+		}
 		return *this;
 	}
 	
 	bool empty() const
 		/// Returns true if the Any is empty.
 	{
-		char buf[POCO_SMALL_OBJECT_SIZE] = { 0 };
-		return 0 == std::memcmp(_valueHolder.holder, buf, POCO_SMALL_OBJECT_SIZE);
+		return _valueHolder.isEmpty();
 	}
 	
 	const std::type_info & type() const
@@ -293,16 +332,7 @@ private:
 
 		virtual void clone(Placeholder<ValueHolder>* pPlaceholder) const
 		{
-			if ((sizeof(Holder<ValueType>) <= POCO_SMALL_OBJECT_SIZE))
-			{
-				new ((ValueHolder*) pPlaceholder->holder) Holder(_held);
-				pPlaceholder->setLocal(true);
-			}
-			else
-			{
-				pPlaceholder->pHolder = new Holder(_held);
-				pPlaceholder->setLocal(false);
-			}
+			pPlaceholder->template assign<Holder<ValueType> >(_held);
 		}
 
 		ValueType _held;
@@ -316,34 +346,6 @@ private:
 		return _valueHolder.content();
 	}
 
-	template<typename ValueType>
-	void construct(const ValueType& value)
-	{
-		if (sizeof(Holder<ValueType>) <= Placeholder<ValueType>::Size::value)
-		{
-			new (reinterpret_cast<ValueHolder*>(_valueHolder.holder)) Holder<ValueType>(value);
-			_valueHolder.setLocal(true);
-		}
-		else
-		{
-			_valueHolder.pHolder = new Holder<ValueType>(value);
-			_valueHolder.setLocal(false);
-		}
-	}
-
-	void construct(const Any& other)
-	{
-		if (!other.empty())
-			other.content()->clone(&_valueHolder);
-		else
-			_valueHolder.erase();
-	}
-	
-	void destruct()
-	{
-		content()->~ValueHolder();
-	}
-
 	Placeholder<ValueHolder> _valueHolder;
 
 
@@ -527,10 +529,10 @@ ValueType AnyCast(Any& operand)
 	if (!result)
 	{
 		std::string s = "RefAnyCast: Failed to convert between Any types ";
-		if (operand._pHolder)
+		if (!operand.empty())
 		{
 			s.append(1, '(');
-			s.append(operand._pHolder->type().name());
+			s.append(operand.content()->type().name());
 			s.append(" => ");
 			s.append(typeid(ValueType).name());
 			s.append(1, ')');
@@ -567,10 +569,10 @@ const ValueType& RefAnyCast(const Any & operand)
 {
 	ValueType* result = AnyCast<ValueType>(const_cast<Any*>(&operand));
 	std::string s = "RefAnyCast: Failed to convert between Any types ";
-	if (operand._pHolder)
+	if (!operand.empty())
 	{
 		s.append(1, '(');
-		s.append(operand._pHolder->type().name());
+		s.append(operand.content()->type().name());
 		s.append(" => ");
 		s.append(typeid(ValueType).name());
 		s.append(1, ')');
@@ -590,10 +592,10 @@ ValueType& RefAnyCast(Any& operand)
 	if (!result)
 	{
 		std::string s = "RefAnyCast: Failed to convert between Any types ";
-		if (operand._pHolder)
+		if (!operand.empty())
 		{
 			s.append(1, '(');
-			s.append(operand._pHolder->type().name());
+			s.append(operand.content()->type().name());
 			s.append(" => ");
 			s.append(typeid(ValueType).name());
 			s.append(1, ')');
@@ -0,0 +1,333 @@
+//
+// Arena.h
+//
+// Library: Foundation
+// Package: Core
+// Module:  Arena
+//
+// Definition of the Arena class and the ArenaAllocator class template.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_Arena_INCLUDED
+#define Foundation_Arena_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include <new>
+#include <utility>
+#include <type_traits>
+#include <cstddef>
+#include <cstdint>
+
+
+#if !defined(POCO_HAVE_STD_PMR) && defined(__has_include)
+	#if __has_include(<memory_resource>) && ((defined(_MSVC_LANG) && _MSVC_LANG >= 201703L) || __cplusplus >= 201703L)
+		#define POCO_HAVE_STD_PMR
+	#endif
+#endif
+#if defined(POCO_HAVE_STD_PMR)
+	#include <memory_resource>
+#endif
+
+
+namespace Poco {
+
+
+class Foundation_API Arena
+	/// An Arena is a region (or monotonic) allocator for objects that
+	/// all have the same lifetime, such as the objects created while
+	/// handling a single request.
+	///
+	/// Memory is taken from large chunks by advancing a pointer, and
+	/// individual allocations are never freed. Instead, all memory is
+	/// released at once by reset(), which keeps the largest chunk for
+	/// reuse, so that an Arena used for one request after the other
+	/// does not need to allocate memory in the steady state.
+	///
+	/// Objects created with create() are destroyed by reset() and by
+	/// the destructor of the Arena, in reverse order of creation.
+	/// Memory obtained with allocate() is not initialized, and no
+	/// destructors are called for it.
+	///
+	/// An ArenaAllocator makes an Arena usable with standard containers
+	/// and strings. If the C++ library supports polymorphic memory
+	/// resources (C++17; see the POCO_ENABLE_CPP17 CMake option),
+	/// an ArenaResource can be used with the std::pmr containers.
+	///
+	/// Arena is not thread-safe.
+	///
+	/// Example:
+	///     Poco::Arena arena;
+	///     typedef std::basic_string<char, std::char_traits<char>, Poco::ArenaAllocator<char> > ArenaString;
+	///     std::vector<ArenaString, Poco::ArenaAllocator<ArenaString> > names(arena);
+	///     names.push_back(ArenaString("Content-Type", arena));
+	///     ...
+	///     names.clear();
+	///     arena.reset();
+{
+public:
+	enum
+	{
+		DEFAULT_CHUNK_SIZE = 4096
+	};
+
+	explicit Arena(std::size_t chunkSize = DEFAULT_CHUNK_SIZE);
+		/// Creates the Arena. Memory is allocated in chunks of at least
+		/// the given size. The size of every new chunk is twice the size
+		/// of the previous one, up to 64 times the given size.
+
+	Arena(void* pBuffer, std::size_t size, std::size_t chunkSize = DEFAULT_CHUNK_SIZE);
+		/// Creates the Arena, using the given buffer, e.g. on the stack,
+		/// before allocating chunks. The buffer must stay valid until
+		/// the Arena is destroyed.
+
+	~Arena();
+		/// Destroys all objects created with create(), and releases
+		/// all memory.
+
+	void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+		/// Returns a block of memory of the given size and alignment,
+		/// which must be a power of two.
+
+	void deallocate(void* ptr, std::size_t size);
+		/// Does nothing. Memory is released by reset().
+
+	template <class T, typename... Args>
+	T* create(Args&&... args)
+		/// Creates an object in the Arena. The object is destroyed
+		/// when the Arena is reset or destroyed.
+	{
+		void* pMem = allocate(sizeof(T), alignof(T));
+		if (std::is_trivially_destructible<T>::value)
+		{
+			return new (pMem) T(std::forward<Args>(args)...);
+		}
+		else
+		{
+			Cleanup* pCleanup = static_cast<Cleanup*>(allocate(sizeof(Cleanup), alignof(Cleanup)));
+			T* pObj = new (pMem) T(std::forward<Args>(args)...);
+			pCleanup->destroy = &destroy<T>;
+			pCleanup->pObj = pObj;
+			pCleanup->pNext = _pCleanups;
+			_pCleanups = pCleanup;
+			return pObj;
+		}
+	}
+
+	void reset();
+		/// Destroys all objects created with create(), and makes all
+		/// memory available again. Only the largest chunk is kept.
+
+	void release();
+		/// Destroys all objects created with create(), and releases
+		/// all chunks.
+
+	std::size_t used() const;
+		/// Returns the number of bytes allocated since the
+		/// Arena has been created or reset, including padding.
+
+	std::size_t capacity() const;
+		/// Returns the total size of all chunks and of the
+		/// initial buffer.
+
+private:
+	struct Chunk
+	{
+		Chunk* pNext;
+		std::size_t size;
+	};
+
+	struct Cleanup
+	{
+		void (*destroy)(void*);
+		void* pObj;
+		Cleanup* pNext;
+	};
+
+	template <class T>
+	static void destroy(void* pObj)
+	{
+		static_cast<T*>(pObj)->~T();
+	}
+
+	void* allocateSlow(std::size_t size, std::size_t alignment);
+	void runCleanups();
+	static char* dataOf(Chunk* pChunk);
+
+	Arena(const Arena&);
+	Arena& operator = (const Arena&);
+
+	char* _pCurrent;
+	char* _pEnd;
+	Chunk* _pChunks;
+	Chunk* _pSpare;
+	char* _pBuffer;
+	std::size_t _bufferSize;
+	std::size_t _chunkSize;
+	std::size_t _nextChunkSize;
+	std::size_t _used;
+	std::size_t _capacity;
+	Cleanup* _pCleanups;
+};
+
+
+template <class T>
+class ArenaAllocator
+	/// A standard allocator that takes memory from an Arena.
+	///
+	/// Memory released by a container is only reused after the Arena
+	/// has been reset, so containers that grow by reallocation, like
+	/// std::vector, should reserve their final size in advance if
+	/// possible.
+{
+public:
+	typedef T value_type;
+	typedef T* pointer;
+	typedef const T* const_pointer;
+	typedef T& reference;
+	typedef const T& const_reference;
+	typedef std::size_t size_type;
+	typedef std::ptrdiff_t difference_type;
+
+	template <class U>
+	struct rebind
+	{
+		typedef ArenaAllocator<U> other;
+	};
+
+	ArenaAllocator(Arena& arena) noexcept:
+		/// Creates the ArenaAllocator for the given Arena.
+		_pArena(&arena)
+	{
+	}
+
+	template <class U>
+	ArenaAllocator(const ArenaAllocator<U>& other) noexcept:
+		_pArena(&other.arena())
+	{
+	}
+
+	T* allocate(std::size_t n)
+	{
+		if (n > static_cast<std::size_t>(-1)/sizeof(T)) throw std::bad_alloc();
+		return static_cast<T*>(_pArena->allocate(n*sizeof(T), alignof(T)));
+	}
+
+	void deallocate(T*, std::size_t) noexcept
+	{
+	}
+
+	Arena& arena() const noexcept
+		/// Returns the Arena.
+	{
+		return *_pArena;
+	}
+
+private:
+	Arena* _pArena;
+};
+
+
+template <class T, class U>
+inline bool operator == (const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) noexcept
+{
+	return &a.arena() == &b.arena();
+}
+
+
+template <class T, class U>
+inline bool operator != (const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) noexcept
+{
+	return &a.arena() != &b.arena();
+}
+
+
+#if defined(POCO_HAVE_STD_PMR)
+
+
+class ArenaResource: public std::pmr::memory_resource
+	/// A polymorphic memory resource that takes memory from an Arena,
+	/// for use with the std::pmr containers.
+{
+public:
+	explicit ArenaResource(Arena& arena) noexcept:
+		/// Creates the ArenaResource for the given Arena.
+		_arena(arena)
+	{
+	}
+
+	Arena& arena() const noexcept
+		/// Returns the Arena.
+	{
+		return _arena;
+	}
+
+protected:
+	void* do_allocate(std::size_t bytes, std::size_t alignment) override
+	{
+		return _arena.allocate(bytes, alignment);
+	}
+
+	void do_deallocate(void*, std::size_t, std::size_t) override
+	{
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+	{
+		const ArenaResource* pOther = dynamic_cast<const ArenaResource*>(&other);
+		return pOther && &pOther->_arena == &_arena;
+	}
+
+private:
+	Arena& _arena;
+};
+
+
+#endif // POCO_HAVE_STD_PMR
+
+
+//
+// inlines
+//
+inline void* Arena::allocate(std::size_t size, std::size_t alignment)
+{
+	std::uintptr_t current = reinterpret_cast<std::uintptr_t>(_pCurrent);
+	std::uintptr_t aligned = (current + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+	std::uintptr_t end = reinterpret_cast<std::uintptr_t>(_pEnd);
+	if (_pCurrent && aligned <= end && size <= end - aligned)
+	{
+		_pCurrent = reinterpret_cast<char*>(aligned + size);
+		_used += static_cast<std::size_t>(aligned + size - current);
+		return reinterpret_cast<void*>(aligned);
+	}
+	return allocateSlow(size, alignment);
+}
+
+
+inline void Arena::deallocate(void*, std::size_t)
+{
+}
+
+
+inline std::size_t Arena::used() const
+{
+	return _used;
+}
+
+
+inline std::size_t Arena::capacity() const
+{
+	return _capacity;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_Arena_INCLUDED
@@ -19,6 +19,7 @@
 
 
 #include "Poco/Foundation.h"
+#include <cstddef>
 
 
 namespace Poco {
@@ -115,6 +116,26 @@ public:
 		/// If the given character is a lowercase character,
 		/// return its uppercase counterpart, otherwise return
 		/// the character.
+
+	static bool isAscii(const char* pChars, std::size_t length);
+		/// Returns true iff all characters in the given
+		/// buffer are within the ASCII range (0 .. 127).
+
+	static void toLowerInPlace(char* pChars, std::size_t length);
+		/// Replaces all uppercase characters in the given buffer
+		/// with their lowercase counterparts.
+
+	static void toUpperInPlace(char* pChars, std::size_t length);
+		/// Replaces all lowercase characters in the given buffer
+		/// with their uppercase counterparts.
+
+	static int icompare(const char* pChars1, std::size_t length1, const char* pChars2, std::size_t length2);
+		/// Compares the two buffers, ignoring the case of ASCII
+		/// characters. Returns -1, 0 or 1, like Poco::icompare().
+		///
+		/// The buffer functions process 16 or 32 characters at
+		/// once using SSE2 or AVX2 instructions, if supported by the
+		/// CPU, which is detected at runtime.
 		
 private:
 	static const int CHARACTER_PROPERTIES[128];
@@ -25,6 +25,8 @@
 #include "Poco/Runnable.h"
 #include "Poco/AutoPtr.h"
 #include "Poco/NotificationQueue.h"
+#include "Poco/BoundedNotificationQueue.h"
+#include <memory>
 
 
 namespace Poco {
@@ -82,11 +84,21 @@ public:
 		///    * highest
 		///
 		/// The "priority" property is set-only.
+		///
+		/// The "queueSize" property, if set to a value greater
+		/// than zero, makes the channel use a lock-free
+		/// BoundedNotificationQueue of the given capacity instead
+		/// of an unbounded NotificationQueue. This reduces contention
+		/// if many threads log concurrently. If the queue is full,
+		/// log() waits until the background thread has caught up.
+		/// The "queueSize" property can only be set before the
+		/// channel has been opened.
 
 protected:
 	~AsyncChannel();
 	void run();
 	void setPriority(const std::string& value);
+	void setQueueSize(const std::string& value);
 		
 private:
 	Channel::Ptr      _pChannel;
@@ -94,6 +106,7 @@ private:
 	FastMutex         _threadMutex;
 	FastMutex         _channelMutex;
 	NotificationQueue _queue;
+	std::unique_ptr<BoundedNotificationQueue> _pBoundedQueue;
 };
 
 
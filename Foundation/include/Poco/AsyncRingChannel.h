@@ -0,0 +1,203 @@
+//
+// AsyncRingChannel.h
+//
+// Library: Foundation
+// Package: Logging
+// Module:  AsyncRingChannel
+//
+// Definition of the AsyncRingChannel class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_AsyncRingChannel_INCLUDED
+#define Foundation_AsyncRingChannel_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Channel.h"
+#include "Poco/Thread.h"
+#include "Poco/Mutex.h"
+#include "Poco/Event.h"
+#include "Poco/Runnable.h"
+#include "Poco/AutoPtr.h"
+#include <vector>
+#include <memory>
+#include <atomic>
+
+
+namespace Poco {
+
+
+class Foundation_API AsyncRingChannel: public Channel, public Runnable
+	/// A high-throughput alternative to AsyncChannel.
+	///
+	/// Every thread logging to an AsyncRingChannel gets a ring
+	/// buffer of its own, with a fixed number of pre-allocated
+	/// message slots. log() copies the message into the next free
+	/// slot, reusing the slot's string buffers, so that in the
+	/// steady state logging takes neither a lock nor a memory
+	/// allocation. A single background thread drains the ring
+	/// buffers in batches and passes the messages on to the
+	/// target channel.
+	///
+	/// Messages logged by one thread are passed on in order;
+	/// messages logged by different threads may be reordered.
+	///
+	/// If the ring buffer of a thread is full, the overflow policy
+	/// decides what happens:
+	///   - OVERFLOW_BLOCK: log() waits until the background thread
+	///     has made room (default).
+	///   - OVERFLOW_DROP: the message is discarded.
+	///   - OVERFLOW_COUNT_AND_DROP: the message is discarded, and
+	///     the background thread logs a warning with the number
+	///     of discarded messages to the target channel.
+	///
+	/// statistics() returns counters for logged, written, dropped
+	/// and blocked messages.
+{
+public:
+	typedef AutoPtr<AsyncRingChannel> Ptr;
+
+	enum OverflowPolicy
+	{
+		OVERFLOW_BLOCK,          /// Wait until a slot becomes available.
+		OVERFLOW_DROP,           /// Discard the message.
+		OVERFLOW_COUNT_AND_DROP  /// Discard the message and report the number of discarded messages.
+	};
+
+	struct Statistics
+	{
+		Poco::UInt64 logged;   /// Number of messages accepted by log().
+		Poco::UInt64 written;  /// Number of messages passed on to the target channel.
+		Poco::UInt64 dropped;  /// Number of messages discarded due to a full buffer.
+		Poco::UInt64 blocked;  /// Number of log() calls that had to wait for a free slot.
+		Poco::UInt64 batches;  /// Number of batches passed on to the target channel.
+	};
+
+	AsyncRingChannel(Channel::Ptr pChannel = 0, std::size_t bufferSize = 1024, OverflowPolicy policy = OVERFLOW_BLOCK);
+		/// Creates the AsyncRingChannel and connects it to
+		/// the given channel. bufferSize is the number of
+		/// message slots per logging thread, rounded up to
+		/// the next power of two.
+
+	void setChannel(Channel::Ptr pChannel);
+		/// Connects the AsyncRingChannel to the given target channel.
+		/// All messages will be forwarded to this channel.
+
+	Channel::Ptr getChannel() const;
+		/// Returns the target channel.
+
+	void open();
+		/// Opens the channel and creates the
+		/// background thread.
+
+	void close();
+		/// Closes the channel and stops the background
+		/// thread, after all buffered messages have been
+		/// passed on to the target channel.
+
+	void log(const Message& msg);
+		/// Copies the message into the calling thread's buffer,
+		/// for processing by the background thread.
+
+	void flush();
+		/// Waits until all messages logged before the call
+		/// have been passed on to the target channel.
+
+	void setOverflowPolicy(OverflowPolicy policy);
+		/// Sets the overflow policy.
+
+	OverflowPolicy getOverflowPolicy() const;
+		/// Returns the overflow policy.
+
+	std::size_t getBufferSize() const;
+		/// Returns the number of message slots per thread.
+
+	Statistics statistics() const;
+		/// Returns the current values of the channel's counters.
+
+	void setProperty(const std::string& name, const std::string& value);
+		/// Sets or changes a configuration property.
+		///
+		/// The "channel" property allows setting the target
+		/// channel via the LoggingRegistry.
+		/// The "channel" property is set-only.
+		///
+		/// The "priority" property allows setting the thread
+		/// priority of the background thread. The following
+		/// values are supported:
+		///    * lowest
+		///    * low
+		///    * normal (default)
+		///    * high
+		///    * highest
+		///
+		/// The "priority" property is set-only.
+		///
+		/// The "bufferSize" property sets the number of message
+		/// slots per thread. Threads that already have a buffer
+		/// keep their buffer.
+		///
+		/// The "overflowPolicy" property sets the overflow policy.
+		/// Supported values are "block", "drop" and "countAndDrop".
+
+	std::string getProperty(const std::string& name) const;
+		/// Returns the value of the property with the given name.
+		/// See setProperty() for a description of the supported
+		/// properties.
+
+protected:
+	~AsyncRingChannel();
+	void run();
+	void setPriority(const std::string& value);
+
+private:
+	class Ring;
+	class RingCache;
+	typedef std::shared_ptr<Ring> RingPtr;
+	typedef std::vector<RingPtr> RingVec;
+
+	enum
+	{
+		MAX_BATCH_SIZE = 256,
+		IDLE_WAIT      = 100 // milliseconds
+	};
+
+	Ring& ring();
+	std::size_t drain(RingVec& rings);
+	void reportDropped(RingVec& rings);
+	void retireOrphaned(RingVec& rings);
+	void wakeUp();
+	static RingCache& ringCache();
+
+	AsyncRingChannel(const AsyncRingChannel&);
+	AsyncRingChannel& operator = (const AsyncRingChannel&);
+
+	Channel::Ptr _pChannel;
+	Thread _thread;
+	FastMutex _threadMutex;
+	FastMutex _channelMutex;
+	RingVec _rings;
+	std::atomic<int> _ringsVersion;
+	mutable FastMutex _ringsMutex;
+	Statistics _retired;
+	std::atomic<Poco::UInt64> _batches;
+	Poco::UInt64 _id;
+	std::atomic<std::size_t> _bufferSize;
+	std::atomic<int> _policy;
+	std::atomic<bool> _running;
+	std::atomic<bool> _stop;
+	std::atomic<bool> _sleeping;
+	Event _wakeUp;
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_AsyncRingChannel_INCLUDED
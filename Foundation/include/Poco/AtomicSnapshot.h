@@ -0,0 +1,182 @@
+//
+// AtomicSnapshot.h
+//
+// Library: Foundation
+// Package: Core
+// Module:  AtomicSnapshot
+//
+// Definition of the AtomicSnapshot class template.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_AtomicSnapshot_INCLUDED
+#define Foundation_AtomicSnapshot_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Mutex.h"
+#include <atomic>
+#include <thread>
+
+
+namespace Poco {
+
+
+template <class T>
+class AtomicSnapshot
+	/// AtomicSnapshot holds an immutable object, such as a copy of a
+	/// list of observers, that is read far more often than it is
+	/// replaced.
+	///
+	/// Readers access the current object through a ReadGuard, which
+	/// never blocks and holds a reference to the object. Writers
+	/// replace the object by publishing a new one. Each replaced object
+	/// is deleted as soon as the last ReadGuard referring to it is
+	/// destroyed, so a reader may keep using the object it has obtained
+	/// while it is being replaced.
+	///
+	/// Readers may call non-const member functions of the object,
+	/// but these must not modify it, as other threads may use it
+	/// at the same time.
+{
+private:
+	struct Holder
+	{
+		explicit Holder(T* pObj):
+			pObject(pObj),
+			refs(1)
+		{
+		}
+
+		~Holder()
+		{
+			delete pObject;
+		}
+
+		T* pObject;
+		std::atomic<int> refs;
+	};
+
+public:
+	class ReadGuard
+		/// Provides access to the current object of an AtomicSnapshot,
+		/// and keeps it alive until the ReadGuard is destroyed.
+	{
+	public:
+		explicit ReadGuard(AtomicSnapshot& snapshot):
+			_pHolder(snapshot.acquire())
+		{
+		}
+
+		~ReadGuard()
+		{
+			AtomicSnapshot::release(_pHolder);
+		}
+
+		T* get() const
+			/// Returns the object, or null if none has been published.
+		{
+			return _pHolder ? _pHolder->pObject : 0;
+		}
+
+		T* operator -> () const
+		{
+			return get();
+		}
+
+	private:
+		ReadGuard(const ReadGuard&);
+		ReadGuard& operator = (const ReadGuard&);
+
+		Holder* _pHolder;
+	};
+
+	AtomicSnapshot():
+		_pCurrent(0),
+		_epoch(0)
+		/// Creates an empty AtomicSnapshot.
+	{
+		_readers[0].store(0);
+		_readers[1].store(0);
+	}
+
+	~AtomicSnapshot()
+		/// Releases the current object.
+		///
+		/// There must not be any ReadGuard left.
+	{
+		release(_pCurrent.load());
+	}
+
+	void publish(T* pObj)
+		/// Replaces the current object with the given one, which
+		/// may be null. The AtomicSnapshot takes ownership of the
+		/// object, which must not be modified afterwards.
+	{
+		Holder* pNew = pObj ? new Holder(pObj) : 0;
+
+		FastMutex::ScopedLock lock(_mutex);
+		Holder* pOld = _pCurrent.exchange(pNew);
+		if (pOld)
+		{
+			// A reader that has loaded the old object may not have
+			// taken its reference yet. Such readers are registered
+			// in the current epoch; readers that register after the
+			// epoch has been switched see the new object. Waiting
+			// for the previous epoch to drain is short, as readers
+			// only stay registered until they hold their reference.
+			int epoch = _epoch.load();
+			_epoch.store(epoch ^ 1);
+			while (_readers[epoch].load() != 0)
+			{
+				std::this_thread::yield();
+			}
+			release(pOld);
+		}
+	}
+
+private:
+	Holder* acquire()
+	{
+		int epoch = _epoch.load();
+		for (;;)
+		{
+			_readers[epoch].fetch_add(1);
+			int current = _epoch.load();
+			if (current == epoch) break;
+			_readers[epoch].fetch_sub(1);
+			epoch = current;
+		}
+		Holder* pHolder = _pCurrent.load();
+		if (pHolder) pHolder->refs.fetch_add(1);
+		_readers[epoch].fetch_sub(1);
+		return pHolder;
+	}
+
+	static void release(Holder* pHolder)
+	{
+		if (pHolder && pHolder->refs.fetch_sub(1) == 1)
+		{
+			delete pHolder;
+		}
+	}
+
+	AtomicSnapshot(const AtomicSnapshot&);
+	AtomicSnapshot& operator = (const AtomicSnapshot&);
+
+	std::atomic<Holder*> _pCurrent;
+	std::atomic<int> _epoch;
+	std::atomic<int> _readers[2];
+	FastMutex _mutex;
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_AtomicSnapshot_INCLUDED
@@ -0,0 +1,227 @@
+//
+// BinaryLogChannel.h
+//
+// Library: Foundation
+// Package: Logging
+// Module:  BinaryLogChannel
+//
+// Definition of the BinaryLogChannel class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_BinaryLogChannel_INCLUDED
+#define Foundation_BinaryLogChannel_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Channel.h"
+#include "Poco/SharedMemory.h"
+#include "Poco/Mutex.h"
+#include <unordered_map>
+#include <string>
+
+
+namespace Poco {
+
+
+class Foundation_API BinaryLogChannel: public Channel
+	/// A Channel that writes messages as binary records to a
+	/// memory-mapped file, deferring all text formatting to the
+	/// time the file is read with a BinaryLogReader.
+	///
+	/// Every record is prefixed with its length. Timestamps, priorities,
+	/// process and thread ids are stored in their raw binary form.
+	/// Strings that are expected to repeat (message sources, thread
+	/// names, source file names and format strings) are stored only
+	/// once, in a string definition record, and are subsequently
+	/// referenced by their id.
+	///
+	/// In addition to log(), which stores the text of the message,
+	/// logf() stores a Poco::format() format string together with the
+	/// unformatted arguments, so that logging a message does not
+	/// format any text at all. Supported argument types are bool,
+	/// all integer types, float, double, long double, const char*
+	/// and std::string.
+	///
+	/// Message parameters are not stored.
+	///
+	/// The file is grown in chunks and truncated to the size of the
+	/// data when the channel is closed. If the file exists when the
+	/// channel is opened, new messages are appended.
+	///
+	/// Memory-mapped files are written back by the operating system,
+	/// so messages are not lost if the process crashes. A record's
+	/// length is written after its contents, so a BinaryLogReader
+	/// never sees an incomplete record.
+	///
+	/// The file format is native byte order; the file header contains
+	/// a byte order mark which is checked by the BinaryLogReader.
+	///
+	/// Example:
+	///     AutoPtr<BinaryLogChannel> pChannel = new BinaryLogChannel("app.blog");
+	///     Logger& logger = Logger::create("App", pChannel);
+	///     logger.information("started");
+	///     pChannel->logf(Message("App", "", Message::PRIO_INFORMATION), "request %s took %d us", uri, micros);
+{
+public:
+	typedef AutoPtr<BinaryLogChannel> Ptr;
+
+	enum RecordType
+	{
+		RECORD_STRING  = 1, /// A string definition: UInt32 id, followed by the string.
+		RECORD_MESSAGE = 2  /// A message, with format string id 0 for a message logged with log().
+	};
+
+	enum ArgType
+	{
+		ARG_BOOL       = 1,
+		ARG_CHAR       = 2,
+		ARG_SHORT      = 3,
+		ARG_USHORT     = 4,
+		ARG_INT        = 5,
+		ARG_UINT       = 6,
+		ARG_LONG       = 7,
+		ARG_ULONG      = 8,
+		ARG_LONGLONG   = 9,
+		ARG_ULONGLONG  = 10,
+		ARG_FLOAT      = 11,
+		ARG_DOUBLE     = 12,
+		ARG_LONGDOUBLE = 13,
+		ARG_STRING     = 14
+	};
+
+	static const char MAGIC[8];
+		/// The first eight bytes of a binary log file.
+
+	static const Poco::UInt32 VERSION;
+		/// The file format version.
+
+	static const Poco::UInt32 BYTE_ORDER_MARK;
+		/// Stored after the version, in native byte order.
+
+	enum
+	{
+		HEADER_SIZE = 16,
+		DEFAULT_CHUNK_SIZE = 1024*1024
+	};
+
+	BinaryLogChannel();
+		/// Creates the BinaryLogChannel.
+
+	BinaryLogChannel(const std::string& path);
+		/// Creates the BinaryLogChannel with the given path.
+
+	void open();
+		/// Opens the file, creating it if it does not exist,
+		/// and maps it into memory.
+
+	void close();
+		/// Unmaps the file and truncates it to the size of the data.
+
+	void log(const Message& msg);
+		/// Writes the message, including its text, to the file.
+
+	template <typename... Args>
+	void logf(const Message& msg, const std::string& fmt, const Args&... args)
+		/// Writes the message to the file, with the given format
+		/// string and arguments instead of its text.
+		/// The BinaryLogReader formats the text with Poco::format().
+	{
+		FastMutex::ScopedLock lock(_mutex);
+
+		_args.clear();
+		appendArgs(args...);
+		writeMessage(msg, &fmt, static_cast<int>(sizeof...(Args)));
+	}
+
+	void setProperty(const std::string& name, const std::string& value);
+		/// Sets the property with the given name.
+		///
+		/// The following properties are supported:
+		///   * path:      The path of the log file. If the channel
+		///                is open, the new path is used when the
+		///                channel is opened again.
+		///   * chunkSize: The number of bytes by which the file is
+		///                grown when it is full. Defaults to 1 MB.
+		///                A value with a K or M suffix is multiplied
+		///                by 1024 or 1024*1024, respectively.
+
+	std::string getProperty(const std::string& name) const;
+		/// Returns the value of the property with the given name.
+		/// See setProperty() for a description of the supported
+		/// properties.
+
+	Poco::UInt64 size() const;
+		/// Returns the number of bytes written to the file so far,
+		/// including the header.
+
+	static const std::string PROP_PATH;
+	static const std::string PROP_CHUNKSIZE;
+
+protected:
+	~BinaryLogChannel();
+
+	void openFile();
+	void scan();
+	void map(Poco::UInt64 size);
+	void writeMessage(const Message& msg, const std::string* pFormat, int argc);
+	void writeRecord();
+	Poco::UInt32 stringId(const std::string& str);
+
+private:
+	typedef std::unordered_map<std::string, Poco::UInt32> StringMap;
+
+	void appendArgs()
+	{
+	}
+
+	template <typename T, typename... Args>
+	void appendArgs(const T& arg, const Args&... args)
+	{
+		appendArg(arg);
+		appendArgs(args...);
+	}
+
+	void appendArg(bool value);
+	void appendArg(char value);
+	void appendArg(short value);
+	void appendArg(unsigned short value);
+	void appendArg(int value);
+	void appendArg(unsigned value);
+	void appendArg(long value);
+	void appendArg(unsigned long value);
+	void appendArg(long long value);
+	void appendArg(unsigned long long value);
+	void appendArg(float value);
+	void appendArg(double value);
+	void appendArg(long double value);
+	void appendArg(const char* value);
+	void appendArg(const std::string& value);
+	void appendRaw(ArgType type, const void* pValue, std::size_t size);
+
+	BinaryLogChannel(const BinaryLogChannel&);
+	BinaryLogChannel& operator = (const BinaryLogChannel&);
+
+	std::string _path;
+	std::string _openPath;
+	std::size_t _chunkSize;
+	SharedMemory _memory;
+	Poco::UInt64 _mappedSize;
+	Poco::UInt64 _size;
+	StringMap _strings;
+	Poco::UInt32 _nextId;
+	std::string _args;
+	std::string _record;
+	mutable FastMutex _mutex;
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_BinaryLogChannel_INCLUDED
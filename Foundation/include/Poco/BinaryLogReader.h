@@ -0,0 +1,90 @@
+//
+// BinaryLogReader.h
+//
+// Library: Foundation
+// Package: Logging
+// Module:  BinaryLogChannel
+//
+// Definition of the BinaryLogReader class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_BinaryLogReader_INCLUDED
+#define Foundation_BinaryLogReader_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Message.h"
+#include "Poco/FileStream.h"
+#include "Poco/Any.h"
+#include <vector>
+#include <map>
+
+
+namespace Poco {
+
+
+class Foundation_API BinaryLogReader
+	/// Reads the messages from a file written by a BinaryLogChannel.
+	///
+	/// The text of messages logged with BinaryLogChannel::logf()
+	/// is formatted with Poco::format().
+	///
+	/// Example:
+	///     BinaryLogReader reader("app.blog");
+	///     PatternFormatter formatter("%Y-%m-%d %H:%M:%S.%i [%p] %s: %t");
+	///     Message msg;
+	///     std::string text;
+	///     while (reader.read(msg))
+	///     {
+	///         text.clear();
+	///         formatter.format(msg, text);
+	///         std::cout << text << std::endl;
+	///     }
+{
+public:
+	explicit BinaryLogReader(const std::string& path);
+		/// Opens the file with the given path.
+		///
+		/// Throws a DataFormatException if the file is not a binary log
+		/// file written on a platform with the same byte order.
+
+	~BinaryLogReader();
+		/// Closes the file.
+
+	bool read(Message& msg);
+		/// Reads the next message from the file.
+		///
+		/// Returns false if there are no more messages.
+		/// Throws a DataFormatException if the file is corrupt.
+
+private:
+	typedef std::map<Poco::UInt32, std::string> StringMap;
+
+	bool readRecord();
+	void readMessage(Message& msg);
+	const std::string& string(Poco::UInt32 id) const;
+	template <typename T> T get();
+	template <typename T> void getArg();
+
+	BinaryLogReader(const BinaryLogReader&);
+	BinaryLogReader& operator = (const BinaryLogReader&);
+
+	std::string _path;
+	FileInputStream _istr;
+	std::string _record;
+	std::size_t _pos;
+	StringMap _strings;
+	std::vector<Any> _args;
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_BinaryLogReader_INCLUDED
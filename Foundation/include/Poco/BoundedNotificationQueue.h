@@ -0,0 +1,201 @@
+//
+// BoundedNotificationQueue.h
+//
+// Library: Foundation
+// Package: Notifications
+// Module:  BoundedNotificationQueue
+//
+// Definition of the BoundedNotificationQueue class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_BoundedNotificationQueue_INCLUDED
+#define Foundation_BoundedNotificationQueue_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Notification.h"
+#if POCO_OS != POCO_OS_LINUX
+#include "Poco/Mutex.h"
+#include "Poco/Condition.h"
+#endif
+#include <atomic>
+
+
+namespace Poco {
+
+
+class NotificationCenter;
+
+
+class Foundation_API BoundedNotificationQueue
+	/// A BoundedNotificationQueue is a lock-free alternative to
+	/// NotificationQueue with a fixed capacity, for queues with
+	/// many concurrent producers and consumers.
+	///
+	/// Notifications are stored in a ring buffer of cells, each
+	/// carrying a sequence number (see Dmitry Vyukov's bounded MPMC
+	/// queue), so that enqueueing and dequeueing only take a
+	/// compare-and-swap on the respective position. Threads only
+	/// block if the queue is empty (consumers) or full (producers);
+	/// on Linux they park on a futex, on other platforms on a
+	/// condition variable. Threads are only woken if some thread
+	/// is actually waiting.
+	///
+	/// Unlike NotificationQueue, a BoundedNotificationQueue does
+	/// not support urgent notifications or removing a specific
+	/// notification, and waiting consumers are not served in FIFO
+	/// order. Otherwise, enqueueNotification(), dequeueNotification(),
+	/// waitDequeueNotification() and wakeUpAll() have the same
+	/// semantics, except that enqueueNotification() waits while
+	/// the queue is full.
+{
+public:
+	explicit BoundedNotificationQueue(std::size_t capacity = 1024);
+		/// Creates the BoundedNotificationQueue. The capacity is
+		/// rounded up to the next power of two.
+
+	~BoundedNotificationQueue();
+		/// Destroys the BoundedNotificationQueue.
+
+	void enqueueNotification(Notification::Ptr pNotification);
+		/// Enqueues the given notification by adding it to
+		/// the end of the queue (FIFO). If the queue is full,
+		/// waits until a notification has been dequeued.
+		/// The queue takes ownership of the notification, thus
+		/// a call like
+		///     notificationQueue.enqueueNotification(new MyNotification);
+		/// does not result in a memory leak.
+
+	bool tryEnqueueNotification(Notification::Ptr pNotification);
+		/// Enqueues the given notification by adding it to
+		/// the end of the queue (FIFO), unless the queue is full.
+		/// Returns true if the notification has been enqueued,
+		/// or false if the queue is full.
+
+	Notification* dequeueNotification();
+		/// Dequeues the next pending notification.
+		/// Returns 0 (null) if no notification is available.
+		/// The caller gains ownership of the notification and
+		/// is expected to release it when done with it.
+		///
+		/// It is highly recommended that the result is immediately
+		/// assigned to a Notification::Ptr, to avoid potential
+		/// memory management issues.
+
+	Notification* waitDequeueNotification();
+		/// Dequeues the next pending notification.
+		/// If no notification is available, waits for a notification
+		/// to be enqueued.
+		/// The caller gains ownership of the notification and
+		/// is expected to release it when done with it.
+		/// This method returns 0 (null) if wakeUpAll()
+		/// has been called by another thread.
+		///
+		/// It is highly recommended that the result is immediately
+		/// assigned to a Notification::Ptr, to avoid potential
+		/// memory management issues.
+
+	Notification* waitDequeueNotification(long milliseconds);
+		/// Dequeues the next pending notification.
+		/// If no notification is available, waits for a notification
+		/// to be enqueued up to the specified time.
+		/// Returns 0 (null) if no notification is available,
+		/// or if wakeUpAll() has been called by another thread.
+		/// The caller gains ownership of the notification and
+		/// is expected to release it when done with it.
+		///
+		/// It is highly recommended that the result is immediately
+		/// assigned to a Notification::Ptr, to avoid potential
+		/// memory management issues.
+
+	void dispatch(NotificationCenter& notificationCenter);
+		/// Dispatches all queued notifications to the given
+		/// notification center.
+
+	void wakeUpAll();
+		/// Wakes up all threads that wait for a notification.
+
+	bool empty() const;
+		/// Returns true iff the queue is empty.
+
+	int size() const;
+		/// Returns the number of notifications in the queue.
+		/// With concurrent producers or consumers, the result
+		/// is only a snapshot.
+
+	std::size_t capacity() const;
+		/// Returns the maximum number of notifications in the queue.
+
+	void clear();
+		/// Removes all notifications from the queue.
+
+	bool hasIdleThreads() const;
+		/// Returns true if the queue has at least one thread waiting
+		/// for a notification.
+
+private:
+	struct Cell
+	{
+		std::atomic<std::size_t> sequence;
+		Notification* pNf;
+	};
+
+	enum
+	{
+		CACHE_LINE_SIZE = 64
+	};
+
+	Notification* dequeueOne();
+	bool enqueueOne(Notification* pNf);
+	Notification* waitDequeue(long milliseconds);
+	void signal(std::atomic<int>& word, std::atomic<int>& waiting);
+	void park(std::atomic<int>& word, int value, long milliseconds);
+	void unpark(std::atomic<int>& word, bool all);
+
+	BoundedNotificationQueue(const BoundedNotificationQueue&);
+	BoundedNotificationQueue& operator = (const BoundedNotificationQueue&);
+
+	Cell* _pCells;
+	std::size_t _mask;
+	char _pad1[CACHE_LINE_SIZE];
+	std::atomic<std::size_t> _enqueuePos;
+	char _pad2[CACHE_LINE_SIZE];
+	std::atomic<std::size_t> _dequeuePos;
+	char _pad3[CACHE_LINE_SIZE];
+	std::atomic<int> _notEmpty;
+	std::atomic<int> _consumersWaiting;
+	std::atomic<int> _notFull;
+	std::atomic<int> _producersWaiting;
+	std::atomic<int> _wakeUps;
+#if POCO_OS != POCO_OS_LINUX
+	FastMutex _parkMutex;
+	Condition _parkCondition;
+#endif
+};
+
+
+//
+// inlines
+//
+inline std::size_t BoundedNotificationQueue::capacity() const
+{
+	return _mask + 1;
+}
+
+
+inline bool BoundedNotificationQueue::hasIdleThreads() const
+{
+	return _consumersWaiting.load(std::memory_order_relaxed) > 0;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_BoundedNotificationQueue_INCLUDED
@@ -0,0 +1,131 @@
+//
+// CoarseClock.h
+//
+// Library: Foundation
+// Package: DateTime
+// Module:  CoarseClock
+//
+// Definition of the CoarseClock class.
+//
+// Copyright (c) 2026, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_CoarseClock_INCLUDED
+#define Foundation_CoarseClock_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Clock.h"
+#include "Poco/Timestamp.h"
+#include <atomic>
+
+
+namespace Poco {
+
+
+class Foundation_API CoarseClock
+	/// CoarseClock provides cheap time sources for code that
+	/// would otherwise query the system clock several times
+	/// per operation.
+	///
+	/// monotonic() returns a monotonic clock value in microseconds,
+	/// relative to the same epoch as Clock, without a system call.
+	/// On x86 processors with an invariant time stamp counter, the
+	/// TSC is read and converted with a factor calibrated against
+	/// Clock during the first 100 milliseconds of use (during which
+	/// Clock is used). The factor is adjusted about once per second,
+	/// so that monotonic() follows Clock without jumping backwards.
+	/// Otherwise, CLOCK_MONOTONIC_COARSE is used on
+	/// Linux, which only advances with the kernel tick (typically
+	/// 1 - 4 ms), and Clock on all other platforms.
+	///
+	/// now() and clock() return the current time and clock value
+	/// cached by a background ticker thread that is started with
+	/// start(). Reading them costs a single atomic load. While the
+	/// ticker is not running, they return Timestamp() and Clock(),
+	/// so the classes that use them (Message, ExpireStrategy and
+	/// its subclasses, ConcurrentCache and Timer) keep full accuracy
+	/// unless the application opts in by starting the ticker.
+{
+public:
+	static Clock::ClockVal monotonic();
+		/// Returns the current value of the coarse monotonic clock.
+
+	static Timestamp now();
+		/// Returns the current time as cached by the ticker, which
+		/// is at most one ticker resolution behind Timestamp().
+		/// Returns Timestamp() if the ticker is not running.
+
+	static Clock clock();
+		/// Returns the current monotonic clock value as cached by
+		/// the ticker. Returns Clock() if the ticker is not running.
+
+	static void start(long resolution = 1);
+		/// Starts the ticker thread, which updates the cached values
+		/// every resolution milliseconds.
+		///
+		/// Calls to start() and stop() are counted, so that independent
+		/// parts of an application can use the ticker. If the ticker
+		/// is already running, the resolution argument is ignored.
+
+	static void stop();
+		/// Stops the ticker thread once stop() has been called as
+		/// often as start().
+
+	static bool isRunning();
+		/// Returns true iff the ticker thread is running.
+
+	static std::string source();
+		/// Returns the time source of monotonic():
+		/// "tsc", "monotonic_coarse" or "clock".
+
+private:
+	CoarseClock();
+	CoarseClock(const CoarseClock&);
+	CoarseClock& operator = (const CoarseClock&);
+
+	static void update();
+
+	static std::atomic<bool> _running;
+	static std::atomic<Timestamp::TimeVal> _now;
+	static std::atomic<Clock::ClockVal> _clock;
+
+	friend class CoarseClockTicker;
+};
+
+
+//
+// inlines
+//
+inline Timestamp CoarseClock::now()
+{
+	if (_running.load(std::memory_order_acquire))
+		return Timestamp(_now.load(std::memory_order_relaxed));
+	else
+		return Timestamp();
+}
+
+
+inline Clock CoarseClock::clock()
+{
+	if (_running.load(std::memory_order_acquire))
+		return Clock(_clock.load(std::memory_order_relaxed));
+	else
+		return Clock();
+}
+
+
+inline bool CoarseClock::isRunning()
+{
+	return _running.load(std::memory_order_acquire);
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_CoarseClock_INCLUDED
@@ -0,0 +1,749 @@
+//
+// ConcurrentCache.h
+//
+// Library: Foundation
+// Package: Cache
+// Module:  ConcurrentCache
+//
+// Definition of the ConcurrentCache class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_ConcurrentCache_INCLUDED
+#define Foundation_ConcurrentCache_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/RWLock.h"
+#include "Poco/Timestamp.h"
+#include "Poco/CoarseClock.h"
+#include "Poco/Hash.h"
+#include <unordered_map>
+#include <vector>
+#include <tuple>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+
+
+namespace Poco {
+
+
+template <class TKey, class TValue, class THash = Hash<TKey> >
+class ConcurrentCache
+	/// A size-limited cache for use by many threads at the same time,
+	/// for example in front of database lookups.
+	///
+	/// In contrast to the AbstractCache family, which serializes all
+	/// operations with a single mutex and notifies its strategies
+	/// through events for every access, the keys of a ConcurrentCache
+	/// are partitioned by their hash value into a number of shards.
+	/// Every shard has its own hash table, read/write lock and eviction
+	/// policy, and holds an equal share of the capacity. Lookups only
+	/// acquire the read lock of their shard. Accesses are recorded in
+	/// a small per-shard buffer, which is applied to the eviction policy
+	/// in a batch when the buffer is full or the shard is modified. If
+	/// the buffer is full and the shard cannot be locked immediately,
+	/// accesses are not recorded, so the eviction policy sees a sample
+	/// of the accesses under heavy load.
+	///
+	/// The following eviction policies are supported:
+	///   - POLICY_LRU: evicts the least recently used entry.
+	///   - POLICY_CLOCK: evicts the oldest entry that has not been
+	///     used since the last time it was considered for eviction.
+	///     Lookups only set a flag in the entry and are never buffered.
+	///   - POLICY_TINYLFU: W-TinyLFU. New entries are kept in a small
+	///     LRU window. When they leave the window, they are only
+	///     admitted to the main (segmented LRU) area if they have been
+	///     used more often than the entry that would be evicted in their
+	///     place, according to an approximate frequency sketch. This
+	///     keeps frequently used entries in the cache when many keys are
+	///     used only once, e.g. by a scan.
+	///
+	/// Like with ExpireLRUCache, an expiry time can be given, after
+	/// which entries are no longer returned by get(). Expired entries
+	/// are removed when they are looked up or evicted.
+	///
+	/// Hits and misses are counted and can be obtained with statistics().
+{
+public:
+	enum Policy
+	{
+		POLICY_LRU,
+		POLICY_CLOCK,
+		POLICY_TINYLFU
+	};
+
+	enum
+	{
+		DEFAULT_SHARDS = 16
+	};
+
+	typedef SharedPtr<TValue> ValuePtr;
+
+	struct Statistics
+		/// Statistics of a ConcurrentCache.
+	{
+		Poco::UInt64 hits;        /// Number of get() calls that returned a value.
+		Poco::UInt64 misses;      /// Number of get() calls that returned null.
+		Poco::UInt64 evictions;   /// Number of entries evicted to make room for new ones.
+		Poco::UInt64 expirations; /// Number of expired entries removed.
+		std::size_t size;         /// Current number of entries.
+
+		double hitRate() const
+			/// Returns the ratio of hits to all lookups,
+			/// or 0 if there have been no lookups.
+		{
+			Poco::UInt64 lookups = hits + misses;
+			return lookups ? static_cast<double>(hits)/lookups : 0.0;
+		}
+	};
+
+	explicit ConcurrentCache(std::size_t capacity = 1024, Policy policy = POLICY_LRU, Timestamp::TimeDiff expire = 0, std::size_t shards = DEFAULT_SHARDS):
+		/// Creates the ConcurrentCache, holding at most the given number of
+		/// entries, using the given eviction policy.
+		///
+		/// If expire is greater than zero, entries expire the given number of
+		/// milliseconds after they have been added.
+		///
+		/// The number of shards is rounded up to a power of two, and reduced
+		/// so that every shard can hold at least one entry. Since keys are
+		/// distributed among the shards by their hash value, entries may be
+		/// evicted before the cache as a whole is full.
+		_capacity(capacity),
+		_policy(policy),
+		_shardMask(0)
+	{
+		poco_assert (capacity > 0);
+
+		std::size_t n = 1;
+		while (n < shards && n*2 <= capacity) n *= 2;
+		_shardMask = n - 1;
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			_shards.push_back(new Shard((capacity + n - 1)/n, policy, expire*1000));
+		}
+	}
+
+	~ConcurrentCache()
+		/// Destroys the ConcurrentCache.
+	{
+		for (typename ShardVec::iterator it = _shards.begin(); it != _shards.end(); ++it)
+		{
+			delete *it;
+		}
+	}
+
+	void add(const TKey& key, const TValue& value)
+		/// Adds the value with the given key to the cache, replacing
+		/// an existing value with the same key. If the cache is full,
+		/// an entry is evicted according to the eviction policy.
+	{
+		add(key, ValuePtr(new TValue(value)));
+	}
+
+	void add(const TKey& key, ValuePtr pValue)
+		/// Adds the value with the given key to the cache, replacing
+		/// an existing value with the same key. If the cache is full,
+		/// an entry is evicted according to the eviction policy.
+	{
+		std::size_t hash = _hash(key);
+		shardOf(hash).add(key, pValue, hash);
+	}
+
+	void remove(const TKey& key)
+		/// Removes the entry with the given key, if it exists.
+	{
+		std::size_t hash = _hash(key);
+		shardOf(hash).remove(key);
+	}
+
+	bool has(const TKey& key) const
+		/// Returns true iff the cache contains an entry with
+		/// the given key that has not expired.
+		///
+		/// Does not count as an access.
+	{
+		std::size_t hash = _hash(key);
+		return shardOf(hash).has(key);
+	}
+
+	ValuePtr get(const TKey& key)
+		/// Returns the value with the given key, or null if the cache
+		/// does not contain an entry with the given key, or if the entry
+		/// has expired.
+	{
+		std::size_t hash = _hash(key);
+		return shardOf(hash).get(key);
+	}
+
+	void clear()
+		/// Removes all entries.
+	{
+		for (typename ShardVec::iterator it = _shards.begin(); it != _shards.end(); ++it)
+		{
+			(*it)->clear();
+		}
+	}
+
+	std::size_t size() const
+		/// Returns the number of entries, including
+		/// expired entries that have not been removed yet.
+	{
+		std::size_t n = 0;
+		for (typename ShardVec::const_iterator it = _shards.begin(); it != _shards.end(); ++it)
+		{
+			n += (*it)->size();
+		}
+		return n;
+	}
+
+	std::size_t capacity() const
+		/// Returns the maximum number of entries.
+	{
+		return _capacity;
+	}
+
+	Policy policy() const
+		/// Returns the eviction policy.
+	{
+		return _policy;
+	}
+
+	std::size_t shards() const
+		/// Returns the number of shards.
+	{
+		return _shards.size();
+	}
+
+	Statistics statistics() const
+		/// Returns the statistics of the cache.
+	{
+		Statistics stats = {0, 0, 0, 0, 0};
+		for (typename ShardVec::const_iterator it = _shards.begin(); it != _shards.end(); ++it)
+		{
+			(*it)->addStatistics(stats);
+		}
+		return stats;
+	}
+
+	void resetStatistics()
+		/// Resets the hit, miss, eviction and expiration counters.
+	{
+		for (typename ShardVec::iterator it = _shards.begin(); it != _shards.end(); ++it)
+		{
+			(*it)->resetStatistics();
+		}
+	}
+
+private:
+	enum Queue
+	{
+		QUEUE_WINDOW = 0,  /// The only queue for LRU and CLOCK.
+		QUEUE_PROBATION,
+		QUEUE_PROTECTED,
+		QUEUE_COUNT
+	};
+
+	struct Link
+	{
+		Link* prev;
+		Link* next;
+	};
+
+	struct Entry: public Link
+	{
+		Entry():
+			pKey(0),
+			hash(0),
+			expiresAt(0),
+			queue(QUEUE_WINDOW),
+			expired(false),
+			referenced(false)
+		{
+			this->prev = 0;
+			this->next = 0;
+		}
+
+		const TKey* pKey;
+		ValuePtr pValue;
+		std::size_t hash;
+		Timestamp::TimeVal expiresAt;
+		int queue;
+		bool expired;
+		std::atomic<bool> referenced;
+	};
+
+	class FrequencySketch
+		/// A count-min sketch with four 4-bit counters per key, which
+		/// are halved periodically so that old accesses are forgotten.
+	{
+	public:
+		explicit FrequencySketch(std::size_t capacity):
+			_mask(0),
+			_additions(0),
+			_sampleSize(10*capacity)
+		{
+			std::size_t n = 8;
+			while (n < capacity) n *= 2;
+			_table.resize(n, 0);
+			_mask = n*16 - 1;
+		}
+
+		void increment(std::size_t hash)
+		{
+			bool added = false;
+			for (int i = 0; i < 4; ++i)
+			{
+				std::size_t index = counterIndex(hash, i);
+				Poco::UInt64& word = _table[index >> 4];
+				int shift = static_cast<int>(index & 15)*4;
+				if (((word >> shift) & 0xF) < 15)
+				{
+					word += Poco::UInt64(1) << shift;
+					added = true;
+				}
+			}
+			if (added && ++_additions >= _sampleSize)
+			{
+				for (typename std::vector<Poco::UInt64>::iterator it = _table.begin(); it != _table.end(); ++it)
+				{
+					*it = (*it >> 1) & 0x7777777777777777ULL;
+				}
+				_additions /= 2;
+			}
+		}
+
+		int frequency(std::size_t hash) const
+		{
+			int result = 15;
+			for (int i = 0; i < 4; ++i)
+			{
+				std::size_t index = counterIndex(hash, i);
+				int count = static_cast<int>((_table[index >> 4] >> ((index & 15)*4)) & 0xF);
+				if (count < result) result = count;
+			}
+			return result;
+		}
+
+		void clear()
+		{
+			std::fill(_table.begin(), _table.end(), 0);
+			_additions = 0;
+		}
+
+	private:
+		std::size_t counterIndex(std::size_t hash, int i) const
+		{
+			static const Poco::UInt64 SEEDS[4] =
+			{
+				0xC3A5C85C97CB3127ULL, 0xB492B66FBE98F273ULL, 0x9AE16A3B2F90404FULL, 0xCBF29CE484222325ULL
+			};
+			Poco::UInt64 h = (static_cast<Poco::UInt64>(hash) + SEEDS[i])*SEEDS[i];
+			return static_cast<std::size_t>((h ^ (h >> 32)) & _mask);
+		}
+
+		std::vector<Poco::UInt64> _table;
+		std::size_t _mask;
+		std::size_t _additions;
+		std::size_t _sampleSize;
+	};
+
+	class Shard
+	{
+	public:
+		Shard(std::size_t capacity, Policy policy, Timestamp::TimeDiff expire):
+			_capacity(capacity),
+			_windowCapacity(1),
+			_protectedCapacity(0),
+			_policy(policy),
+			_expire(expire),
+			_sketch(policy == POLICY_TINYLFU ? capacity : 0),
+			_bufferPos(0),
+			_hits(0),
+			_misses(0),
+			_evictions(0),
+			_expirations(0)
+		{
+			if (policy == POLICY_TINYLFU)
+			{
+				// 1% of the capacity for the window, and 80% of
+				// the rest for the protected segment.
+				if (capacity > 100) _windowCapacity = capacity/100;
+				_protectedCapacity = (capacity - _windowCapacity)*8/10;
+			}
+			for (int i = 0; i < QUEUE_COUNT; ++i)
+			{
+				_queues[i].prev = _queues[i].next = &_queues[i];
+				_sizes[i] = 0;
+			}
+			for (int i = 0; i < BUFFER_SIZE; ++i)
+			{
+				_buffer[i].store(0, std::memory_order_relaxed);
+			}
+		}
+
+		void add(const TKey& key, ValuePtr pValue, std::size_t hash)
+		{
+			ScopedWriteRWLock lock(_lock);
+			drainBuffer();
+
+			std::pair<typename Map::iterator, bool> result = _map.emplace(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple());
+			Entry& entry = result.first->second;
+			entry.pValue = pValue;
+			entry.expiresAt = _expire > 0 ? CoarseClock::now().epochMicroseconds() + _expire : 0;
+			if (!result.second)
+			{
+				if (_policy == POLICY_CLOCK)
+					entry.referenced.store(true, std::memory_order_relaxed);
+				else
+					onAccess(&entry);
+				return;
+			}
+
+			entry.pKey = &result.first->first;
+			entry.hash = hash;
+			pushBack(&entry, QUEUE_WINDOW);
+			if (_policy == POLICY_TINYLFU)
+			{
+				_sketch.increment(hash);
+				while (_sizes[QUEUE_WINDOW] > _windowCapacity)
+				{
+					admit();
+				}
+			}
+			else
+			{
+				while (_map.size() > _capacity)
+				{
+					evict();
+				}
+			}
+		}
+
+		void remove(const TKey& key)
+		{
+			ScopedWriteRWLock lock(_lock);
+			drainBuffer();
+
+			typename Map::iterator it = _map.find(key);
+			if (it != _map.end())
+			{
+				unlink(&it->second);
+				_map.erase(it);
+			}
+		}
+
+		bool has(const TKey& key) const
+		{
+			ScopedReadRWLock lock(_lock);
+
+			typename Map::const_iterator it = _map.find(key);
+			return it != _map.end() && !isExpired(it->second);
+		}
+
+		ValuePtr get(const TKey& key)
+		{
+			ValuePtr pValue;
+			bool full = false;
+			{
+				ScopedReadRWLock lock(_lock);
+
+				typename Map::iterator it = _map.find(key);
+				if (it != _map.end())
+				{
+					Entry& entry = it->second;
+					if (isExpired(entry))
+					{
+						// The entry is removed when the buffer is drained.
+						_misses.fetch_add(1, std::memory_order_relaxed);
+						full = record(&entry);
+					}
+					else
+					{
+						pValue = entry.pValue;
+						_hits.fetch_add(1, std::memory_order_relaxed);
+						if (_policy == POLICY_CLOCK)
+						{
+							if (!entry.referenced.load(std::memory_order_relaxed))
+								entry.referenced.store(true, std::memory_order_relaxed);
+						}
+						else full = record(&entry);
+					}
+				}
+				else _misses.fetch_add(1, std::memory_order_relaxed);
+			}
+			if (full && _lock.tryWriteLock())
+			{
+				try
+				{
+					drainBuffer();
+				}
+				catch (...)
+				{
+					_lock.unlock();
+					throw;
+				}
+				_lock.unlock();
+			}
+			return pValue;
+		}
+
+		void clear()
+		{
+			ScopedWriteRWLock lock(_lock);
+			drainBuffer();
+
+			_map.clear();
+			for (int i = 0; i < QUEUE_COUNT; ++i)
+			{
+				_queues[i].prev = _queues[i].next = &_queues[i];
+				_sizes[i] = 0;
+			}
+			if (_policy == POLICY_TINYLFU) _sketch.clear();
+		}
+
+		std::size_t size() const
+		{
+			ScopedReadRWLock lock(_lock);
+
+			return _map.size();
+		}
+
+		void addStatistics(Statistics& stats) const
+		{
+			stats.hits        += _hits.load(std::memory_order_relaxed);
+			stats.misses      += _misses.load(std::memory_order_relaxed);
+			stats.evictions   += _evictions.load(std::memory_order_relaxed);
+			stats.expirations += _expirations.load(std::memory_order_relaxed);
+			stats.size        += size();
+		}
+
+		void resetStatistics()
+		{
+			_hits.store(0, std::memory_order_relaxed);
+			_misses.store(0, std::memory_order_relaxed);
+			_evictions.store(0, std::memory_order_relaxed);
+			_expirations.store(0, std::memory_order_relaxed);
+		}
+
+	private:
+		typedef std::unordered_map<TKey, Entry, THash> Map;
+
+		enum
+		{
+			BUFFER_SIZE = 64
+		};
+
+		bool isExpired(const Entry& entry) const
+		{
+			return entry.expiresAt != 0 && CoarseClock::now().epochMicroseconds() >= entry.expiresAt;
+		}
+
+		bool record(Entry* pEntry)
+			/// Records an access with the read lock held.
+			/// Returns true if the buffer is full.
+		{
+			if (_bufferPos.load(std::memory_order_relaxed) >= BUFFER_SIZE) return true;
+
+			unsigned pos = _bufferPos.fetch_add(1, std::memory_order_relaxed);
+			if (pos < BUFFER_SIZE)
+			{
+				_buffer[pos].store(pEntry, std::memory_order_relaxed);
+			}
+			return pos >= BUFFER_SIZE - 1;
+		}
+
+		void drainBuffer()
+			/// Applies the recorded accesses, with the write lock held.
+			/// Entries are only removed with the write lock held,
+			/// after the buffer has been drained, so all entries in
+			/// the buffer are valid.
+		{
+			unsigned n = _bufferPos.load(std::memory_order_relaxed);
+			if (n == 0) return;
+			if (n > BUFFER_SIZE) n = BUFFER_SIZE;
+
+			std::vector<Entry*> expired;
+			for (unsigned i = 0; i < n; ++i)
+			{
+				Entry* pEntry = _buffer[i].load(std::memory_order_relaxed);
+				_buffer[i].store(0, std::memory_order_relaxed);
+				if (!pEntry || pEntry->expired) continue;
+
+				if (isExpired(*pEntry))
+				{
+					// The same entry may be in the buffer more than once,
+					// so it is removed after all accesses have been applied.
+					pEntry->expired = true;
+					expired.push_back(pEntry);
+				}
+				else onAccess(pEntry);
+			}
+			_bufferPos.store(0, std::memory_order_relaxed);
+
+			for (typename std::vector<Entry*>::iterator it = expired.begin(); it != expired.end(); ++it)
+			{
+				erase(*it);
+				_expirations.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		void onAccess(Entry* pEntry)
+		{
+			switch (_policy)
+			{
+			case POLICY_LRU:
+				moveToBack(pEntry, QUEUE_WINDOW);
+				break;
+			case POLICY_CLOCK:
+				pEntry->referenced.store(true, std::memory_order_relaxed);
+				break;
+			case POLICY_TINYLFU:
+				_sketch.increment(pEntry->hash);
+				if (pEntry->queue == QUEUE_PROBATION)
+				{
+					moveToBack(pEntry, QUEUE_PROTECTED);
+					while (_sizes[QUEUE_PROTECTED] > _protectedCapacity)
+					{
+						moveToBack(front(QUEUE_PROTECTED), QUEUE_PROBATION);
+					}
+				}
+				else moveToBack(pEntry, pEntry->queue);
+				break;
+			}
+		}
+
+		void evict()
+			/// Evicts an entry according to the LRU or CLOCK policy.
+		{
+			for (;;)
+			{
+				Entry* pVictim = front(QUEUE_WINDOW);
+				if (_policy == POLICY_CLOCK && pVictim->referenced.load(std::memory_order_relaxed) && !isExpired(*pVictim))
+				{
+					pVictim->referenced.store(false, std::memory_order_relaxed);
+					moveToBack(pVictim, QUEUE_WINDOW);
+				}
+				else
+				{
+					evict(pVictim);
+					return;
+				}
+			}
+		}
+
+		void admit()
+			/// Moves the oldest entry of the window to the probation
+			/// segment. If the shard is full, either that entry or
+			/// the oldest entry of the main area is evicted, whichever
+			/// has been used less often.
+		{
+			Entry* pCandidate = front(QUEUE_WINDOW);
+			moveToBack(pCandidate, QUEUE_PROBATION);
+			if (_map.size() <= _capacity) return;
+
+			Entry* pVictim = front(QUEUE_PROBATION);
+			if (pVictim == pCandidate)
+			{
+				pVictim = _sizes[QUEUE_PROTECTED] > 0 ? front(QUEUE_PROTECTED) : 0;
+			}
+			if (pVictim && _sketch.frequency(pCandidate->hash) > _sketch.frequency(pVictim->hash))
+				evict(pVictim);
+			else
+				evict(pCandidate);
+		}
+
+		void evict(Entry* pEntry)
+		{
+			if (isExpired(*pEntry))
+				_expirations.fetch_add(1, std::memory_order_relaxed);
+			else
+				_evictions.fetch_add(1, std::memory_order_relaxed);
+			erase(pEntry);
+		}
+
+		void erase(Entry* pEntry)
+		{
+			unlink(pEntry);
+			_map.erase(*pEntry->pKey);
+		}
+
+		Entry* front(int queue)
+		{
+			return static_cast<Entry*>(_queues[queue].next);
+		}
+
+		void pushBack(Entry* pEntry, int queue)
+		{
+			Link& head = _queues[queue];
+			pEntry->prev = head.prev;
+			pEntry->next = &head;
+			head.prev->next = pEntry;
+			head.prev = pEntry;
+			pEntry->queue = queue;
+			++_sizes[queue];
+		}
+
+		void unlink(Entry* pEntry)
+		{
+			pEntry->prev->next = pEntry->next;
+			pEntry->next->prev = pEntry->prev;
+			--_sizes[pEntry->queue];
+		}
+
+		void moveToBack(Entry* pEntry, int queue)
+		{
+			unlink(pEntry);
+			pushBack(pEntry, queue);
+		}
+
+		Map _map;
+		Link _queues[QUEUE_COUNT];
+		std::size_t _sizes[QUEUE_COUNT];
+		std::size_t _capacity;
+		std::size_t _windowCapacity;
+		std::size_t _protectedCapacity;
+		Policy _policy;
+		Timestamp::TimeDiff _expire;
+		FrequencySketch _sketch;
+		std::atomic<Entry*> _buffer[BUFFER_SIZE];
+		std::atomic<unsigned> _bufferPos;
+		std::atomic<Poco::UInt64> _hits;
+		std::atomic<Poco::UInt64> _misses;
+		std::atomic<Poco::UInt64> _evictions;
+		std::atomic<Poco::UInt64> _expirations;
+		mutable RWLock _lock;
+	};
+
+	typedef std::vector<Shard*> ShardVec;
+
+	Shard& shardOf(std::size_t hash) const
+	{
+		// The hash table of a shard uses the low bits of the hash
+		// value, so the shard is selected by mixing in the high bits.
+		Poco::UInt64 h = static_cast<Poco::UInt64>(hash)*0x9E3779B97F4A7C15ULL;
+		return *_shards[static_cast<std::size_t>(h >> 32) & _shardMask];
+	}
+
+	ConcurrentCache(const ConcurrentCache&);
+	ConcurrentCache& operator = (const ConcurrentCache&);
+
+	std::size_t _capacity;
+	Policy _policy;
+	std::size_t _shardMask;
+	ShardVec _shards;
+	THash _hash;
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_ConcurrentCache_INCLUDED
@@ -85,28 +85,17 @@
 // candidates) will be auto-allocated on the stack in
 // cases when value holder fits into POCO_SMALL_OBJECT_SIZE
 // (see below).
-//
-// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
-// !!! NOTE: Any/Dynamic::Var SOO will NOT work reliably   !!!
-// !!! without C++11 (std::aligned_storage in particular). !!!
-// !!! Only comment this out if your compiler has support  !!!
-// !!! for std::aligned_storage.                           !!!
-// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
-//
-#ifndef POCO_NO_SOO
-#ifndef POCO_ENABLE_SOO
-#define POCO_NO_SOO
-#endif
-#endif
-
+// #define POCO_NO_SOO
 
 
 // Small object size in bytes. When assigned to Any or Var,
 // objects larger than this value will be alocated on the heap,
 // while those smaller will be placement new-ed into an
-// internal buffer.
+// internal buffer. The default is large enough to hold
+// scalars, Timestamp and std::string (with its own short
+// string buffer) in place on common 64-bit platforms.
 #if !defined(POCO_SMALL_OBJECT_SIZE) && !defined(POCO_NO_SOO)
-	#define POCO_SMALL_OBJECT_SIZE 32
+	#define POCO_SMALL_OBJECT_SIZE 40
 #endif
 
 
@@ -178,6 +167,15 @@
 // #define POCO_LOG_DEBUG
 
 
+// Define to the least important message priority for which the
+// logging macros (poco_information(), poco_debug_f2(), etc.)
+// generate code, from 1 (PRIO_FATAL) to 8 (PRIO_TRACE). Macros for
+// less important priorities expand to nothing, so their arguments
+// are not even compiled. Defaults to 8 if _DEBUG or POCO_LOG_DEBUG
+// is defined, and to 6 (PRIO_INFORMATION) otherwise.
+// #define POCO_LOG_LEVEL 6
+
+
 // OpenSSL on Windows
 //
 // Poco has its own OpenSSL build system.
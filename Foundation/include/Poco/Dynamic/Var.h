@@ -79,6 +79,10 @@ class Foundation_API Var
 	///
 	/// A Var can be created from and converted to a value of any type for which a specialization of
 	/// VarHolderImpl is available. For supported types, see VarHolder documentation.
+	///
+	/// Unless POCO_NO_SOO is defined, values whose holder fits into POCO_SMALL_OBJECT_SIZE
+	/// bytes (scalars, Timestamp and std::string on common platforms) are stored inside
+	/// the Var, without a heap allocation.
 {
 public:
 	typedef SharedPtr<Var>             Ptr;
@@ -633,50 +637,25 @@ private:
 	template<typename ValueType>
 	void construct(const ValueType& value)
 	{
-		if (sizeof(VarHolderImpl<ValueType>) <= Placeholder<ValueType>::Size::value)
-		{
-			new (reinterpret_cast<VarHolder*>(_placeholder.holder)) VarHolderImpl<ValueType>(value);
-			_placeholder.setLocal(true);
-		}
-		else
-		{
-			_placeholder.pHolder = new VarHolderImpl<ValueType>(value);
-			_placeholder.setLocal(false);
-		}
+		_placeholder.template assign<VarHolderImpl<ValueType> >(value);
 	}
 
 	void construct(const char* value)
 	{
-		std::string val(value);
-		if (sizeof(VarHolderImpl<std::string>) <= Placeholder<std::string>::Size::value)
-		{
-			new (reinterpret_cast<VarHolder*>(_placeholder.holder)) VarHolderImpl<std::string>(val);
-			_placeholder.setLocal(true);
-		}
-		else
-		{
-			_placeholder.pHolder = new VarHolderImpl<std::string>(val);
-			_placeholder.setLocal(false);
-		}
+		_placeholder.template assign<VarHolderImpl<std::string> >(std::string(value));
 	}
 
 	void construct(const Var& other)
 	{
-		if (!other.isEmpty())
-			other.content()->clone(&_placeholder);
-		else
+		if (other.isEmpty())
 			_placeholder.erase();
+		else
+			other.content()->clone(&_placeholder);
 	}
 
 	void destruct()
 	{
-		if (!isEmpty())
-		{
-			if (_placeholder.isLocal())
-				content()->~VarHolder();
-			else
-				delete content();
-		}
+		_placeholder.erase();
 	}
 
 	Placeholder<VarHolder> _placeholder;
@@ -706,22 +685,13 @@ inline void Var::swap(Var& other)
 
 	if (!_placeholder.isLocal() && !other._placeholder.isLocal())
 	{
-		std::swap(_placeholder.pHolder, other._placeholder.pHolder);
+		_placeholder.swap(other._placeholder);
 	}
 	else
 	{
 		Var tmp(*this);
-		try
-		{
-			if (_placeholder.isLocal()) destruct();
-			construct(other);
-			other = tmp;
-		}
-		catch (...)
-		{
-			construct(tmp);
-			throw;
-		}
+		construct(other);
+		other.construct(tmp);
 	}
 
 #endif
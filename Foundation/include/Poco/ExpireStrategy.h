@@ -23,6 +23,7 @@
 #include "Poco/AbstractStrategy.h"
 #include "Poco/Bugcheck.h"
 #include "Poco/Timestamp.h"
+#include "Poco/CoarseClock.h"
 #include "Poco/EventArgs.h"
 #include "Poco/Exception.h"
 #include <set>
@@ -37,7 +38,10 @@ template <
 	class TValue
 >
 class ExpireStrategy: public AbstractStrategy<TKey, TValue>
-	/// An ExpireStrategy implements time based expiration of cache entries
+	/// An ExpireStrategy implements time based expiration of cache entries.
+	///
+	/// Entry times are taken from CoarseClock::now(), i.e. from the cached
+	/// time if the application has started the CoarseClock ticker.
 {
 public:
 	typedef std::multimap<Timestamp, TKey>     TimeIndex;
@@ -60,7 +64,7 @@ public:
 
 	void onAdd(const void*, const KeyValueArgs <TKey, TValue>& args)
 	{
-		Timestamp now;
+		Timestamp now = CoarseClock::now();
 		typename TimeIndex::value_type tiValue(now, args.key());
 		IndexIterator it = _keyIndex.insert(tiValue);
 		typename Keys::value_type kValue(args.key(), it);
@@ -98,7 +102,7 @@ public:
 		Iterator it = _keys.find(args.key());
 		if (it != _keys.end())
 		{
-			if (it->second->first.isElapsed(_expireTime))
+			if (CoarseClock::now() - it->second->first >= _expireTime)
 			{
 				args.invalidate();
 			}
@@ -113,7 +117,8 @@ public:
 		// it would like to remove!
 		// it does not remove them on its own!
 		IndexIterator it = _keyIndex.begin();
-		while (it != _keyIndex.end() && it->first.isElapsed(_expireTime))
+		Timestamp now = CoarseClock::now();
+		while (it != _keyIndex.end() && now - it->first >= _expireTime)
 		{
 			elemsToRemove.insert(it->second);
 			++it;
@@ -29,6 +29,7 @@ namespace Poco {
 
 
 class LogFile;
+class Timer;
 class RotateStrategy;
 class ArchiveStrategy;
 class PurgeStrategy;
@@ -154,6 +155,20 @@ class Foundation_API FileChannel: public Channel
 	///   * true:  Every message is immediately flushed to the log file (default).
 	///   * false: Messages are not immediately flushed to the log file.
 	///
+	/// For high message rates, the FileChannel supports group commits.
+	/// If the bufferSize property is set to a number of bytes (optionally
+	/// followed by K or M) greater than zero, messages are collected in a
+	/// buffer of that size and written to the log file with a single
+	/// system call when the buffer is full, regardless of the flush
+	/// property. Buffered messages are also written every flushInterval
+	/// milliseconds (default 1000; 0 disables the timed flush), as well
+	/// as before the log file is rotated or closed.
+	/// If syncInterval is set to a number of milliseconds greater than zero
+	/// (default 0), the log file data is also synchronized to the storage
+	/// device (using fdatasync()) when buffered messages are written, at
+	/// most once per syncInterval. Rotation, archiving and purging work
+	/// the same in both modes.
+	///
 	/// The rotateOnOpen property specifies whether an existing log file should be
 	/// rotated (and archived) when the channel is opened. Valid values are:
 	///
@@ -207,6 +222,13 @@ public:
 		///                   for details.
 		///   * rotateOnOpen: Specifies whether an existing log file should be
 		///                   rotated and archived when the channel is opened.
+		///   * bufferSize:   Size of the group commit buffer in bytes (0 = disabled).
+		///                   See the FileChannel class for details.
+		///   * flushInterval: Maximum time in milliseconds messages stay in the
+		///                   group commit buffer. Changes take effect when the
+		///                   channel is opened.
+		///   * syncInterval: Minimum time in milliseconds between synchronizations
+		///                   of the log file to the storage device (0 = never).
 
 	std::string getProperty(const std::string& name) const;
 		/// Returns the value of the property with the given name.
@@ -222,6 +244,9 @@ public:
 	const std::string& path() const;
 		/// Returns the log file's path.
 
+	void flush();
+		/// Writes all buffered messages to the log file.
+
 	static const std::string PROP_PATH;
 	static const std::string PROP_ROTATION;
 	static const std::string PROP_ARCHIVE;
@@ -231,6 +256,9 @@ public:
 	static const std::string PROP_PURGECOUNT;
 	static const std::string PROP_FLUSH;
 	static const std::string PROP_ROTATEONOPEN;
+	static const std::string PROP_BUFFERSIZE;
+	static const std::string PROP_FLUSHINTERVAL;
+	static const std::string PROP_SYNCINTERVAL;
 
 protected:
 	~FileChannel();
@@ -241,6 +269,9 @@ protected:
 	void setPurgeCount(const std::string& count);
 	void setFlush(const std::string& flush);
 	void setRotateOnOpen(const std::string& rotateOnOpen);
+	void setBufferSize(const std::string& size);
+	void setFlushInterval(const std::string& interval);
+	void setSyncInterval(const std::string& interval);
 	void purge();
 
 private:
@@ -248,6 +279,10 @@ private:
 	int extractDigit(const std::string& value, std::string::const_iterator* nextToDigit = NULL) const;
 	void setPurgeStrategy(PurgeStrategy* strategy);
 	Timespan::TimeDiff extractFactor(const std::string& value, std::string::const_iterator start) const;
+	void initFile();
+	void onFlush(Timer& timer);
+	void flushFile();
+	void updateTimer();
 
 	std::string      _path;
 	std::string      _times;
@@ -258,6 +293,11 @@ private:
 	std::string      _purgeCount;
 	bool             _flush;
 	bool             _rotateOnOpen;
+	std::size_t      _bufferSize;
+	long             _flushInterval;
+	long             _syncInterval;
+	Timestamp        _lastSync;
+	Timer*           _pTimer;
 	LogFile*         _pFile;
 	RotateStrategy*  _pRotateStrategy;
 	ArchiveStrategy* _pArchiveStrategy;
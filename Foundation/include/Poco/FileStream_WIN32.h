@@ -30,6 +30,8 @@ class Foundation_API FileStreamBuf: public BufferedBidirectionalStreamBuf
 	/// This stream buffer handles Fileio
 {
 public:
+	typedef HANDLE NativeHandle;
+
 	FileStreamBuf();
 		/// Creates a FileStreamBuf.
 
@@ -49,6 +51,14 @@ public:
 	std::streampos seekpos(std::streampos pos, std::ios::openmode mode = std::ios::in | std::ios::out);
 		/// change to specified position, according to mode
 
+	NativeHandle nativeHandle() const;
+		/// Returns the native file descriptor (or handle) of
+		/// the file, for use with system calls that work on
+		/// files directly, like sendfile().
+		///
+		/// The position of the file descriptor may differ from
+		/// the position of the stream, due to buffering.
+
 protected:
 	enum
 	{
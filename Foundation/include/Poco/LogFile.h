@@ -47,6 +47,25 @@ public:
 		/// If flush is true, the text will be immediately
 		/// flushed to the file.
 
+	void flush();
+		/// Writes all buffered text to the file.
+
+	void sync();
+		/// Writes all buffered text to the file and waits
+		/// until the operating system has written the file
+		/// data to the storage device (fdatasync()).
+
+	void setBufferSize(std::size_t size);
+		/// Flushes the buffer and changes its size to the given
+		/// number of bytes, rounded up to a multiple of the page
+		/// size. Text is written to the file when the buffer is full,
+		/// or when flush() is called or requested by write().
+		///
+		/// The buffer size is ignored on Windows.
+
+	std::size_t getBufferSize() const;
+		/// Returns the buffer size.
+
 	UInt64 size() const;
 		/// Returns the current size in bytes of the log file.
 
@@ -67,6 +86,30 @@ inline void LogFile::write(const std::string& text, bool flush)
 }
 
 
+inline void LogFile::flush()
+{
+	flushImpl();
+}
+
+
+inline void LogFile::sync()
+{
+	syncImpl();
+}
+
+
+inline void LogFile::setBufferSize(std::size_t size)
+{
+	setBufferSizeImpl(size);
+}
+
+
+inline std::size_t LogFile::getBufferSize() const
+{
+	return getBufferSizeImpl();
+}
+
+
 inline UInt64 LogFile::size() const
 {
 	return sizeImpl();
@@ -5,7 +5,7 @@
 // Package: Logging
 // Module:  LogFile
 //
-// Definition of the LogFileImpl class using iostreams.
+// Definition of the LogFileImpl class using POSIX file I/O.
 //
 // Copyright (c) 2004-2006, Applied Informatics Software Engineering GmbH.
 // and Contributors.
@@ -20,7 +20,9 @@
 
 #include "Poco/Foundation.h"
 #include "Poco/Timestamp.h"
-#include "Poco/FileStream.h"
+
+
+struct iovec;
 
 
 namespace Poco {
@@ -30,20 +32,42 @@ class Foundation_API LogFileImpl
 	/// The implementation of LogFile for non-Windows platforms.
 	/// The native filesystem APIs are used for
 	/// total control over locking behavior.
+	///
+	/// Text is collected in a page-aligned buffer and written
+	/// with a single writev() call when the buffer is full or
+	/// a flush is requested.
 {
 public:
 	LogFileImpl(const std::string& path);
 	~LogFileImpl();
 	void writeImpl(const std::string& text, bool flush);
+	void flushImpl();
+	void syncImpl();
+	void setBufferSizeImpl(std::size_t size);
+	std::size_t getBufferSizeImpl() const;
 	UInt64 sizeImpl() const;
 	Timestamp creationDateImpl() const;
 	const std::string& pathImpl() const;
 
+	enum
+	{
+		DEFAULT_BUFFER_SIZE = 8192
+	};
+
 private:
+	void openFile();
+	void closeFile();
+	void writeAll(::iovec* pVec, int count, std::size_t& written);
+	void discardBuffered(std::size_t length);
+	void allocateBuffer(std::size_t size);
+
 	std::string _path;
-	mutable Poco::FileOutputStream _str;
-	Timestamp _creationDate;
-	UInt64 _size;
+	int         _fd;
+	char*       _pBuffer;
+	std::size_t _capacity;
+	std::size_t _used;
+	Timestamp   _creationDate;
+	UInt64      _size;
 };
 
 
@@ -30,11 +30,18 @@ class Foundation_API LogFileImpl
 	/// The implementation of LogFile for Windows.
 	/// The native filesystem APIs are used for
 	/// total control over locking behavior.
+	///
+	/// Text is written to the file immediately; the
+	/// buffer size is not used.
 {
 public:
 	LogFileImpl(const std::string& path);
 	~LogFileImpl();
 	void writeImpl(const std::string& text, bool flush);
+	void flushImpl();
+	void syncImpl();
+	void setBufferSizeImpl(std::size_t size);
+	std::size_t getBufferSizeImpl() const;
 	UInt64 sizeImpl() const;
 	Timestamp creationDateImpl() const;
 	const std::string& pathImpl() const;
@@ -45,6 +52,7 @@ private:
 	std::string _path;
 	HANDLE      _hFile;
 	Timestamp   _creationDate;
+	std::size_t _bufferSize;
 };
 
 
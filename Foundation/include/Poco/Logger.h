@@ -73,11 +73,18 @@ class Foundation_API Logger: public Channel
 	/// are used. The macros also add the source file path and line
 	/// number into the log message so that it is available to formatters.
 	/// Variants of these macros that allow message formatting with Poco::format()
-	/// are also available. Up to four arguments are supported.
+	/// are also available, either with any number of arguments (poco_information_f())
+	/// or up to four arguments (poco_information_f1() to poco_information_f4()).
+	/// The arguments are only evaluated if the message is actually logged.
+	///
+	/// Macros for priorities less important than POCO_LOG_LEVEL (see Poco/Config.h)
+	/// expand to nothing. By default, these are the debug and trace macros,
+	/// unless _DEBUG or POCO_LOG_DEBUG is defined.
 	///
 	/// Examples:
 	///     poco_warning(logger, "This is a warning");
 	///     poco_information_f2(logger, "An informational message with args: %d, %d", 1, 2);
+	///     poco_debug_f(logger, "A debug message with args: %s, %d, %d", describe(obj), 1, 2);
 {
 public:
 	typedef AutoPtr<Logger> Ptr;
@@ -156,7 +163,7 @@ public:
 	template <typename T, typename... Args>
 	void fatal(const std::string &fmt, T arg1, Args&&... args)
 	{
-		log(Poco::format(fmt, arg1, std::forward<Args>(args)...), Message::PRIO_FATAL);
+		if (fatal()) log(Poco::format(fmt, arg1, std::forward<Args>(args)...), Message::PRIO_FATAL);
 	}
 
 	void critical(const std::string& msg);
@@ -178,7 +185,7 @@ public:
 	template <typename T, typename... Args>
 	void critical(const std::string &fmt, T arg1, Args&&... args)
 	{
-		log(Poco::format(fmt, arg1, std::forward<Args>(args)...), Message::PRIO_CRITICAL);
+		if (critical()) log(Poco::format(fmt, arg1, std::forward<Args>(args)...), Message::PRIO_CRITICAL);
 	}
 
 	void error(const std::string& msg);
@@ -200,7 +207,7 @@ public:
 	template <typename T, typename... Args>
 	void error(const std::string &fmt, T arg1, Args&&... args)
 	{
-		log(Poco::format(fmt, arg1, std::forward<Args>(args)...), Message::PRIO_ERROR);
+		if (error()) log(Poco::format(fmt, arg1, std::forward<Args>(args)...), Message::PRIO_ERROR);
 	}
 
 	void warning(const std::string& msg);
@@ -222,7 +229,7 @@ public:
 	template <typename T, typename... Args>
 	void warning(const std::string &fmt, T arg1, Args&&... args)
 	{
-		log(Poco::format(fmt, arg1, std::forward<Args>(args)...), Message::PRIO_WARNING);
+		if (warning()) log(Poco::format(fmt, arg1, std::forward<Args>(args)...), Message::PRIO_WARNING);
 	}
 
 	void notice(const std::string& msg);
@@ -244,7 +251,7 @@ public:
 	template <typename T, typename... Args>
 	void notice(const std::string &fmt, T arg1, Args&&... args)
 	{
-		log(Poco::format(fmt, arg1, std::forward<Args>(args)...), Message::PRIO_NOTICE);
+		if (notice()) log(Poco::format(fmt, arg1, std::forward<Args>(args)...), Message::PRIO_NOTICE);
 	}
 
 	void information(const std::string& msg);
@@ -266,7 +273,7 @@ public:
 	template <typename T, typename... Args>
 	void information(const std::string &fmt, T arg1, Args&&... args)
 	{
-		log(Poco::format(fmt, arg1, std::forward<Args>(args)...), Message::PRIO_INFORMATION);
+		if (information()) log(Poco::format(fmt, arg1, std::forward<Args>(args)...), Message::PRIO_INFORMATION);
 	}
 
 	void debug(const std::string& msg);
@@ -288,7 +295,7 @@ public:
 	template <typename T, typename... Args>
 	void debug(const std::string &fmt, T arg1, Args&&... args)
 	{
-		log(Poco::format(fmt, arg1, std::forward<Args>(args)...), Message::PRIO_DEBUG);
+		if (debug()) log(Poco::format(fmt, arg1, std::forward<Args>(args)...), Message::PRIO_DEBUG);
 	}
 
 	void trace(const std::string& msg);
@@ -310,7 +317,7 @@ public:
 	template <typename T, typename... Args>
 	void trace(const std::string &fmt, T arg1, Args&&... args)
 	{
-		log(Poco::format(fmt, arg1, std::forward<Args>(args)...), Message::PRIO_TRACE);
+		if (trace()) log(Poco::format(fmt, arg1, std::forward<Args>(args)...), Message::PRIO_TRACE);
 	}
 
 	void dump(const std::string& msg, const void* buffer, std::size_t length, Message::Priority prio = Message::PRIO_DEBUG);
@@ -481,100 +488,183 @@ private:
 //
 // convenience macros
 //
-#define poco_fatal(logger, msg) \
-	if ((logger).fatal()) (logger).fatal(msg, __FILE__, __LINE__); else (void) 0
+#if !defined(POCO_LOG_LEVEL)
+	#if defined(_DEBUG) || defined(POCO_LOG_DEBUG)
+		#define POCO_LOG_LEVEL 8 // Message::PRIO_TRACE
+	#else
+		#define POCO_LOG_LEVEL 6 // Message::PRIO_INFORMATION
+	#endif
+#endif
+
+#if POCO_LOG_LEVEL >= 1 // Message::PRIO_FATAL
+	#define poco_fatal(logger, msg) \
+		if ((logger).fatal()) (logger).fatal(msg, __FILE__, __LINE__); else (void) 0
 
-#define poco_fatal_f1(logger, fmt, arg1) \
-	if ((logger).fatal()) (logger).fatal(Poco::format((fmt), arg1), __FILE__, __LINE__); else (void) 0
+	#define poco_fatal_f(logger, fmt, ...) \
+		if ((logger).fatal()) (logger).fatal(Poco::format((fmt), __VA_ARGS__), __FILE__, __LINE__); else (void) 0
 
-#define poco_fatal_f2(logger, fmt, arg1, arg2) \
-	if ((logger).fatal()) (logger).fatal(Poco::format((fmt), (arg1), (arg2)), __FILE__, __LINE__); else (void) 0
+	#define poco_fatal_f1(logger, fmt, arg1) \
+		if ((logger).fatal()) (logger).fatal(Poco::format((fmt), (arg1)), __FILE__, __LINE__); else (void) 0
 
-#define poco_fatal_f3(logger, fmt, arg1, arg2, arg3) \
-	if ((logger).fatal()) (logger).fatal(Poco::format((fmt), (arg1), (arg2), (arg3)), __FILE__, __LINE__); else (void) 0
+	#define poco_fatal_f2(logger, fmt, arg1, arg2) \
+		if ((logger).fatal()) (logger).fatal(Poco::format((fmt), (arg1), (arg2)), __FILE__, __LINE__); else (void) 0
 
-#define poco_fatal_f4(logger, fmt, arg1, arg2, arg3, arg4) \
-	if ((logger).fatal()) (logger).fatal(Poco::format((fmt), (arg1), (arg2), (arg3), (arg4)), __FILE__, __LINE__); else (void) 0
+	#define poco_fatal_f3(logger, fmt, arg1, arg2, arg3) \
+		if ((logger).fatal()) (logger).fatal(Poco::format((fmt), (arg1), (arg2), (arg3)), __FILE__, __LINE__); else (void) 0
 
-#define poco_critical(logger, msg) \
-	if ((logger).critical()) (logger).critical(msg, __FILE__, __LINE__); else (void) 0
+	#define poco_fatal_f4(logger, fmt, arg1, arg2, arg3, arg4) \
+		if ((logger).fatal()) (logger).fatal(Poco::format((fmt), (arg1), (arg2), (arg3), (arg4)), __FILE__, __LINE__); else (void) 0
+#else
+	#define poco_fatal(logger, msg)
+	#define poco_fatal_f(logger, fmt, ...)
+	#define poco_fatal_f1(logger, fmt, arg1)
+	#define poco_fatal_f2(logger, fmt, arg1, arg2)
+	#define poco_fatal_f3(logger, fmt, arg1, arg2, arg3)
+	#define poco_fatal_f4(logger, fmt, arg1, arg2, arg3, arg4)
+#endif
 
-#define poco_critical_f1(logger, fmt, arg1) \
-	if ((logger).critical()) (logger).critical(Poco::format((fmt), (arg1)), __FILE__, __LINE__); else (void) 0
+#if POCO_LOG_LEVEL >= 2 // Message::PRIO_CRITICAL
+	#define poco_critical(logger, msg) \
+		if ((logger).critical()) (logger).critical(msg, __FILE__, __LINE__); else (void) 0
 
-#define poco_critical_f2(logger, fmt, arg1, arg2) \
-	if ((logger).critical()) (logger).critical(Poco::format((fmt), (arg1), (arg2)), __FILE__, __LINE__); else (void) 0
+	#define poco_critical_f(logger, fmt, ...) \
+		if ((logger).critical()) (logger).critical(Poco::format((fmt), __VA_ARGS__), __FILE__, __LINE__); else (void) 0
 
-#define poco_critical_f3(logger, fmt, arg1, arg2, arg3) \
-	if ((logger).critical()) (logger).critical(Poco::format((fmt), (arg1), (arg2), (arg3)), __FILE__, __LINE__); else (void) 0
+	#define poco_critical_f1(logger, fmt, arg1) \
+		if ((logger).critical()) (logger).critical(Poco::format((fmt), (arg1)), __FILE__, __LINE__); else (void) 0
 
-#define poco_critical_f4(logger, fmt, arg1, arg2, arg3, arg4) \
-	if ((logger).critical()) (logger).critical(Poco::format((fmt), (arg1), (arg2), (arg3), (arg4)), __FILE__, __LINE__); else (void) 0
+	#define poco_critical_f2(logger, fmt, arg1, arg2) \
+		if ((logger).critical()) (logger).critical(Poco::format((fmt), (arg1), (arg2)), __FILE__, __LINE__); else (void) 0
 
-#define poco_error(logger, msg) \
-	if ((logger).error()) (logger).error(msg, __FILE__, __LINE__); else (void) 0
+	#define poco_critical_f3(logger, fmt, arg1, arg2, arg3) \
+		if ((logger).critical()) (logger).critical(Poco::format((fmt), (arg1), (arg2), (arg3)), __FILE__, __LINE__); else (void) 0
 
-#define poco_error_f1(logger, fmt, arg1) \
-	if ((logger).error()) (logger).error(Poco::format((fmt), (arg1)), __FILE__, __LINE__); else (void) 0
+	#define poco_critical_f4(logger, fmt, arg1, arg2, arg3, arg4) \
+		if ((logger).critical()) (logger).critical(Poco::format((fmt), (arg1), (arg2), (arg3), (arg4)), __FILE__, __LINE__); else (void) 0
+#else
+	#define poco_critical(logger, msg)
+	#define poco_critical_f(logger, fmt, ...)
+	#define poco_critical_f1(logger, fmt, arg1)
+	#define poco_critical_f2(logger, fmt, arg1, arg2)
+	#define poco_critical_f3(logger, fmt, arg1, arg2, arg3)
+	#define poco_critical_f4(logger, fmt, arg1, arg2, arg3, arg4)
+#endif
 
-#define poco_error_f2(logger, fmt, arg1, arg2) \
-	if ((logger).error()) (logger).error(Poco::format((fmt), (arg1), (arg2)), __FILE__, __LINE__); else (void) 0
+#if POCO_LOG_LEVEL >= 3 // Message::PRIO_ERROR
+	#define poco_error(logger, msg) \
+		if ((logger).error()) (logger).error(msg, __FILE__, __LINE__); else (void) 0
 
-#define poco_error_f3(logger, fmt, arg1, arg2, arg3) \
-	if ((logger).error()) (logger).error(Poco::format((fmt), (arg1), (arg2), (arg3)), __FILE__, __LINE__); else (void) 0
+	#define poco_error_f(logger, fmt, ...) \
+		if ((logger).error()) (logger).error(Poco::format((fmt), __VA_ARGS__), __FILE__, __LINE__); else (void) 0
 
-#define poco_error_f4(logger, fmt, arg1, arg2, arg3, arg4) \
-	if ((logger).error()) (logger).error(Poco::format((fmt), (arg1), (arg2), (arg3), (arg4)), __FILE__, __LINE__); else (void) 0
+	#define poco_error_f1(logger, fmt, arg1) \
+		if ((logger).error()) (logger).error(Poco::format((fmt), (arg1)), __FILE__, __LINE__); else (void) 0
 
-#define poco_warning(logger, msg) \
-	if ((logger).warning()) (logger).warning(msg, __FILE__, __LINE__); else (void) 0
+	#define poco_error_f2(logger, fmt, arg1, arg2) \
+		if ((logger).error()) (logger).error(Poco::format((fmt), (arg1), (arg2)), __FILE__, __LINE__); else (void) 0
 
-#define poco_warning_f1(logger, fmt, arg1) \
-	if ((logger).warning()) (logger).warning(Poco::format((fmt), (arg1)), __FILE__, __LINE__); else (void) 0
+	#define poco_error_f3(logger, fmt, arg1, arg2, arg3) \
+		if ((logger).error()) (logger).error(Poco::format((fmt), (arg1), (arg2), (arg3)), __FILE__, __LINE__); else (void) 0
 
-#define poco_warning_f2(logger, fmt, arg1, arg2) \
-	if ((logger).warning()) (logger).warning(Poco::format((fmt), (arg1), (arg2)), __FILE__, __LINE__); else (void) 0
+	#define poco_error_f4(logger, fmt, arg1, arg2, arg3, arg4) \
+		if ((logger).error()) (logger).error(Poco::format((fmt), (arg1), (arg2), (arg3), (arg4)), __FILE__, __LINE__); else (void) 0
+#else
+	#define poco_error(logger, msg)
+	#define poco_error_f(logger, fmt, ...)
+	#define poco_error_f1(logger, fmt, arg1)
+	#define poco_error_f2(logger, fmt, arg1, arg2)
+	#define poco_error_f3(logger, fmt, arg1, arg2, arg3)
+	#define poco_error_f4(logger, fmt, arg1, arg2, arg3, arg4)
+#endif
 
-#define poco_warning_f3(logger, fmt, arg1, arg2, arg3) \
-	if ((logger).warning()) (logger).warning(Poco::format((fmt), (arg1), (arg2), (arg3)), __FILE__, __LINE__); else (void) 0
+#if POCO_LOG_LEVEL >= 4 // Message::PRIO_WARNING
+	#define poco_warning(logger, msg) \
+		if ((logger).warning()) (logger).warning(msg, __FILE__, __LINE__); else (void) 0
 
-#define poco_warning_f4(logger, fmt, arg1, arg2, arg3, arg4) \
-	if ((logger).warning()) (logger).warning(Poco::format((fmt), (arg1), (arg2), (arg3), (arg4)), __FILE__, __LINE__); else (void) 0
-	
-#define poco_notice(logger, msg) \
-	if ((logger).notice()) (logger).notice(msg, __FILE__, __LINE__); else (void) 0
+	#define poco_warning_f(logger, fmt, ...) \
+		if ((logger).warning()) (logger).warning(Poco::format((fmt), __VA_ARGS__), __FILE__, __LINE__); else (void) 0
 
-#define poco_notice_f1(logger, fmt, arg1) \
-	if ((logger).notice()) (logger).notice(Poco::format((fmt), (arg1)), __FILE__, __LINE__); else (void) 0
+	#define poco_warning_f1(logger, fmt, arg1) \
+		if ((logger).warning()) (logger).warning(Poco::format((fmt), (arg1)), __FILE__, __LINE__); else (void) 0
 
-#define poco_notice_f2(logger, fmt, arg1, arg2) \
-	if ((logger).notice()) (logger).notice(Poco::format((fmt), (arg1), (arg2)), __FILE__, __LINE__); else (void) 0
+	#define poco_warning_f2(logger, fmt, arg1, arg2) \
+		if ((logger).warning()) (logger).warning(Poco::format((fmt), (arg1), (arg2)), __FILE__, __LINE__); else (void) 0
 
-#define poco_notice_f3(logger, fmt, arg1, arg2, arg3) \
-	if ((logger).notice()) (logger).notice(Poco::format((fmt), (arg1), (arg2), (arg3)), __FILE__, __LINE__); else (void) 0
+	#define poco_warning_f3(logger, fmt, arg1, arg2, arg3) \
+		if ((logger).warning()) (logger).warning(Poco::format((fmt), (arg1), (arg2), (arg3)), __FILE__, __LINE__); else (void) 0
 
-#define poco_notice_f4(logger, fmt, arg1, arg2, arg3, arg4) \
-	if ((logger).notice()) (logger).notice(Poco::format((fmt), (arg1), (arg2), (arg3), (arg4)), __FILE__, __LINE__); else (void) 0
+	#define poco_warning_f4(logger, fmt, arg1, arg2, arg3, arg4) \
+		if ((logger).warning()) (logger).warning(Poco::format((fmt), (arg1), (arg2), (arg3), (arg4)), __FILE__, __LINE__); else (void) 0
+#else
+	#define poco_warning(logger, msg)
+	#define poco_warning_f(logger, fmt, ...)
+	#define poco_warning_f1(logger, fmt, arg1)
+	#define poco_warning_f2(logger, fmt, arg1, arg2)
+	#define poco_warning_f3(logger, fmt, arg1, arg2, arg3)
+	#define poco_warning_f4(logger, fmt, arg1, arg2, arg3, arg4)
+#endif
+
+#if POCO_LOG_LEVEL >= 5 // Message::PRIO_NOTICE
+	#define poco_notice(logger, msg) \
+		if ((logger).notice()) (logger).notice(msg, __FILE__, __LINE__); else (void) 0
+
+	#define poco_notice_f(logger, fmt, ...) \
+		if ((logger).notice()) (logger).notice(Poco::format((fmt), __VA_ARGS__), __FILE__, __LINE__); else (void) 0
+
+	#define poco_notice_f1(logger, fmt, arg1) \
+		if ((logger).notice()) (logger).notice(Poco::format((fmt), (arg1)), __FILE__, __LINE__); else (void) 0
+
+	#define poco_notice_f2(logger, fmt, arg1, arg2) \
+		if ((logger).notice()) (logger).notice(Poco::format((fmt), (arg1), (arg2)), __FILE__, __LINE__); else (void) 0
+
+	#define poco_notice_f3(logger, fmt, arg1, arg2, arg3) \
+		if ((logger).notice()) (logger).notice(Poco::format((fmt), (arg1), (arg2), (arg3)), __FILE__, __LINE__); else (void) 0
+
+	#define poco_notice_f4(logger, fmt, arg1, arg2, arg3, arg4) \
+		if ((logger).notice()) (logger).notice(Poco::format((fmt), (arg1), (arg2), (arg3), (arg4)), __FILE__, __LINE__); else (void) 0
+#else
+	#define poco_notice(logger, msg)
+	#define poco_notice_f(logger, fmt, ...)
+	#define poco_notice_f1(logger, fmt, arg1)
+	#define poco_notice_f2(logger, fmt, arg1, arg2)
+	#define poco_notice_f3(logger, fmt, arg1, arg2, arg3)
+	#define poco_notice_f4(logger, fmt, arg1, arg2, arg3, arg4)
+#endif
 
-#define poco_information(logger, msg) \
-	if ((logger).information()) (logger).information(msg, __FILE__, __LINE__); else (void) 0
+#if POCO_LOG_LEVEL >= 6 // Message::PRIO_INFORMATION
+	#define poco_information(logger, msg) \
+		if ((logger).information()) (logger).information(msg, __FILE__, __LINE__); else (void) 0
 
-#define poco_information_f1(logger, fmt, arg1) \
-	if ((logger).information()) (logger).information(Poco::format((fmt), (arg1)), __FILE__, __LINE__); else (void) 0
+	#define poco_information_f(logger, fmt, ...) \
+		if ((logger).information()) (logger).information(Poco::format((fmt), __VA_ARGS__), __FILE__, __LINE__); else (void) 0
 
-#define poco_information_f2(logger, fmt, arg1, arg2) \
-	if ((logger).information()) (logger).information(Poco::format((fmt), (arg1), (arg2)), __FILE__, __LINE__); else (void) 0
+	#define poco_information_f1(logger, fmt, arg1) \
+		if ((logger).information()) (logger).information(Poco::format((fmt), (arg1)), __FILE__, __LINE__); else (void) 0
 
-#define poco_information_f3(logger, fmt, arg1, arg2, arg3) \
-	if ((logger).information()) (logger).information(Poco::format((fmt), (arg1), (arg2), (arg3)), __FILE__, __LINE__); else (void) 0
+	#define poco_information_f2(logger, fmt, arg1, arg2) \
+		if ((logger).information()) (logger).information(Poco::format((fmt), (arg1), (arg2)), __FILE__, __LINE__); else (void) 0
 
-#define poco_information_f4(logger, fmt, arg1, arg2, arg3, arg4) \
-	if ((logger).information()) (logger).information(Poco::format((fmt), (arg1), (arg2), (arg3), (arg4)), __FILE__, __LINE__); else (void) 0
+	#define poco_information_f3(logger, fmt, arg1, arg2, arg3) \
+		if ((logger).information()) (logger).information(Poco::format((fmt), (arg1), (arg2), (arg3)), __FILE__, __LINE__); else (void) 0
 
-#if defined(_DEBUG) || defined(POCO_LOG_DEBUG)
+	#define poco_information_f4(logger, fmt, arg1, arg2, arg3, arg4) \
+		if ((logger).information()) (logger).information(Poco::format((fmt), (arg1), (arg2), (arg3), (arg4)), __FILE__, __LINE__); else (void) 0
+#else
+	#define poco_information(logger, msg)
+	#define poco_information_f(logger, fmt, ...)
+	#define poco_information_f1(logger, fmt, arg1)
+	#define poco_information_f2(logger, fmt, arg1, arg2)
+	#define poco_information_f3(logger, fmt, arg1, arg2, arg3)
+	#define poco_information_f4(logger, fmt, arg1, arg2, arg3, arg4)
+#endif
+
+#if POCO_LOG_LEVEL >= 7 // Message::PRIO_DEBUG
 	#define poco_debug(logger, msg) \
 		if ((logger).debug()) (logger).debug(msg, __FILE__, __LINE__); else (void) 0
 
+	#define poco_debug_f(logger, fmt, ...) \
+		if ((logger).debug()) (logger).debug(Poco::format((fmt), __VA_ARGS__), __FILE__, __LINE__); else (void) 0
+
 	#define poco_debug_f1(logger, fmt, arg1) \
 		if ((logger).debug()) (logger).debug(Poco::format((fmt), (arg1)), __FILE__, __LINE__); else (void) 0
 
@@ -586,10 +676,22 @@ private:
 
 	#define poco_debug_f4(logger, fmt, arg1, arg2, arg3, arg4) \
 		if ((logger).debug()) (logger).debug(Poco::format((fmt), (arg1), (arg2), (arg3), (arg4)), __FILE__, __LINE__); else (void) 0
+#else
+	#define poco_debug(logger, msg)
+	#define poco_debug_f(logger, fmt, ...)
+	#define poco_debug_f1(logger, fmt, arg1)
+	#define poco_debug_f2(logger, fmt, arg1, arg2)
+	#define poco_debug_f3(logger, fmt, arg1, arg2, arg3)
+	#define poco_debug_f4(logger, fmt, arg1, arg2, arg3, arg4)
+#endif
 
+#if POCO_LOG_LEVEL >= 8 // Message::PRIO_TRACE
 	#define poco_trace(logger, msg) \
 		if ((logger).trace()) (logger).trace(msg, __FILE__, __LINE__); else (void) 0
 
+	#define poco_trace_f(logger, fmt, ...) \
+		if ((logger).trace()) (logger).trace(Poco::format((fmt), __VA_ARGS__), __FILE__, __LINE__); else (void) 0
+
 	#define poco_trace_f1(logger, fmt, arg1) \
 		if ((logger).trace()) (logger).trace(Poco::format((fmt), (arg1)), __FILE__, __LINE__); else (void) 0
 
@@ -602,18 +704,15 @@ private:
 	#define poco_trace_f4(logger, fmt, arg1, arg2, arg3, arg4) \
 		if ((logger).trace()) (logger).trace(Poco::format((fmt), (arg1), (arg2), (arg3), (arg4)), __FILE__, __LINE__); else (void) 0
 #else
-	#define poco_debug(logger, msg)
-	#define poco_debug_f1(logger, fmt, arg1)
-	#define poco_debug_f2(logger, fmt, arg1, arg2)
-	#define poco_debug_f3(logger, fmt, arg1, arg2, arg3)
-	#define poco_debug_f4(logger, fmt, arg1, arg2, arg3, arg4)
 	#define poco_trace(logger, msg)
+	#define poco_trace_f(logger, fmt, ...)
 	#define poco_trace_f1(logger, fmt, arg1)
 	#define poco_trace_f2(logger, fmt, arg1, arg2)
 	#define poco_trace_f3(logger, fmt, arg1, arg2, arg3)
 	#define poco_trace_f4(logger, fmt, arg1, arg2, arg3, arg4)
 #endif
 
+
 //
 // inlines
 //
@@ -22,7 +22,10 @@
 #include "Poco/Alignment.h"
 #include "Poco/Mutex.h"
 #include "Poco/NestedDiagnosticContext.h"
+#include "Poco/Environment.h"
 #include <vector>
+#include <memory>
+#include <atomic>
 #include <cstring>
 #include <cstddef>
 #include <iostream>
@@ -122,6 +125,11 @@ inline int MemoryPool::available() const
 // FastMemoryPool pre-alloc at runtime.
 #define POCO_FAST_MEMORY_POOL_PREALLOC 1000
 
+// Macro defining the default maximum number of blocks
+// cached in each per-thread magazine of a FastMemoryPool;
+// can be overriden by specifying the magazine size at runtime.
+#define POCO_FAST_MEMORY_POOL_MAGAZINE_SIZE 64
+
 
 template <typename T, typename M = SpinlockMutex>
 class FastMemoryPool
@@ -207,6 +215,14 @@ class FastMemoryPool
 	/// parameter, if needed. Poco::NullMutex can be specified as template
 	/// parameter to avoid locking and improve speed in single-threaded
 	/// scenarios.
+	///
+	/// To avoid contention on the shared list of free blocks, every thread
+	/// keeps released blocks in its own magazine, and takes blocks from it.
+	/// Blocks are moved between a magazine and the shared list in batches
+	/// of half the magazine size. If the pool cannot be resized any more,
+	/// blocks are taken from the magazines of other threads (see stolen()).
+	/// Each magazine has its own mutex, which is only contended if there
+	/// are more threads than magazines.
 {
 private:
 	class Block
@@ -281,10 +297,14 @@ public:
 	typedef Block* Bucket;
 	typedef std::vector<Bucket> BucketVec;
 
-	FastMemoryPool(std::size_t blocksPerBucket = POCO_FAST_MEMORY_POOL_PREALLOC, std::size_t bucketPreAlloc = 10, std::size_t maxAlloc = 0):
+	FastMemoryPool(std::size_t blocksPerBucket = POCO_FAST_MEMORY_POOL_PREALLOC, std::size_t bucketPreAlloc = 10, std::size_t maxAlloc = 0, std::size_t magazineSize = POCO_FAST_MEMORY_POOL_MAGAZINE_SIZE):
 			_blocksPerBucket(blocksPerBucket),
+			_firstBlock(0),
 			_maxAlloc(maxAlloc),
-			_available(0)
+			_available(0),
+			_magazineSize(magazineSize),
+			_magazineMask(0),
+			_stolen(0)
 		/// Creates the FastMemoryPool.
 		///
 		/// The size of a block is inferred from the type size. Number of blocks
@@ -300,11 +320,25 @@ public:
 		///                    pre-alocated.
 		///
 		///   - maxAlloc specifies maximum allowed total pool size in bytes.
+		///
+		///   - magazineSize specifies the maximum number of blocks cached
+		///                  in each magazine; defaults to
+		///                  POCO_FAST_MEMORY_POOL_MAGAZINE_SIZE. Zero disables
+		///                  the magazines, which is recommended if the pool
+		///                  is only used by a single thread.
 	{
 		if (_blocksPerBucket < 2)
 			throw std::invalid_argument("FastMemoryPool: blocksPerBucket must be >=2");
 		_buckets.reserve(bucketPreAlloc);
 		resize();
+		if (_magazineSize > 0)
+		{
+			std::size_t n = 4;
+			std::size_t threads = 2*Environment::processorCount();
+			while (n < threads && n < MAX_MAGAZINES) n *= 2;
+			_magazines.reset(new Magazine[n]);
+			_magazineMask = n - 1;
+		}
 	}
 
 	~FastMemoryPool()
@@ -321,15 +355,28 @@ public:
 		/// it will be resized by allocating a new
 		/// bucket.
 	{
-		Block* ret;
+		if (_magazineSize == 0)
 		{
 			ScopedLock l(_mutex);
-			if(_firstBlock == 0) resize();
-			ret = _firstBlock;
+			if (_firstBlock == 0) resize();
+			Block* ret = _firstBlock;
 			_firstBlock = _firstBlock->_memory.next;
+			--_available;
+			return ret;
+		}
+
+		Magazine& magazine = threadMagazine();
+		{
+			ScopedLock l(magazine.mutex);
+			if (magazine.first)
+			{
+				Block* ret = magazine.first;
+				magazine.first = ret->_memory.next;
+				--magazine.count;
+				return ret;
+			}
 		}
-		--_available;
-		return ret;
+		return refill(magazine);
 	}
 
 	template <typename P>
@@ -342,9 +389,33 @@ public:
 	{
 		if (!ptr) return;
 		reinterpret_cast<P*>(ptr)->~P();
-		++_available;
+		if (_magazineSize == 0)
+		{
+			ScopedLock l(_mutex);
+			_firstBlock = new (ptr) Block(_firstBlock);
+			++_available;
+			return;
+		}
+
+		Magazine& magazine = threadMagazine();
+		Block* first = 0;
+		Block* last = 0;
+		{
+			ScopedLock l(magazine.mutex);
+			magazine.first = new (ptr) Block(magazine.first);
+			if (++magazine.count <= _magazineSize) return;
+
+			// Return half of the magazine to the shared free list.
+			std::size_t n = _magazineSize/2 + 1;
+			first = last = magazine.first;
+			for (std::size_t i = 1; i < n; ++i) last = last->_memory.next;
+			magazine.first = last->_memory.next;
+			magazine.count -= n;
+		}
 		ScopedLock l(_mutex);
-		_firstBlock = new (ptr) Block(_firstBlock);
+		last->_memory.next = _firstBlock;
+		_firstBlock = first;
+		_available += _magazineSize/2 + 1;
 	}
 
 	std::size_t blockSize() const
@@ -360,9 +431,38 @@ public:
 	}
 
 	std::size_t available() const
-		/// Returns currently available amount of memory in bytes.
+		/// Returns currently available amount of memory in bytes,
+		/// including the memory cached in the magazines.
 	{
-		return _available;
+		std::size_t n = cached();
+		ScopedLock l(_mutex);
+		return n + _available;
+	}
+
+	std::size_t cached() const
+		/// Returns the number of blocks cached in the magazines.
+	{
+		std::size_t n = 0;
+		for (std::size_t i = 0; _magazineSize > 0 && i <= _magazineMask; ++i)
+		{
+			ScopedLock l(_magazines[i].mutex);
+			n += _magazines[i].count;
+		}
+		return n;
+	}
+
+	std::size_t stolen() const
+		/// Returns the number of blocks that have been taken from the
+		/// magazines of other threads, because the pool was exhausted
+		/// and could not be resized.
+	{
+		return _stolen.load(std::memory_order_relaxed);
+	}
+
+	std::size_t magazineSize() const
+		/// Returns the maximum number of blocks cached in each magazine.
+	{
+		return _magazineSize;
 	}
 
 private:
@@ -371,6 +471,100 @@ private:
 	FastMemoryPool(FastMemoryPool&&) = delete;
 	FastMemoryPool& operator = (FastMemoryPool&&) = delete;
 
+	enum
+	{
+		MAX_MAGAZINES = 256
+	};
+
+	struct Magazine
+		/// A per-thread cache of free blocks. Every thread always uses
+		/// the same magazine, and threads only share a magazine if there
+		/// are more threads than magazines. Magazines are padded, so
+		/// that they never share a cache line.
+	{
+		Magazine(): first(0), count(0)
+		{
+		}
+
+		char padding1[64];
+		Block* first;
+		std::size_t count;
+		mutable M mutex;
+		char padding2[64];
+	};
+
+	Magazine& threadMagazine() const
+	{
+		static std::atomic<unsigned> nextIndex(0);
+		static thread_local unsigned index = nextIndex++;
+
+		return _magazines[index & _magazineMask];
+	}
+
+	void* refill(Magazine& magazine)
+		/// Takes a batch of blocks from the shared free list, returns
+		/// one of them and puts the others into the given magazine.
+		/// New buckets are allocated and initialized by the thread that
+		/// needs them, so on systems with a first-touch memory policy,
+		/// their memory is placed on the NUMA node of that thread.
+	{
+		Block* first = 0;
+		Block* last = 0;
+		std::size_t n = 0;
+		{
+			ScopedLock l(_mutex);
+			if (_firstBlock == 0)
+			{
+				try
+				{
+					resize();
+				}
+				catch (std::bad_alloc&)
+				{
+				}
+			}
+			if (_firstBlock)
+			{
+				std::size_t batch = _magazineSize/2 + 1;
+				first = last = _firstBlock;
+				for (n = 1; n < batch && last->_memory.next; ++n) last = last->_memory.next;
+				_firstBlock = last->_memory.next;
+				_available -= n;
+			}
+		}
+		if (n == 0) return steal(magazine);
+		if (n > 1)
+		{
+			ScopedLock l(magazine.mutex);
+			last->_memory.next = magazine.first;
+			magazine.first = first->_memory.next;
+			magazine.count += n - 1;
+		}
+		return first;
+	}
+
+	void* steal(Magazine& own)
+		/// Takes a block from the magazine of another thread.
+		/// Throws std::bad_alloc if all magazines are empty.
+	{
+		for (std::size_t i = 0; i <= _magazineMask; ++i)
+		{
+			Magazine& magazine = _magazines[i];
+			if (&magazine == &own) continue;
+
+			ScopedLock l(magazine.mutex);
+			if (magazine.first)
+			{
+				Block* ret = magazine.first;
+				magazine.first = ret->_memory.next;
+				--magazine.count;
+				_stolen.fetch_add(1, std::memory_order_relaxed);
+				return ret;
+			}
+		}
+		throw std::bad_alloc();
+	}
+
 	void resize()
 		/// Creates new bucket and initializes it for internal use.
 		/// Sets the previously next block to point to the new bucket's
@@ -395,13 +589,15 @@ private:
 		for (auto& block : _buckets) delete[] block;
 	}
 
-	typedef std::atomic<std::size_t> Counter;
-
 	std::size_t _blocksPerBucket;
 	BucketVec   _buckets;
 	Block*      _firstBlock;
 	std::size_t _maxAlloc;
-	Counter     _available;
+	std::size_t _available;
+	std::size_t _magazineSize;
+	std::size_t _magazineMask;
+	std::unique_ptr<Magazine[]> _magazines;
+	std::atomic<std::size_t> _stolen;
 	mutable M   _mutex;
 };
 
@@ -38,6 +38,10 @@ class Foundation_API Message
 	/// Optionally a Message can also contain the source file path
 	/// and line number of the statement generating the message.
 	///
+	/// The creation time is taken from CoarseClock::now(), so if the
+	/// application has started the CoarseClock ticker, it is the
+	/// cached time, which saves a system call per message.
+	///
 	/// A Message can also contain any number of named parameters
 	/// that contain additional information about the event that
 	/// caused the message.
@@ -89,6 +93,10 @@ public:
 
 	Message& operator = (const Message& msg);
 		/// Assignment operator.
+		///
+		/// The strings of the target Message reuse their
+		/// storage where possible, so assigning to a recycled
+		/// Message usually does not allocate memory.
 
 	Message& operator = (Message&& msg);
 		/// Assignment operator.
@@ -22,6 +22,7 @@
 #include "Poco/Notification.h"
 #include "Poco/Mutex.h"
 #include "Poco/SharedPtr.h"
+#include "Poco/AtomicSnapshot.h"
 #include <vector>
 #include <cstddef>
 
@@ -60,6 +61,10 @@ class Foundation_API NotificationCenter
 	/// or it can register or unregister other observers. Observers added during a dispatch cycle
 	/// will not receive the current notification.
 	///
+	/// Registering and unregistering observers publishes a new copy of the list
+	/// of observers, so postNotification() neither locks the NotificationCenter
+	/// nor copies the list of observers.
+	///
 	/// The method receiving the notification must be implemented as
 	///     void handleNotification(MyNotification* pNf);
 	/// The handler method gets co-ownership of the Notification object
@@ -128,7 +133,10 @@ private:
 	typedef SharedPtr<AbstractObserver> AbstractObserverPtr;
 	typedef std::vector<AbstractObserverPtr> ObserverList;
 
+	void updateSnapshot();
+
 	ObserverList  _observers;
+	AtomicSnapshot<ObserverList> _snapshot;
 	mutable Mutex _mutex;
 };
 
@@ -30,6 +30,7 @@
 #include <limits>
 #include <cmath>
 #include <cctype>
+#include <type_traits>
 #if !defined(POCO_NO_LOCALE)
 	#include <locale>
 #endif
@@ -366,6 +367,72 @@ namespace Impl {
 		const char* _end;
 };	
 
+
+template <typename U>
+char* formatDecimal(U value, char* end)
+	/// Writes the decimal digits of the unsigned value backwards,
+	/// two digits at a time, so that the last digit is stored
+	/// immediately before end. Returns a pointer to the first digit.
+{
+	static const char DIGIT_PAIRS[] =
+		"0001020304050607080910111213141516171819202122232425262728293031323334353637383940414243444546474849"
+		"5051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+
+	while (value >= 100)
+	{
+		const unsigned i = static_cast<unsigned>(value % 100)*2;
+		value /= 100;
+		*--end = DIGIT_PAIRS[i + 1];
+		*--end = DIGIT_PAIRS[i];
+	}
+	if (value < 10)
+	{
+		*--end = static_cast<char>('0' + value);
+	}
+	else
+	{
+		const unsigned i = static_cast<unsigned>(value)*2;
+		*--end = DIGIT_PAIRS[i + 1];
+		*--end = DIGIT_PAIRS[i];
+	}
+	return end;
+}
+
+
+template <typename U>
+bool uIntToDecStr(U value,
+	bool negative,
+	char* result,
+	std::size_t& size,
+	int width,
+	char fill)
+	/// Fast path of intToStr() and uIntToStr() for base 10
+	/// without thousand separators.
+{
+	char digits[std::numeric_limits<U>::digits10 + 1];
+	char* end = digits + sizeof(digits);
+	const char* begin = formatDecimal(value, end);
+	const std::size_t length = (end - begin) + (negative ? 1 : 0);
+	const std::size_t padding = (width > 0 && std::size_t(width) > length) ? width - length : 0;
+	if (length + padding >= size) throw RangeException();
+
+	char* ptr = result;
+	if ('0' != fill)
+	{
+		for (std::size_t i = 0; i < padding; ++i) *ptr++ = fill;
+	}
+	if (negative) *ptr++ = '-';
+	if ('0' == fill)
+	{
+		for (std::size_t i = 0; i < padding; ++i) *ptr++ = '0';
+	}
+	while (begin < end) *ptr++ = *begin++;
+	*ptr = '\0';
+	size = ptr - result;
+	return true;
+}
+
+
 } // namespace Impl
 
 
@@ -392,6 +459,14 @@ bool intToStr(T value,
 		return false;
 	}
 
+	if (base == 10 && !thSep)
+	{
+		typedef typename std::make_unsigned<T>::type U;
+		const bool negative = value < 0;
+		const U absValue = negative ? U(0) - static_cast<U>(value) : static_cast<U>(value);
+		return Impl::uIntToDecStr(absValue, negative, result, size, width, fill);
+	}
+
 	Impl::Ptr ptr(result, size);
 	int thCount = 0;
 	T tmpVal;
@@ -469,6 +544,12 @@ bool uIntToStr(T value,
 		*result = '\0';
 		return false;
 	}
+
+	if (base == 10 && !thSep)
+	{
+		typedef typename std::make_unsigned<T>::type U;
+		return Impl::uIntToDecStr(static_cast<U>(value), false, result, size, width, fill);
+	}
 	
 	Impl::Ptr ptr(result, size);
 	int thCount = 0;
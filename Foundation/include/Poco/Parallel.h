@@ -0,0 +1,232 @@
+//
+// Parallel.h
+//
+// Library: Foundation
+// Package: Threading
+// Module:  Parallel
+//
+// Definition of the parallelFor, parallelReduce and parallelSort
+// function templates.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_Parallel_INCLUDED
+#define Foundation_Parallel_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/WorkStealingPool.h"
+#include <functional>
+#include <algorithm>
+#include <iterator>
+#include <vector>
+#include <cstddef>
+
+
+namespace Poco {
+
+
+//
+// The data-parallel algorithms below split a range into chunks and
+// run the chunks on a WorkStealingPool (the default pool, unless a pool
+// is given). The calling thread takes part in the work, so the
+// algorithms can also be called from within tasks running on the pool.
+//
+// The grain size is the minimum number of elements in a chunk. If it is
+// zero, it is chosen automatically, so that every worker gets a few
+// chunks to balance uneven workloads.
+//
+// If the function passed to an algorithm throws, no further chunks are
+// started, and the first exception thrown is rethrown to the caller
+// once all running chunks have completed.
+//
+
+
+namespace Impl {
+
+
+Foundation_API std::size_t parallelGrainSize(WorkStealingPool& pool, std::size_t size, std::size_t grainSize);
+	/// Returns the number of elements per chunk for a range of the
+	/// given size. If grainSize is zero, a grain size yielding about
+	/// eight chunks per worker is chosen.
+
+
+Foundation_API void parallelRun(WorkStealingPool& pool, std::size_t chunks, const std::function<void(std::size_t)>& chunkFunction);
+	/// Calls chunkFunction for every chunk index in [0, chunks), using
+	/// the calling thread and up to pool.threads() workers of the pool,
+	/// and waits until all calls have completed.
+	///
+	/// Rethrows the first exception thrown by chunkFunction.
+
+
+} // namespace Impl
+
+
+template <class Index, class F>
+void parallelFor(WorkStealingPool& pool, Index first, Index last, F&& function, std::size_t grainSize = 0)
+	/// Calls function(i) for every index i in [first, last),
+	/// in parallel, using the given pool.
+{
+	if (!(first < last)) return;
+	const std::size_t size = static_cast<std::size_t>(last - first);
+	const std::size_t grain = Impl::parallelGrainSize(pool, size, grainSize);
+	const std::size_t chunks = (size + grain - 1)/grain;
+	if (chunks == 1)
+	{
+		for (Index i = first; i < last; ++i) function(i);
+		return;
+	}
+	Impl::parallelRun(pool, chunks, [&](std::size_t chunk)
+	{
+		Index begin = first + static_cast<Index>(chunk*grain);
+		Index end = chunk + 1 < chunks ? begin + static_cast<Index>(grain) : last;
+		for (Index i = begin; i < end; ++i) function(i);
+	});
+}
+
+
+template <class Index, class F>
+void parallelFor(Index first, Index last, F&& function, std::size_t grainSize = 0)
+	/// Calls function(i) for every index i in [first, last),
+	/// in parallel, using the default WorkStealingPool.
+{
+	parallelFor(WorkStealingPool::defaultPool(), first, last, std::forward<F>(function), grainSize);
+}
+
+
+template <class Iterator, class T, class BinaryOp>
+T parallelReduce(WorkStealingPool& pool, Iterator first, Iterator last, T init, BinaryOp op, std::size_t grainSize = 0)
+	/// Combines init and all elements in the random access range
+	/// [first, last) with op, in parallel, using the given pool.
+	///
+	/// Every chunk is reduced separately, and the partial results
+	/// are combined in order. Therefore op must be associative,
+	/// but need not be commutative.
+	///
+	/// As with std::reduce(), a chunk's partial result is initialized
+	/// with the chunk's first element, and init is only combined once
+	/// with the partial results. The element type must therefore be
+	/// convertible to T, and op must accept two arguments of type T,
+	/// as well as a T and an element, and return a T.
+{
+	if (!(first < last)) return init;
+	const std::size_t size = static_cast<std::size_t>(last - first);
+	const std::size_t grain = Impl::parallelGrainSize(pool, size, grainSize);
+	const std::size_t chunks = (size + grain - 1)/grain;
+	if (chunks == 1)
+	{
+		for (; first != last; ++first) init = op(init, *first);
+		return init;
+	}
+	std::vector<T> partials(chunks, init);
+	Impl::parallelRun(pool, chunks, [&](std::size_t chunk)
+	{
+		typedef typename std::iterator_traits<Iterator>::difference_type Diff;
+		Iterator it = first + static_cast<Diff>(chunk*grain);
+		Iterator end = chunk + 1 < chunks ? it + static_cast<Diff>(grain) : last;
+		T partial(*it);
+		for (++it; it != end; ++it) partial = op(partial, *it);
+		partials[chunk] = partial;
+	});
+	for (typename std::vector<T>::const_iterator it = partials.begin(); it != partials.end(); ++it)
+	{
+		init = op(init, *it);
+	}
+	return init;
+}
+
+
+template <class Iterator, class T, class BinaryOp>
+T parallelReduce(Iterator first, Iterator last, T init, BinaryOp op, std::size_t grainSize = 0)
+	/// Combines init and all elements in the random access range
+	/// [first, last) with op, in parallel, using the default
+	/// WorkStealingPool.
+{
+	return parallelReduce(WorkStealingPool::defaultPool(), first, last, init, op, grainSize);
+}
+
+
+template <class Iterator>
+typename std::iterator_traits<Iterator>::value_type parallelReduce(Iterator first, Iterator last)
+	/// Returns the sum of all elements in the random access range
+	/// [first, last), computed in parallel using the default
+	/// WorkStealingPool.
+{
+	typedef typename std::iterator_traits<Iterator>::value_type T;
+	return parallelReduce(WorkStealingPool::defaultPool(), first, last, T(), std::plus<T>());
+}
+
+
+template <class Iterator, class Compare>
+void parallelSort(WorkStealingPool& pool, Iterator first, Iterator last, Compare comp, std::size_t grainSize = 0)
+	/// Sorts the random access range [first, last) with comp,
+	/// in parallel, using the given pool. The sort is not stable.
+	///
+	/// The range is divided into a power of two of blocks, which
+	/// are sorted with std::sort in parallel and then merged
+	/// pairwise with std::inplace_merge, again in parallel.
+	/// The grain size is the minimum number of elements in a block.
+{
+	enum
+	{
+		MIN_SORT_BLOCK = 4096
+	};
+
+	const std::size_t size = static_cast<std::size_t>(last - first);
+	const std::size_t minBlock = grainSize > 0 ? grainSize : std::size_t(MIN_SORT_BLOCK);
+	const std::size_t maxBlocks = 4*static_cast<std::size_t>(pool.threads());
+	std::size_t blocks = 1;
+	while (blocks < maxBlocks && size/(2*blocks) >= minBlock) blocks *= 2;
+	if (blocks == 1 || pool.threads() < 2)
+	{
+		std::sort(first, last, comp);
+		return;
+	}
+
+	const std::size_t blockSize = size/blocks;
+	auto blockBegin = [&](std::size_t block)
+	{
+		return block < blocks ? first + static_cast<typename std::iterator_traits<Iterator>::difference_type>(block*blockSize) : last;
+	};
+	Impl::parallelRun(pool, blocks, [&](std::size_t block)
+	{
+		std::sort(blockBegin(block), blockBegin(block + 1), comp);
+	});
+	for (std::size_t width = 1; width < blocks; width *= 2)
+	{
+		Impl::parallelRun(pool, blocks/(2*width), [&](std::size_t pair)
+		{
+			std::size_t block = 2*pair*width;
+			std::inplace_merge(blockBegin(block), blockBegin(block + width), blockBegin(block + 2*width), comp);
+		});
+	}
+}
+
+
+template <class Iterator, class Compare>
+void parallelSort(Iterator first, Iterator last, Compare comp)
+	/// Sorts the random access range [first, last) with comp,
+	/// in parallel, using the default WorkStealingPool.
+{
+	parallelSort(WorkStealingPool::defaultPool(), first, last, comp);
+}
+
+
+template <class Iterator>
+void parallelSort(Iterator first, Iterator last)
+	/// Sorts the random access range [first, last) in ascending
+	/// order, in parallel, using the default WorkStealingPool.
+{
+	parallelSort(WorkStealingPool::defaultPool(), first, last, std::less<typename std::iterator_traits<Iterator>::value_type>());
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_Parallel_INCLUDED
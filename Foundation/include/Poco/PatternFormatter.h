@@ -21,6 +21,7 @@
 #include "Poco/Foundation.h"
 #include "Poco/Formatter.h"
 #include "Poco/Message.h"
+#include "Poco/Timestamp.h"
 #include <vector>
 
 
@@ -75,6 +76,13 @@ class Foundation_API PatternFormatter: public Formatter
 	///   * %v[width] - the message source (%s) but text length is padded/cropped to 'width'
 	///   * %[name] - the value of the message parameter with the given name
 	///   * %% - percent sign
+	///
+	/// The pattern is compiled once into a sequence of actions.
+	/// Consecutive date/time specifiers, together with the text
+	/// between them, form a single action whose output is cached
+	/// per thread and reused for all messages logged within the
+	/// same second. Fractions of a second (%i, %c, %F) are
+	/// formatted separately for every message.
 
 {
 public:
@@ -127,7 +135,7 @@ protected:
 private:
 	struct PatternAction
 	{
-		PatternAction(): key(0), length(0)
+		PatternAction(): key(0), length(0), block(-1)
 		{
 		}
 
@@ -135,16 +143,49 @@ private:
 		int length;
 		std::string property;
 		std::string prepend;
+		int block; /// index of the TimeBlock for date/time actions, or -1
+	};
+
+	struct TimeBlock
+		/// A run of date/time actions that is formatted
+		/// and cached as a whole.
+	{
+		TimeBlock(): localTime(false)
+		{
+		}
+
+		std::vector<PatternAction> actions;
+		bool localTime; /// true if preceded by %L
 	};
 
+	struct TimeCache;
+
 	void parsePattern();
 		/// Will parse the _pattern string into the vector of PatternActions,
 		/// which contains the message key, any text that needs to be written first
 		/// a property in case of %[] and required length.
 
+	void compilePattern();
+		/// Moves runs of date/time actions into TimeBlocks.
+
+	void appendTime(const Message& msg, int block, std::string& text);
+		/// Appends the formatted date/time of the given block,
+		/// from the cache if the message time is within the
+		/// same second as the cached one.
+
+	void formatTime(const Message& msg, const TimeBlock& block, std::string& text);
+		/// Formats the date/time actions of the given block.
+
+	static bool isTimeKey(char key);
+	static Timestamp::TimeVal epochSeconds(const Timestamp& timestamp);
+	static int fraction(const Timestamp& timestamp);
+	static TimeCache& timeCache();
+
 	void parsePriorityNames();
 
 	std::vector<PatternAction> _patternActions;
+	std::vector<TimeBlock> _timeBlocks;
+	Poco::UInt64 _id;
 	bool _localTime;
 	std::string _pattern;
 	std::string _priorityNames;
@@ -162,9 +162,79 @@ S& toLowerInPlace(S& str)
 }
 
 
+inline std::string toUpper(const std::string& str)
+	/// Returns a copy of str containing all upper-case characters.
+{
+	std::string result(str);
+	Ascii::toUpperInPlace(&result[0], result.size());
+	return result;
+}
+
+
+inline std::string& toUpperInPlace(std::string& str)
+	/// Replaces all characters in str with their upper-case counterparts.
+{
+	Ascii::toUpperInPlace(&str[0], str.size());
+	return str;
+}
+
+
+inline std::string toLower(const std::string& str)
+	/// Returns a copy of str containing all lower-case characters.
+{
+	std::string result(str);
+	Ascii::toLowerInPlace(&result[0], result.size());
+	return result;
+}
+
+
+inline std::string& toLowerInPlace(std::string& str)
+	/// Replaces all characters in str with their lower-case counterparts.
+{
+	Ascii::toLowerInPlace(&str[0], str.size());
+	return str;
+}
+
+
 #if !defined(POCO_NO_TEMPLATE_ICOMPARE)
 
 
+inline int icompare(
+	const std::string& str,
+	std::string::size_type pos,
+	std::string::size_type n,
+	std::string::const_iterator it2,
+	std::string::const_iterator end2)
+	/// Case-insensitive string comparison
+{
+	std::string::size_type sz = str.size();
+	if (pos > sz) pos = sz;
+	if (pos + n > sz) n = sz - pos;
+	const char* ptr2 = it2 != end2 ? &*it2 : 0;
+	return Ascii::icompare(str.data() + pos, n, ptr2, static_cast<std::size_t>(end2 - it2));
+}
+
+
+inline int icompare(const std::string& str1, const std::string& str2)
+{
+	return Ascii::icompare(str1.data(), str1.size(), str2.data(), str2.size());
+}
+
+
+inline int icompare(
+	const std::string& str,
+	std::string::size_type pos,
+	std::string::size_type n,
+	const std::string::value_type* ptr)
+{
+	poco_check_ptr (ptr);
+	std::string::size_type sz = str.size();
+	if (pos > sz) pos = sz;
+	if (pos + n > sz) n = sz - pos;
+	return Ascii::icompare(str.data() + pos, n, ptr, std::strlen(ptr));
+}
+
+
 template <class S, class It>
 int icompare(
 	const S& str,
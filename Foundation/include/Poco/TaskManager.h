@@ -25,6 +25,7 @@
 #include "Poco/NotificationCenter.h"
 #include "Poco/Timestamp.h"
 #include "Poco/ThreadPool.h"
+#include "Poco/WorkStealingPool.h"
 #include <list>
 
 
@@ -58,6 +59,15 @@ public:
 		/// Creates the TaskManager, using the
 		/// given ThreadPool.
 
+	TaskManager(WorkStealingPool& pool);
+		/// Creates the TaskManager, using the
+		/// given WorkStealingPool.
+		///
+		/// Tasks are queued in the WorkStealingPool until
+		/// a worker becomes available, instead of failing
+		/// if no thread is available. The cpu argument
+		/// to start() is ignored.
+
 	~TaskManager();
 		/// Destroys the TaskManager.
 
@@ -115,7 +125,8 @@ protected:
 	void taskFailed(Task* pTask, const Exception& exc);
 
 private:
-	ThreadPool&        _threadPool;
+	ThreadPool*        _pThreadPool;
+	WorkStealingPool*  _pWorkStealingPool;
 	TaskList           _taskList;
 	Timestamp          _lastProgressNotification;
 	NotificationCenter _nc;
@@ -0,0 +1,195 @@
+//
+// TimingWheel.h
+//
+// Library: Foundation
+// Package: Notifications
+// Module:  TimingWheel
+//
+// Definition of the TimingWheel class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_TimingWheel_INCLUDED
+#define Foundation_TimingWheel_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Notification.h"
+#include "Poco/Mutex.h"
+#include "Poco/Event.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Clock.h"
+#include <vector>
+
+
+namespace Poco {
+
+
+class Foundation_API TimingWheel
+	/// A TimingWheel schedules notifications for future expiry,
+	/// like a TimedNotificationQueue, for very large numbers of
+	/// timers, such as per-connection idle and retry timeouts.
+	///
+	/// Time is divided into ticks of a fixed resolution (one
+	/// millisecond by default). The timers are kept in a hierarchy
+	/// of six wheels of 64 slots each, covering 64, 64^2, ..., 64^6
+	/// ticks; timers further in the future are kept in an overflow
+	/// list. Every slot is a doubly linked list, so that schedule()
+	/// and cancel() take constant time. A timer is moved to a
+	/// finer-grained wheel when the time covered by its slot
+	/// begins, so every timer is moved at most six times. Timer
+	/// entries are kept in a single array, so scheduling a timer
+	/// does not allocate memory in the steady state.
+	///
+	/// Timers expire at the end of the tick containing their
+	/// expiry time, so they never expire early, but up to one tick
+	/// late. Expired notifications are returned in batches by
+	/// expire() and waitExpire(), ordered by tick; notifications
+	/// expiring within the same tick are not ordered.
+	///
+	/// Multiple threads may schedule and cancel timers, but only
+	/// one thread at a time may call expire() or waitExpire().
+{
+public:
+	typedef Poco::UInt64 TimerId;
+		/// Identifies a scheduled timer. Zero is never a valid id.
+
+	typedef std::vector<Notification::Ptr> NotificationVec;
+
+	explicit TimingWheel(Clock::ClockDiff resolution = 1000);
+		/// Creates the TimingWheel, with the given length of a tick
+		/// in microseconds.
+
+	~TimingWheel();
+		/// Destroys the TimingWheel.
+
+	TimerId schedule(Notification::Ptr pNotification, Clock clock);
+		/// Schedules the given notification to expire at the given
+		/// clock value, and returns the id of the timer.
+		/// The TimingWheel takes ownership of the notification.
+
+	TimerId schedule(Notification::Ptr pNotification, Timestamp timestamp);
+		/// Schedules the given notification to expire at the given
+		/// time, and returns the id of the timer.
+		///
+		/// The Timestamp is converted to an equivalent Clock value.
+
+	bool cancel(TimerId id);
+		/// Cancels the timer with the given id and releases its
+		/// notification.
+		///
+		/// Returns true if the timer has been cancelled, or false
+		/// if the timer has already expired or been cancelled.
+
+	std::size_t expire(NotificationVec& expired);
+		/// Appends the notifications of all expired timers to the
+		/// given vector, and returns their number.
+
+	std::size_t expire(NotificationVec& expired, Clock now);
+		/// Appends the notifications of all timers that expire
+		/// up to the given clock value to the given vector, and
+		/// returns their number.
+
+	std::size_t waitExpire(NotificationVec& expired);
+		/// Waits until at least one timer has expired, then appends
+		/// the notifications of all expired timers to the given
+		/// vector, and returns their number.
+		///
+		/// Returns 0 if wakeUp() has been called by another thread.
+
+	std::size_t waitExpire(NotificationVec& expired, long milliseconds);
+		/// Waits up to the given time for a timer to expire, then
+		/// appends the notifications of all expired timers to the
+		/// given vector, and returns their number.
+		///
+		/// Returns 0 if no timer has expired in time, or if wakeUp()
+		/// has been called by another thread.
+
+	void wakeUp();
+		/// Wakes up the thread waiting in waitExpire().
+
+	bool empty() const;
+		/// Returns true iff no timers are scheduled.
+
+	std::size_t size() const;
+		/// Returns the number of scheduled timers.
+
+	void clear();
+		/// Cancels all timers.
+
+	Clock::ClockDiff resolution() const;
+		/// Returns the length of a tick in microseconds.
+
+private:
+	enum
+	{
+		LEVELS     = 6,
+		SLOT_BITS  = 6,
+		SLOTS      = 1 << SLOT_BITS,
+		OVERFLOW_LIST = LEVELS*SLOTS,
+		LISTS      = LEVELS*SLOTS + 1
+	};
+
+	static const Poco::UInt32 NIL;
+	static const Poco::UInt32 FREE;
+	static const Poco::UInt64 NEVER;
+
+	struct Entry
+	{
+		Notification* pNf;
+		Poco::UInt64 tick;
+		Poco::UInt32 prev;
+		Poco::UInt32 next;
+		Poco::UInt32 list;
+		Poco::UInt32 generation;
+	};
+
+	typedef std::vector<Entry> EntryVec;
+
+	Poco::UInt64 tickOf(const Clock& clock, bool roundUp) const;
+	Clock clockOf(Poco::UInt64 tick) const;
+	void insert(Poco::UInt32 index);
+	void link(Poco::UInt32 index, Poco::UInt32 list);
+	void unlink(Poco::UInt32 index);
+	Notification* release(Poco::UInt32 index);
+	std::size_t advance(Poco::UInt64 target, NotificationVec& expired);
+	void cascade(Poco::UInt32 list);
+	Poco::UInt64 nextEvent() const;
+	std::size_t waitExpireImpl(NotificationVec& expired, long milliseconds);
+
+	TimingWheel(const TimingWheel&);
+	TimingWheel& operator = (const TimingWheel&);
+
+	Clock::ClockDiff _resolution;
+	Clock _origin;
+	Poco::UInt64 _now;
+	EntryVec _entries;
+	Poco::UInt32 _free;
+	std::size_t _size;
+	Poco::UInt32 _heads[LISTS];
+	Poco::UInt64 _occupied[LEVELS];
+	Poco::UInt64 _waitTick;
+	bool _wakeUp;
+	Event _wakeUpEvent;
+	mutable FastMutex _mutex;
+};
+
+
+//
+// inlines
+//
+inline Clock::ClockDiff TimingWheel::resolution() const
+{
+	return _resolution;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_TimingWheel_INCLUDED
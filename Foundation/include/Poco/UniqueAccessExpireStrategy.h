@@ -23,6 +23,7 @@
 #include "Poco/AbstractStrategy.h"
 #include "Poco/Bugcheck.h"
 #include "Poco/Timestamp.h"
+#include "Poco/CoarseClock.h"
 #include "Poco/Timespan.h"
 #include "Poco/EventArgs.h"
 #include "Poco/UniqueExpireStrategy.h"
@@ -69,7 +70,7 @@ public:
 	{
 		// the expire value defines how many millisecs in the future the
 		// value will expire, even insert negative values!
-		Timestamp expire;
+		Timestamp expire = CoarseClock::now();
 		expire += args.value().getTimeout().totalMicroseconds();
 		
 		IndexIterator it = _keyIndex.insert(std::make_pair(expire, std::make_pair(args.key(), args.value().getTimeout())));
@@ -99,7 +100,7 @@ public:
 		{
 			KeyExpire ke = it->second->second;
 			// gen new absolute expire value
-			Timestamp expire;
+			Timestamp expire = CoarseClock::now();
 			expire += ke.second.totalMicroseconds();
 			// delete old index
 			_keyIndex.erase(it->second);
@@ -120,7 +121,7 @@ public:
 		Iterator it = _keys.find(args.key());
 		if (it != _keys.end())
 		{
-			Timestamp now;
+			Timestamp now = CoarseClock::now();
 			if (it->second->first <= now)
 			{
 				args.invalidate();
@@ -136,7 +137,7 @@ public:
 		// it would like to remove!
 		// it does not remove them on its own!
 		IndexIterator it = _keyIndex.begin();
-		Timestamp now;
+		Timestamp now = CoarseClock::now();
 		while (it != _keyIndex.end() && it->first < now)
 		{
 			elemsToRemove.insert(it->second.first);
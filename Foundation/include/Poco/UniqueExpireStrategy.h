@@ -23,6 +23,7 @@
 #include "Poco/AbstractStrategy.h"
 #include "Poco/Bugcheck.h"
 #include "Poco/Timestamp.h"
+#include "Poco/CoarseClock.h"
 #include "Poco/EventArgs.h"
 #include <set>
 #include <map>
@@ -102,7 +103,7 @@ public:
 		Iterator it = _keys.find(args.key());
 		if (it != _keys.end())
 		{
-			Timestamp now;
+			Timestamp now = CoarseClock::now();
 			if (it->second->first <= now)
 			{
 				args.invalidate();
@@ -118,7 +119,7 @@ public:
 		// it would like to remove!
 		// it does not remove them on its own!
 		IndexIterator it = _keyIndex.begin();
-		Timestamp now;
+		Timestamp now = CoarseClock::now();
 		while (it != _keyIndex.end() && it->first < now)
 		{
 			elemsToRemove.insert(it->second);
@@ -0,0 +1,251 @@
+//
+// WorkStealingPool.h
+//
+// Library: Foundation
+// Package: Threading
+// Module:  WorkStealingPool
+//
+// Definition of the WorkStealingPool class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_WorkStealingPool_INCLUDED
+#define Foundation_WorkStealingPool_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Runnable.h"
+#include "Poco/Thread.h"
+#include "Poco/Mutex.h"
+#include "Poco/Condition.h"
+#include <vector>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <type_traits>
+
+
+namespace Poco {
+
+
+class Foundation_API WorkStealingPool
+	/// A fixed set of worker threads executing short tasks
+	/// from work-stealing queues.
+	///
+	/// Unlike ThreadPool, which hands every Runnable to a thread
+	/// of its own and fails if no thread is available, a
+	/// WorkStealingPool queues tasks until a worker becomes
+	/// available. Every worker owns a double-ended queue
+	/// (a Chase-Lev deque), to which tasks submitted from within
+	/// a task running on that worker are added, and from which
+	/// the worker takes tasks in LIFO order without locking.
+	/// Tasks submitted from other threads are added to a bounded
+	/// injection queue shared by all workers. A worker that runs
+	/// out of tasks takes tasks from the injection queue, or steals
+	/// the oldest tasks from the queues of other workers.
+	/// Idle workers sleep until new tasks are submitted.
+	///
+	/// Tasks should not block for long periods of time, since a
+	/// blocked task occupies its worker. Tasks waiting for other
+	/// tasks should use joinAll() or futures with care, as waiting
+	/// from within a task may deadlock once all workers wait.
+	///
+	/// Exceptions thrown by a Runnable started with start() or a
+	/// function passed to execute() are passed to the ErrorHandler.
+	/// Exceptions thrown by a function passed to submit() are
+	/// stored in the returned future.
+{
+public:
+	WorkStealingPool(int threads = 0, std::size_t queueCapacity = 1024);
+		/// Creates the WorkStealingPool with the given number
+		/// of worker threads (one per CPU core if zero) and
+		/// the given capacity of the injection queue.
+
+	WorkStealingPool(const std::string& name, int threads = 0, std::size_t queueCapacity = 1024);
+		/// Creates the WorkStealingPool with the given name, which
+		/// is used for the names of the worker threads.
+
+	~WorkStealingPool();
+		/// Stops the pool, after all queued tasks have been
+		/// executed, and destroys it.
+
+	void start(Runnable& target);
+		/// Queues the given Runnable for execution by one of the workers.
+		///
+		/// The Runnable must stay alive until it has completed.
+		///
+		/// If called from a worker of this pool, the Runnable is added
+		/// to the queue of the worker. Otherwise it is added to the
+		/// injection queue; if the injection queue is full, a
+		/// NoThreadAvailableException is thrown.
+		///
+		/// Throws an IllegalStateException if the pool has been stopped.
+
+	template <class F>
+	void execute(F&& function)
+		/// Queues the given function (any callable taking no arguments)
+		/// for execution by one of the workers. See start().
+	{
+		schedule(new FunctionTask<typename std::decay<F>::type>(std::forward<F>(function)));
+	}
+
+	template <class F>
+	auto submit(F&& function) -> std::future<decltype(function())>
+		/// Queues the given function (any callable taking no arguments)
+		/// for execution by one of the workers, and returns a future
+		/// for its result. See start().
+	{
+		typedef decltype(function()) R;
+		std::shared_ptr<std::packaged_task<R()>> pTask = std::make_shared<std::packaged_task<R()>>(std::forward<F>(function));
+		std::future<R> result = pTask->get_future();
+		schedule(new FunctionTask<PackagedTaskRunner<R>>(PackagedTaskRunner<R>(pTask)));
+		return result;
+	}
+
+	void joinAll();
+		/// Waits until all tasks submitted so far, and all tasks
+		/// submitted by these tasks, have completed.
+		///
+		/// Must not be called from a worker of this pool.
+
+	void stop();
+		/// Stops the pool after all queued tasks have been
+		/// executed, and waits for the worker threads to finish.
+		/// No more tasks can be submitted afterwards.
+		///
+		/// Must not be called from a worker of this pool.
+
+	int threads() const;
+		/// Returns the number of worker threads.
+
+	std::size_t queueCapacity() const;
+		/// Returns the capacity of the injection queue.
+
+	const std::string& name() const;
+		/// Returns the name of the pool.
+
+	Poco::UInt64 executed() const;
+		/// Returns the number of tasks executed so far.
+
+	Poco::UInt64 stolen() const;
+		/// Returns the number of tasks workers have stolen
+		/// from the queues of other workers so far.
+
+	bool isWorker() const;
+		/// Returns true if the calling thread is a worker of this pool.
+
+	static WorkStealingPool& defaultPool();
+		/// Returns a reference to the default WorkStealingPool,
+		/// which has one worker per CPU core.
+
+private:
+	class Task
+	{
+	public:
+		virtual ~Task();
+		virtual void run() = 0;
+	};
+
+	template <class F>
+	class FunctionTask: public Task
+	{
+	public:
+		template <class G>
+		explicit FunctionTask(G&& function):
+			_function(std::forward<G>(function))
+		{
+		}
+
+		void run()
+		{
+			_function();
+		}
+
+	private:
+		F _function;
+	};
+
+	template <class R>
+	class PackagedTaskRunner
+	{
+	public:
+		explicit PackagedTaskRunner(const std::shared_ptr<std::packaged_task<R()>>& pTask):
+			_pTask(pTask)
+		{
+		}
+
+		void operator () ()
+		{
+			(*_pTask)();
+		}
+
+	private:
+		std::shared_ptr<std::packaged_task<R()>> _pTask;
+	};
+
+	class RunnableTask;
+	class Deque;
+	class Worker;
+
+	typedef std::vector<Worker*> WorkerVec;
+
+	enum
+	{
+		SPIN_COUNT = 16,
+		MAX_INJECTED_BATCH = 32
+	};
+
+	void init(int threads);
+	static Worker*& currentWorker();
+	void schedule(Task* pTask);
+	Task* findTask(Worker& worker);
+	bool hasWork() const;
+	void wakeUp();
+	void run(Worker& worker);
+	void runTask(Worker& worker, Task* pTask);
+	void park();
+
+	WorkStealingPool(const WorkStealingPool&);
+	WorkStealingPool& operator = (const WorkStealingPool&);
+
+	std::string _name;
+	WorkerVec _workers;
+	std::vector<Task*> _injected;
+	std::size_t _injectedHead;
+	std::atomic<std::size_t> _injectedCount;
+	Poco::UInt64 _injectedTotal;
+	mutable FastMutex _injectedMutex;
+	std::atomic<int> _sleeping;
+	FastMutex _sleepMutex;
+	Condition _sleepCondition;
+	std::atomic<int> _joining;
+	FastMutex _joinMutex;
+	Condition _joinCondition;
+	std::atomic<bool> _stopped;
+};
+
+
+//
+// inlines
+//
+inline std::size_t WorkStealingPool::queueCapacity() const
+{
+	return _injected.size();
+}
+
+
+inline const std::string& WorkStealingPool::name() const
+{
+	return _name;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_WorkStealingPool_INCLUDED
@@ -0,0 +1,129 @@
+//
+// EventBenchmark.cpp
+//
+// This sample measures the number of events per second that
+// BasicEvent and NotificationCenter can deliver from multiple
+// threads to a few delegates.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/BasicEvent.h"
+#include "Poco/Delegate.h"
+#include "Poco/NotificationCenter.h"
+#include "Poco/NObserver.h"
+#include "Poco/Notification.h"
+#include "Poco/AutoPtr.h"
+#include "Poco/Thread.h"
+#include "Poco/Stopwatch.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <atomic>
+#include <cstdlib>
+
+
+using Poco::BasicEvent;
+using Poco::NotificationCenter;
+using Poco::NObserver;
+using Poco::Notification;
+using Poco::AutoPtr;
+using Poco::Thread;
+using Poco::Stopwatch;
+
+
+class Subscriber
+{
+public:
+	Subscriber():
+		_count(0)
+	{
+	}
+
+	void onEvent(const void* pSender, int& arg)
+	{
+		_count.fetch_add(arg, std::memory_order_relaxed);
+	}
+
+	void onNotification(const AutoPtr<Notification>& pNf)
+	{
+		_count.fetch_add(1, std::memory_order_relaxed);
+	}
+
+private:
+	std::atomic<long> _count;
+};
+
+
+template <typename F>
+void benchmark(const std::string& what, int threadCount, int count, F fire)
+	/// Calls fire() count times in each of threadCount threads,
+	/// and prints the number of events per second.
+{
+	std::vector<Thread*> threads;
+	for (int i = 0; i < threadCount; ++i)
+	{
+		threads.push_back(new Thread);
+	}
+	Stopwatch sw;
+	sw.start();
+	for (std::vector<Thread*>::iterator it = threads.begin(); it != threads.end(); ++it)
+	{
+		(*it)->startFunc([count, &fire]()
+		{
+			for (int n = 0; n < count; ++n) fire();
+		});
+	}
+	for (std::vector<Thread*>::iterator it = threads.begin(); it != threads.end(); ++it)
+	{
+		(*it)->join();
+		delete *it;
+	}
+	sw.stop();
+
+	double eventsPerSecond = 1000000.0*threadCount*count/sw.elapsed();
+	std::cout << std::setw(20) << std::left << what << std::setw(3) << std::right << threadCount << " threads: "
+		<< std::setw(12) << std::fixed << std::setprecision(0) << eventsPerSecond << " events/s" << std::endl;
+}
+
+
+int main(int argc, char** argv)
+{
+	int count = 1000000;
+	if (argc > 1) count = std::atoi(argv[1]);
+
+	Subscriber subscriber1;
+	Subscriber subscriber2;
+
+	BasicEvent<int> event;
+	event += Poco::delegate(&subscriber1, &Subscriber::onEvent);
+	event += Poco::delegate(&subscriber2, &Subscriber::onEvent);
+
+	NotificationCenter nc;
+	nc.addObserver(NObserver<Subscriber, Notification>(subscriber1, &Subscriber::onNotification));
+	nc.addObserver(NObserver<Subscriber, Notification>(subscriber2, &Subscriber::onNotification));
+	AutoPtr<Notification> pNf = new Notification;
+
+	const int threadCounts[] = {1, 8, 32};
+	for (int i = 0; i < 3; ++i)
+	{
+		benchmark("BasicEvent", threadCounts[i], count/threadCounts[i], [&event]()
+		{
+			int arg = 1;
+			event.notify(0, arg);
+		});
+	}
+	for (int i = 0; i < 3; ++i)
+	{
+		benchmark("NotificationCenter", threadCounts[i], count/threadCounts[i], [&nc, &pNf]()
+		{
+			nc.postNotification(pNf);
+		});
+	}
+
+	return 0;
+}
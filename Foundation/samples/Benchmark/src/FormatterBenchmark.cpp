@@ -0,0 +1,89 @@
+//
+// FormatterBenchmark.cpp
+//
+// This sample measures the time PatternFormatter takes to format
+// a log message, for some commonly used patterns.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/PatternFormatter.h"
+#include "Poco/Message.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/AutoPtr.h"
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+
+
+using Poco::PatternFormatter;
+using Poco::Message;
+using Poco::Timestamp;
+using Poco::Stopwatch;
+using Poco::AutoPtr;
+
+
+void benchmark(const std::string& pattern, const std::string& times, Timestamp::TimeDiff step, int count)
+	/// Formats count messages, advancing the message time
+	/// by step microseconds per message.
+{
+	AutoPtr<PatternFormatter> pFormatter = new PatternFormatter(pattern);
+	pFormatter->setProperty(PatternFormatter::PROP_TIMES, times);
+
+	Message msg("Benchmark", "A typical log message with some text", Message::PRIO_INFORMATION);
+	Timestamp time;
+	std::string text;
+	std::size_t length = 0;
+
+	Stopwatch sw;
+	sw.start();
+	for (int i = 0; i < count; ++i)
+	{
+		time += step;
+		msg.setTime(time);
+		text.clear();
+		pFormatter->format(msg, text);
+		length += text.size();
+	}
+	sw.stop();
+
+	double ns = 1000.0*sw.elapsed()/count;
+	std::cout << std::setw(44) << std::left << pattern
+		<< std::setw(6) << times
+		<< std::setw(10) << std::right << step << " us"
+		<< std::setw(10) << std::fixed << std::setprecision(1) << ns << " ns/msg"
+		<< (length == 0 ? " (empty)" : "") << std::endl;
+}
+
+
+int main(int argc, char** argv)
+{
+	int count = 1000000;
+	if (argc > 1) count = std::atoi(argv[1]);
+
+	const char* patterns[] =
+	{
+		"%Y-%m-%d %H:%M:%S.%i [%p] %s: %t",
+		"%Y-%m-%d %H:%M:%S [%p] %s: %t",
+		"%Y-%m-%d %H:%M:%S.%F [%p] %s: %t",
+		"%d %b %Y %H:%M:%S %Z [%q] %s: %t",
+		"[%p] %s: %t"
+	};
+
+	std::cout << std::setw(44) << std::left << "pattern" << std::setw(6) << "times"
+		<< std::setw(13) << std::right << "msg interval" << std::setw(17) << "time" << std::endl;
+	for (const char* pattern: patterns)
+	{
+		// many messages per second, and one message per millisecond
+		benchmark(pattern, "UTC", 10, count);
+		benchmark(pattern, "UTC", 1000, count);
+		benchmark(pattern, "local", 10, count);
+	}
+
+	return 0;
+}
@@ -0,0 +1,111 @@
+//
+// MemoryPoolBenchmark.cpp
+//
+// This sample compares the throughput of MemoryPool, FastMemoryPool
+// with and without per-thread magazines, and malloc() with 1 to 64
+// threads allocating and releasing blocks.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/MemoryPool.h"
+#include "Poco/Thread.h"
+#include "Poco/Stopwatch.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cstdlib>
+
+
+using Poco::MemoryPool;
+using Poco::FastMemoryPool;
+using Poco::Thread;
+using Poco::Stopwatch;
+
+
+struct Object
+{
+	char data[64];
+};
+
+
+const int BATCH = 16;
+
+
+template <typename Get, typename Release>
+void benchmark(const std::string& what, int threadCount, int count, Get get, Release release)
+	/// Allocates and releases count blocks in batches of BATCH blocks
+	/// in each of threadCount threads, and prints the number of
+	/// allocations per second.
+{
+	std::vector<Thread*> threads;
+	for (int i = 0; i < threadCount; ++i)
+	{
+		threads.push_back(new Thread);
+	}
+	Stopwatch sw;
+	sw.start();
+	for (std::vector<Thread*>::iterator it = threads.begin(); it != threads.end(); ++it)
+	{
+		(*it)->startFunc([count, &get, &release]()
+		{
+			Object* objects[BATCH];
+			for (int n = 0; n < count; n += BATCH)
+			{
+				for (int i = 0; i < BATCH; ++i) objects[i] = new (get()) Object;
+				for (int i = 0; i < BATCH; ++i) release(objects[i]);
+			}
+		});
+	}
+	for (std::vector<Thread*>::iterator it = threads.begin(); it != threads.end(); ++it)
+	{
+		(*it)->join();
+		delete *it;
+	}
+	sw.stop();
+
+	double allocsPerSecond = 1000000.0*threadCount*count/sw.elapsed();
+	std::cout << std::setw(28) << std::left << what << std::setw(3) << std::right << threadCount << " threads: "
+		<< std::setw(12) << std::fixed << std::setprecision(0) << allocsPerSecond << " allocations/s" << std::endl;
+}
+
+
+int main(int argc, char** argv)
+{
+	int count = 4000000;
+	if (argc > 1) count = std::atoi(argv[1]);
+
+	const int threadCounts[] = {1, 2, 4, 8, 16, 32, 64};
+	for (int i = 0; i < 7; ++i)
+	{
+		int threads = threadCounts[i];
+		int perThread = count/threads;
+
+		MemoryPool pool(sizeof(Object), threads*BATCH);
+		benchmark("MemoryPool", threads, perThread,
+			[&pool]() { return pool.get(); },
+			[&pool](Object* p) { pool.release(p); });
+
+		FastMemoryPool<Object> sharedPool(POCO_FAST_MEMORY_POOL_PREALLOC, 10, 0, 0);
+		benchmark("FastMemoryPool (shared)", threads, perThread,
+			[&sharedPool]() { return sharedPool.get(); },
+			[&sharedPool](Object* p) { sharedPool.release(p); });
+
+		FastMemoryPool<Object> fastPool;
+		benchmark("FastMemoryPool (magazines)", threads, perThread,
+			[&fastPool]() { return fastPool.get(); },
+			[&fastPool](Object* p) { fastPool.release(p); });
+
+		benchmark("malloc", threads, perThread,
+			[]() { return std::malloc(sizeof(Object)); },
+			[](Object* p) { std::free(p); });
+
+		std::cout << std::endl;
+	}
+
+	return 0;
+}
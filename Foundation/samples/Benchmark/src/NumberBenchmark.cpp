@@ -0,0 +1,123 @@
+//
+// NumberBenchmark.cpp
+//
+// This sample measures the throughput of integer and floating-point
+// formatting with NumberFormatter and parsing with NumberParser, with
+// snprintf() and strtod() as a reference.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/NumberFormatter.h"
+#include "Poco/NumberParser.h"
+#include "Poco/NumericString.h"
+#include "Poco/Random.h"
+#include "Poco/Stopwatch.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+
+
+using Poco::NumberFormatter;
+using Poco::NumberParser;
+using Poco::Stopwatch;
+
+
+template <typename F>
+void benchmark(const std::string& what, int count, F f)
+	/// Calls f(n) count times and prints the time per call and
+	/// the number of characters produced or consumed per second.
+{
+	std::size_t chars = 0;
+	Stopwatch sw;
+	sw.start();
+	for (int n = 0; n < count; ++n) chars += f(n);
+	sw.stop();
+
+	double nsPerOp = 1000.0*sw.elapsed()/count;
+	double mbPerSec = static_cast<double>(chars)/sw.elapsed();
+	std::cout << std::setw(32) << std::left << what << std::right << std::fixed << std::setprecision(1)
+		<< std::setw(10) << nsPerOp << " ns/op" << std::setw(10) << mbPerSec << " MB/s" << std::endl;
+}
+
+
+int main(int argc, char** argv)
+{
+	int count = 1000000;
+	if (argc > 1) count = std::atoi(argv[1]);
+
+	const int SIZE = 4096;
+	Poco::Random rnd;
+	rnd.seed(42);
+	std::vector<int> ints;
+	std::vector<Poco::Int64> int64s;
+	std::vector<double> doubles;
+	std::vector<std::string> strings;
+	for (int i = 0; i < SIZE; ++i)
+	{
+		ints.push_back(static_cast<int>(rnd.next()) >> (rnd.next() % 31));
+		int64s.push_back((static_cast<Poco::Int64>(rnd.next()) << 32 | rnd.next()) >> (rnd.next() % 63));
+		// a mix of "typical" values with few digits and full precision values
+		double d = (i % 2) ? rnd.nextDouble()*1e6 : static_cast<int>(rnd.next() % 100000)/100.0;
+		doubles.push_back(d);
+		strings.push_back(NumberFormatter::format(d));
+	}
+
+	std::string str;
+	benchmark("NumberFormatter::append(int)", count, [&](int n)
+	{
+		str.clear();
+		NumberFormatter::append(str, ints[n % SIZE]);
+		return str.size();
+	});
+	benchmark("NumberFormatter::append(Int64)", count, [&](int n)
+	{
+		str.clear();
+		NumberFormatter::append(str, int64s[n % SIZE]);
+		return str.size();
+	});
+	benchmark("NumberFormatter::append(double)", count, [&](int n)
+	{
+		str.clear();
+		NumberFormatter::append(str, doubles[n % SIZE]);
+		return str.size();
+	});
+	benchmark("NumberFormatter::format(double)", count, [&](int n)
+	{
+		return NumberFormatter::format(doubles[n % SIZE]).size();
+	});
+	char buffer[POCO_MAX_FLT_STRING_LEN];
+	benchmark("snprintf(%.17g)", count, [&](int n)
+	{
+		return static_cast<std::size_t>(std::snprintf(buffer, sizeof(buffer), "%.17g", doubles[n % SIZE]));
+	});
+
+	double sum = 0;
+	benchmark("NumberParser::parseFloat()", count, [&](int n)
+	{
+		const std::string& s = strings[n % SIZE];
+		sum += NumberParser::parseFloat(s);
+		return s.size();
+	});
+	benchmark("strToDouble(const char*)", count, [&](int n)
+	{
+		const std::string& s = strings[n % SIZE];
+		sum += Poco::strToDouble(s.c_str());
+		return s.size();
+	});
+	benchmark("strtod()", count, [&](int n)
+	{
+		const std::string& s = strings[n % SIZE];
+		sum += std::strtod(s.c_str(), 0);
+		return s.size();
+	});
+
+	return sum == 0 ? 1 : 0;
+}
@@ -0,0 +1,119 @@
+//
+// ParallelBenchmark.cpp
+//
+// This sample compares parallelFor, parallelReduce and parallelSort
+// with their sequential counterparts on large std::vector workloads.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Parallel.h"
+#include "Poco/WorkStealingPool.h"
+#include "Poco/Random.h"
+#include "Poco/Stopwatch.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <numeric>
+#include <functional>
+#include <cmath>
+#include <cstdlib>
+
+
+using Poco::WorkStealingPool;
+using Poco::Stopwatch;
+
+
+template <typename F>
+double measure(int rounds, F f)
+	/// Returns the best time of the given number of rounds
+	/// in milliseconds.
+{
+	double best = 0;
+	for (int i = 0; i < rounds; ++i)
+	{
+		Stopwatch sw;
+		sw.start();
+		f();
+		sw.stop();
+		double ms = sw.elapsed()/1000.0;
+		if (i == 0 || ms < best) best = ms;
+	}
+	return best;
+}
+
+
+void report(const std::string& what, double sequential, double parallel)
+{
+	std::cout << std::setw(24) << std::left << what << std::right << std::fixed << std::setprecision(2)
+		<< std::setw(10) << sequential << " ms" << std::setw(10) << parallel << " ms"
+		<< std::setw(8) << sequential/parallel << "x" << std::endl;
+}
+
+
+int main(int argc, char** argv)
+{
+	std::size_t size = 10000000;
+	if (argc > 1) size = static_cast<std::size_t>(std::atol(argv[1]));
+	const int rounds = 5;
+
+	WorkStealingPool& pool = WorkStealingPool::defaultPool();
+	std::cout << "Elements: " << size << ", workers: " << pool.threads() << std::endl << std::endl;
+	std::cout << std::setw(24) << std::left << "" << std::right << std::setw(13) << "sequential" << std::setw(13) << "parallel" << std::setw(9) << "speedup" << std::endl;
+
+	Poco::Random rnd;
+	rnd.seed(42);
+	std::vector<double> input(size);
+	for (std::size_t i = 0; i < size; ++i) input[i] = rnd.nextDouble();
+	std::vector<double> output(size);
+
+	// transform: a compute-bound loop body
+	double seqFor = measure(rounds, [&]()
+	{
+		for (std::size_t i = 0; i < size; ++i) output[i] = std::sqrt(input[i])*std::sin(input[i]);
+	});
+	double parFor = measure(rounds, [&]()
+	{
+		Poco::parallelFor(std::size_t(0), size, [&](std::size_t i)
+		{
+			output[i] = std::sqrt(input[i])*std::sin(input[i]);
+		});
+	});
+	report("parallelFor", seqFor, parFor);
+
+	// sum: a memory-bound reduction
+	volatile double sink = 0;
+	double seqReduce = measure(rounds, [&]()
+	{
+		sink = std::accumulate(input.begin(), input.end(), 0.0);
+	});
+	double parReduce = measure(rounds, [&]()
+	{
+		sink = Poco::parallelReduce(input.begin(), input.end(), 0.0, std::plus<double>());
+	});
+	report("parallelReduce", seqReduce, parReduce);
+
+	// sort of random integers
+	std::vector<int> ints(size);
+	for (std::size_t i = 0; i < size; ++i) ints[i] = static_cast<int>(rnd.next());
+	std::vector<int> work;
+	double seqSort = measure(rounds, [&]()
+	{
+		work = ints;
+		std::sort(work.begin(), work.end());
+	});
+	double parSort = measure(rounds, [&]()
+	{
+		work = ints;
+		Poco::parallelSort(work.begin(), work.end());
+	});
+	report("parallelSort", seqSort, parSort);
+
+	return 0;
+}
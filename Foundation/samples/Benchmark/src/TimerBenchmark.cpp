@@ -0,0 +1,128 @@
+//
+// TimerBenchmark.cpp
+//
+// This sample compares TimingWheel and TimedNotificationQueue with
+// one million live timers, such as per-connection idle timeouts.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/TimingWheel.h"
+#include "Poco/TimedNotificationQueue.h"
+#include "Poco/Notification.h"
+#include "Poco/Clock.h"
+#include "Poco/Random.h"
+#include "Poco/Stopwatch.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cstdlib>
+
+
+using Poco::TimingWheel;
+using Poco::TimedNotificationQueue;
+using Poco::Notification;
+using Poco::Clock;
+using Poco::Random;
+using Poco::Stopwatch;
+
+
+void report(const std::string& what, const Stopwatch& sw, int count)
+{
+	std::cout << std::setw(48) << std::left << what
+		<< std::setw(10) << std::right << std::fixed << std::setprecision(1)
+		<< 1000.0*sw.elapsed()/count << " ns/timer" << std::endl;
+}
+
+
+int main(int argc, char** argv)
+{
+	int count = 1000000;
+	if (argc > 1) count = std::atoi(argv[1]);
+
+	// timeouts between one second and one minute
+	Random rnd;
+	rnd.seed(1);
+	std::vector<Clock::ClockDiff> delays;
+	for (int i = 0; i < count; ++i)
+	{
+		delays.push_back(1000000 + 1000*static_cast<Clock::ClockDiff>(rnd.next(59000)));
+	}
+	std::vector<Notification::Ptr> notifications;
+	for (int i = 0; i < count; ++i)
+	{
+		notifications.push_back(new Notification);
+	}
+
+	std::cout << count << " timers" << std::endl;
+	{
+		TimingWheel wheel;
+		Clock base;
+		std::vector<TimingWheel::TimerId> ids(count);
+		Stopwatch sw;
+
+		sw.start();
+		for (int i = 0; i < count; ++i)
+			ids[i] = wheel.schedule(notifications[i], base + delays[i]);
+		sw.stop();
+		report("TimingWheel: schedule", sw, count);
+
+		sw.restart();
+		for (int i = 0; i < count; ++i)
+		{
+			wheel.cancel(ids[i]);
+			ids[i] = wheel.schedule(notifications[i], base + delays[count - 1 - i]);
+		}
+		sw.stop();
+		report("TimingWheel: cancel and reschedule", sw, count);
+
+		TimingWheel::NotificationVec expired;
+		expired.reserve(count);
+		std::size_t n = 0;
+		sw.restart();
+		for (Clock::ClockDiff t = 0; t <= 61000000; t += 1000)
+			n += wheel.expire(expired, base + t);
+		sw.stop();
+		report("TimingWheel: expire (1 ms steps)", sw, static_cast<int>(n));
+		expired.clear();
+
+		for (int i = 0; i < count; ++i)
+			ids[i] = wheel.schedule(notifications[i], base + delays[i]);
+		sw.restart();
+		for (int i = 0; i < count; ++i)
+			wheel.cancel(ids[i]);
+		sw.stop();
+		report("TimingWheel: cancel", sw, count);
+	}
+	{
+		// Notifications are scheduled in the past,
+		// so that they can be dequeued immediately.
+		TimedNotificationQueue queue;
+		Clock base;
+		base -= 61000000;
+		Stopwatch sw;
+
+		sw.start();
+		for (int i = 0; i < count; ++i)
+			queue.enqueueNotification(notifications[i], base + delays[i]);
+		sw.stop();
+		report("TimedNotificationQueue: enqueue", sw, count);
+
+		int n = 0;
+		sw.restart();
+		Notification::Ptr pNf = queue.dequeueNotification();
+		while (pNf)
+		{
+			++n;
+			pNf = queue.dequeueNotification();
+		}
+		sw.stop();
+		report("TimedNotificationQueue: dequeue", sw, n);
+	}
+
+	return 0;
+}
@@ -0,0 +1,124 @@
+//
+// VarBenchmark.cpp
+//
+// This sample measures the cost of creating, copying and assigning
+// Dynamic::Var values holding scalars, Timestamps and strings, and
+// of building a DynamicStruct, as done per field by the JSON parser
+// and by RecordSet.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Dynamic/Var.h"
+#include "Poco/Dynamic/Struct.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Stopwatch.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <cstdlib>
+
+
+using Poco::Dynamic::Var;
+using Poco::DynamicStruct;
+using Poco::Timestamp;
+using Poco::Stopwatch;
+
+
+template <typename F>
+void benchmark(const std::string& what, int count, F f)
+	/// Calls f() count times and prints the average time per call.
+{
+	Stopwatch sw;
+	sw.start();
+	for (int n = 0; n < count; ++n) f(n);
+	sw.stop();
+
+	double nsPerOp = 1000.0*sw.elapsed()/count;
+	std::cout << std::setw(32) << std::left << what << std::setw(10) << std::right
+		<< std::fixed << std::setprecision(1) << nsPerOp << " ns/op" << std::endl;
+}
+
+
+int main(int argc, char** argv)
+{
+	int count = 1000000;
+	if (argc > 1) count = std::atoi(argv[1]);
+
+#ifdef POCO_NO_SOO
+	std::cout << "small object optimization disabled" << std::endl;
+#else
+	std::cout << "small object size: " << POCO_SMALL_OBJECT_SIZE << std::endl;
+#endif
+
+	std::vector<Var> vars(16);
+	const std::string shortString("value");
+	const std::string longString(100, 'x');
+	const Timestamp ts;
+
+	benchmark("Var(int)", count, [&vars](int n)
+	{
+		vars[n & 15] = Var(n);
+	});
+	benchmark("Var(double)", count, [&vars](int n)
+	{
+		vars[n & 15] = Var(n*0.5);
+	});
+	benchmark("Var(Timestamp)", count, [&vars, &ts](int n)
+	{
+		vars[n & 15] = Var(ts);
+	});
+	benchmark("Var(short string)", count, [&vars, &shortString](int n)
+	{
+		vars[n & 15] = Var(shortString);
+	});
+	benchmark("Var(long string)", count, [&vars, &longString](int n)
+	{
+		vars[n & 15] = Var(longString);
+	});
+
+	Var intVar(42);
+	Var stringVar(shortString);
+	benchmark("copy Var(int)", count, [&vars, &intVar](int n)
+	{
+		vars[n & 15] = intVar;
+	});
+	benchmark("copy Var(short string)", count, [&vars, &stringVar](int n)
+	{
+		vars[n & 15] = stringVar;
+	});
+
+	int sum = 0;
+	benchmark("convert<int>()", count, [&intVar, &sum](int n)
+	{
+		sum += intVar.convert<int>();
+	});
+
+	benchmark("DynamicStruct (4 fields)", count/10, [&shortString, &ts](int n)
+	{
+		DynamicStruct ds;
+		ds.insert("id", n);
+		ds.insert("name", shortString);
+		ds.insert("price", n*0.5);
+		ds.insert("created", ts);
+	});
+
+	std::vector<Var> row;
+	row.reserve(8);
+	benchmark("row of 8 fields", count/10, [&row, &shortString](int n)
+	{
+		row.clear();
+		for (int i = 0; i < 4; ++i)
+		{
+			row.push_back(Var(n + i));
+			row.push_back(Var(shortString));
+		}
+	});
+
+	return sum == 0 ? 1 : 0;
+}
@@ -0,0 +1,73 @@
+//
+// BinaryLogDecoder.cpp
+//
+// This sample demonstrates the BinaryLogReader class, by converting
+// a file written by a BinaryLogChannel to text, using a PatternFormatter.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/BinaryLogReader.h"
+#include "Poco/PatternFormatter.h"
+#include "Poco/Message.h"
+#include "Poco/Exception.h"
+#include <iostream>
+#include <cstring>
+
+
+using Poco::BinaryLogReader;
+using Poco::PatternFormatter;
+using Poco::Message;
+
+
+int main(int argc, char** argv)
+{
+	std::string pattern("%Y-%m-%d %H:%M:%S.%F [%p] %s<%I>: %t");
+	bool localTime = false;
+	int i = 1;
+	for (; i < argc && argv[i][0] == '-'; ++i)
+	{
+		if (std::strcmp(argv[i], "-p") == 0 && i + 1 < argc)
+			pattern = argv[++i];
+		else if (std::strcmp(argv[i], "-l") == 0)
+			localTime = true;
+		else
+			break;
+	}
+	if (i + 1 != argc)
+	{
+		std::cout << "usage: " << argv[0] << ": [-l] [-p <pattern>] <log_file>" << std::endl
+		          << "       print the messages in <log_file>, written by a BinaryLogChannel," << std::endl
+		          << "       formatted with the given PatternFormatter pattern." << std::endl
+		          << "       -l: format times as local time" << std::endl;
+		return 1;
+	}
+
+	try
+	{
+		BinaryLogReader reader(argv[i]);
+		PatternFormatter formatter(pattern);
+		if (localTime) formatter.setProperty(PatternFormatter::PROP_TIMES, "local");
+
+		Message msg;
+		std::string text;
+		while (reader.read(msg))
+		{
+			text.clear();
+			formatter.format(msg, text);
+			std::cout << text << '\n';
+		}
+		std::cout.flush();
+	}
+	catch (Poco::Exception& exc)
+	{
+		std::cerr << exc.displayText() << std::endl;
+		return 2;
+	}
+
+	return 0;
+}
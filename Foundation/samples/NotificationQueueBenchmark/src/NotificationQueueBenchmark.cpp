@@ -0,0 +1,149 @@
+//
+// NotificationQueueBenchmark.cpp
+//
+// This sample compares the throughput of NotificationQueue and the
+// lock-free BoundedNotificationQueue with an increasing number of
+// concurrent producer and consumer threads.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/NotificationQueue.h"
+#include "Poco/BoundedNotificationQueue.h"
+#include "Poco/Notification.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/NumberParser.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <memory>
+
+
+using Poco::NotificationQueue;
+using Poco::BoundedNotificationQueue;
+using Poco::Notification;
+using Poco::Thread;
+using Poco::Runnable;
+using Poco::Stopwatch;
+using Poco::NumberParser;
+
+
+template <class Q>
+class Producer: public Runnable
+{
+public:
+	Producer(Q& queue, int count):
+		_queue(queue),
+		_count(count)
+	{
+	}
+
+	void run()
+	{
+		Notification::Ptr pNf = new Notification;
+		for (int i = 0; i < _count; ++i)
+		{
+			_queue.enqueueNotification(pNf);
+		}
+	}
+
+private:
+	Q& _queue;
+	int _count;
+};
+
+
+template <class Q>
+class Consumer: public Runnable
+{
+public:
+	Consumer(Q& queue):
+		_queue(queue)
+	{
+	}
+
+	void run()
+	{
+		Notification::Ptr pNf = _queue.waitDequeueNotification();
+		while (pNf)
+		{
+			pNf = _queue.waitDequeueNotification();
+		}
+	}
+
+private:
+	Q& _queue;
+};
+
+
+template <class Q>
+double benchmark(Q& queue, int threads, int count)
+	/// Runs the given number of producers and consumers and
+	/// returns the number of notifications passed per second.
+{
+	std::vector<std::unique_ptr<Thread>> consumerThreads;
+	std::vector<std::unique_ptr<Thread>> producerThreads;
+	std::vector<std::unique_ptr<Consumer<Q>>> consumers;
+	std::vector<std::unique_ptr<Producer<Q>>> producers;
+	for (int i = 0; i < threads; ++i)
+	{
+		consumers.emplace_back(new Consumer<Q>(queue));
+		producers.emplace_back(new Producer<Q>(queue, count/threads));
+		consumerThreads.emplace_back(new Thread);
+		producerThreads.emplace_back(new Thread);
+	}
+
+	Stopwatch sw;
+	sw.start();
+	for (int i = 0; i < threads; ++i)
+	{
+		consumerThreads[i]->start(*consumers[i]);
+		producerThreads[i]->start(*producers[i]);
+	}
+	for (int i = 0; i < threads; ++i)
+	{
+		producerThreads[i]->join();
+	}
+	while (!queue.empty()) Thread::yield();
+	sw.stop();
+
+	for (int i = 0; i < threads; ++i)
+	{
+		do
+		{
+			queue.wakeUpAll();
+		}
+		while (!consumerThreads[i]->tryJoin(10));
+	}
+	return (count/threads)*threads*1000000.0/sw.elapsed();
+}
+
+
+int main(int argc, char** argv)
+{
+	int maxThreads = argc > 1 ? NumberParser::parse(argv[1]) : 16;
+	int count = argc > 2 ? NumberParser::parse(argv[2]) : 1000000;
+
+	std::cout << count << " notifications per run" << std::endl;
+	std::cout << std::setw(20) << "producers/consumers"
+		<< std::setw(20) << "NotificationQueue"
+		<< std::setw(28) << "BoundedNotificationQueue" << std::endl;
+	for (int threads = 1; threads <= maxThreads; threads *= 2)
+	{
+		NotificationQueue queue;
+		BoundedNotificationQueue boundedQueue(1024);
+		double rate = benchmark(queue, threads, count);
+		double boundedRate = benchmark(boundedQueue, threads, count);
+		std::cout << std::setw(20) << threads
+			<< std::fixed << std::setprecision(0)
+			<< std::setw(15) << rate << " nf/s"
+			<< std::setw(23) << boundedRate << " nf/s" << std::endl;
+	}
+	return 0;
+}
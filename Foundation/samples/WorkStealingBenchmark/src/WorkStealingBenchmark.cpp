@@ -0,0 +1,133 @@
+//
+// WorkStealingBenchmark.cpp
+//
+// This sample measures how the throughput of a WorkStealingPool
+// scales with the number of worker threads, from 1 up to 64
+// (or the number given on the command line).
+//
+// Two workloads are run for every thread count:
+//   - fork: a binary tree of tasks, each spawning two child
+//     tasks from within the pool (local deques and stealing).
+//   - inject: many independent tasks submitted from the main
+//     thread (the shared injection queue).
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/WorkStealingPool.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Environment.h"
+#include "Poco/NumberParser.h"
+#include "Poco/Exception.h"
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+
+
+using Poco::WorkStealingPool;
+using Poco::Stopwatch;
+using Poco::Environment;
+using Poco::NumberParser;
+
+
+namespace
+{
+	const int WORK = 2000;
+
+	void work()
+		/// Simulates a small amount of CPU-bound work.
+	{
+		static std::atomic<unsigned> sink(0);
+		unsigned x = 1;
+		for (int i = 0; i < WORK; ++i)
+		{
+			x = x*1664525 + 1013904223;
+		}
+		sink.fetch_add(x & 1, std::memory_order_relaxed);
+	}
+
+	void spawn(WorkStealingPool& pool, int depth)
+	{
+		work();
+		if (depth > 0)
+		{
+			pool.execute([&pool, depth]() { spawn(pool, depth - 1); });
+			pool.execute([&pool, depth]() { spawn(pool, depth - 1); });
+		}
+	}
+
+	double benchmarkFork(int threads, int depth)
+		/// Returns tasks per second for a tree of tasks.
+	{
+		WorkStealingPool pool(threads);
+		Stopwatch sw;
+		sw.start();
+		pool.execute([&pool, depth]() { spawn(pool, depth); });
+		pool.joinAll();
+		sw.stop();
+		return pool.executed()*1000000.0/sw.elapsed();
+	}
+
+	double benchmarkInject(int threads, int tasks)
+		/// Returns tasks per second for tasks submitted from outside the pool.
+	{
+		WorkStealingPool pool(threads, 65536);
+		Stopwatch sw;
+		sw.start();
+		for (int i = 0; i < tasks; ++i)
+		{
+			for (;;)
+			{
+				try
+				{
+					pool.execute(work);
+					break;
+				}
+				catch (Poco::NoThreadAvailableException&)
+				{
+					Poco::Thread::yield();
+				}
+			}
+		}
+		pool.joinAll();
+		sw.stop();
+		return pool.executed()*1000000.0/sw.elapsed();
+	}
+}
+
+
+int main(int argc, char** argv)
+{
+	int maxThreads = argc > 1 ? NumberParser::parse(argv[1]) : 64;
+	int depth = argc > 2 ? NumberParser::parse(argv[2]) : 18;
+	int tasks = (1 << (depth + 1)) - 1;
+
+	std::cout << Environment::processorCount() << " CPU cores, "
+		<< tasks << " tasks per run" << std::endl;
+	std::cout << std::setw(8) << "threads"
+		<< std::setw(16) << "fork tasks/s" << std::setw(9) << "speedup"
+		<< std::setw(16) << "inject tasks/s" << std::setw(9) << "speedup" << std::endl;
+
+	double forkBase = 0;
+	double injectBase = 0;
+	for (int threads = 1; threads <= maxThreads; threads *= 2)
+	{
+		double forkRate = benchmarkFork(threads, depth);
+		double injectRate = benchmarkInject(threads, tasks);
+		if (threads == 1)
+		{
+			forkBase = forkRate;
+			injectBase = injectRate;
+		}
+		std::cout << std::setw(8) << threads
+			<< std::fixed << std::setprecision(0) << std::setw(16) << forkRate
+			<< std::setprecision(2) << std::setw(9) << forkRate/forkBase
+			<< std::setprecision(0) << std::setw(16) << injectRate
+			<< std::setprecision(2) << std::setw(9) << injectRate/injectBase << std::endl;
+	}
+	return 0;
+}
@@ -0,0 +1,182 @@
+//
+// Arena.cpp
+//
+// Library: Foundation
+// Package: Core
+// Module:  Arena
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Arena.h"
+#include "Poco/Bugcheck.h"
+#include <cstdlib>
+
+
+namespace Poco {
+
+
+namespace
+{
+	const std::size_t MAX_CHUNK_FACTOR = 64;
+	const std::size_t CHUNK_HEADER_SIZE = (sizeof(void*) + sizeof(std::size_t) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+}
+
+
+Arena::Arena(std::size_t chunkSize):
+	_pCurrent(0),
+	_pEnd(0),
+	_pChunks(0),
+	_pSpare(0),
+	_pBuffer(0),
+	_bufferSize(0),
+	_chunkSize(chunkSize > 0 ? chunkSize : std::size_t(DEFAULT_CHUNK_SIZE)),
+	_nextChunkSize(_chunkSize),
+	_used(0),
+	_capacity(0),
+	_pCleanups(0)
+{
+}
+
+
+Arena::Arena(void* pBuffer, std::size_t size, std::size_t chunkSize):
+	_pCurrent(static_cast<char*>(pBuffer)),
+	_pEnd(static_cast<char*>(pBuffer) + size),
+	_pChunks(0),
+	_pSpare(0),
+	_pBuffer(static_cast<char*>(pBuffer)),
+	_bufferSize(size),
+	_chunkSize(chunkSize > 0 ? chunkSize : std::size_t(DEFAULT_CHUNK_SIZE)),
+	_nextChunkSize(_chunkSize),
+	_used(0),
+	_capacity(size),
+	_pCleanups(0)
+{
+	poco_check_ptr (pBuffer);
+}
+
+
+Arena::~Arena()
+{
+	try
+	{
+		release();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+}
+
+
+void* Arena::allocateSlow(std::size_t size, std::size_t alignment)
+{
+	poco_assert ((alignment & (alignment - 1)) == 0);
+
+	std::size_t required = size + alignment;
+	if (required < size) throw std::bad_alloc();
+
+	Chunk* pChunk = 0;
+	if (_pSpare && _pSpare->size >= required)
+	{
+		pChunk = _pSpare;
+		_pSpare = 0;
+	}
+	else
+	{
+		std::size_t chunkSize = _nextChunkSize;
+		if (chunkSize < required) chunkSize = required;
+		if (chunkSize > static_cast<std::size_t>(-1) - CHUNK_HEADER_SIZE) throw std::bad_alloc();
+		void* pMem = std::malloc(CHUNK_HEADER_SIZE + chunkSize);
+		if (!pMem) throw std::bad_alloc();
+		pChunk = static_cast<Chunk*>(pMem);
+		pChunk->size = chunkSize;
+		_capacity += chunkSize;
+		if (_nextChunkSize < _chunkSize*MAX_CHUNK_FACTOR) _nextChunkSize *= 2;
+	}
+	pChunk->pNext = _pChunks;
+	_pChunks = pChunk;
+
+	_pCurrent = dataOf(pChunk);
+	_pEnd = _pCurrent + pChunk->size;
+	return allocate(size, alignment);
+}
+
+
+void Arena::reset()
+{
+	runCleanups();
+
+	Chunk* pLargest = _pSpare;
+	Chunk* pChunk = _pChunks;
+	while (pChunk)
+	{
+		Chunk* pNext = pChunk->pNext;
+		if (!pLargest || pChunk->size > pLargest->size)
+		{
+			if (pLargest)
+			{
+				_capacity -= pLargest->size;
+				std::free(pLargest);
+			}
+			pLargest = pChunk;
+		}
+		else
+		{
+			_capacity -= pChunk->size;
+			std::free(pChunk);
+		}
+		pChunk = pNext;
+	}
+	_pChunks = 0;
+	_pSpare = pLargest;
+	_nextChunkSize = _chunkSize;
+	_used = 0;
+
+	if (_pBuffer)
+	{
+		_pCurrent = _pBuffer;
+		_pEnd = _pBuffer + _bufferSize;
+	}
+	else
+	{
+		_pCurrent = 0;
+		_pEnd = 0;
+	}
+}
+
+
+void Arena::release()
+{
+	reset();
+	if (_pSpare)
+	{
+		_capacity -= _pSpare->size;
+		std::free(_pSpare);
+		_pSpare = 0;
+	}
+}
+
+
+void Arena::runCleanups()
+{
+	while (_pCleanups)
+	{
+		Cleanup* pCleanup = _pCleanups;
+		_pCleanups = pCleanup->pNext;
+		pCleanup->destroy(pCleanup->pObj);
+	}
+}
+
+
+char* Arena::dataOf(Chunk* pChunk)
+{
+	return reinterpret_cast<char*>(pChunk) + CHUNK_HEADER_SIZE;
+}
+
+
+} // namespace Poco
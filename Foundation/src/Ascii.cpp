@@ -13,6 +13,20 @@
 
 
 #include "Poco/Ascii.h"
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define POCO_ASCII_SSE2
+	#include <emmintrin.h>
+	#if defined(_MSC_VER)
+		#define POCO_ASCII_AVX2
+		#define POCO_ASCII_AVX2_TARGET
+		#include <intrin.h>
+		#include <immintrin.h>
+	#elif defined(__GNUC__) && (__GNUC__ >= 5 || defined(__clang__))
+		#define POCO_ASCII_AVX2
+		#define POCO_ASCII_AVX2_TARGET __attribute__((target("avx2")))
+		#include <immintrin.h>
+	#endif
+#endif
 
 
 namespace Poco {
@@ -151,4 +165,279 @@ const int Ascii::CHARACTER_PROPERTIES[128] =
 };
 
 
+namespace
+{
+	// The vectorized functions handle buffers of at least 16 characters.
+	// Characters are case-converted by adding or subtracting 0x20
+	// if they are within the range first .. first + 25. The range check
+	// is done with a single signed comparison by moving the range to
+	// the bottom of the signed byte range.
+
+	const std::size_t MIN_SIMD_LENGTH = 16;
+
+	struct SIMD
+	{
+		bool (*isAscii)(const char*, std::size_t);
+		void (*convert)(char*, std::size_t, char, char);
+		std::size_t (*mismatch)(const char*, const char*, std::size_t);
+	};
+
+	bool isAsciiScalar(const char* p, std::size_t n)
+	{
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			if (!Ascii::isAscii(static_cast<unsigned char>(p[i]))) return false;
+		}
+		return true;
+	}
+
+	void convertScalar(char* p, std::size_t n, char first, char delta)
+	{
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			if (static_cast<unsigned char>(p[i] - first) < 26) p[i] = static_cast<char>(p[i] + delta);
+		}
+	}
+
+#if defined(POCO_ASCII_SSE2)
+
+	inline int countTrailingZeros(unsigned mask)
+	{
+	#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward(&index, mask);
+		return static_cast<int>(index);
+	#else
+		return __builtin_ctz(mask);
+	#endif
+	}
+
+	inline __m128i convert16(__m128i v, __m128i offset, __m128i limit, __m128i delta)
+	{
+		__m128i inRange = _mm_cmpgt_epi8(limit, _mm_add_epi8(v, offset));
+		return _mm_add_epi8(v, _mm_and_si128(inRange, delta));
+	}
+
+	bool isAsciiSSE2(const char* p, std::size_t n)
+	{
+		__m128i acc = _mm_setzero_si128();
+		std::size_t i = 0;
+		for (; i + 16 <= n; i += 16)
+		{
+			acc = _mm_or_si128(acc, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)));
+		}
+		if (i < n)
+		{
+			acc = _mm_or_si128(acc, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + n - 16)));
+		}
+		return _mm_movemask_epi8(acc) == 0;
+	}
+
+	void convertSSE2(char* p, std::size_t n, char first, char delta)
+	{
+		const __m128i offset = _mm_set1_epi8(static_cast<char>(0x80 - first));
+		const __m128i limit = _mm_set1_epi8(static_cast<char>(-128 + 26));
+		const __m128i vdelta = _mm_set1_epi8(delta);
+		std::size_t i = 0;
+		for (; i + 16 <= n; i += 16)
+		{
+			__m128i* pv = reinterpret_cast<__m128i*>(p + i);
+			_mm_storeu_si128(pv, convert16(_mm_loadu_si128(pv), offset, limit, vdelta));
+		}
+		if (i < n)
+		{
+			// the last block overlaps with the previous one, which
+			// is fine, as converting a character twice has no effect
+			__m128i* pv = reinterpret_cast<__m128i*>(p + n - 16);
+			_mm_storeu_si128(pv, convert16(_mm_loadu_si128(pv), offset, limit, vdelta));
+		}
+	}
+
+	std::size_t mismatchSSE2(const char* p1, const char* p2, std::size_t n)
+		/// Returns the index of the first character that differs
+		/// in lower case, or the index of the first character
+		/// following the last complete block of 16 characters.
+	{
+		const __m128i offset = _mm_set1_epi8(static_cast<char>(0x80 - 'A'));
+		const __m128i limit = _mm_set1_epi8(static_cast<char>(-128 + 26));
+		const __m128i delta = _mm_set1_epi8(0x20);
+		std::size_t i = 0;
+		for (; i + 16 <= n; i += 16)
+		{
+			__m128i v1 = convert16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p1 + i)), offset, limit, delta);
+			__m128i v2 = convert16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p2 + i)), offset, limit, delta);
+			unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v1, v2))) ^ 0xFFFFu;
+			if (mask) return i + countTrailingZeros(mask);
+		}
+		return i;
+	}
+
+#endif // POCO_ASCII_SSE2
+
+#if defined(POCO_ASCII_AVX2)
+
+	POCO_ASCII_AVX2_TARGET inline __m256i convert32(__m256i v, __m256i offset, __m256i limit, __m256i delta)
+	{
+		__m256i inRange = _mm256_cmpgt_epi8(limit, _mm256_add_epi8(v, offset));
+		return _mm256_add_epi8(v, _mm256_and_si256(inRange, delta));
+	}
+
+	POCO_ASCII_AVX2_TARGET bool isAsciiAVX2(const char* p, std::size_t n)
+	{
+		// Short buffers are passed on before touching the upper halves of the
+		// YMM registers, avoiding the AVX-SSE transition penalty.
+		if (n < 32) return isAsciiSSE2(p, n);
+		__m256i acc = _mm256_setzero_si256();
+		std::size_t i = 0;
+		for (; i + 32 <= n; i += 32)
+		{
+			acc = _mm256_or_si256(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)));
+		}
+		if (i < n)
+		{
+			acc = _mm256_or_si256(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + n - 32)));
+		}
+		return _mm256_movemask_epi8(acc) == 0;
+	}
+
+	POCO_ASCII_AVX2_TARGET void convertAVX2(char* p, std::size_t n, char first, char delta)
+	{
+		if (n < 32) return convertSSE2(p, n, first, delta);
+		const __m256i offset = _mm256_set1_epi8(static_cast<char>(0x80 - first));
+		const __m256i limit = _mm256_set1_epi8(static_cast<char>(-128 + 26));
+		const __m256i vdelta = _mm256_set1_epi8(delta);
+		std::size_t i = 0;
+		for (; i + 32 <= n; i += 32)
+		{
+			__m256i* pv = reinterpret_cast<__m256i*>(p + i);
+			_mm256_storeu_si256(pv, convert32(_mm256_loadu_si256(pv), offset, limit, vdelta));
+		}
+		if (i < n)
+		{
+			__m256i* pv = reinterpret_cast<__m256i*>(p + n - 32);
+			_mm256_storeu_si256(pv, convert32(_mm256_loadu_si256(pv), offset, limit, vdelta));
+		}
+	}
+
+	POCO_ASCII_AVX2_TARGET std::size_t mismatchAVX2(const char* p1, const char* p2, std::size_t n)
+	{
+		if (n < 32) return mismatchSSE2(p1, p2, n);
+		const __m256i offset = _mm256_set1_epi8(static_cast<char>(0x80 - 'A'));
+		const __m256i limit = _mm256_set1_epi8(static_cast<char>(-128 + 26));
+		const __m256i delta = _mm256_set1_epi8(0x20);
+		std::size_t i = 0;
+		for (;;)
+		{
+			__m256i v1 = convert32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p1 + i)), offset, limit, delta);
+			__m256i v2 = convert32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p2 + i)), offset, limit, delta);
+			unsigned mask = ~static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v1, v2)));
+			if (mask) return i + countTrailingZeros(mask);
+			if (i + 32 == n) return n;
+			// the last block overlaps with the previous one
+			i = i + 64 <= n ? i + 32 : n - 32;
+		}
+	}
+
+	bool hasAVX2()
+	{
+	#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7) return false;
+		__cpuid(info, 1);
+		const int OSXSAVE = 1 << 27;
+		const int AVX = 1 << 28;
+		if ((info[2] & (OSXSAVE | AVX)) != (OSXSAVE | AVX)) return false;
+		if ((_xgetbv(0) & 6) != 6) return false;
+		__cpuidex(info, 7, 0);
+		return (info[1] & (1 << 5)) != 0;
+	#else
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2") != 0;
+	#endif
+	}
+
+#endif // POCO_ASCII_AVX2
+
+#if !defined(POCO_ASCII_SSE2)
+
+	std::size_t mismatchScalar(const char*, const char*, std::size_t)
+	{
+		return 0;
+	}
+
+#endif
+
+	SIMD selectSIMD()
+	{
+	#if defined(POCO_ASCII_AVX2)
+		if (hasAVX2())
+		{
+			SIMD simd = { isAsciiAVX2, convertAVX2, mismatchAVX2 };
+			return simd;
+		}
+	#endif
+	#if defined(POCO_ASCII_SSE2)
+		SIMD simd = { isAsciiSSE2, convertSSE2, mismatchSSE2 };
+	#else
+		SIMD simd = { isAsciiScalar, convertScalar, mismatchScalar };
+	#endif
+		return simd;
+	}
+
+	const SIMD& simd()
+	{
+		static const SIMD simd = selectSIMD();
+		return simd;
+	}
+}
+
+
+bool Ascii::isAscii(const char* pChars, std::size_t length)
+{
+	if (length < MIN_SIMD_LENGTH)
+		return isAsciiScalar(pChars, length);
+	else
+		return simd().isAscii(pChars, length);
+}
+
+
+void Ascii::toLowerInPlace(char* pChars, std::size_t length)
+{
+	if (length < MIN_SIMD_LENGTH)
+		convertScalar(pChars, length, 'A', 0x20);
+	else
+		simd().convert(pChars, length, 'A', 0x20);
+}
+
+
+void Ascii::toUpperInPlace(char* pChars, std::size_t length)
+{
+	if (length < MIN_SIMD_LENGTH)
+		convertScalar(pChars, length, 'a', -0x20);
+	else
+		simd().convert(pChars, length, 'a', -0x20);
+}
+
+
+int Ascii::icompare(const char* pChars1, std::size_t length1, const char* pChars2, std::size_t length2)
+{
+	std::size_t n = length1 < length2 ? length1 : length2;
+	std::size_t i = n < MIN_SIMD_LENGTH ? 0 : simd().mismatch(pChars1, pChars2, n);
+	for (; i < n; ++i)
+	{
+		char c1 = static_cast<char>(toLower(pChars1[i]));
+		char c2 = static_cast<char>(toLower(pChars2[i]));
+		if (c1 < c2)
+			return -1;
+		else if (c1 > c2)
+			return 1;
+	}
+	if (length1 == length2)
+		return 0;
+	else
+		return length1 < length2 ? -1 : 1;
+}
+
+
 } // namespace Poco
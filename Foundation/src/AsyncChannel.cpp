@@ -19,6 +19,7 @@
 #include "Poco/AutoPtr.h"
 #include "Poco/LoggingRegistry.h"
 #include "Poco/Exception.h"
+#include "Poco/NumberParser.h"
 
 
 namespace Poco {
@@ -93,11 +94,21 @@ void AsyncChannel::close()
 {
 	if (_thread.isRunning())
 	{
-		while (!_queue.empty()) Thread::sleep(100);
+		if (_pBoundedQueue)
+		{
+			while (!_pBoundedQueue->empty()) Thread::sleep(100);
+		}
+		else
+		{
+			while (!_queue.empty()) Thread::sleep(100);
+		}
 		
 		do
 		{
-			_queue.wakeUpAll();
+			if (_pBoundedQueue)
+				_pBoundedQueue->wakeUpAll();
+			else
+				_queue.wakeUpAll();
 		}
 		while (!_thread.tryJoin(100));
 	}
@@ -108,7 +119,10 @@ void AsyncChannel::log(const Message& msg)
 {
 	open();
 
-	_queue.enqueueNotification(new MessageNotification(msg));
+	if (_pBoundedQueue)
+		_pBoundedQueue->enqueueNotification(new MessageNotification(msg));
+	else
+		_queue.enqueueNotification(new MessageNotification(msg));
 }
 
 
@@ -118,6 +132,8 @@ void AsyncChannel::setProperty(const std::string& name, const std::string& value
 		setChannel(LoggingRegistry::defaultRegistry().channelForName(value));
 	else if (name == "priority")
 		setPriority(value);
+	else if (name == "queueSize")
+		setQueueSize(value);
 	else
 		Channel::setProperty(name, value);
 }
@@ -125,7 +141,7 @@ void AsyncChannel::setProperty(const std::string& name, const std::string& value
 
 void AsyncChannel::run()
 {
-	AutoPtr<Notification> nf = _queue.waitDequeueNotification();
+	AutoPtr<Notification> nf = _pBoundedQueue ? _pBoundedQueue->waitDequeueNotification() : _queue.waitDequeueNotification();
 	while (nf)
 	{
 		MessageNotification* pNf = dynamic_cast<MessageNotification*>(nf.get());
@@ -134,7 +150,7 @@ void AsyncChannel::run()
 
 			if (pNf && _pChannel) _pChannel->log(pNf->message());
 		}
-		nf = _queue.waitDequeueNotification();
+		nf = _pBoundedQueue ? _pBoundedQueue->waitDequeueNotification() : _queue.waitDequeueNotification();
 	}
 }
 		
@@ -160,4 +176,19 @@ void AsyncChannel::setPriority(const std::string& value)
 }
 
 
+void AsyncChannel::setQueueSize(const std::string& value)
+{
+	int size = NumberParser::parse(value);
+	if (size < 0) throw InvalidArgumentException("queue size", value);
+
+	FastMutex::ScopedLock lock(_threadMutex);
+
+	if (_thread.isRunning()) throw IllegalStateException("Cannot change the queue size of an open AsyncChannel");
+	if (size > 0)
+		_pBoundedQueue.reset(new BoundedNotificationQueue(size));
+	else
+		_pBoundedQueue.reset();
+}
+
+
 } // namespace Poco
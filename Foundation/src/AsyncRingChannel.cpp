@@ -0,0 +1,601 @@
+//
+// AsyncRingChannel.cpp
+//
+// Library: Foundation
+// Package: Logging
+// Module:  AsyncRingChannel
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/AsyncRingChannel.h"
+#include "Poco/Message.h"
+#include "Poco/LoggingRegistry.h"
+#include "Poco/ErrorHandler.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/NumberParser.h"
+#include "Poco/Exception.h"
+#include <algorithm>
+
+
+namespace Poco {
+
+
+//
+// AsyncRingChannel::Ring
+//
+
+
+class AsyncRingChannel::Ring
+	/// A single-producer, single-consumer ring buffer
+	/// of Message slots, owned by one logging thread.
+{
+public:
+	explicit Ring(std::size_t capacity):
+		orphaned(false),
+		logged(0),
+		dropped(0),
+		blocked(0),
+		written(0),
+		reported(0),
+		_slots(capacity),
+		_mask(capacity - 1),
+		_head(0),
+		_tail(0)
+	{
+	}
+
+	bool push(const Message& msg)
+		/// Called by the owning thread only.
+	{
+		Poco::UInt64 tail = _tail.load(std::memory_order_relaxed);
+		if (tail - _head.load(std::memory_order_acquire) > _mask) return false;
+		_slots[tail & _mask] = msg;
+		_tail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	std::size_t drain(Channel* pChannel, std::size_t maxCount)
+		/// Called by the background thread only.
+	{
+		Poco::UInt64 head = _head.load(std::memory_order_relaxed);
+		Poco::UInt64 tail = _tail.load(std::memory_order_acquire);
+		std::size_t n = static_cast<std::size_t>(std::min<Poco::UInt64>(tail - head, maxCount));
+		if (pChannel)
+		{
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				try
+				{
+					pChannel->log(_slots[(head + i) & _mask]);
+				}
+				catch (Exception& exc)
+				{
+					ErrorHandler::handle(exc);
+				}
+				catch (std::exception& exc)
+				{
+					ErrorHandler::handle(exc);
+				}
+				catch (...)
+				{
+					ErrorHandler::handle();
+				}
+			}
+		}
+		_head.store(head + n, std::memory_order_release);
+		increment(written, n);
+		return n;
+	}
+
+	bool empty() const
+	{
+		return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire);
+	}
+
+	Poco::UInt64 head() const
+	{
+		return _head.load(std::memory_order_acquire);
+	}
+
+	Poco::UInt64 tail() const
+	{
+		return _tail.load(std::memory_order_acquire);
+	}
+
+	static void increment(std::atomic<Poco::UInt64>& counter, Poco::UInt64 n = 1)
+		/// Increments a counter that has a single writer.
+	{
+		counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+	}
+
+	std::atomic<bool> orphaned;
+	std::atomic<Poco::UInt64> logged;
+	std::atomic<Poco::UInt64> dropped;
+	std::atomic<Poco::UInt64> blocked;
+	std::atomic<Poco::UInt64> written;
+	Poco::UInt64 reported;
+
+private:
+	enum
+	{
+		CACHE_LINE_SIZE = 64
+	};
+
+	std::vector<Message> _slots;
+	std::size_t _mask;
+	std::atomic<Poco::UInt64> _head;
+	char _pad[CACHE_LINE_SIZE];
+	std::atomic<Poco::UInt64> _tail;
+};
+
+
+//
+// AsyncRingChannel::RingCache
+//
+
+
+class AsyncRingChannel::RingCache
+	/// The ring buffers of a thread, one per channel.
+{
+public:
+	~RingCache()
+	{
+		// The thread is going away; let the channels
+		// discard the buffers once they are drained.
+		for (EntryVec::iterator it = _entries.begin(); it != _entries.end(); ++it)
+		{
+			it->second->orphaned = true;
+		}
+	}
+
+	Ring* find(Poco::UInt64 id) const
+	{
+		for (EntryVec::const_iterator it = _entries.begin(); it != _entries.end(); ++it)
+		{
+			if (it->first == id) return it->second.get();
+		}
+		return 0;
+	}
+
+	void add(Poco::UInt64 id, const RingPtr& pRing)
+	{
+		// drop the buffers of channels that have been destroyed
+		EntryVec::iterator it = _entries.begin();
+		while (it != _entries.end())
+		{
+			if (it->second->orphaned)
+				it = _entries.erase(it);
+			else
+				++it;
+		}
+		_entries.push_back(Entry(id, pRing));
+	}
+
+private:
+	typedef std::pair<Poco::UInt64, RingPtr> Entry;
+	typedef std::vector<Entry> EntryVec;
+
+	EntryVec _entries;
+};
+
+
+//
+// AsyncRingChannel
+//
+
+
+namespace
+{
+	std::atomic<Poco::UInt64> nextChannelId(1);
+}
+
+
+AsyncRingChannel::AsyncRingChannel(Channel::Ptr pChannel, std::size_t bufferSize, OverflowPolicy policy):
+	_pChannel(pChannel),
+	_thread("AsyncRingChannel"),
+	_ringsVersion(0),
+	_batches(0),
+	_id(nextChannelId++),
+	_bufferSize(bufferSize),
+	_policy(policy),
+	_running(false),
+	_stop(false),
+	_sleeping(false)
+{
+	poco_assert (bufferSize > 0);
+
+	_retired.logged  = 0;
+	_retired.written = 0;
+	_retired.dropped = 0;
+	_retired.blocked = 0;
+	_retired.batches = 0;
+}
+
+
+AsyncRingChannel::~AsyncRingChannel()
+{
+	try
+	{
+		close();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+
+	FastMutex::ScopedLock lock(_ringsMutex);
+	for (RingVec::iterator it = _rings.begin(); it != _rings.end(); ++it)
+	{
+		(*it)->orphaned = true;
+	}
+}
+
+
+void AsyncRingChannel::setChannel(Channel::Ptr pChannel)
+{
+	FastMutex::ScopedLock lock(_channelMutex);
+
+	_pChannel = pChannel;
+}
+
+
+Channel::Ptr AsyncRingChannel::getChannel() const
+{
+	return _pChannel;
+}
+
+
+void AsyncRingChannel::open()
+{
+	FastMutex::ScopedLock lock(_threadMutex);
+
+	if (!_running)
+	{
+		_stop = false;
+		_thread.start(*this);
+		_running = true;
+	}
+}
+
+
+void AsyncRingChannel::close()
+{
+	FastMutex::ScopedLock lock(_threadMutex);
+
+	if (_running)
+	{
+		_stop = true;
+		_wakeUp.set();
+		_thread.join();
+		_running = false;
+	}
+}
+
+
+void AsyncRingChannel::log(const Message& msg)
+{
+	if (!_running.load(std::memory_order_acquire)) open();
+
+	Ring& r = ring();
+	if (!r.push(msg))
+	{
+		if (_policy.load(std::memory_order_relaxed) != OVERFLOW_BLOCK)
+		{
+			Ring::increment(r.dropped);
+			return;
+		}
+
+		Ring::increment(r.blocked);
+		int spins = 0;
+		bool pushed = false;
+		while (!pushed && _running.load(std::memory_order_acquire))
+		{
+			wakeUp();
+			if (++spins < 16)
+				Thread::yield();
+			else
+				Thread::sleep(1);
+			pushed = r.push(msg);
+		}
+		if (!pushed)
+		{
+			Ring::increment(r.dropped);
+			return;
+		}
+	}
+	Ring::increment(r.logged);
+
+	// A missed wake-up only delays the message until
+	// the background thread wakes up by itself.
+	if (_sleeping.load(std::memory_order_relaxed)) wakeUp();
+}
+
+
+void AsyncRingChannel::flush()
+{
+	std::vector<std::pair<RingPtr, Poco::UInt64>> marks;
+	{
+		FastMutex::ScopedLock lock(_ringsMutex);
+		for (RingVec::const_iterator it = _rings.begin(); it != _rings.end(); ++it)
+		{
+			marks.push_back(std::make_pair(*it, (*it)->tail()));
+		}
+	}
+	for (std::vector<std::pair<RingPtr, Poco::UInt64>>::const_iterator it = marks.begin(); it != marks.end(); ++it)
+	{
+		while (it->first->head() < it->second && _running)
+		{
+			wakeUp();
+			Thread::sleep(1);
+		}
+	}
+}
+
+
+void AsyncRingChannel::setOverflowPolicy(OverflowPolicy policy)
+{
+	_policy = policy;
+}
+
+
+AsyncRingChannel::OverflowPolicy AsyncRingChannel::getOverflowPolicy() const
+{
+	return static_cast<OverflowPolicy>(_policy.load());
+}
+
+
+std::size_t AsyncRingChannel::getBufferSize() const
+{
+	return _bufferSize;
+}
+
+
+AsyncRingChannel::Statistics AsyncRingChannel::statistics() const
+{
+	FastMutex::ScopedLock lock(_ringsMutex);
+
+	Statistics stats = _retired;
+	for (RingVec::const_iterator it = _rings.begin(); it != _rings.end(); ++it)
+	{
+		stats.logged  += (*it)->logged.load(std::memory_order_relaxed);
+		stats.written += (*it)->written.load(std::memory_order_relaxed);
+		stats.dropped += (*it)->dropped.load(std::memory_order_relaxed);
+		stats.blocked += (*it)->blocked.load(std::memory_order_relaxed);
+	}
+	stats.batches = _batches.load(std::memory_order_relaxed);
+	return stats;
+}
+
+
+void AsyncRingChannel::setProperty(const std::string& name, const std::string& value)
+{
+	if (name == "channel")
+	{
+		setChannel(LoggingRegistry::defaultRegistry().channelForName(value));
+	}
+	else if (name == "priority")
+	{
+		setPriority(value);
+	}
+	else if (name == "bufferSize")
+	{
+		int size = NumberParser::parse(value);
+		if (size <= 0) throw InvalidArgumentException("buffer size", value);
+		_bufferSize = size;
+	}
+	else if (name == "overflowPolicy")
+	{
+		if (value == "block")
+			setOverflowPolicy(OVERFLOW_BLOCK);
+		else if (value == "drop")
+			setOverflowPolicy(OVERFLOW_DROP);
+		else if (value == "countAndDrop")
+			setOverflowPolicy(OVERFLOW_COUNT_AND_DROP);
+		else
+			throw InvalidArgumentException("overflow policy", value);
+	}
+	else
+	{
+		Channel::setProperty(name, value);
+	}
+}
+
+
+std::string AsyncRingChannel::getProperty(const std::string& name) const
+{
+	if (name == "bufferSize")
+	{
+		return NumberFormatter::format(getBufferSize());
+	}
+	else if (name == "overflowPolicy")
+	{
+		switch (getOverflowPolicy())
+		{
+		case OVERFLOW_DROP:
+			return "drop";
+		case OVERFLOW_COUNT_AND_DROP:
+			return "countAndDrop";
+		default:
+			return "block";
+		}
+	}
+	else
+	{
+		return Channel::getProperty(name);
+	}
+}
+
+
+void AsyncRingChannel::run()
+{
+	RingVec rings;
+	int version = -1;
+	for (;;)
+	{
+		if (version != _ringsVersion.load())
+		{
+			FastMutex::ScopedLock lock(_ringsMutex);
+			version = _ringsVersion;
+			rings = _rings;
+		}
+
+		if (drain(rings) == 0)
+		{
+			if (_stop && version == _ringsVersion.load()) break;
+
+			retireOrphaned(rings);
+
+			_sleeping = true;
+			bool idle = true;
+			for (RingVec::const_iterator it = rings.begin(); it != rings.end() && idle; ++it)
+			{
+				idle = (*it)->empty();
+			}
+			if (idle && !_stop && version == _ringsVersion.load())
+			{
+				_wakeUp.tryWait(IDLE_WAIT);
+			}
+			_sleeping = false;
+		}
+	}
+}
+
+
+std::size_t AsyncRingChannel::drain(RingVec& rings)
+{
+	FastMutex::ScopedLock lock(_channelMutex);
+
+	std::size_t n = 0;
+	for (RingVec::iterator it = rings.begin(); it != rings.end(); ++it)
+	{
+		n += (*it)->drain(_pChannel, MAX_BATCH_SIZE);
+	}
+	if (n > 0) _batches.store(_batches.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	if (_policy.load(std::memory_order_relaxed) == OVERFLOW_COUNT_AND_DROP)
+	{
+		reportDropped(rings);
+	}
+	return n;
+}
+
+
+void AsyncRingChannel::reportDropped(RingVec& rings)
+{
+	Poco::UInt64 n = 0;
+	for (RingVec::iterator it = rings.begin(); it != rings.end(); ++it)
+	{
+		Poco::UInt64 dropped = (*it)->dropped.load(std::memory_order_relaxed);
+		n += dropped - (*it)->reported;
+		(*it)->reported = dropped;
+	}
+	if (n > 0 && _pChannel)
+	{
+		std::string text;
+		NumberFormatter::append(text, n);
+		text.append(" log messages dropped due to a full buffer");
+		try
+		{
+			_pChannel->log(Message("AsyncRingChannel", text, Message::PRIO_WARNING));
+		}
+		catch (Exception& exc)
+		{
+			ErrorHandler::handle(exc);
+		}
+		catch (std::exception& exc)
+		{
+			ErrorHandler::handle(exc);
+		}
+		catch (...)
+		{
+			ErrorHandler::handle();
+		}
+	}
+}
+
+
+void AsyncRingChannel::retireOrphaned(RingVec& rings)
+{
+	bool found = false;
+	for (RingVec::const_iterator it = rings.begin(); it != rings.end() && !found; ++it)
+	{
+		found = (*it)->orphaned && (*it)->empty();
+	}
+	if (!found) return;
+
+	FastMutex::ScopedLock lock(_ringsMutex);
+	RingVec::iterator it = _rings.begin();
+	while (it != _rings.end())
+	{
+		if ((*it)->orphaned && (*it)->empty())
+		{
+			_retired.logged  += (*it)->logged;
+			_retired.written += (*it)->written;
+			_retired.dropped += (*it)->dropped;
+			_retired.blocked += (*it)->blocked;
+			it = _rings.erase(it);
+		}
+		else ++it;
+	}
+	++_ringsVersion;
+}
+
+
+void AsyncRingChannel::wakeUp()
+{
+	if (_sleeping.exchange(false)) _wakeUp.set();
+}
+
+
+AsyncRingChannel::Ring& AsyncRingChannel::ring()
+{
+	RingCache& cache = ringCache();
+	Ring* pRing = cache.find(_id);
+	if (pRing) return *pRing;
+
+	std::size_t capacity = 2;
+	while (capacity < _bufferSize) capacity *= 2;
+	RingPtr pNewRing(new Ring(capacity));
+	{
+		FastMutex::ScopedLock lock(_ringsMutex);
+		_rings.push_back(pNewRing);
+		++_ringsVersion;
+	}
+	cache.add(_id, pNewRing);
+	return *pNewRing;
+}
+
+
+AsyncRingChannel::RingCache& AsyncRingChannel::ringCache()
+{
+	static thread_local RingCache cache;
+	return cache;
+}
+
+
+void AsyncRingChannel::setPriority(const std::string& value)
+{
+	Thread::Priority prio = Thread::PRIO_NORMAL;
+
+	if (value == "lowest")
+		prio = Thread::PRIO_LOWEST;
+	else if (value == "low")
+		prio = Thread::PRIO_LOW;
+	else if (value == "normal")
+		prio = Thread::PRIO_NORMAL;
+	else if (value == "high")
+		prio = Thread::PRIO_HIGH;
+	else if (value == "highest")
+		prio = Thread::PRIO_HIGHEST;
+	else
+		throw InvalidArgumentException("thread priority", value);
+
+	_thread.setPriority(prio);
+}
+
+
+} // namespace Poco
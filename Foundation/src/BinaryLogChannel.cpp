@@ -0,0 +1,403 @@
+//
+// BinaryLogChannel.cpp
+//
+// Library: Foundation
+// Package: Logging
+// Module:  BinaryLogChannel
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/BinaryLogChannel.h"
+#include "Poco/Message.h"
+#include "Poco/File.h"
+#include "Poco/Exception.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/Ascii.h"
+#include <cstring>
+
+
+namespace Poco {
+
+
+const char BinaryLogChannel::MAGIC[8] = {'P', 'O', 'C', 'O', 'B', 'L', 'O', 'G'};
+const Poco::UInt32 BinaryLogChannel::VERSION = 1;
+const Poco::UInt32 BinaryLogChannel::BYTE_ORDER_MARK = 0x01020304;
+const std::string BinaryLogChannel::PROP_PATH      = "path";
+const std::string BinaryLogChannel::PROP_CHUNKSIZE = "chunkSize";
+
+
+namespace
+{
+	template <typename T>
+	inline void append(std::string& buffer, T value)
+	{
+		buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+	}
+}
+
+
+BinaryLogChannel::BinaryLogChannel():
+	_chunkSize(DEFAULT_CHUNK_SIZE),
+	_mappedSize(0),
+	_size(0),
+	_nextId(1)
+{
+}
+
+
+BinaryLogChannel::BinaryLogChannel(const std::string& path):
+	_path(path),
+	_chunkSize(DEFAULT_CHUNK_SIZE),
+	_mappedSize(0),
+	_size(0),
+	_nextId(1)
+{
+}
+
+
+BinaryLogChannel::~BinaryLogChannel()
+{
+	try
+	{
+		close();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+}
+
+
+void BinaryLogChannel::open()
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	if (_mappedSize == 0) openFile();
+}
+
+
+void BinaryLogChannel::close()
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	if (_mappedSize > 0)
+	{
+		SharedMemory().swap(_memory);
+		File(_openPath).setSize(_size);
+		_mappedSize = 0;
+		_size = 0;
+		_strings.clear();
+		_nextId = 1;
+	}
+}
+
+
+void BinaryLogChannel::log(const Message& msg)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	_args.clear();
+	appendArg(msg.getText());
+	writeMessage(msg, 0, 1);
+}
+
+
+void BinaryLogChannel::setProperty(const std::string& name, const std::string& value)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	if (name == PROP_PATH)
+	{
+		_path = value;
+	}
+	else if (name == PROP_CHUNKSIZE)
+	{
+		std::string::const_iterator it  = value.begin();
+		std::string::const_iterator end = value.end();
+		std::size_t n = 0;
+		while (it != end && Ascii::isSpace(*it)) ++it;
+		while (it != end && Ascii::isDigit(*it)) { n *= 10; n += *it++ - '0'; }
+		while (it != end && Ascii::isSpace(*it)) ++it;
+		std::string unit;
+		while (it != end && Ascii::isAlpha(*it)) unit += *it++;
+
+		if (unit == "K")
+			n *= 1024;
+		else if (unit == "M")
+			n *= 1024*1024;
+		else if (!unit.empty())
+			throw InvalidArgumentException(PROP_CHUNKSIZE, value);
+		if (n < 4096)
+			throw InvalidArgumentException(PROP_CHUNKSIZE, "must be at least 4K");
+
+		_chunkSize = n;
+	}
+	else Channel::setProperty(name, value);
+}
+
+
+std::string BinaryLogChannel::getProperty(const std::string& name) const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	if (name == PROP_PATH)
+		return _path;
+	else if (name == PROP_CHUNKSIZE)
+		return NumberFormatter::format(_chunkSize);
+	else
+		return Channel::getProperty(name);
+}
+
+
+Poco::UInt64 BinaryLogChannel::size() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	return _size;
+}
+
+
+void BinaryLogChannel::openFile()
+{
+	_openPath = _path;
+	File file(_openPath);
+	if (file.exists() && file.getSize() > 0)
+	{
+		map(file.getSize());
+		scan();
+	}
+	else
+	{
+		file.createFile();
+		map(_chunkSize);
+		char* pHeader = _memory.begin();
+		std::memcpy(pHeader, MAGIC, sizeof(MAGIC));
+		std::memcpy(pHeader + 8, &VERSION, sizeof(VERSION));
+		std::memcpy(pHeader + 12, &BYTE_ORDER_MARK, sizeof(BYTE_ORDER_MARK));
+		_size = HEADER_SIZE;
+	}
+}
+
+
+void BinaryLogChannel::scan()
+{
+	// Find the end of the existing data, and collect the
+	// string definitions so that new messages can refer to them.
+	const char* pBase = _memory.begin();
+	Poco::UInt32 version = 0;
+	Poco::UInt32 bom = 0;
+	if (_mappedSize >= HEADER_SIZE)
+	{
+		std::memcpy(&version, pBase + 8, sizeof(version));
+		std::memcpy(&bom, pBase + 12, sizeof(bom));
+	}
+	if (version != VERSION || bom != BYTE_ORDER_MARK || std::memcmp(pBase, MAGIC, sizeof(MAGIC)) != 0)
+	{
+		SharedMemory().swap(_memory);
+		_mappedSize = 0;
+		throw DataFormatException("Not a binary log file with native byte order", _openPath);
+	}
+
+	Poco::UInt64 pos = HEADER_SIZE;
+	while (pos + sizeof(Poco::UInt32) <= _mappedSize)
+	{
+		Poco::UInt32 length;
+		std::memcpy(&length, pBase + pos, sizeof(length));
+		if (length == 0 || pos + sizeof(length) + length > _mappedSize) break;
+
+		const char* pRecord = pBase + pos + sizeof(length);
+		if (pRecord[0] == RECORD_STRING && length >= 1 + sizeof(Poco::UInt32))
+		{
+			Poco::UInt32 id;
+			std::memcpy(&id, pRecord + 1, sizeof(id));
+			_strings[std::string(pRecord + 1 + sizeof(id), length - 1 - sizeof(id))] = id;
+			if (id >= _nextId) _nextId = id + 1;
+		}
+		pos += sizeof(length) + length;
+	}
+	_size = pos;
+}
+
+
+void BinaryLogChannel::map(Poco::UInt64 size)
+{
+	SharedMemory().swap(_memory);
+	_mappedSize = 0;
+	File file(_openPath);
+	if (file.getSize() != size) file.setSize(size);
+	SharedMemory(file, SharedMemory::AM_WRITE).swap(_memory);
+	_mappedSize = size;
+}
+
+
+void BinaryLogChannel::writeMessage(const Message& msg, const std::string* pFormat, int argc)
+{
+	if (_mappedSize == 0) openFile();
+
+	// Define new strings first, since that uses the record buffer.
+	Poco::UInt32 sourceId = stringId(msg.getSource());
+	Poco::UInt32 threadId = stringId(msg.getThread());
+	Poco::UInt32 fileId   = msg.getSourceFile() ? stringId(msg.getSourceFile()) : 0;
+	Poco::UInt32 formatId = pFormat ? stringId(*pFormat) : 0;
+
+	_record.clear();
+	_record += static_cast<char>(RECORD_MESSAGE);
+	append(_record, static_cast<Poco::Int64>(msg.getTime().epochMicroseconds()));
+	append(_record, static_cast<Poco::Int64>(msg.getPid()));
+	append(_record, static_cast<Poco::Int64>(msg.getTid()));
+	append(_record, sourceId);
+	append(_record, threadId);
+	append(_record, fileId);
+	append(_record, static_cast<Poco::Int32>(msg.getSourceLine()));
+	append(_record, static_cast<Poco::UInt8>(msg.getPriority()));
+	append(_record, formatId);
+	append(_record, static_cast<Poco::UInt16>(argc));
+	_record += _args;
+	writeRecord();
+}
+
+
+void BinaryLogChannel::writeRecord()
+{
+	Poco::UInt32 length = static_cast<Poco::UInt32>(_record.size());
+	Poco::UInt64 needed = _size + sizeof(length) + length;
+	if (needed > _mappedSize)
+	{
+		Poco::UInt64 newSize = _mappedSize + _chunkSize;
+		if (newSize < needed) newSize = needed + _chunkSize;
+		map(newSize);
+	}
+
+	// Write the length last; a zero length marks the end of the data.
+	char* pRecord = _memory.begin() + _size;
+	std::memcpy(pRecord + sizeof(length), _record.data(), length);
+	std::memcpy(pRecord, &length, sizeof(length));
+	_size = needed;
+}
+
+
+Poco::UInt32 BinaryLogChannel::stringId(const std::string& str)
+{
+	if (str.empty()) return 0;
+
+	StringMap::const_iterator it = _strings.find(str);
+	if (it != _strings.end()) return it->second;
+
+	Poco::UInt32 id = _nextId++;
+	_strings[str] = id;
+	_record.clear();
+	_record += static_cast<char>(RECORD_STRING);
+	append(_record, id);
+	_record += str;
+	writeRecord();
+	return id;
+}
+
+
+void BinaryLogChannel::appendArg(bool value)
+{
+	appendRaw(ARG_BOOL, &value, sizeof(value));
+}
+
+
+void BinaryLogChannel::appendArg(char value)
+{
+	appendRaw(ARG_CHAR, &value, sizeof(value));
+}
+
+
+void BinaryLogChannel::appendArg(short value)
+{
+	appendRaw(ARG_SHORT, &value, sizeof(value));
+}
+
+
+void BinaryLogChannel::appendArg(unsigned short value)
+{
+	appendRaw(ARG_USHORT, &value, sizeof(value));
+}
+
+
+void BinaryLogChannel::appendArg(int value)
+{
+	appendRaw(ARG_INT, &value, sizeof(value));
+}
+
+
+void BinaryLogChannel::appendArg(unsigned value)
+{
+	appendRaw(ARG_UINT, &value, sizeof(value));
+}
+
+
+void BinaryLogChannel::appendArg(long value)
+{
+	appendRaw(ARG_LONG, &value, sizeof(value));
+}
+
+
+void BinaryLogChannel::appendArg(unsigned long value)
+{
+	appendRaw(ARG_ULONG, &value, sizeof(value));
+}
+
+
+void BinaryLogChannel::appendArg(long long value)
+{
+	appendRaw(ARG_LONGLONG, &value, sizeof(value));
+}
+
+
+void BinaryLogChannel::appendArg(unsigned long long value)
+{
+	appendRaw(ARG_ULONGLONG, &value, sizeof(value));
+}
+
+
+void BinaryLogChannel::appendArg(float value)
+{
+	appendRaw(ARG_FLOAT, &value, sizeof(value));
+}
+
+
+void BinaryLogChannel::appendArg(double value)
+{
+	appendRaw(ARG_DOUBLE, &value, sizeof(value));
+}
+
+
+void BinaryLogChannel::appendArg(long double value)
+{
+	appendRaw(ARG_LONGDOUBLE, &value, sizeof(value));
+}
+
+
+void BinaryLogChannel::appendArg(const char* value)
+{
+	Poco::UInt32 length = static_cast<Poco::UInt32>(std::strlen(value));
+	appendRaw(ARG_STRING, &length, sizeof(length));
+	_args.append(value, length);
+}
+
+
+void BinaryLogChannel::appendArg(const std::string& value)
+{
+	Poco::UInt32 length = static_cast<Poco::UInt32>(value.size());
+	appendRaw(ARG_STRING, &length, sizeof(length));
+	_args.append(value);
+}
+
+
+void BinaryLogChannel::appendRaw(ArgType type, const void* pValue, std::size_t size)
+{
+	_args += static_cast<char>(type);
+	_args.append(static_cast<const char*>(pValue), size);
+}
+
+
+} // namespace Poco
@@ -0,0 +1,174 @@
+//
+// BinaryLogReader.cpp
+//
+// Library: Foundation
+// Package: Logging
+// Module:  BinaryLogChannel
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/BinaryLogReader.h"
+#include "Poco/BinaryLogChannel.h"
+#include "Poco/Format.h"
+#include "Poco/Exception.h"
+#include <cstring>
+
+
+namespace Poco {
+
+
+BinaryLogReader::BinaryLogReader(const std::string& path):
+	_path(path),
+	_istr(path, std::ios::in | std::ios::binary),
+	_pos(0)
+{
+	char header[BinaryLogChannel::HEADER_SIZE];
+	_istr.read(header, sizeof(header));
+	Poco::UInt32 version = 0;
+	Poco::UInt32 bom = 0;
+	if (_istr.gcount() == sizeof(header))
+	{
+		std::memcpy(&version, header + 8, sizeof(version));
+		std::memcpy(&bom, header + 12, sizeof(bom));
+	}
+	if (version != BinaryLogChannel::VERSION || bom != BinaryLogChannel::BYTE_ORDER_MARK || std::memcmp(header, BinaryLogChannel::MAGIC, sizeof(BinaryLogChannel::MAGIC)) != 0)
+		throw DataFormatException("Not a binary log file with native byte order", path);
+}
+
+
+BinaryLogReader::~BinaryLogReader()
+{
+}
+
+
+bool BinaryLogReader::read(Message& msg)
+{
+	while (readRecord())
+	{
+		switch (get<Poco::UInt8>())
+		{
+		case BinaryLogChannel::RECORD_STRING:
+			{
+				Poco::UInt32 id = get<Poco::UInt32>();
+				_strings[id].assign(_record, _pos, std::string::npos);
+			}
+			break;
+		case BinaryLogChannel::RECORD_MESSAGE:
+			readMessage(msg);
+			return true;
+		default: // skip unknown records
+			break;
+		}
+	}
+	return false;
+}
+
+
+bool BinaryLogReader::readRecord()
+{
+	Poco::UInt32 length = 0;
+	_istr.read(reinterpret_cast<char*>(&length), sizeof(length));
+	if (_istr.gcount() != sizeof(length) || length == 0) return false;
+
+	_record.resize(length);
+	_istr.read(&_record[0], length);
+	if (static_cast<Poco::UInt32>(_istr.gcount()) != length) return false; // incomplete last record
+	_pos = 0;
+	return true;
+}
+
+
+void BinaryLogReader::readMessage(Message& msg)
+{
+	msg.setTime(Timestamp(get<Poco::Int64>()));
+	msg.setPid(static_cast<long>(get<Poco::Int64>()));
+	msg.setTid(static_cast<long>(get<Poco::Int64>()));
+	msg.setSource(string(get<Poco::UInt32>()));
+	msg.setThread(string(get<Poco::UInt32>()));
+	Poco::UInt32 fileId = get<Poco::UInt32>();
+	msg.setSourceFile(fileId ? string(fileId).c_str() : 0);
+	msg.setSourceLine(get<Poco::Int32>());
+	msg.setPriority(static_cast<Message::Priority>(get<Poco::UInt8>()));
+	Poco::UInt32 formatId = get<Poco::UInt32>();
+	int argc = get<Poco::UInt16>();
+
+	_args.clear();
+	for (int i = 0; i < argc; ++i)
+	{
+		switch (get<Poco::UInt8>())
+		{
+		case BinaryLogChannel::ARG_BOOL:       getArg<bool>(); break;
+		case BinaryLogChannel::ARG_CHAR:       getArg<char>(); break;
+		case BinaryLogChannel::ARG_SHORT:      getArg<short>(); break;
+		case BinaryLogChannel::ARG_USHORT:     getArg<unsigned short>(); break;
+		case BinaryLogChannel::ARG_INT:        getArg<int>(); break;
+		case BinaryLogChannel::ARG_UINT:       getArg<unsigned>(); break;
+		case BinaryLogChannel::ARG_LONG:       getArg<long>(); break;
+		case BinaryLogChannel::ARG_ULONG:      getArg<unsigned long>(); break;
+		case BinaryLogChannel::ARG_LONGLONG:   getArg<long long>(); break;
+		case BinaryLogChannel::ARG_ULONGLONG:  getArg<unsigned long long>(); break;
+		case BinaryLogChannel::ARG_FLOAT:      getArg<float>(); break;
+		case BinaryLogChannel::ARG_DOUBLE:     getArg<double>(); break;
+		case BinaryLogChannel::ARG_LONGDOUBLE: getArg<long double>(); break;
+		case BinaryLogChannel::ARG_STRING:
+			{
+				Poco::UInt32 length = get<Poco::UInt32>();
+				if (_record.size() - _pos < length) throw DataFormatException("Truncated message record", _path);
+				_args.push_back(std::string(_record, _pos, length));
+				_pos += length;
+			}
+			break;
+		default:
+			throw DataFormatException("Unknown argument type", _path);
+		}
+	}
+
+	if (formatId)
+	{
+		std::string text;
+		format(text, string(formatId), _args);
+		msg.setText(text);
+	}
+	else if (!_args.empty() && _args[0].type() == typeid(std::string))
+	{
+		msg.setText(RefAnyCast<std::string>(_args[0]));
+	}
+	else msg.setText(std::string());
+}
+
+
+const std::string& BinaryLogReader::string(Poco::UInt32 id) const
+{
+	static const std::string EMPTY;
+
+	if (id == 0) return EMPTY;
+	StringMap::const_iterator it = _strings.find(id);
+	if (it == _strings.end()) throw DataFormatException("Undefined string id in message record", _path);
+	return it->second;
+}
+
+
+template <typename T>
+T BinaryLogReader::get()
+{
+	T value;
+	if (_record.size() - _pos < sizeof(value)) throw DataFormatException("Truncated record", _path);
+	std::memcpy(&value, _record.data() + _pos, sizeof(value));
+	_pos += sizeof(value);
+	return value;
+}
+
+
+template <typename T>
+void BinaryLogReader::getArg()
+{
+	_args.push_back(get<T>());
+}
+
+
+} // namespace Poco
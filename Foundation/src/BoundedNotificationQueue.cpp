@@ -0,0 +1,338 @@
+//
+// BoundedNotificationQueue.cpp
+//
+// Library: Foundation
+// Package: Notifications
+// Module:  BoundedNotificationQueue
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/BoundedNotificationQueue.h"
+#include "Poco/NotificationCenter.h"
+#include "Poco/Clock.h"
+#if POCO_OS == POCO_OS_LINUX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <time.h>
+#endif
+#include <climits>
+
+
+namespace Poco {
+
+
+BoundedNotificationQueue::BoundedNotificationQueue(std::size_t capacity):
+	_pCells(0),
+	_mask(0),
+	_enqueuePos(0),
+	_dequeuePos(0),
+	_notEmpty(0),
+	_consumersWaiting(0),
+	_notFull(0),
+	_producersWaiting(0),
+	_wakeUps(0)
+{
+	poco_assert (capacity > 0);
+
+	std::size_t n = 2;
+	while (n < capacity) n *= 2;
+	_mask = n - 1;
+	_pCells = new Cell[n];
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		_pCells[i].sequence.store(i, std::memory_order_relaxed);
+		_pCells[i].pNf = 0;
+	}
+}
+
+
+BoundedNotificationQueue::~BoundedNotificationQueue()
+{
+	try
+	{
+		clear();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+	delete [] _pCells;
+}
+
+
+void BoundedNotificationQueue::enqueueNotification(Notification::Ptr pNotification)
+{
+	poco_check_ptr (pNotification);
+
+	Notification* pNf = pNotification.duplicate();
+	if (!enqueueOne(pNf))
+	{
+		bool enqueued = false;
+		while (!enqueued)
+		{
+			_producersWaiting.fetch_add(1);
+			int value = _notFull.load();
+			enqueued = enqueueOne(pNf);
+			if (!enqueued)
+			{
+				park(_notFull, value, -1);
+				enqueued = enqueueOne(pNf);
+			}
+			_producersWaiting.fetch_sub(1);
+		}
+	}
+	signal(_notEmpty, _consumersWaiting);
+}
+
+
+bool BoundedNotificationQueue::tryEnqueueNotification(Notification::Ptr pNotification)
+{
+	poco_check_ptr (pNotification);
+
+	Notification* pNf = pNotification.duplicate();
+	if (!enqueueOne(pNf))
+	{
+		pNf->release();
+		return false;
+	}
+	signal(_notEmpty, _consumersWaiting);
+	return true;
+}
+
+
+Notification* BoundedNotificationQueue::dequeueNotification()
+{
+	return dequeueOne();
+}
+
+
+Notification* BoundedNotificationQueue::waitDequeueNotification()
+{
+	return waitDequeue(-1);
+}
+
+
+Notification* BoundedNotificationQueue::waitDequeueNotification(long milliseconds)
+{
+	poco_assert (milliseconds >= 0);
+
+	return waitDequeue(milliseconds);
+}
+
+
+void BoundedNotificationQueue::dispatch(NotificationCenter& notificationCenter)
+{
+	Notification::Ptr pNf = dequeueOne();
+	while (pNf)
+	{
+		notificationCenter.postNotification(pNf);
+		pNf = dequeueOne();
+	}
+}
+
+
+void BoundedNotificationQueue::wakeUpAll()
+{
+	_wakeUps.fetch_add(1);
+	_notEmpty.fetch_add(1);
+	unpark(_notEmpty, true);
+}
+
+
+bool BoundedNotificationQueue::empty() const
+{
+	return size() == 0;
+}
+
+
+int BoundedNotificationQueue::size() const
+{
+	// Load the dequeue position first; it never overtakes
+	// the enqueue position.
+	std::size_t dequeuePos = _dequeuePos.load(std::memory_order_acquire);
+	std::size_t enqueuePos = _enqueuePos.load(std::memory_order_acquire);
+	std::size_t n = enqueuePos - dequeuePos;
+	if (n > _mask + 1) n = _mask + 1;
+	return static_cast<int>(n);
+}
+
+
+void BoundedNotificationQueue::clear()
+{
+	Notification::Ptr pNf = dequeueOne();
+	while (pNf)
+	{
+		pNf = dequeueOne();
+	}
+}
+
+
+bool BoundedNotificationQueue::enqueueOne(Notification* pNf)
+{
+	Cell* pCell;
+	std::size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+	for (;;)
+	{
+		pCell = &_pCells[pos & _mask];
+		std::size_t seq = pCell->sequence.load(std::memory_order_acquire);
+		std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+		if (diff == 0)
+		{
+			if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				break;
+		}
+		else if (diff < 0)
+		{
+			return false; // full
+		}
+		else
+		{
+			pos = _enqueuePos.load(std::memory_order_relaxed);
+		}
+	}
+	pCell->pNf = pNf;
+	pCell->sequence.store(pos + 1, std::memory_order_release);
+	return true;
+}
+
+
+Notification* BoundedNotificationQueue::dequeueOne()
+{
+	Cell* pCell;
+	std::size_t pos = _dequeuePos.load(std::memory_order_relaxed);
+	for (;;)
+	{
+		pCell = &_pCells[pos & _mask];
+		std::size_t seq = pCell->sequence.load(std::memory_order_acquire);
+		std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+		if (diff == 0)
+		{
+			if (_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				break;
+		}
+		else if (diff < 0)
+		{
+			return 0; // empty
+		}
+		else
+		{
+			pos = _dequeuePos.load(std::memory_order_relaxed);
+		}
+	}
+	Notification* pNf = pCell->pNf;
+	pCell->pNf = 0;
+	pCell->sequence.store(pos + _mask + 1, std::memory_order_release);
+
+	signal(_notFull, _producersWaiting);
+	return pNf;
+}
+
+
+Notification* BoundedNotificationQueue::waitDequeue(long milliseconds)
+{
+	Notification* pNf = dequeueOne();
+	if (pNf) return pNf;
+
+	Clock start;
+	int wakeUps = _wakeUps.load();
+	for (;;)
+	{
+		long remaining = -1;
+		if (milliseconds >= 0)
+		{
+			remaining = milliseconds - static_cast<long>(start.elapsed()/1000);
+			if (remaining <= 0) return 0;
+		}
+
+		// Register as waiting before checking the queue again, so that
+		// a producer either sees us waiting or we see its notification.
+		_consumersWaiting.fetch_add(1);
+		int value = _notEmpty.load();
+		pNf = dequeueOne();
+		if (!pNf && _wakeUps.load() == wakeUps)
+		{
+			park(_notEmpty, value, remaining);
+			pNf = dequeueOne();
+		}
+		_consumersWaiting.fetch_sub(1);
+
+		if (pNf) return pNf;
+		if (_wakeUps.load() != wakeUps) return 0;
+	}
+}
+
+
+void BoundedNotificationQueue::signal(std::atomic<int>& word, std::atomic<int>& waiting)
+{
+	// Pairs with the increment of the waiting counter: either the
+	// waiting thread sees the change to the queue, or we see it waiting.
+	// Every change wakes one waiting thread. Changing the futex word
+	// makes a thread that is just about to park return immediately.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (waiting.load(std::memory_order_relaxed) > 0)
+	{
+		word.fetch_add(1);
+		unpark(word, false);
+	}
+}
+
+
+#if POCO_OS == POCO_OS_LINUX
+
+
+void BoundedNotificationQueue::park(std::atomic<int>& word, int value, long milliseconds)
+{
+	struct timespec ts;
+	struct timespec* pTimeout = 0;
+	if (milliseconds >= 0)
+	{
+		ts.tv_sec = milliseconds/1000;
+		ts.tv_nsec = (milliseconds % 1000)*1000000;
+		pTimeout = &ts;
+	}
+	// Returns immediately if word no longer holds value.
+	syscall(SYS_futex, reinterpret_cast<int*>(&word), FUTEX_WAIT_PRIVATE, value, pTimeout, 0, 0);
+}
+
+
+void BoundedNotificationQueue::unpark(std::atomic<int>& word, bool all)
+{
+	syscall(SYS_futex, reinterpret_cast<int*>(&word), FUTEX_WAKE_PRIVATE, all ? INT_MAX : 1, 0, 0, 0);
+}
+
+
+#else
+
+
+void BoundedNotificationQueue::park(std::atomic<int>& word, int value, long milliseconds)
+{
+	FastMutex::ScopedLock lock(_parkMutex);
+	if (word.load() == value)
+	{
+		if (milliseconds >= 0)
+			_parkCondition.tryWait(_parkMutex, milliseconds);
+		else
+			_parkCondition.wait(_parkMutex);
+	}
+}
+
+
+void BoundedNotificationQueue::unpark(std::atomic<int>& /*word*/, bool /*all*/)
+{
+	// Producers and consumers share the condition,
+	// so all waiting threads must be woken.
+	FastMutex::ScopedLock lock(_parkMutex);
+	_parkCondition.broadcast();
+}
+
+
+#endif
+
+
+} // namespace Poco
@@ -0,0 +1,367 @@
+//
+// CoarseClock.cpp
+//
+// Library: Foundation
+// Package: DateTime
+// Module:  CoarseClock
+//
+// Copyright (c) 2026, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/CoarseClock.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/Event.h"
+#include "Poco/Mutex.h"
+#if defined(POCO_OS_FAMILY_UNIX)
+#include <time.h>
+#endif
+
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+	#include <x86intrin.h>
+	#include <cpuid.h>
+	#define POCO_COARSE_CLOCK_TSC
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	#include <intrin.h>
+	#define POCO_COARSE_CLOCK_TSC
+#endif
+
+
+namespace Poco {
+
+
+class CoarseClockTicker: public Runnable
+	/// The background thread updating the cached
+	/// values of CoarseClock.
+{
+public:
+	CoarseClockTicker():
+		_count(0),
+		_resolution(1)
+	{
+	}
+
+	~CoarseClockTicker()
+	{
+		try
+		{
+			FastMutex::ScopedLock lock(_mutex);
+			if (_count > 0)
+			{
+				_count = 0;
+				stopThread();
+			}
+		}
+		catch (...)
+		{
+			poco_unexpected();
+		}
+	}
+
+	void start(long resolution)
+	{
+		poco_assert (resolution > 0);
+
+		FastMutex::ScopedLock lock(_mutex);
+		if (_count++ == 0)
+		{
+			_resolution = resolution;
+			CoarseClock::update();
+			CoarseClock::_running.store(true, std::memory_order_release);
+			_stop.reset();
+			_thread.setName("CoarseClock");
+			_thread.start(*this);
+		}
+	}
+
+	void stop()
+	{
+		FastMutex::ScopedLock lock(_mutex);
+		if (_count > 0 && --_count == 0)
+		{
+			stopThread();
+		}
+	}
+
+	void run()
+	{
+		while (!_stop.tryWait(_resolution))
+		{
+			CoarseClock::update();
+		}
+	}
+
+private:
+	void stopThread()
+	{
+		CoarseClock::_running.store(false, std::memory_order_release);
+		_stop.set();
+		_thread.join();
+	}
+
+	int _count;
+	long _resolution;
+	Event _stop;
+	Thread _thread;
+	FastMutex _mutex;
+};
+
+
+namespace
+{
+	CoarseClockTicker& ticker()
+	{
+		static CoarseClockTicker ticker;
+		return ticker;
+	}
+
+	Clock::ClockVal coarseMonotonic()
+	{
+	#if defined(CLOCK_MONOTONIC_COARSE)
+		struct timespec ts;
+		if (clock_gettime(CLOCK_MONOTONIC_COARSE, &ts) == 0)
+			return static_cast<Clock::ClockVal>(ts.tv_sec)*1000000 + ts.tv_nsec/1000;
+	#endif
+		return Clock().raw();
+	}
+
+#if defined(POCO_COARSE_CLOCK_TSC)
+
+	enum TSCState
+	{
+		TSC_UNAVAILABLE = -1,
+		TSC_UNKNOWN     = 0,
+		TSC_CALIBRATING = 1,
+		TSC_READY       = 2
+	};
+
+	const Clock::ClockDiff CALIBRATION_TIME = 100000;
+	const Clock::ClockDiff RECALIBRATION_INTERVAL = 1000000;
+
+	struct TSCParams
+		/// The parameters for converting TSC values into clock values,
+		/// published with a sequence lock, so that readers always see
+		/// a consistent set without taking a lock.
+	{
+		std::atomic<unsigned> seq;
+		std::atomic<UInt64> tscBase;
+		std::atomic<Clock::ClockVal> clockBase;
+		std::atomic<double> microsecondsPerTick;
+		std::atomic<UInt64> nextCalibrationTSC;
+	};
+
+	std::atomic<int> tscState(TSC_UNKNOWN);
+	UInt64 calibrationTSC = 0;
+	Clock::ClockVal calibrationClock = 0;
+	TSCParams tscParams;
+	FastMutex tscMutex;
+
+	inline UInt64 readTSC()
+	{
+		return __rdtsc();
+	}
+
+	Clock::ClockVal convert(UInt64 tsc, UInt64 tscBase, Clock::ClockVal clockBase, double microsecondsPerTick)
+	{
+		// The TSC of another core may be slightly behind the
+		// TSC value the parameters have been computed from.
+		Int64 ticks = static_cast<Int64>(tsc - tscBase);
+		if (ticks < 0) ticks = 0;
+		return clockBase + static_cast<Clock::ClockVal>(static_cast<double>(ticks)*microsecondsPerTick);
+	}
+
+	void publish(UInt64 tscBase, Clock::ClockVal clockBase, double microsecondsPerTick)
+		/// Publishes new conversion parameters.
+		/// Must be called with tscMutex locked.
+	{
+		unsigned seq = tscParams.seq.load(std::memory_order_relaxed);
+		tscParams.seq.store(seq + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		tscParams.tscBase.store(tscBase, std::memory_order_relaxed);
+		tscParams.clockBase.store(clockBase, std::memory_order_relaxed);
+		tscParams.microsecondsPerTick.store(microsecondsPerTick, std::memory_order_relaxed);
+		tscParams.nextCalibrationTSC.store(tscBase + static_cast<UInt64>(RECALIBRATION_INTERVAL/microsecondsPerTick), std::memory_order_relaxed);
+		tscParams.seq.store(seq + 2, std::memory_order_release);
+	}
+
+	void recalibrate()
+		/// Adjusts the conversion factor, so that the TSC based clock
+		/// follows Clock instead of drifting away from it. The long-term
+		/// rate is measured since the initial calibration, and the current
+		/// difference to Clock is slewed out over the next interval.
+		/// The clock stays continuous and never runs backwards.
+	{
+		if (!tscMutex.tryLock()) return; // another thread is doing it
+		try
+		{
+			Clock::ClockVal clock = Clock().raw();
+			UInt64 tsc = readTSC();
+			UInt64 tscBase = tscParams.tscBase.load(std::memory_order_relaxed);
+			if (tsc > calibrationTSC && tsc > tscBase)
+			{
+				Clock::ClockVal value = convert(tsc, tscBase, tscParams.clockBase.load(std::memory_order_relaxed), tscParams.microsecondsPerTick.load(std::memory_order_relaxed));
+				double rate = static_cast<double>(clock - calibrationClock)/static_cast<double>(tsc - calibrationTSC);
+				Clock::ClockDiff error = clock - value;
+				if (error > RECALIBRATION_INTERVAL)
+				{
+					// far behind, e.g. after the system has been suspended
+					publish(tsc, clock, rate);
+				}
+				else
+				{
+					double microsecondsPerTick = rate*(1.0 + static_cast<double>(error)/RECALIBRATION_INTERVAL);
+					if (microsecondsPerTick < rate/2) microsecondsPerTick = rate/2;
+					publish(tsc, value, microsecondsPerTick);
+				}
+			}
+		}
+		catch (...)
+		{
+			tscMutex.unlock();
+			throw;
+		}
+		tscMutex.unlock();
+	}
+
+	Clock::ClockVal tscMonotonic()
+	{
+		for (;;)
+		{
+			unsigned seq = tscParams.seq.load(std::memory_order_acquire);
+			if (seq & 1) continue; // being updated
+			UInt64 tscBase = tscParams.tscBase.load(std::memory_order_relaxed);
+			Clock::ClockVal clockBase = tscParams.clockBase.load(std::memory_order_relaxed);
+			double microsecondsPerTick = tscParams.microsecondsPerTick.load(std::memory_order_relaxed);
+			UInt64 nextCalibrationTSC = tscParams.nextCalibrationTSC.load(std::memory_order_relaxed);
+			// Read the TSC before validating the parameters, so that it is
+			// never newer than parameters published after it has been read.
+			UInt64 tsc = readTSC();
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (tscParams.seq.load(std::memory_order_relaxed) != seq) continue;
+
+			if (static_cast<Int64>(tsc - nextCalibrationTSC) >= 0)
+			{
+				recalibrate();
+				if (tscParams.seq.load(std::memory_order_acquire) != seq) continue;
+			}
+			return convert(tsc, tscBase, clockBase, microsecondsPerTick);
+		}
+	}
+
+	bool hasInvariantTSC()
+		/// Returns true if the processor's TSC runs at a constant
+		/// rate in all power states (CPUID 8000_0007H, EDX bit 8).
+	{
+	#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, static_cast<int>(0x80000000));
+		if (static_cast<unsigned>(info[0]) < 0x80000007u) return false;
+		__cpuid(info, static_cast<int>(0x80000007));
+		return (info[3] & (1 << 8)) != 0;
+	#else
+		unsigned eax, ebx, ecx, edx;
+		if (__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) == 0 || eax < 0x80000007u) return false;
+		__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+		return (edx & (1 << 8)) != 0;
+	#endif
+	}
+
+	Clock::ClockVal calibrate(int state)
+		/// Called until the conversion factor is known. Records the TSC and
+		/// clock values on the first call and computes the factor once
+		/// CALIBRATION_TIME has passed. Returns the current clock value.
+	{
+		Clock::ClockVal clock = Clock().raw();
+		UInt64 tsc = readTSC();
+		if (state == TSC_UNKNOWN)
+		{
+			FastMutex::ScopedLock lock(tscMutex);
+			if (tscState.load(std::memory_order_relaxed) == TSC_UNKNOWN)
+			{
+				if (hasInvariantTSC())
+				{
+					calibrationTSC = tsc;
+					calibrationClock = clock;
+					tscState.store(TSC_CALIBRATING, std::memory_order_release);
+				}
+				else tscState.store(TSC_UNAVAILABLE, std::memory_order_release);
+			}
+			return tscState.load(std::memory_order_relaxed) == TSC_UNAVAILABLE ? coarseMonotonic() : clock;
+		}
+		else if (clock - calibrationClock >= CALIBRATION_TIME)
+		{
+			FastMutex::ScopedLock lock(tscMutex);
+			if (tscState.load(std::memory_order_relaxed) == TSC_CALIBRATING)
+			{
+				if (tsc > calibrationTSC)
+				{
+					publish(tsc, clock, static_cast<double>(clock - calibrationClock)/static_cast<double>(tsc - calibrationTSC));
+					tscState.store(TSC_READY, std::memory_order_release);
+				}
+				else tscState.store(TSC_UNAVAILABLE, std::memory_order_release);
+			}
+		}
+		return clock;
+	}
+
+#endif // POCO_COARSE_CLOCK_TSC
+}
+
+
+std::atomic<bool> CoarseClock::_running(false);
+std::atomic<Timestamp::TimeVal> CoarseClock::_now(0);
+std::atomic<Clock::ClockVal> CoarseClock::_clock(0);
+
+
+Clock::ClockVal CoarseClock::monotonic()
+{
+#if defined(POCO_COARSE_CLOCK_TSC)
+	int state = tscState.load(std::memory_order_acquire);
+	if (state == TSC_READY)
+		return tscMonotonic();
+	else if (state != TSC_UNAVAILABLE)
+		return calibrate(state);
+#endif
+	return coarseMonotonic();
+}
+
+
+void CoarseClock::start(long resolution)
+{
+	ticker().start(resolution);
+}
+
+
+void CoarseClock::stop()
+{
+	ticker().stop();
+}
+
+
+std::string CoarseClock::source()
+{
+#if defined(POCO_COARSE_CLOCK_TSC)
+	monotonic();
+	if (tscState.load(std::memory_order_acquire) != TSC_UNAVAILABLE) return "tsc";
+#endif
+#if defined(CLOCK_MONOTONIC_COARSE)
+	return "monotonic_coarse";
+#else
+	return "clock";
+#endif
+}
+
+
+void CoarseClock::update()
+{
+	_now.store(Timestamp().epochMicroseconds(), std::memory_order_relaxed);
+	_clock.store(Clock().raw(), std::memory_order_relaxed);
+}
+
+
+} // namespace Poco
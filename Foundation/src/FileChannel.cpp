@@ -24,6 +24,10 @@
 #include "Poco/String.h"
 #include "Poco/Exception.h"
 #include "Poco/Ascii.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/Timer.h"
+#include "Poco/LogFile.h"
+#include <algorithm>
 
 
 namespace Poco {
@@ -38,12 +42,19 @@ const std::string FileChannel::PROP_PURGEAGE     = "purgeAge";
 const std::string FileChannel::PROP_PURGECOUNT   = "purgeCount";
 const std::string FileChannel::PROP_FLUSH        = "flush";
 const std::string FileChannel::PROP_ROTATEONOPEN = "rotateOnOpen";
+const std::string FileChannel::PROP_BUFFERSIZE   = "bufferSize";
+const std::string FileChannel::PROP_FLUSHINTERVAL = "flushInterval";
+const std::string FileChannel::PROP_SYNCINTERVAL = "syncInterval";
 
 FileChannel::FileChannel():
 	_times("utc"),
 	_compress(false),
 	_flush(true),
 	_rotateOnOpen(false),
+	_bufferSize(0),
+	_flushInterval(1000),
+	_syncInterval(0),
+	_pTimer(0),
 	_pFile(0),
 	_pRotateStrategy(0),
 	_pArchiveStrategy(new ArchiveByNumberStrategy),
@@ -58,6 +69,10 @@ FileChannel::FileChannel(const std::string& rPath):
 	_compress(false),
 	_flush(true),
 	_rotateOnOpen(false),
+	_bufferSize(0),
+	_flushInterval(1000),
+	_syncInterval(0),
+	_pTimer(0),
 	_pFile(0),
 	_pRotateStrategy(0),
 	_pArchiveStrategy(new ArchiveByNumberStrategy),
@@ -101,14 +116,33 @@ void FileChannel::open()
 				_pFile = new LogFile(_path);
 			}
 		}
+		initFile();
+		if (_bufferSize > 0 && _flushInterval > 0 && !_pTimer)
+		{
+			_pTimer = new Timer(_flushInterval, _flushInterval);
+			_pTimer->start(TimerCallback<FileChannel>(*this, &FileChannel::onFlush));
+		}
 	}
 }
 
 
 void FileChannel::close()
 {
+	Timer* pTimer = 0;
+	{
+		FastMutex::ScopedLock lock(_mutex);
+		std::swap(pTimer, _pTimer);
+	}
+	// the timer callback takes the mutex
+	if (pTimer)
+	{
+		pTimer->stop();
+		delete pTimer;
+	}
+
 	FastMutex::ScopedLock lock(_mutex);
 
+	if (_pFile && _syncInterval > 0) _pFile->sync();
 	delete _pFile;
 	_pFile = 0;
 }
@@ -131,17 +165,35 @@ void FileChannel::log(const Message& msg)
 		{
 			_pFile = new LogFile(_path);
 		}
+		initFile();
 		// we must call mustRotate() again to give the
 		// RotateByIntervalStrategy a chance to write its timestamp
 		// to the new file.
 		_pRotateStrategy->mustRotate(_pFile);
 	}
-	_pFile->write(msg.getText(), _flush);
+	_pFile->write(msg.getText(), _flush && _bufferSize == 0);
+	if (_syncInterval > 0 && _lastSync.isElapsed(_syncInterval*Timestamp::TimeDiff(1000)))
+	{
+		flushFile();
+	}
 }
 
 	
 void FileChannel::setProperty(const std::string& name, const std::string& value)
 {
+	// these take the mutex themselves, as they may have
+	// to stop the flush timer
+	if (name == PROP_BUFFERSIZE)
+	{
+		setBufferSize(value);
+		return;
+	}
+	else if (name == PROP_FLUSHINTERVAL)
+	{
+		setFlushInterval(value);
+		return;
+	}
+
 	FastMutex::ScopedLock lock(_mutex);
 
 	if (name == PROP_TIMES)
@@ -170,6 +222,8 @@ void FileChannel::setProperty(const std::string& name, const std::string& value)
 		setFlush(value);
 	else if (name == PROP_ROTATEONOPEN)
 		setRotateOnOpen(value);
+	else if (name == PROP_SYNCINTERVAL)
+		setSyncInterval(value);
 	else
 		Channel::setProperty(name, value);
 }
@@ -195,6 +249,12 @@ std::string FileChannel::getProperty(const std::string& name) const
 		return std::string(_flush ? "true" : "false");
 	else if (name == PROP_ROTATEONOPEN)
 		return std::string(_rotateOnOpen ? "true" : "false");
+	else if (name == PROP_BUFFERSIZE)
+		return NumberFormatter::format(_bufferSize);
+	else if (name == PROP_FLUSHINTERVAL)
+		return NumberFormatter::format(_flushInterval);
+	else if (name == PROP_SYNCINTERVAL)
+		return NumberFormatter::format(_syncInterval);
 	else
 		return Channel::getProperty(name);
 }
@@ -224,6 +284,14 @@ const std::string& FileChannel::path() const
 }
 
 
+void FileChannel::flush()
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	flushFile();
+}
+
+
 void FileChannel::setRotation(const std::string& rotation)
 {
 	std::string::const_iterator it  = rotation.begin();
@@ -343,6 +411,62 @@ void FileChannel::setRotateOnOpen(const std::string& rotateOnOpen)
 }
 
 
+void FileChannel::setBufferSize(const std::string& size)
+{
+	std::string::const_iterator it  = size.begin();
+	std::string::const_iterator end = size.end();
+	std::size_t n = 0;
+	while (it != end && Ascii::isSpace(*it)) ++it;
+	while (it != end && Ascii::isDigit(*it)) { n *= 10; n += *it++ - '0'; }
+	while (it != end && Ascii::isSpace(*it)) ++it;
+	std::string unit;
+	while (it != end && Ascii::isAlpha(*it)) unit += *it++;
+
+	if (unit == "K")
+		n *= 1024;
+	else if (unit == "M")
+		n *= 1024*1024;
+	else if (!unit.empty())
+		throw InvalidArgumentException("bufferSize", size);
+
+	{
+		// The flush timer accesses the file with the mutex locked.
+		FastMutex::ScopedLock lock(_mutex);
+
+		_bufferSize = n;
+		if (_pFile)
+		{
+			if (_bufferSize > 0)
+				_pFile->setBufferSize(_bufferSize);
+			else
+				_pFile->flush();
+		}
+	}
+	updateTimer();
+}
+
+
+void FileChannel::setFlushInterval(const std::string& interval)
+{
+	int n = NumberParser::parse(interval);
+	if (n < 0) throw InvalidArgumentException("flushInterval", interval);
+	{
+		FastMutex::ScopedLock lock(_mutex);
+
+		_flushInterval = n;
+	}
+	updateTimer();
+}
+
+
+void FileChannel::setSyncInterval(const std::string& interval)
+{
+	int n = NumberParser::parse(interval);
+	if (n < 0) throw InvalidArgumentException("syncInterval", interval);
+	_syncInterval = n;
+}
+
+
 void FileChannel::purge()
 {
 	if (_pPurgeStrategy)
@@ -424,5 +548,61 @@ Timespan::TimeDiff FileChannel::extractFactor(const std::string& value, std::str
 }
 
 
+void FileChannel::initFile()
+{
+	if (_bufferSize > 0) _pFile->setBufferSize(_bufferSize);
+}
+
+
+void FileChannel::onFlush(Timer& /*timer*/)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	flushFile();
+}
+
+
+void FileChannel::updateTimer()
+{
+	// Starts, restarts or stops the flush timer of an open file after
+	// bufferSize or flushInterval has changed. Must be called with the
+	// mutex unlocked, as stopping the timer waits for onFlush().
+	Timer* pOldTimer = 0;
+	{
+		FastMutex::ScopedLock lock(_mutex);
+
+		bool needTimer = _pFile && _bufferSize > 0 && _flushInterval > 0;
+		if (_pTimer && (!needTimer || _pTimer->getPeriodicInterval() != _flushInterval))
+		{
+			std::swap(pOldTimer, _pTimer);
+		}
+		if (needTimer && !_pTimer)
+		{
+			_pTimer = new Timer(_flushInterval, _flushInterval);
+			_pTimer->start(TimerCallback<FileChannel>(*this, &FileChannel::onFlush));
+		}
+	}
+	if (pOldTimer)
+	{
+		pOldTimer->stop();
+		delete pOldTimer;
+	}
+}
+
+
+void FileChannel::flushFile()
+{
+	if (_pFile)
+	{
+		if (_syncInterval > 0 && _lastSync.isElapsed(_syncInterval*Timestamp::TimeDiff(1000)))
+		{
+			_pFile->sync();
+			_lastSync.update();
+		}
+		else _pFile->flush();
+	}
+}
+
+
 
 } // namespace Poco
@@ -15,16 +15,35 @@
 #include "Poco/LogFile_STD.h"
 #include "Poco/File.h"
 #include "Poco/Exception.h"
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
 
 
 namespace Poco {
 
 
+namespace
+{
+	const std::size_t BUFFER_ALIGNMENT = 4096;
+}
+
+
 LogFileImpl::LogFileImpl(const std::string& path):
 	_path(path),
-	_str(_path, std::ios::app),
-	_size((UInt64) _str.tellp())
+	_fd(-1),
+	_pBuffer(0),
+	_capacity(0),
+	_used(0),
+	_size(0)
 {
+	allocateBuffer(DEFAULT_BUFFER_SIZE);
+	openFile();
 	if (_size == 0)
 		_creationDate = File(path).getLastModified();
 	else
@@ -34,24 +53,113 @@ LogFileImpl::LogFileImpl(const std::string& path):
 
 LogFileImpl::~LogFileImpl()
 {
+	try
+	{
+		flushImpl();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+	closeFile();
+	std::free(_pBuffer);
 }
 
 
 void LogFileImpl::writeImpl(const std::string& text, bool flush)
 {
-	if (!_str.good())
+	if (_fd < 0) openFile();
+
+	std::size_t length = text.size() + 1;
+	if (_used + length <= _capacity)
 	{
-		_str.close();
-		_str.open(_path, std::ios::app);
+		text.copy(_pBuffer + _used, text.size());
+		_pBuffer[_used + text.size()] = '\n';
+		_used += length;
+		if (flush || _used == _capacity) flushImpl();
 	}
-	if (!_str.good()) throw WriteFileException(_path);
-	_str << text;
-	if (flush)
-		_str << std::endl;
 	else
-		_str << "\n";
-	if (!_str.good()) throw WriteFileException(_path);
-	_size = (UInt64) _str.tellp();
+	{
+		// Write the buffered text and the new text with
+		// a single system call, without copying the new text.
+		struct iovec vec[3];
+		int count = 0;
+		if (_used > 0)
+		{
+			vec[count].iov_base = _pBuffer;
+			vec[count].iov_len  = _used;
+			++count;
+		}
+		vec[count].iov_base = const_cast<char*>(text.data());
+		vec[count].iov_len  = text.size();
+		++count;
+		vec[count].iov_base = const_cast<char*>("\n");
+		vec[count].iov_len  = 1;
+		++count;
+		std::size_t written = 0;
+		try
+		{
+			writeAll(vec, count, written);
+		}
+		catch (...)
+		{
+			// keep the buffered text that has not been written
+			discardBuffered(written);
+			throw;
+		}
+		_used = 0;
+	}
+	_size += length;
+}
+
+
+void LogFileImpl::flushImpl()
+{
+	if (_used > 0)
+	{
+		struct iovec vec;
+		vec.iov_base = _pBuffer;
+		vec.iov_len  = _used;
+		std::size_t written = 0;
+		try
+		{
+			writeAll(&vec, 1, written);
+		}
+		catch (...)
+		{
+			discardBuffered(written);
+			throw;
+		}
+		_used = 0;
+	}
+}
+
+
+void LogFileImpl::syncImpl()
+{
+	flushImpl();
+	if (_fd >= 0)
+	{
+#if POCO_OS == POCO_OS_LINUX
+		int rc = fdatasync(_fd);
+#else
+		int rc = fsync(_fd);
+#endif
+		if (rc != 0) throw WriteFileException(_path);
+	}
+}
+
+
+void LogFileImpl::setBufferSizeImpl(std::size_t size)
+{
+	flushImpl();
+	allocateBuffer(size);
+}
+
+
+std::size_t LogFileImpl::getBufferSizeImpl() const
+{
+	return _capacity;
 }
 
 
@@ -73,4 +181,85 @@ const std::string& LogFileImpl::pathImpl() const
 }
 
 
+void LogFileImpl::openFile()
+{
+	_fd = ::open(_path.c_str(), O_WRONLY | O_CREAT | O_APPEND, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH);
+	if (_fd < 0) throw OpenFileException(_path);
+	struct stat st;
+	if (fstat(_fd, &st) == 0)
+		_size = static_cast<UInt64>(st.st_size) + _used;
+}
+
+
+void LogFileImpl::closeFile()
+{
+	if (_fd >= 0)
+	{
+		::close(_fd);
+		_fd = -1;
+	}
+}
+
+
+void LogFileImpl::writeAll(::iovec* pVec, int count, std::size_t& written)
+{
+	if (_fd < 0) openFile();
+
+	while (count > 0)
+	{
+		ssize_t n = ::writev(_fd, pVec, count);
+		if (n < 0)
+		{
+			if (errno == EINTR) continue;
+			// reopen the file with the next write
+			closeFile();
+			throw WriteFileException(_path);
+		}
+		written += static_cast<std::size_t>(n);
+		std::size_t remaining = static_cast<std::size_t>(n);
+		while (count > 0 && remaining >= pVec->iov_len)
+		{
+			remaining -= pVec->iov_len;
+			++pVec;
+			--count;
+		}
+		if (count > 0)
+		{
+			pVec->iov_base = static_cast<char*>(pVec->iov_base) + remaining;
+			pVec->iov_len -= remaining;
+		}
+	}
+}
+
+
+void LogFileImpl::discardBuffered(std::size_t length)
+{
+	if (length >= _used)
+	{
+		_used = 0;
+	}
+	else if (length > 0)
+	{
+		std::memmove(_pBuffer, _pBuffer + length, _used - length);
+		_used -= length;
+	}
+}
+
+
+void LogFileImpl::allocateBuffer(std::size_t size)
+{
+	poco_assert (_used == 0);
+
+	std::size_t capacity = (size + BUFFER_ALIGNMENT - 1) & ~(BUFFER_ALIGNMENT - 1);
+	if (capacity == 0) capacity = BUFFER_ALIGNMENT;
+	if (capacity == _capacity) return;
+
+	void* pBuffer = 0;
+	if (posix_memalign(&pBuffer, BUFFER_ALIGNMENT, capacity) != 0) throw OutOfMemoryException("LogFile buffer");
+	std::free(_pBuffer);
+	_pBuffer = static_cast<char*>(pBuffer);
+	_capacity = capacity;
+}
+
+
 } // namespace Poco
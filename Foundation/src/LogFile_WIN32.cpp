@@ -21,7 +21,7 @@
 namespace Poco {
 
 
-LogFileImpl::LogFileImpl(const std::string& path): _path(path), _hFile(INVALID_HANDLE_VALUE)
+LogFileImpl::LogFileImpl(const std::string& path): _path(path), _hFile(INVALID_HANDLE_VALUE), _bufferSize(0)
 {
 	File file(path);
 	if (file.exists())
@@ -57,6 +57,32 @@ void LogFileImpl::writeImpl(const std::string& text, bool flush)
 }
 
 
+void LogFileImpl::flushImpl()
+{
+}
+
+
+void LogFileImpl::syncImpl()
+{
+	if (INVALID_HANDLE_VALUE != _hFile)
+	{
+		if (!FlushFileBuffers(_hFile)) throw WriteFileException(_path);
+	}
+}
+
+
+void LogFileImpl::setBufferSizeImpl(std::size_t size)
+{
+	_bufferSize = size;
+}
+
+
+std::size_t LogFileImpl::getBufferSizeImpl() const
+{
+	return _bufferSize;
+}
+
+
 UInt64 LogFileImpl::sizeImpl() const
 {
 	if (INVALID_HANDLE_VALUE == _hFile)
@@ -19,11 +19,186 @@
 #include "Poco/NumberFormatter.h"
 #include "Poco/NumberParser.h"
 #include "Poco/String.h"
+#include "Poco/Hash.h"
+#include "Poco/AtomicSnapshot.h"
+#include <atomic>
 
 
 namespace Poco {
 
 
+namespace
+{
+	class LoggerIndex
+		/// A hash index of all loggers, for looking up existing
+		/// loggers in get() without taking the registry mutex.
+		///
+		/// The index is only modified while holding Logger::_mapMtx.
+		/// New entries are added to the current table in place. When
+		/// a logger is destroyed, its entry stays in the table with a
+		/// null logger pointer, and is reused if a logger with the same
+		/// name is created again. Once there are more such dead entries
+		/// than live ones, the table is rebuilt with the live entries
+		/// only. A table is also rebuilt with twice the number of
+		/// buckets when it gets full. Each table owns its entries, and
+		/// is published through an AtomicSnapshot, so a replaced table
+		/// is freed as soon as the last reader traversing it is done.
+		/// The index therefore holds at most about twice as many
+		/// entries as there are loggers.
+	{
+	public:
+		LoggerIndex():
+			_pTable(new Table(INITIAL_SIZE)),
+			_count(0),
+			_dead(0)
+		{
+			_snapshot.publish(_pTable);
+		}
+
+		Logger* find(const std::string& name)
+		{
+			AtomicSnapshot<Table>::ReadGuard table(_snapshot);
+			const Entry* pEntry = table->find(name, std::memory_order_acquire);
+			return pEntry ? pEntry->pLogger.load(std::memory_order_acquire) : 0;
+		}
+
+		void set(const std::string& name, Logger* pLogger)
+		{
+			Entry* pEntry = _pTable->find(name, std::memory_order_relaxed);
+			if (pEntry)
+			{
+				Logger* pOld = pEntry->pLogger.exchange(pLogger, std::memory_order_release);
+				if (pOld && !pLogger) ++_dead;
+				else if (!pOld && pLogger) --_dead;
+			}
+			else if (pLogger)
+			{
+				if (_count + 1 > _pTable->buckets.size()) rebuild(2*_pTable->buckets.size());
+				_pTable->insert(new Entry(name, pLogger));
+				++_count;
+			}
+			if (_dead > INITIAL_SIZE && 2*_dead > _count)
+			{
+				std::size_t size = INITIAL_SIZE;
+				while (size < _count - _dead) size *= 2;
+				rebuild(size);
+			}
+		}
+
+		void clear()
+		{
+			_pTable = new Table(INITIAL_SIZE);
+			_count = 0;
+			_dead = 0;
+			_snapshot.publish(_pTable);
+		}
+
+	private:
+		enum
+		{
+			INITIAL_SIZE = 64
+		};
+
+		struct Entry
+		{
+			Entry(const std::string& n, Logger* p): name(n), pLogger(p)
+			{
+			}
+
+			const std::string name;
+			std::atomic<Logger*> pLogger;
+		};
+
+		struct Link
+		{
+			Entry* pEntry;
+			const Link* pNext;
+		};
+
+		struct Table
+		{
+			explicit Table(std::size_t size): buckets(size), mask(size - 1)
+			{
+			}
+
+			~Table()
+			{
+				for (auto& bucket: buckets)
+				{
+					const Link* pLink = bucket.load(std::memory_order_relaxed);
+					while (pLink)
+					{
+						const Link* pNext = pLink->pNext;
+						delete pLink->pEntry;
+						delete pLink;
+						pLink = pNext;
+					}
+				}
+			}
+
+			Entry* find(const std::string& name, std::memory_order order) const
+			{
+				const Link* pLink = buckets[Poco::hash(name) & mask].load(order);
+				while (pLink)
+				{
+					if (pLink->pEntry->name == name) return pLink->pEntry;
+					pLink = pLink->pNext;
+				}
+				return 0;
+			}
+
+			void insert(Entry* pEntry)
+			{
+				std::atomic<const Link*>& bucket = buckets[Poco::hash(pEntry->name) & mask];
+				Link* pLink = new Link;
+				pLink->pEntry = pEntry;
+				pLink->pNext = bucket.load(std::memory_order_relaxed);
+				bucket.store(pLink, std::memory_order_release);
+			}
+
+			std::vector<std::atomic<const Link*>> buckets;
+			std::size_t mask;
+		};
+
+		void rebuild(std::size_t size)
+		{
+			Table* pNew = new Table(size);
+			std::size_t count = 0;
+			for (const auto& bucket: _pTable->buckets)
+			{
+				for (const Link* pLink = bucket.load(std::memory_order_relaxed); pLink; pLink = pLink->pNext)
+				{
+					Logger* pLogger = pLink->pEntry->pLogger.load(std::memory_order_relaxed);
+					if (pLogger)
+					{
+						pNew->insert(new Entry(pLink->pEntry->name, pLogger));
+						++count;
+					}
+				}
+			}
+			_pTable = pNew;
+			_count = count;
+			_dead = 0;
+			_snapshot.publish(pNew);
+		}
+
+		AtomicSnapshot<Table> _snapshot;
+		Table* _pTable;
+		std::size_t _count;
+		std::size_t _dead;
+	};
+
+
+	LoggerIndex& loggerIndex()
+	{
+		// Intentionally never destroyed, as loggers may still be
+		// looked up during static destruction.
+		static LoggerIndex* pIndex = new LoggerIndex;
+		return *pIndex;
+	}
+}
+
+
 Logger::Logger(const std::string& name, Channel::Ptr pChannel, int level): _name(name), _pChannel(pChannel), _level(level)
 {
 }
@@ -273,6 +448,9 @@ void Logger::formatDump(std::string& message, const void* buffer, std::size_t le
 
 Logger& Logger::get(const std::string& name)
 {
+	Logger* pLogger = loggerIndex().find(name);
+	if (pLogger) return *pLogger;
+
 	Mutex::ScopedLock lock(_mapMtx);
 
 	return unsafeGet(name);
@@ -312,6 +490,9 @@ Logger& Logger::create(const std::string& name, Channel::Ptr pChannel, int level
 
 Logger& Logger::root()
 {
+	Logger* pLogger = loggerIndex().find(ROOT);
+	if (pLogger) return *pLogger;
+
 	Mutex::ScopedLock lock(_mapMtx);
 
 	return unsafeGet(ROOT);
@@ -330,6 +511,7 @@ void Logger::shutdown()
 {
 	Mutex::ScopedLock lock(_mapMtx);
 
+	loggerIndex().clear();
 	_pLoggerMap.reset();
 }
 
@@ -352,7 +534,11 @@ void Logger::destroy(const std::string& name)
 	if (_pLoggerMap)
 	{
 		LoggerMap::iterator it = _pLoggerMap->find(name);
-		if (it != _pLoggerMap->end()) _pLoggerMap->erase(it);
+		if (it != _pLoggerMap->end())
+		{
+			loggerIndex().set(name, 0);
+			_pLoggerMap->erase(it);
+		}
 	}
 }
 
@@ -427,7 +613,8 @@ int Logger::parseLevel(const std::string& level)
 void Logger::add(Ptr pLogger)
 {
 	if (!_pLoggerMap) _pLoggerMap.reset(new LoggerMap);
-	_pLoggerMap->insert(LoggerMap::value_type(pLogger->name(), pLogger));
+	std::pair<LoggerMap::iterator, bool> result = _pLoggerMap->insert(LoggerMap::value_type(pLogger->name(), pLogger));
+	if (result.second) loggerIndex().set(pLogger->name(), pLogger);
 }
 
 
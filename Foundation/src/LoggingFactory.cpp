@@ -15,6 +15,8 @@
 #include "Poco/LoggingFactory.h"
 #include "Poco/SingletonHolder.h"
 #include "Poco/AsyncChannel.h"
+#include "Poco/AsyncRingChannel.h"
+#include "Poco/BinaryLogChannel.h"
 #include "Poco/ConsoleChannel.h"
 #include "Poco/FileChannel.h"
 #include "Poco/SimpleFileChannel.h"
@@ -85,6 +87,8 @@ LoggingFactory& LoggingFactory::defaultFactory()
 void LoggingFactory::registerBuiltins()
 {
 	_channelFactory.registerClass("AsyncChannel", new Instantiator<AsyncChannel, Channel>);
+	_channelFactory.registerClass("AsyncRingChannel", new Instantiator<AsyncRingChannel, Channel>);
+	_channelFactory.registerClass("BinaryLogChannel", new Instantiator<BinaryLogChannel, Channel>);
 #if defined(POCO_OS_FAMILY_WINDOWS) && !defined(_WIN32_WCE)
 	_channelFactory.registerClass("ConsoleChannel", new Instantiator<WindowsConsoleChannel, Channel>);
 	_channelFactory.registerClass("ColorConsoleChannel", new Instantiator<WindowsColorConsoleChannel, Channel>);
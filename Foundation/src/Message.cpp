@@ -13,6 +13,7 @@
 
 
 #include "Poco/Message.h"
+#include "Poco/CoarseClock.h"
 #include "Poco/Exception.h"
 #if !defined(POCO_VXWORKS)
 #include "Poco/Process.h"
@@ -26,6 +27,7 @@ namespace Poco {
 
 Message::Message():
 	_prio(PRIO_FATAL),
+	_time(CoarseClock::now()),
 	_tid(0),
 	_ostid(0),
 	_pid(0),
@@ -41,6 +43,7 @@ Message::Message(const std::string& source, const std::string& text, Priority pr
 	_source(source),
 	_text(text),
 	_prio(prio),
+	_time(CoarseClock::now()),
 	_tid(0),
 	_ostid(0),
 	_pid(0),
@@ -56,6 +59,7 @@ Message::Message(const std::string& source, const std::string& text, Priority pr
 	_source(source),
 	_text(text),
 	_prio(prio),
+	_time(CoarseClock::now()),
 	_tid(0),
 	_ostid(0),
 	_pid(0),
@@ -147,8 +151,30 @@ Message& Message::operator = (const Message& msg)
 {
 	if (&msg != this)
 	{
-		Message tmp(msg);
-		swap(tmp);
+		// Assign member-wise, so that the strings can reuse
+		// their buffers when a Message object is recycled.
+		_source = msg._source;
+		_text = msg._text;
+		_prio = msg._prio;
+		_time = msg._time;
+		_tid = msg._tid;
+		_ostid = msg._ostid;
+		_thread = msg._thread;
+		_pid = msg._pid;
+		_file = msg._file;
+		_line = msg._line;
+		if (msg._pMap)
+		{
+			if (_pMap)
+				*_pMap = *msg._pMap;
+			else
+				_pMap = new StringMap(*msg._pMap);
+		}
+		else
+		{
+			delete _pMap;
+			_pMap = 0;
+		}
 	}
 	return *this;
 }
@@ -36,6 +36,7 @@ void NotificationCenter::addObserver(const AbstractObserver& observer)
 {
 	Mutex::ScopedLock lock(_mutex);
 	_observers.push_back(observer.clone());
+	updateSnapshot();
 }
 
 
@@ -48,6 +49,7 @@ void NotificationCenter::removeObserver(const AbstractObserver& observer)
 		{
 			(*it)->disable();
 			_observers.erase(it);
+			updateSnapshot();
 			return;
 		}
 	}
@@ -68,12 +70,13 @@ void NotificationCenter::postNotification(Notification::Ptr pNotification)
 {
 	poco_check_ptr (pNotification);
 
-	ScopedLockWithUnlock<Mutex> lock(_mutex);
-	ObserverList observersToNotify(_observers);
-	lock.unlock();
-	for (ObserverList::iterator it = observersToNotify.begin(); it != observersToNotify.end(); ++it)
+	AtomicSnapshot<ObserverList>::ReadGuard observersToNotify(_snapshot);
+	if (observersToNotify.get())
 	{
-		(*it)->notify(pNotification);
+		for (ObserverList::iterator it = observersToNotify->begin(); it != observersToNotify->end(); ++it)
+		{
+			(*it)->notify(pNotification);
+		}
 	}
 }
 
@@ -94,6 +97,12 @@ std::size_t NotificationCenter::countObservers() const
 }
 
 
+void NotificationCenter::updateSnapshot()
+{
+	_snapshot.publish(_observers.empty() ? 0 : new ObserverList(_observers));
+}
+
+
 namespace
 {
 	static SingletonHolder<NotificationCenter> sh;
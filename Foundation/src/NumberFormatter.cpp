@@ -56,8 +56,10 @@ std::string NumberFormatter::format(const bool value, const BoolFormat format)
 
 void NumberFormatter::append(std::string& str, int value)
 {
-	const std::string result = intToStr(value, 10);
-	str.append(result);
+	char result[NF_MAX_INT_STRING_LEN];
+	std::size_t size = NF_MAX_INT_STRING_LEN;
+	intToStr(value, 10, result, size);
+	str.append(result, size);
 }
 
 
@@ -91,8 +93,10 @@ void NumberFormatter::appendHex(std::string& str, int value, int width)
 
 void NumberFormatter::append(std::string& str, unsigned value)
 {
-	const std::string result = uIntToStr(value, 10);
-	str.append(result);
+	char result[NF_MAX_INT_STRING_LEN];
+	std::size_t size = NF_MAX_INT_STRING_LEN;
+	uIntToStr(value, 10, result, size);
+	str.append(result, size);
 }
 
 
@@ -129,8 +133,10 @@ void NumberFormatter::appendHex(std::string& str, unsigned value, int width)
 
 void NumberFormatter::append(std::string& str, long value)
 {
-	const std::string result = intToStr(value, 10);
-	str.append(result);
+	char result[NF_MAX_INT_STRING_LEN];
+	std::size_t size = NF_MAX_INT_STRING_LEN;
+	intToStr(value, 10, result, size);
+	str.append(result, size);
 }
 
 
@@ -164,8 +170,10 @@ void NumberFormatter::appendHex(std::string& str, long value, int width)
 
 void NumberFormatter::append(std::string& str, unsigned long value)
 {
-	const std::string result = uIntToStr(value, 10);
-	str.append(result);
+	char result[NF_MAX_INT_STRING_LEN];
+	std::size_t size = NF_MAX_INT_STRING_LEN;
+	uIntToStr(value, 10, result, size);
+	str.append(result, size);
 }
 
 
@@ -202,8 +210,10 @@ void NumberFormatter::appendHex(std::string& str, unsigned long value, int width
 
 void NumberFormatter::append(std::string& str, Int64 value)
 {
-	const std::string result = intToStr(value, 10);
-	str.append(result);
+	char result[NF_MAX_INT_STRING_LEN];
+	std::size_t size = NF_MAX_INT_STRING_LEN;
+	intToStr(value, 10, result, size);
+	str.append(result, size);
 }
 
 
@@ -237,8 +247,10 @@ void NumberFormatter::appendHex(std::string& str, Int64 value, int width)
 
 void NumberFormatter::append(std::string& str, UInt64 value)
 {
-	const std::string result = uIntToStr(value, 10);
-	str.append(result);
+	char result[NF_MAX_INT_STRING_LEN];
+	std::size_t size = NF_MAX_INT_STRING_LEN;
+	uIntToStr(value, 10, result, size);
+	str.append(result, size);
 }
 
 
@@ -272,7 +284,8 @@ void NumberFormatter::appendHex(std::string& str, UInt64 value, int width)
 
 void NumberFormatter::append(std::string& str, float value)
 {
-	const std::string result = floatToStr(value);
+	char result[NF_MAX_FLT_STRING_LEN];
+	floatToStr(result, NF_MAX_FLT_STRING_LEN, value);
 	str.append(result);
 }
 
@@ -293,7 +306,8 @@ void NumberFormatter::append(std::string& str, float value, int width, int preci
 
 void NumberFormatter::append(std::string& str, double value)
 {
-	const std::string result = doubleToStr(value);
+	char result[NF_MAX_FLT_STRING_LEN];
+	doubleToStr(result, NF_MAX_FLT_STRING_LEN, value);
 	str.append(result);
 }
 
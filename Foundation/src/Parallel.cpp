@@ -0,0 +1,135 @@
+//
+// Parallel.cpp
+//
+// Library: Foundation
+// Package: Threading
+// Module:  Parallel
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Parallel.h"
+#include "Poco/Event.h"
+#include "Poco/Mutex.h"
+#include "Poco/Exception.h"
+#include <exception>
+#include <memory>
+#include <atomic>
+
+
+namespace Poco {
+namespace Impl {
+
+
+namespace
+{
+	enum
+	{
+		CHUNKS_PER_THREAD = 8
+	};
+
+	class ParallelRun
+		/// The state shared by the calling thread and the
+		/// workers helping with a parallelRun().
+		///
+		/// Workers may start after all chunks have completed
+		/// and the caller has returned. Such workers only see
+		/// that no chunks are left, and never call the function,
+		/// which may no longer exist at that time.
+	{
+	public:
+		ParallelRun(std::size_t chunks, const std::function<void(std::size_t)>& function):
+			_chunks(chunks),
+			_pFunction(&function),
+			_next(0),
+			_completed(0),
+			_failed(false),
+			_done(Event::EVENT_MANUALRESET)
+		{
+		}
+
+		void work()
+		{
+			std::size_t chunk;
+			while ((chunk = _next.fetch_add(1, std::memory_order_relaxed)) < _chunks)
+			{
+				if (!_failed.load(std::memory_order_relaxed))
+				{
+					try
+					{
+						(*_pFunction)(chunk);
+					}
+					catch (...)
+					{
+						FastMutex::ScopedLock lock(_mutex);
+						if (!_pException) _pException = std::current_exception();
+						_failed.store(true, std::memory_order_relaxed);
+					}
+				}
+				if (_completed.fetch_add(1, std::memory_order_acq_rel) + 1 == _chunks)
+				{
+					_done.set();
+				}
+			}
+		}
+
+		void wait()
+		{
+			_done.wait();
+			if (_pException) std::rethrow_exception(_pException);
+		}
+
+	private:
+		const std::size_t _chunks;
+		const std::function<void(std::size_t)>* _pFunction;
+		std::atomic<std::size_t> _next;
+		std::atomic<std::size_t> _completed;
+		std::atomic<bool> _failed;
+		std::exception_ptr _pException;
+		FastMutex _mutex;
+		Event _done;
+	};
+}
+
+
+std::size_t parallelGrainSize(WorkStealingPool& pool, std::size_t size, std::size_t grainSize)
+{
+	if (grainSize > 0) return grainSize;
+	std::size_t chunks = static_cast<std::size_t>(pool.threads())*CHUNKS_PER_THREAD;
+	std::size_t grain = chunks > 0 ? size/chunks : size;
+	return grain > 0 ? grain : 1;
+}
+
+
+void parallelRun(WorkStealingPool& pool, std::size_t chunks, const std::function<void(std::size_t)>& chunkFunction)
+{
+	if (chunks == 0) return;
+
+	std::shared_ptr<ParallelRun> pRun = std::make_shared<ParallelRun>(chunks, chunkFunction);
+	std::size_t helpers = std::min(chunks - 1, static_cast<std::size_t>(pool.threads()));
+	for (std::size_t i = 0; i < helpers; ++i)
+	{
+		try
+		{
+			pool.execute([pRun]()
+			{
+				pRun->work();
+			});
+		}
+		catch (Exception&)
+		{
+			// The pool is stopped or its queue is full;
+			// the calling thread does the remaining work.
+			break;
+		}
+	}
+	pRun->work();
+	pRun->wait();
+}
+
+
+} } // namespace Poco::Impl
@@ -23,6 +23,7 @@
 #include "Poco/Environment.h"
 #include "Poco/NumberParser.h"
 #include "Poco/StringTokenizer.h"
+#include <atomic>
 
 
 namespace Poco {
@@ -33,7 +34,39 @@ const std::string PatternFormatter::PROP_TIMES   = "times";
 const std::string PatternFormatter::PROP_PRIORITY_NAMES = "priorityNames";
 
 
+namespace
+{
+	std::atomic<Poco::UInt64> nextFormatterId(1);
+}
+
+
+struct PatternFormatter::TimeCache
+	/// The most recently formatted date/time blocks of a thread,
+	/// indexed by formatter and block.
+{
+	enum
+	{
+		SIZE = 16
+	};
+
+	struct Entry
+	{
+		Entry(): id(0), block(0), seconds(0)
+		{
+		}
+
+		Poco::UInt64 id;
+		int block;
+		Timestamp::TimeVal seconds;
+		std::string text;
+	};
+
+	Entry entries[SIZE];
+};
+
+
 PatternFormatter::PatternFormatter():
+	_id(nextFormatterId++),
 	_localTime(false)
 {
 	parsePriorityNames();
@@ -41,6 +74,7 @@ PatternFormatter::PatternFormatter():
 
 
 PatternFormatter::PatternFormatter(const std::string& rFormat):
+	_id(nextFormatterId++),
 	_localTime(false),
 	_pattern(rFormat)
 {
@@ -56,17 +90,14 @@ PatternFormatter::~PatternFormatter()
 
 void PatternFormatter::format(const Message& msg, std::string& text)
 {
-	Timestamp timestamp = msg.getTime();
-	bool localTime = _localTime;
-	if (localTime)
-	{
-		timestamp += Timezone::utcOffset()*Timestamp::resolution();
-		timestamp += Timezone::dst()*Timestamp::resolution();
-	}
-	DateTime dateTime = timestamp;
-	for (std::vector<PatternAction>::iterator ip = _patternActions.begin(); ip != _patternActions.end(); ++ip)
+	for (std::vector<PatternAction>::const_iterator ip = _patternActions.begin(); ip != _patternActions.end(); ++ip)
 	{
 		text.append(ip->prepend);
+		if (ip->block >= 0)
+		{
+			appendTime(msg, ip->block, text);
+			continue;
+		}
 		switch (ip->key)
 		{
 		case 's': text.append(msg.getSource()); break;
@@ -81,6 +112,62 @@ void PatternFormatter::format(const Message& msg, std::string& text)
 		case 'N': text.append(Environment::nodeName()); break;
 		case 'U': text.append(msg.getSourceFile() ? msg.getSourceFile() : ""); break;
 		case 'u': NumberFormatter::append(text, msg.getSourceLine()); break;
+		case 'i': NumberFormatter::append0(text, fraction(msg.getTime())/1000, 3); break;
+		case 'c': NumberFormatter::append(text, fraction(msg.getTime())/100000); break;
+		case 'F': NumberFormatter::append0(text, fraction(msg.getTime()), 6); break;
+		case 'v':
+			if (ip->length > msg.getSource().length())	//append spaces
+				text.append(msg.getSource()).append(ip->length - msg.getSource().length(), ' ');
+			else if (ip->length && ip->length < msg.getSource().length()) // crop
+				text.append(msg.getSource(), msg.getSource().length()-ip->length, ip->length);
+			else
+				text.append(msg.getSource());
+			break;
+		case 'x':
+			try
+			{
+				text.append(msg[ip->property]);
+			}
+			catch (...)
+			{
+			}
+			break;
+		}
+	}
+}
+
+
+void PatternFormatter::appendTime(const Message& msg, int block, std::string& text)
+{
+	Timestamp::TimeVal seconds = epochSeconds(msg.getTime());
+	TimeCache::Entry& entry = timeCache().entries[(_id*7 + block) % TimeCache::SIZE];
+	if (entry.id != _id || entry.block != block || entry.seconds != seconds)
+	{
+		entry.text.clear();
+		formatTime(msg, _timeBlocks[block], entry.text);
+		entry.id = _id;
+		entry.block = block;
+		entry.seconds = seconds;
+	}
+	text.append(entry.text);
+}
+
+
+void PatternFormatter::formatTime(const Message& msg, const TimeBlock& block, std::string& text)
+{
+	Timestamp timestamp = msg.getTime();
+	bool localTime = _localTime || block.localTime;
+	if (localTime)
+	{
+		timestamp += Timezone::utcOffset()*Timestamp::resolution();
+		timestamp += Timezone::dst()*Timestamp::resolution();
+	}
+	DateTime dateTime = timestamp;
+	for (std::vector<PatternAction>::const_iterator ip = block.actions.begin(); ip != block.actions.end(); ++ip)
+	{
+		text.append(ip->prepend);
+		switch (ip->key)
+		{
 		case 'w': text.append(DateTimeFormat::WEEKDAY_NAMES[dateTime.dayOfWeek()], 0, 3); break;
 		case 'W': text.append(DateTimeFormat::WEEKDAY_NAMES[dateTime.dayOfWeek()]); break;
 		case 'b': text.append(DateTimeFormat::MONTH_NAMES[dateTime.month() - 1], 0, 3); break;
@@ -99,38 +186,9 @@ void PatternFormatter::format(const Message& msg, std::string& text)
 		case 'A': text.append(dateTime.isAM() ? "AM" : "PM"); break;
 		case 'M': NumberFormatter::append0(text, dateTime.minute(), 2); break;
 		case 'S': NumberFormatter::append0(text, dateTime.second(), 2); break;
-		case 'i': NumberFormatter::append0(text, dateTime.millisecond(), 3); break;
-		case 'c': NumberFormatter::append(text, dateTime.millisecond()/100); break;
-		case 'F': NumberFormatter::append0(text, dateTime.millisecond()*1000 + dateTime.microsecond(), 6); break;
 		case 'z': text.append(DateTimeFormatter::tzdISO(localTime ? Timezone::tzd() : DateTimeFormatter::UTC)); break;
 		case 'Z': text.append(DateTimeFormatter::tzdRFC(localTime ? Timezone::tzd() : DateTimeFormatter::UTC)); break;
 		case 'E': NumberFormatter::append(text, static_cast<Poco::Int64>(msg.getTime().epochTime())); break;
-		case 'v':
-			if (ip->length > msg.getSource().length())	//append spaces
-				text.append(msg.getSource()).append(ip->length - msg.getSource().length(), ' ');
-			else if (ip->length && ip->length < msg.getSource().length()) // crop
-				text.append(msg.getSource(), msg.getSource().length()-ip->length, ip->length);
-			else
-				text.append(msg.getSource());
-			break;
-		case 'x':
-			try
-			{
-				text.append(msg[ip->property]);
-			}
-			catch (...)
-			{
-			}
-			break;
-		case 'L':
-			if (!localTime)
-			{
-				localTime = true;
-				timestamp += Timezone::utcOffset()*Timestamp::resolution();
-				timestamp += Timezone::dst()*Timestamp::resolution();
-				dateTime = timestamp;
-			}
-			break;
 		}
 	}
 }
@@ -192,6 +250,83 @@ void PatternFormatter::parsePattern()
 	{
 		_patternActions.push_back(endAct);
 	}
+	compilePattern();
+}
+
+
+void PatternFormatter::compilePattern()
+{
+	_timeBlocks.clear();
+	_id = nextFormatterId++;
+
+	std::vector<PatternAction> actions;
+	bool localTime = false;
+	for (std::vector<PatternAction>::iterator ip = _patternActions.begin(); ip != _patternActions.end(); ++ip)
+	{
+		if (ip->key == 'L')
+		{
+			localTime = true;
+		}
+		if (!isTimeKey(ip->key))
+		{
+			actions.push_back(*ip);
+			continue;
+		}
+
+		// start a new block, or extend the block of the preceding action
+		if (actions.empty() || actions.back().block < 0)
+		{
+			PatternAction act;
+			act.prepend.swap(ip->prepend);
+			act.block = static_cast<int>(_timeBlocks.size());
+			actions.push_back(act);
+			_timeBlocks.push_back(TimeBlock());
+			_timeBlocks.back().localTime = localTime;
+		}
+		_timeBlocks.back().actions.push_back(*ip);
+	}
+	_patternActions.swap(actions);
+}
+
+
+bool PatternFormatter::isTimeKey(char key)
+{
+	switch (key)
+	{
+	case 'w': case 'W': case 'b': case 'B':
+	case 'd': case 'e': case 'f':
+	case 'm': case 'n': case 'o':
+	case 'y': case 'Y':
+	case 'H': case 'h': case 'a': case 'A':
+	case 'M': case 'S':
+	case 'z': case 'Z': case 'E':
+		return true;
+	default:
+		return false;
+	}
+}
+
+
+Timestamp::TimeVal PatternFormatter::epochSeconds(const Timestamp& timestamp)
+{
+	Timestamp::TimeVal time = timestamp.epochMicroseconds();
+	if (time >= 0)
+		return time/Timestamp::resolution();
+	else
+		return (time + 1)/Timestamp::resolution() - 1;
+}
+
+
+int PatternFormatter::fraction(const Timestamp& timestamp)
+{
+	return static_cast<int>(timestamp.epochMicroseconds() - epochSeconds(timestamp)*Timestamp::resolution());
+}
+
+
+PatternFormatter::TimeCache& PatternFormatter::timeCache()
+{
+	static thread_local TimeCache cache;
+	return cache;
 }
 
 	
@@ -205,6 +340,7 @@ void PatternFormatter::setProperty(const std::string& name, const std::string& v
 	else if (name == PROP_TIMES)
 	{
 		_localTime = (value == "local");
+		_id = nextFormatterId++;
 	}
 	else if (name == PROP_PRIORITY_NAMES)
 	{
@@ -23,13 +23,22 @@ const int TaskManager::MIN_PROGRESS_NOTIFICATION_INTERVAL = 100000; // 100 milli
 
 
 TaskManager::TaskManager(ThreadPool::ThreadAffinityPolicy affinityPolicy):
-	_threadPool(ThreadPool::defaultPool(affinityPolicy))
+	_pThreadPool(&ThreadPool::defaultPool(affinityPolicy)),
+	_pWorkStealingPool(0)
 {
 }
 
 
 TaskManager::TaskManager(ThreadPool& pool):
-	_threadPool(pool)
+	_pThreadPool(&pool),
+	_pWorkStealingPool(0)
+{
+}
+
+
+TaskManager::TaskManager(WorkStealingPool& pool):
+	_pThreadPool(0),
+	_pWorkStealingPool(&pool)
 {
 }
 
@@ -49,7 +58,10 @@ void TaskManager::start(Task* pTask, int cpu)
 	_taskList.push_back(pAutoTask);
 	try
 	{
-		_threadPool.start(*pAutoTask, pAutoTask->name(), cpu);
+		if (_pWorkStealingPool)
+			_pWorkStealingPool->start(*pAutoTask);
+		else
+			_pThreadPool->start(*pAutoTask, pAutoTask->name(), cpu);
 	}
 	catch (...)
 	{
@@ -101,7 +113,10 @@ void TaskManager::cancelAll()
 
 void TaskManager::joinAll()
 {
-	_threadPool.joinAll();
+	if (_pWorkStealingPool)
+		_pWorkStealingPool->joinAll();
+	else
+		_pThreadPool->joinAll();
 }
 
 
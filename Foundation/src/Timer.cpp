@@ -16,6 +16,7 @@
 #include "Poco/ThreadPool.h"
 #include "Poco/Exception.h"
 #include "Poco/ErrorHandler.h"
+#include "Poco/CoarseClock.h"
 
 
 namespace Poco {
@@ -64,7 +65,7 @@ void Timer::start(const AbstractTimerCallback& method, ThreadPool& threadPool)
 
 void Timer::start(const AbstractTimerCallback& method, Thread::Priority priority, ThreadPool& threadPool)
 {
-	Clock nextInvocation;
+	Clock nextInvocation(CoarseClock::clock());
 	nextInvocation += static_cast<Clock::ClockVal>(_startInterval)*1000;
 	
 	FastMutex::ScopedLock lock(_mutex);	
@@ -160,14 +161,14 @@ void Timer::setPeriodicInterval(long milliseconds)
 
 void Timer::run()
 {
-	Poco::Clock now;
+	Poco::Clock now(CoarseClock::clock());
 	long interval(0);
 	do
 	{
 		long sleep(0);
 		do
 		{
-			now.update();
+			now = CoarseClock::clock();
 			sleep = static_cast<long>((_nextInvocation - now)/1000);
 			if (sleep < 0)
 			{
@@ -185,7 +186,7 @@ void Timer::run()
 		if (_wakeUp.tryWait(sleep))
 		{
 			Poco::FastMutex::ScopedLock lock(_mutex);
-			_nextInvocation.update();
+			_nextInvocation = CoarseClock::clock();
 			interval = _periodicInterval;
 		}
 		else
@@ -0,0 +1,430 @@
+//
+// TimingWheel.cpp
+//
+// Library: Foundation
+// Package: Notifications
+// Module:  TimingWheel
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/TimingWheel.h"
+#include "Poco/Exception.h"
+#include <limits>
+
+
+namespace Poco {
+
+
+namespace
+{
+	inline int lowestBit(Poco::UInt64 bits)
+	{
+	#if defined(__GNUC__) || defined(__clang__)
+		return __builtin_ctzll(bits);
+	#else
+		int n = 0;
+		while ((bits & 1) == 0)
+		{
+			bits >>= 1;
+			++n;
+		}
+		return n;
+	#endif
+	}
+}
+
+
+const Poco::UInt32 TimingWheel::NIL  = 0xFFFFFFFF;
+const Poco::UInt32 TimingWheel::FREE = 0xFFFFFFFF;
+const Poco::UInt64 TimingWheel::NEVER = std::numeric_limits<Poco::UInt64>::max();
+
+
+TimingWheel::TimingWheel(Clock::ClockDiff resolution):
+	_resolution(resolution),
+	_now(0),
+	_free(NIL),
+	_size(0),
+	_waitTick(0),
+	_wakeUp(false)
+{
+	poco_assert (resolution > 0);
+
+	for (int i = 0; i < LISTS; ++i) _heads[i] = NIL;
+	for (int i = 0; i < LEVELS; ++i) _occupied[i] = 0;
+}
+
+
+TimingWheel::~TimingWheel()
+{
+	try
+	{
+		clear();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+}
+
+
+TimingWheel::TimerId TimingWheel::schedule(Notification::Ptr pNotification, Clock clock)
+{
+	poco_check_ptr (pNotification);
+
+	Poco::UInt64 tick = tickOf(clock, true);
+
+	FastMutex::ScopedLock lock(_mutex);
+
+	Poco::UInt32 index;
+	if (_free != NIL)
+	{
+		index = _free;
+		_free = _entries[index].next;
+	}
+	else
+	{
+		if (_entries.size() >= NIL - 1) throw OutOfMemoryException("Too many timers");
+		index = static_cast<Poco::UInt32>(_entries.size());
+		Entry entry;
+		entry.generation = 1;
+		_entries.push_back(entry);
+	}
+	Entry& entry = _entries[index];
+	entry.pNf = pNotification.duplicate();
+	entry.tick = tick;
+	insert(index);
+	++_size;
+
+	// Only wake up the waiting thread if the new timer
+	// expires before the time it is waiting for.
+	if (tick < _waitTick)
+	{
+		_waitTick = tick;
+		_wakeUpEvent.set();
+	}
+	return (static_cast<TimerId>(entry.generation) << 32) | (index + 1);
+}
+
+
+TimingWheel::TimerId TimingWheel::schedule(Notification::Ptr pNotification, Timestamp timestamp)
+{
+	Timestamp tsNow;
+	Clock clock;
+	clock += timestamp - tsNow;
+	return schedule(pNotification, clock);
+}
+
+
+bool TimingWheel::cancel(TimerId id)
+{
+	Notification::Ptr pNf;
+	{
+		FastMutex::ScopedLock lock(_mutex);
+
+		Poco::UInt32 index = static_cast<Poco::UInt32>(id & 0xFFFFFFFF) - 1;
+		Poco::UInt32 generation = static_cast<Poco::UInt32>(id >> 32);
+		if (index >= _entries.size() || _entries[index].generation != generation || _entries[index].list == FREE)
+			return false;
+
+		unlink(index);
+		pNf.assign(release(index), false);
+	}
+	// The notification is released outside the lock, as
+	// its destructor may schedule or cancel timers.
+	return true;
+}
+
+
+std::size_t TimingWheel::expire(NotificationVec& expired)
+{
+	return expire(expired, Clock());
+}
+
+
+std::size_t TimingWheel::expire(NotificationVec& expired, Clock now)
+{
+	Poco::UInt64 tick = tickOf(now, false);
+
+	FastMutex::ScopedLock lock(_mutex);
+
+	return advance(tick, expired);
+}
+
+
+std::size_t TimingWheel::waitExpire(NotificationVec& expired)
+{
+	return waitExpireImpl(expired, -1);
+}
+
+
+std::size_t TimingWheel::waitExpire(NotificationVec& expired, long milliseconds)
+{
+	poco_assert (milliseconds >= 0);
+
+	return waitExpireImpl(expired, milliseconds);
+}
+
+
+void TimingWheel::wakeUp()
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	_wakeUp = true;
+	_wakeUpEvent.set();
+}
+
+
+bool TimingWheel::empty() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	return _size == 0;
+}
+
+
+std::size_t TimingWheel::size() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	return _size;
+}
+
+
+void TimingWheel::clear()
+{
+	EntryVec entries;
+	{
+		FastMutex::ScopedLock lock(_mutex);
+
+		// Keep the generations, so that ids of cancelled
+		// timers are not reused.
+		entries = _entries;
+		_free = NIL;
+		for (Poco::UInt32 i = static_cast<Poco::UInt32>(_entries.size()); i > 0; --i)
+		{
+			Entry& entry = _entries[i - 1];
+			if (entry.list != FREE) ++entry.generation;
+			entry.pNf = 0;
+			entry.list = FREE;
+			entry.next = _free;
+			_free = i - 1;
+		}
+		for (int i = 0; i < LISTS; ++i) _heads[i] = NIL;
+		for (int i = 0; i < LEVELS; ++i) _occupied[i] = 0;
+		_size = 0;
+	}
+	for (EntryVec::iterator it = entries.begin(); it != entries.end(); ++it)
+	{
+		if (it->list != FREE) it->pNf->release();
+	}
+}
+
+
+Poco::UInt64 TimingWheel::tickOf(const Clock& clock, bool roundUp) const
+{
+	Clock::ClockDiff diff = clock - _origin;
+	if (diff <= 0) return 0;
+	if (roundUp) diff += _resolution - 1;
+	return static_cast<Poco::UInt64>(diff/_resolution);
+}
+
+
+Clock TimingWheel::clockOf(Poco::UInt64 tick) const
+{
+	return _origin + static_cast<Clock::ClockDiff>(tick)*_resolution;
+}
+
+
+void TimingWheel::insert(Poco::UInt32 index)
+{
+	// A timer is kept at the lowest level whose current rotation
+	// contains its tick, so its slot always lies ahead of the current
+	// position of the wheel, and the slot's start time is the time
+	// at which the timer must be moved to the next lower level.
+	// Timers that are due are kept in the current slot of level 0.
+	Poco::UInt64 tick = _entries[index].tick;
+	if (tick <= _now)
+	{
+		link(index, static_cast<Poco::UInt32>(_now & (SLOTS - 1)));
+		return;
+	}
+	for (int level = 0; level < LEVELS; ++level)
+	{
+		int shift = SLOT_BITS*(level + 1);
+		if ((tick >> shift) == (_now >> shift))
+		{
+			Poco::UInt32 slot = static_cast<Poco::UInt32>((tick >> (SLOT_BITS*level)) & (SLOTS - 1));
+			link(index, level*SLOTS + slot);
+			return;
+		}
+	}
+	link(index, OVERFLOW_LIST);
+}
+
+
+void TimingWheel::link(Poco::UInt32 index, Poco::UInt32 list)
+{
+	Entry& entry = _entries[index];
+	entry.list = list;
+	entry.prev = NIL;
+	entry.next = _heads[list];
+	if (entry.next != NIL) _entries[entry.next].prev = index;
+	_heads[list] = index;
+	if (list != OVERFLOW_LIST) _occupied[list/SLOTS] |= Poco::UInt64(1) << (list % SLOTS);
+}
+
+
+void TimingWheel::unlink(Poco::UInt32 index)
+{
+	Entry& entry = _entries[index];
+	if (entry.prev != NIL)
+		_entries[entry.prev].next = entry.next;
+	else
+		_heads[entry.list] = entry.next;
+	if (entry.next != NIL) _entries[entry.next].prev = entry.prev;
+	if (_heads[entry.list] == NIL && entry.list != OVERFLOW_LIST)
+		_occupied[entry.list/SLOTS] &= ~(Poco::UInt64(1) << (entry.list % SLOTS));
+}
+
+
+Notification* TimingWheel::release(Poco::UInt32 index)
+{
+	Entry& entry = _entries[index];
+	Notification* pNf = entry.pNf;
+	entry.pNf = 0;
+	entry.list = FREE;
+	++entry.generation;
+	entry.next = _free;
+	_free = index;
+	--_size;
+	return pNf;
+}
+
+
+std::size_t TimingWheel::advance(Poco::UInt64 target, NotificationVec& expired)
+{
+	std::size_t n = 0;
+	for (;;)
+	{
+		Poco::UInt32 slot = static_cast<Poco::UInt32>(_now & (SLOTS - 1));
+		while (_heads[slot] != NIL)
+		{
+			Poco::UInt32 index = _heads[slot];
+			unlink(index);
+			expired.push_back(Notification::Ptr(release(index), false));
+			++n;
+		}
+
+		// Nothing happens between now and the next event,
+		// so the wheel can skip ahead to it.
+		Poco::UInt64 next = nextEvent();
+		if (next > target)
+		{
+			if (target > _now) _now = target;
+			break;
+		}
+		_now = next;
+
+		if ((_now & ((Poco::UInt64(1) << (SLOT_BITS*LEVELS)) - 1)) == 0)
+			cascade(OVERFLOW_LIST);
+		for (int level = LEVELS - 1; level > 0; --level)
+		{
+			if ((_now & ((Poco::UInt64(1) << (SLOT_BITS*level)) - 1)) == 0)
+			{
+				Poco::UInt32 levelSlot = static_cast<Poco::UInt32>((_now >> (SLOT_BITS*level)) & (SLOTS - 1));
+				cascade(level*SLOTS + levelSlot);
+			}
+		}
+	}
+	return n;
+}
+
+
+void TimingWheel::cascade(Poco::UInt32 list)
+{
+	Poco::UInt32 index = _heads[list];
+	if (index == NIL) return;
+
+	_heads[list] = NIL;
+	if (list != OVERFLOW_LIST) _occupied[list/SLOTS] &= ~(Poco::UInt64(1) << (list % SLOTS));
+	while (index != NIL)
+	{
+		Poco::UInt32 next = _entries[index].next;
+		insert(index);
+		index = next;
+	}
+}
+
+
+Poco::UInt64 TimingWheel::nextEvent() const
+{
+	// Levels are searched from the lowest one, since an event on a
+	// lower level always occurs before an event on a higher level.
+	for (int level = 0; level < LEVELS; ++level)
+	{
+		int shift = SLOT_BITS*level;
+		Poco::UInt32 current = static_cast<Poco::UInt32>((_now >> shift) & (SLOTS - 1));
+		Poco::UInt64 ahead = _occupied[level] & (~Poco::UInt64(1) << current);
+		if (ahead)
+		{
+			Poco::UInt64 rotation = (_now >> (shift + SLOT_BITS)) << (shift + SLOT_BITS);
+			return rotation | (static_cast<Poco::UInt64>(lowestBit(ahead)) << shift);
+		}
+	}
+	if (_heads[OVERFLOW_LIST] != NIL)
+	{
+		int shift = SLOT_BITS*LEVELS;
+		return ((_now >> shift) + 1) << shift;
+	}
+	return NEVER;
+}
+
+
+std::size_t TimingWheel::waitExpireImpl(NotificationVec& expired, long milliseconds)
+{
+	const Clock::ClockDiff MAX_SLEEP = 8*60*60*Clock::ClockDiff(1000000); // sleep at most 8 hours at a time
+
+	Clock start;
+	for (;;)
+	{
+		Clock now;
+		Clock::ClockDiff sleep = MAX_SLEEP;
+		{
+			FastMutex::ScopedLock lock(_mutex);
+
+			std::size_t n = advance(tickOf(now, false), expired);
+			if (n > 0 || _wakeUp)
+			{
+				_wakeUp = false;
+				_waitTick = 0;
+				return n;
+			}
+			_waitTick = nextEvent();
+			if (_waitTick != NEVER)
+			{
+				Clock::ClockDiff untilNext = clockOf(_waitTick) - now;
+				if (untilNext < sleep) sleep = untilNext;
+			}
+		}
+		if (milliseconds >= 0)
+		{
+			Clock::ClockDiff remaining = 1000*Clock::ClockDiff(milliseconds) - start.elapsed();
+			if (remaining <= 0)
+			{
+				FastMutex::ScopedLock lock(_mutex);
+				_waitTick = 0;
+				return 0;
+			}
+			if (remaining < sleep) sleep = remaining;
+		}
+		if (sleep > 0) _wakeUpEvent.tryWait(static_cast<long>((sleep + 999)/1000));
+	}
+}
+
+
+} // namespace Poco
@@ -53,8 +53,8 @@ Var::Var(const Var& other)
 }
 #else
 {
-	if ((this != &other) && !other.isEmpty())
-			construct(other);
+	if (!other.isEmpty())
+		construct(other);
 }
 #endif
 
@@ -71,10 +71,8 @@ Var& Var::operator = (const Var& rhs)
 	Var tmp(rhs);
 	swap(tmp);
 #else
-	if ((this != &rhs) && !rhs.isEmpty())
+	if (this != &rhs)
 		construct(rhs);
-	else if ((this != &rhs) && rhs.isEmpty())
-		_placeholder.erase();
 #endif
 	return *this;
 }
@@ -331,8 +329,6 @@ void Var::empty()
 	delete _pHolder;
 	_pHolder = 0;
 #else
-	if (_placeholder.isLocal()) this->~Var();
-	else delete content();
 	_placeholder.erase();
 #endif
 }
@@ -344,8 +340,6 @@ void Var::clear()
 	delete _pHolder;
 	_pHolder = 0;
 #else
-	if (_placeholder.isLocal()) this->~Var();
-	else delete content();
 	_placeholder.erase();
 #endif
 }
@@ -0,0 +1,607 @@
+//
+// WorkStealingPool.cpp
+//
+// Library: Foundation
+// Package: Threading
+// Module:  WorkStealingPool
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/WorkStealingPool.h"
+#include "Poco/Environment.h"
+#include "Poco/ErrorHandler.h"
+#include "Poco/Exception.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/SingletonHolder.h"
+
+
+namespace Poco {
+
+
+//
+// WorkStealingPool::Task
+//
+
+
+WorkStealingPool::Task::~Task()
+{
+}
+
+
+//
+// WorkStealingPool::RunnableTask
+//
+
+
+class WorkStealingPool::RunnableTask: public WorkStealingPool::Task
+{
+public:
+	explicit RunnableTask(Runnable& target):
+		_target(target)
+	{
+	}
+
+	void run()
+	{
+		_target.run();
+	}
+
+private:
+	Runnable& _target;
+};
+
+
+//
+// WorkStealingPool::Deque
+//
+
+
+class WorkStealingPool::Deque
+	/// A Chase-Lev work-stealing deque, as described in
+	/// "Correct and Efficient Work-Stealing for Weak Memory Models"
+	/// by N. M. Le, A. Pop, A. Cohen and F. Zappa Nardelli (PPoPP 2013).
+	///
+	/// Only the owning worker calls push() and pop(), which work on the
+	/// bottom end of the deque; other workers steal() from the top end.
+	/// The circular array grows as needed; replaced arrays are kept until
+	/// the deque is destroyed, since stealers may still be reading them.
+{
+public:
+	Deque():
+		_top(0),
+		_bottom(0),
+		_pArray(new Array(INITIAL_CAPACITY))
+	{
+	}
+
+	~Deque()
+	{
+		delete _pArray.load(std::memory_order_relaxed);
+		for (std::vector<Array*>::iterator it = _garbage.begin(); it != _garbage.end(); ++it)
+		{
+			delete *it;
+		}
+	}
+
+	void push(Task* pTask)
+	{
+		Poco::Int64 b = _bottom.load(std::memory_order_relaxed);
+		Poco::Int64 t = _top.load(std::memory_order_acquire);
+		Array* pArray = _pArray.load(std::memory_order_relaxed);
+		if (b - t > pArray->capacity - 1)
+		{
+			Array* pNew = pArray->grow(t, b);
+			_garbage.push_back(pArray);
+			pArray = pNew;
+			_pArray.store(pArray, std::memory_order_release);
+		}
+		pArray->put(b, pTask);
+		std::atomic_thread_fence(std::memory_order_release);
+		_bottom.store(b + 1, std::memory_order_relaxed);
+	}
+
+	Task* pop()
+	{
+		Poco::Int64 b = _bottom.load(std::memory_order_relaxed) - 1;
+		Array* pArray = _pArray.load(std::memory_order_relaxed);
+		_bottom.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		Poco::Int64 t = _top.load(std::memory_order_relaxed);
+		Task* pTask = 0;
+		if (t <= b)
+		{
+			pTask = pArray->get(b);
+			if (t == b)
+			{
+				// last element; race against stealers
+				if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					pTask = 0;
+				_bottom.store(b + 1, std::memory_order_relaxed);
+			}
+		}
+		else
+		{
+			_bottom.store(b + 1, std::memory_order_relaxed);
+		}
+		return pTask;
+	}
+
+	Task* steal()
+	{
+		Poco::Int64 t = _top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		Poco::Int64 b = _bottom.load(std::memory_order_acquire);
+		if (t < b)
+		{
+			Array* pArray = _pArray.load(std::memory_order_acquire);
+			Task* pTask = pArray->get(t);
+			if (_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				return pTask;
+		}
+		return 0;
+	}
+
+	bool empty() const
+	{
+		Poco::Int64 b = _bottom.load(std::memory_order_acquire);
+		Poco::Int64 t = _top.load(std::memory_order_acquire);
+		return b <= t;
+	}
+
+private:
+	enum
+	{
+		INITIAL_CAPACITY = 256,
+		CACHE_LINE_SIZE  = 64
+	};
+
+	struct Array
+	{
+		explicit Array(Poco::Int64 cap):
+			capacity(cap),
+			items(new std::atomic<Task*>[static_cast<std::size_t>(cap)])
+		{
+		}
+
+		~Array()
+		{
+			delete [] items;
+		}
+
+		Task* get(Poco::Int64 i) const
+		{
+			return items[i & (capacity - 1)].load(std::memory_order_relaxed);
+		}
+
+		void put(Poco::Int64 i, Task* pTask)
+		{
+			items[i & (capacity - 1)].store(pTask, std::memory_order_relaxed);
+		}
+
+		Array* grow(Poco::Int64 t, Poco::Int64 b) const
+		{
+			Array* pArray = new Array(2*capacity);
+			for (Poco::Int64 i = t; i < b; ++i)
+			{
+				pArray->put(i, get(i));
+			}
+			return pArray;
+		}
+
+		Poco::Int64 capacity;
+		std::atomic<Task*>* items;
+	};
+
+	Deque(const Deque&);
+	Deque& operator = (const Deque&);
+
+	std::atomic<Poco::Int64> _top;
+	char _pad1[CACHE_LINE_SIZE];
+	std::atomic<Poco::Int64> _bottom;
+	std::atomic<Array*> _pArray;
+	std::vector<Array*> _garbage;
+	char _pad2[CACHE_LINE_SIZE];
+};
+
+
+//
+// WorkStealingPool::Worker
+//
+
+
+class WorkStealingPool::Worker: public Runnable
+{
+public:
+	Worker(WorkStealingPool& pool, int index):
+		pool(pool),
+		submitted(0),
+		executed(0),
+		stolen(0),
+		_seed(2463534242U + index)
+	{
+	}
+
+	void run()
+	{
+		pool.run(*this);
+	}
+
+	Poco::UInt32 random()
+		/// Returns a pseudo-random number (xorshift32),
+		/// used to pick victims for stealing.
+	{
+		_seed ^= _seed << 13;
+		_seed ^= _seed >> 17;
+		_seed ^= _seed << 5;
+		return _seed;
+	}
+
+	static void increment(std::atomic<Poco::UInt64>& counter)
+		/// Increments a counter that is only written by its worker.
+	{
+		counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+
+	WorkStealingPool& pool;
+	Deque deque;
+	Thread thread;
+	std::atomic<Poco::UInt64> submitted;
+	std::atomic<Poco::UInt64> executed;
+	std::atomic<Poco::UInt64> stolen;
+
+private:
+	Poco::UInt32 _seed;
+};
+
+
+//
+// WorkStealingPool
+//
+
+
+WorkStealingPool::WorkStealingPool(int threads, std::size_t queueCapacity):
+	_injected(queueCapacity),
+	_injectedHead(0),
+	_injectedCount(0),
+	_injectedTotal(0),
+	_sleeping(0),
+	_joining(0),
+	_stopped(false)
+{
+	init(threads);
+}
+
+
+WorkStealingPool::WorkStealingPool(const std::string& name, int threads, std::size_t queueCapacity):
+	_name(name),
+	_injected(queueCapacity),
+	_injectedHead(0),
+	_injectedCount(0),
+	_injectedTotal(0),
+	_sleeping(0),
+	_joining(0),
+	_stopped(false)
+{
+	init(threads);
+}
+
+
+WorkStealingPool::~WorkStealingPool()
+{
+	try
+	{
+		stop();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+	for (WorkerVec::iterator it = _workers.begin(); it != _workers.end(); ++it)
+	{
+		delete *it;
+	}
+}
+
+
+void WorkStealingPool::init(int threads)
+{
+	poco_assert (threads >= 0);
+	poco_assert (!_injected.empty());
+
+	if (threads == 0) threads = static_cast<int>(Environment::processorCount());
+	if (threads == 0) threads = 1;
+
+	for (int i = 0; i < threads; ++i)
+	{
+		_workers.push_back(new Worker(*this, i));
+	}
+	for (int i = 0; i < threads; ++i)
+	{
+		std::string threadName(_name.empty() ? "WorkStealingPool" : _name);
+		threadName.append("[#");
+		NumberFormatter::append(threadName, i);
+		threadName.append("]");
+		_workers[i]->thread.setName(threadName);
+		_workers[i]->thread.start(*_workers[i]);
+	}
+}
+
+
+void WorkStealingPool::start(Runnable& target)
+{
+	schedule(new RunnableTask(target));
+}
+
+
+void WorkStealingPool::joinAll()
+{
+	poco_assert (!isWorker());
+
+	++_joining;
+	FastMutex::ScopedLock lock(_joinMutex);
+	for (;;)
+	{
+		// Read the executed counters before the submitted counters:
+		// every task counted as executed has then also been counted
+		// as submitted, so equal sums mean that nothing is left.
+		Poco::UInt64 executedTasks = executed();
+		Poco::UInt64 submittedTasks = 0;
+		for (WorkerVec::const_iterator it = _workers.begin(); it != _workers.end(); ++it)
+		{
+			submittedTasks += (*it)->submitted.load(std::memory_order_acquire);
+		}
+		{
+			FastMutex::ScopedLock injectedLock(_injectedMutex);
+			submittedTasks += _injectedTotal;
+		}
+		if (executedTasks == submittedTasks) break;
+		_joinCondition.tryWait(_joinMutex, 10);
+	}
+	--_joining;
+}
+
+
+void WorkStealingPool::stop()
+{
+	poco_assert (!isWorker());
+
+	if (_stopped.exchange(true)) return;
+
+	{
+		FastMutex::ScopedLock lock(_sleepMutex);
+		_sleepCondition.broadcast();
+	}
+	for (WorkerVec::iterator it = _workers.begin(); it != _workers.end(); ++it)
+	{
+		(*it)->thread.join();
+	}
+}
+
+
+int WorkStealingPool::threads() const
+{
+	return static_cast<int>(_workers.size());
+}
+
+
+Poco::UInt64 WorkStealingPool::executed() const
+{
+	Poco::UInt64 n = 0;
+	for (WorkerVec::const_iterator it = _workers.begin(); it != _workers.end(); ++it)
+	{
+		n += (*it)->executed.load(std::memory_order_acquire);
+	}
+	return n;
+}
+
+
+Poco::UInt64 WorkStealingPool::stolen() const
+{
+	Poco::UInt64 n = 0;
+	for (WorkerVec::const_iterator it = _workers.begin(); it != _workers.end(); ++it)
+	{
+		n += (*it)->stolen.load(std::memory_order_relaxed);
+	}
+	return n;
+}
+
+
+bool WorkStealingPool::isWorker() const
+{
+	Worker* pWorker = currentWorker();
+	return pWorker && &pWorker->pool == this;
+}
+
+
+WorkStealingPool::Worker*& WorkStealingPool::currentWorker()
+{
+	static thread_local Worker* pWorker = 0;
+	return pWorker;
+}
+
+
+void WorkStealingPool::schedule(Task* pTask)
+{
+	Worker* pWorker = currentWorker();
+	if (pWorker && &pWorker->pool == this)
+	{
+		// Tasks submitted by tasks are accepted even while
+		// the pool is stopping, since they are still drained.
+		Worker::increment(pWorker->submitted);
+		pWorker->deque.push(pTask);
+	}
+	else
+	{
+		FastMutex::ScopedLock lock(_injectedMutex);
+		if (_stopped)
+		{
+			delete pTask;
+			throw IllegalStateException("WorkStealingPool has been stopped");
+		}
+		std::size_t count = _injectedCount.load(std::memory_order_relaxed);
+		if (count == _injected.size())
+		{
+			delete pTask;
+			throw NoThreadAvailableException("WorkStealingPool queue is full");
+		}
+		_injected[(_injectedHead + count) % _injected.size()] = pTask;
+		++_injectedTotal;
+		_injectedCount.store(count + 1, std::memory_order_release);
+	}
+	wakeUp();
+}
+
+
+WorkStealingPool::Task* WorkStealingPool::findTask(Worker& worker)
+{
+	Task* pTask = worker.deque.pop();
+	if (pTask) return pTask;
+
+	if (_injectedCount.load(std::memory_order_acquire) > 0)
+	{
+		// Take a fair share of the injected tasks, so that
+		// the injection queue lock is taken less often.
+		FastMutex::ScopedLock lock(_injectedMutex);
+		std::size_t count = _injectedCount.load(std::memory_order_relaxed);
+		if (count > 0)
+		{
+			std::size_t n = 1 + (count - 1)/_workers.size();
+			if (n > MAX_INJECTED_BATCH) n = MAX_INJECTED_BATCH;
+			pTask = _injected[_injectedHead];
+			for (std::size_t i = 1; i < n; ++i)
+			{
+				worker.deque.push(_injected[(_injectedHead + i) % _injected.size()]);
+			}
+			_injectedHead = (_injectedHead + n) % _injected.size();
+			_injectedCount.store(count - n, std::memory_order_release);
+			if (n > 1) wakeUp();
+			return pTask;
+		}
+	}
+
+	std::size_t n = _workers.size();
+	if (n > 1)
+	{
+		std::size_t start = worker.random() % n;
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			Worker* pVictim = _workers[(start + i) % n];
+			if (pVictim == &worker) continue;
+			pTask = pVictim->deque.steal();
+			if (pTask)
+			{
+				Worker::increment(worker.stolen);
+				return pTask;
+			}
+		}
+	}
+	return 0;
+}
+
+
+bool WorkStealingPool::hasWork() const
+{
+	if (_injectedCount.load(std::memory_order_acquire) > 0) return true;
+	for (WorkerVec::const_iterator it = _workers.begin(); it != _workers.end(); ++it)
+	{
+		if (!(*it)->deque.empty()) return true;
+	}
+	return false;
+}
+
+
+void WorkStealingPool::wakeUp()
+{
+	// Pairs with the increment of _sleeping in park(): either the
+	// sleeping worker sees the new task, or we see the sleeper.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (_sleeping.load(std::memory_order_relaxed) > 0)
+	{
+		FastMutex::ScopedLock lock(_sleepMutex);
+		_sleepCondition.signal();
+	}
+}
+
+
+void WorkStealingPool::run(Worker& worker)
+{
+	currentWorker() = &worker;
+	for (;;)
+	{
+		Task* pTask = findTask(worker);
+		if (pTask)
+			runTask(worker, pTask);
+		else if (_stopped && !hasWork())
+			break;
+		else
+			park();
+	}
+	currentWorker() = 0;
+}
+
+
+void WorkStealingPool::runTask(Worker& worker, Task* pTask)
+{
+	try
+	{
+		pTask->run();
+	}
+	catch (Exception& exc)
+	{
+		ErrorHandler::handle(exc);
+	}
+	catch (std::exception& exc)
+	{
+		ErrorHandler::handle(exc);
+	}
+	catch (...)
+	{
+		ErrorHandler::handle();
+	}
+	delete pTask;
+	Worker::increment(worker.executed);
+}
+
+
+void WorkStealingPool::park()
+{
+	for (int i = 0; i < SPIN_COUNT; ++i)
+	{
+		if (_stopped || hasWork()) return;
+		Thread::yield();
+	}
+
+	if (_joining > 0)
+	{
+		FastMutex::ScopedLock lock(_joinMutex);
+		_joinCondition.broadcast();
+	}
+
+	FastMutex::ScopedLock lock(_sleepMutex);
+	_sleeping.fetch_add(1);
+	if (!_stopped && !hasWork())
+	{
+		_sleepCondition.tryWait(_sleepMutex, 100);
+	}
+	_sleeping.fetch_sub(1);
+}
+
+
+namespace
+{
+	static SingletonHolder<WorkStealingPool> sh;
+}
+
+
+WorkStealingPool& WorkStealingPool::defaultPool()
+{
+	return *sh.get();
+}
+
+
+} // namespace Poco
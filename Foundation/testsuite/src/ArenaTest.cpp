@@ -0,0 +1,302 @@
+//
+// ArenaTest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "ArenaTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/Arena.h"
+#include <vector>
+#include <map>
+#include <string>
+#include <cstring>
+#include <cstdint>
+
+
+using Poco::Arena;
+using Poco::ArenaAllocator;
+
+
+namespace
+{
+	struct Tracked
+	{
+		Tracked(std::vector<int>& log, int id):
+			_log(log),
+			_id(id)
+		{
+		}
+
+		~Tracked()
+		{
+			_log.push_back(_id);
+		}
+
+		std::vector<int>& _log;
+		int _id;
+	};
+
+	struct alignas(64) Aligned
+	{
+		char data[64];
+	};
+}
+
+
+ArenaTest::ArenaTest(const std::string& rName): CppUnit::TestCase(rName)
+{
+}
+
+
+ArenaTest::~ArenaTest()
+{
+}
+
+
+void ArenaTest::testAllocate()
+{
+	Arena arena(1024);
+	assertTrue (arena.used() == 0);
+	assertTrue (arena.capacity() == 0);
+
+	char* p1 = static_cast<char*>(arena.allocate(100, 1));
+	char* p2 = static_cast<char*>(arena.allocate(100, 1));
+	assertTrue (p2 == p1 + 100);
+	assertTrue (arena.used() == 200);
+	assertTrue (arena.capacity() == 1024);
+
+	std::memset(p1, 'a', 100);
+	std::memset(p2, 'b', 100);
+	assertTrue (p1[99] == 'a');
+	assertTrue (p2[0] == 'b');
+
+	for (int i = 0; i < 100; ++i)
+	{
+		arena.allocate(100, 1);
+	}
+	assertTrue (arena.used() == 10200);
+	assertTrue (arena.capacity() >= 10200);
+	assertTrue (arena.capacity() <= 1024*64*2);
+}
+
+
+void ArenaTest::testAlignment()
+{
+	Arena arena;
+	arena.allocate(1, 1);
+	void* p8 = arena.allocate(8, 8);
+	assertTrue (reinterpret_cast<std::uintptr_t>(p8) % 8 == 0);
+	arena.allocate(3, 1);
+	void* p64 = arena.allocate(64, 64);
+	assertTrue (reinterpret_cast<std::uintptr_t>(p64) % 64 == 0);
+	void* pDefault = arena.allocate(1);
+	assertTrue (reinterpret_cast<std::uintptr_t>(pDefault) % alignof(std::max_align_t) == 0);
+
+	Aligned* pAligned = arena.create<Aligned>();
+	assertTrue (reinterpret_cast<std::uintptr_t>(pAligned) % 64 == 0);
+}
+
+
+void ArenaTest::testLargeAllocation()
+{
+	Arena arena(256);
+	char* pSmall = static_cast<char*>(arena.allocate(16));
+	char* pLarge = static_cast<char*>(arena.allocate(100000));
+	std::memset(pLarge, 'x', 100000);
+	assertTrue (arena.capacity() >= 100000 + 256);
+	char* pNext = static_cast<char*>(arena.allocate(16));
+	assertTrue (pNext != pSmall);
+	assertTrue (pNext < pLarge || pNext >= pLarge + 100000);
+}
+
+
+void ArenaTest::testBuffer()
+{
+	char buffer[256];
+	Arena arena(buffer, sizeof(buffer), 1024);
+	assertTrue (arena.capacity() == 256);
+
+	char* p1 = static_cast<char*>(arena.allocate(100, 1));
+	assertTrue (p1 == buffer);
+	char* p2 = static_cast<char*>(arena.allocate(200, 1));
+	assertTrue (p2 < buffer || p2 >= buffer + sizeof(buffer));
+	assertTrue (arena.capacity() == 256 + 1024);
+
+	arena.reset();
+	assertTrue (arena.used() == 0);
+	char* p3 = static_cast<char*>(arena.allocate(100, 1));
+	assertTrue (p3 == buffer);
+}
+
+
+void ArenaTest::testCreate()
+{
+	std::vector<int> log;
+	{
+		Arena arena;
+		Tracked* p1 = arena.create<Tracked>(log, 1);
+		arena.create<Tracked>(log, 2);
+		arena.create<Tracked>(log, 3);
+		assertTrue (p1->_id == 1);
+
+		int* pInt = arena.create<int>(42);
+		assertTrue (*pInt == 42);
+
+		std::string* pStr = arena.create<std::string>("a string that is too long for the small buffer");
+		assertTrue (*pStr == "a string that is too long for the small buffer");
+
+		assertTrue (log.empty());
+		arena.reset();
+		assertTrue (log.size() == 3);
+		assertTrue (log[0] == 3);
+		assertTrue (log[1] == 2);
+		assertTrue (log[2] == 1);
+
+		arena.create<Tracked>(log, 4);
+	}
+	assertTrue (log.size() == 4);
+	assertTrue (log[3] == 4);
+}
+
+
+void ArenaTest::testReset()
+{
+	Arena arena(1024);
+	for (int i = 0; i < 100; ++i)
+	{
+		arena.allocate(100);
+	}
+	std::size_t capacity = arena.capacity();
+	assertTrue (capacity >= 10000);
+
+	arena.reset();
+	assertTrue (arena.used() == 0);
+	assertTrue (arena.capacity() < capacity);
+	std::size_t kept = arena.capacity();
+	assertTrue (kept > 0);
+
+	// the kept chunk is reused, no new chunks are allocated
+	for (int n = 0; n < 10; ++n)
+	{
+		void* pFirst = arena.allocate(100);
+		arena.allocate(100);
+		assertTrue (arena.capacity() == kept);
+		arena.reset();
+		assertTrue (arena.allocate(100) == pFirst);
+		arena.reset();
+	}
+
+	arena.release();
+	assertTrue (arena.capacity() == 0);
+	assertTrue (arena.used() == 0);
+	arena.allocate(10);
+	assertTrue (arena.capacity() == 1024);
+}
+
+
+void ArenaTest::testAllocator()
+{
+	typedef std::basic_string<char, std::char_traits<char>, ArenaAllocator<char> > ArenaString;
+	typedef std::map<int, ArenaString, std::less<int>, ArenaAllocator<std::pair<const int, ArenaString> > > ArenaMap;
+
+	Arena arena;
+	ArenaAllocator<char> alloc(arena);
+	ArenaAllocator<int> intAlloc(alloc);
+	assertTrue (alloc == intAlloc);
+	Arena otherArena;
+	assertTrue (alloc != ArenaAllocator<int>(otherArena));
+
+	{
+		std::vector<int, ArenaAllocator<int> > vec(intAlloc);
+		vec.reserve(1000);
+		for (int i = 0; i < 1000; ++i) vec.push_back(i);
+		assertTrue (vec[999] == 999);
+		assertTrue (arena.used() >= 1000*sizeof(int));
+
+		ArenaMap map(std::less<int>(), alloc);
+		for (int i = 0; i < 100; ++i)
+		{
+			map.insert(ArenaMap::value_type(i, ArenaString("a value that does not fit into the small buffer", alloc)));
+		}
+		assertTrue (map.size() == 100);
+		assertTrue (map.find(50)->second == "a value that does not fit into the small buffer");
+	}
+	arena.reset();
+	assertTrue (arena.used() == 0);
+
+	try
+	{
+		intAlloc.allocate(static_cast<std::size_t>(-1)/2);
+		fail("must throw");
+	}
+	catch (std::bad_alloc&)
+	{
+	}
+}
+
+
+void ArenaTest::testResource()
+{
+#if defined(POCO_HAVE_STD_PMR)
+	Arena arena;
+	Poco::ArenaResource resource(arena);
+	assertTrue (&resource.arena() == &arena);
+	Poco::ArenaResource sameResource(arena);
+	assertTrue (resource.is_equal(sameResource));
+	Arena otherArena;
+	Poco::ArenaResource otherResource(otherArena);
+	assertTrue (!resource.is_equal(otherResource));
+	assertTrue (!resource.is_equal(*std::pmr::new_delete_resource()));
+
+	{
+		std::pmr::vector<std::pmr::string> names(&resource);
+		for (int i = 0; i < 100; ++i)
+		{
+			names.emplace_back("a name that does not fit into the small buffer");
+		}
+		assertTrue (names.size() == 100);
+		assertTrue (names[99] == "a name that does not fit into the small buffer");
+		assertTrue (names[99].get_allocator().resource() == &resource);
+		assertTrue (arena.used() >= 100*sizeof(std::pmr::string));
+
+		void* p = resource.allocate(64, 64);
+		assertTrue ((reinterpret_cast<std::uintptr_t>(p) & 63) == 0);
+		resource.deallocate(p, 64, 64);
+	}
+	arena.reset();
+	assertTrue (arena.used() == 0);
+#endif
+}
+
+
+void ArenaTest::setUp()
+{
+}
+
+
+void ArenaTest::tearDown()
+{
+}
+
+
+CppUnit::Test* ArenaTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("ArenaTest");
+
+	CppUnit_addTest(pSuite, ArenaTest, testAllocate);
+	CppUnit_addTest(pSuite, ArenaTest, testAlignment);
+	CppUnit_addTest(pSuite, ArenaTest, testLargeAllocation);
+	CppUnit_addTest(pSuite, ArenaTest, testBuffer);
+	CppUnit_addTest(pSuite, ArenaTest, testCreate);
+	CppUnit_addTest(pSuite, ArenaTest, testReset);
+	CppUnit_addTest(pSuite, ArenaTest, testAllocator);
+	CppUnit_addTest(pSuite, ArenaTest, testResource);
+
+	return pSuite;
+}
@@ -0,0 +1,368 @@
+//
+// AsyncRingChannelTest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "AsyncRingChannelTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/AsyncRingChannel.h"
+#include "Poco/Message.h"
+#include "Poco/AutoPtr.h"
+#include "Poco/Event.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/NumberParser.h"
+#include "Poco/Exception.h"
+#include "TestChannel.h"
+
+
+using Poco::AsyncRingChannel;
+using Poco::Message;
+using Poco::AutoPtr;
+using Poco::Event;
+using Poco::Thread;
+using Poco::NumberFormatter;
+using Poco::NumberParser;
+
+
+namespace
+{
+	class GateChannel: public Poco::Channel
+		/// Holds up the background thread until opened.
+	{
+	public:
+		GateChannel():
+			_count(0)
+		{
+		}
+
+		void log(const Message& msg)
+		{
+			_entered.set();
+			_gate.wait();
+			_gate.set();
+			if (msg.getSource() == "AsyncRingChannel") _report = msg.getText();
+			++_count;
+		}
+
+		void waitEntered()
+		{
+			_entered.wait();
+		}
+
+		void release()
+		{
+			_gate.set();
+		}
+
+		int count() const
+		{
+			return _count;
+		}
+
+		const std::string& report() const
+		{
+			return _report;
+		}
+
+	protected:
+		~GateChannel()
+		{
+		}
+
+	private:
+		Event _entered;
+		Event _gate;
+		std::string _report;
+		int _count;
+	};
+
+	class Releaser: public Poco::Runnable
+	{
+	public:
+		Releaser(GateChannel& channel):
+			_channel(channel)
+		{
+		}
+
+		void run()
+		{
+			Thread::sleep(100);
+			_channel.release();
+		}
+
+	private:
+		GateChannel& _channel;
+	};
+
+	class Producer: public Poco::Runnable
+	{
+	public:
+		Producer(AsyncRingChannel& channel, int id, int count):
+			_channel(channel),
+			_id(id),
+			_count(count)
+		{
+		}
+
+		void run()
+		{
+			Message msg("Producer", "", Message::PRIO_INFORMATION);
+			for (int i = 0; i < _count; ++i)
+			{
+				msg.setText(NumberFormatter::format(_id) + " " + NumberFormatter::format(i));
+				_channel.log(msg);
+			}
+		}
+
+	private:
+		AsyncRingChannel& _channel;
+		int _id;
+		int _count;
+	};
+}
+
+
+AsyncRingChannelTest::AsyncRingChannelTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+AsyncRingChannelTest::~AsyncRingChannelTest()
+{
+}
+
+
+void AsyncRingChannelTest::testLog()
+{
+	AutoPtr<TestChannel> pChannel = new TestChannel;
+	AutoPtr<AsyncRingChannel> pAsync = new AsyncRingChannel(pChannel);
+	pAsync->open();
+	Message msg("Source", "Text", Message::PRIO_ERROR);
+	msg.set("key", "value");
+	pAsync->log(msg);
+	pAsync->log(msg);
+	pAsync->flush();
+	assertTrue (pChannel->list().size() == 2);
+	pAsync->close();
+	assertTrue (pChannel->list().size() == 2);
+	const Message& last = pChannel->list().back();
+	assertTrue (last.getSource() == "Source");
+	assertTrue (last.getText() == "Text");
+	assertTrue (last.getPriority() == Message::PRIO_ERROR);
+	assertTrue (last.get("key") == "value");
+
+	AsyncRingChannel::Statistics stats = pAsync->statistics();
+	assertTrue (stats.logged == 2);
+	assertTrue (stats.written == 2);
+	assertTrue (stats.dropped == 0);
+	assertTrue (stats.batches >= 1);
+}
+
+
+void AsyncRingChannelTest::testOrder()
+{
+	AutoPtr<TestChannel> pChannel = new TestChannel;
+	AutoPtr<AsyncRingChannel> pAsync = new AsyncRingChannel(pChannel, 16);
+	Message msg;
+	for (int i = 0; i < 1000; ++i)
+	{
+		msg.setText(NumberFormatter::format(i));
+		pAsync->log(msg);
+	}
+	pAsync->close();
+	assertTrue (pChannel->list().size() == 1000);
+	int i = 0;
+	for (TestChannel::MsgList::const_iterator it = pChannel->list().begin(); it != pChannel->list().end(); ++it)
+	{
+		assertTrue (it->getText() == NumberFormatter::format(i++));
+	}
+}
+
+
+void AsyncRingChannelTest::testThreads()
+{
+	const int THREADS = 4;
+	const int COUNT = 5000;
+
+	AutoPtr<TestChannel> pChannel = new TestChannel;
+	AutoPtr<AsyncRingChannel> pAsync = new AsyncRingChannel(pChannel, 64);
+	pAsync->open();
+
+	std::vector<Producer*> producers;
+	std::vector<Thread*> threads;
+	for (int i = 0; i < THREADS; ++i)
+	{
+		producers.push_back(new Producer(*pAsync, i, COUNT));
+		threads.push_back(new Thread);
+		threads.back()->start(*producers.back());
+	}
+	for (int i = 0; i < THREADS; ++i)
+	{
+		threads[i]->join();
+		delete threads[i];
+		delete producers[i];
+	}
+	pAsync->close();
+
+	assertTrue (pChannel->list().size() == THREADS*COUNT);
+
+	// the messages of every thread must arrive in order
+	std::vector<int> next(THREADS, 0);
+	for (TestChannel::MsgList::const_iterator it = pChannel->list().begin(); it != pChannel->list().end(); ++it)
+	{
+		std::string::size_type pos = it->getText().find(' ');
+		int id = NumberParser::parse(it->getText().substr(0, pos));
+		int n = NumberParser::parse(it->getText().substr(pos + 1));
+		assertTrue (n == next[id]);
+		++next[id];
+	}
+
+	AsyncRingChannel::Statistics stats = pAsync->statistics();
+	assertTrue (stats.logged == THREADS*COUNT);
+	assertTrue (stats.written == THREADS*COUNT);
+	assertTrue (stats.dropped == 0);
+}
+
+
+void AsyncRingChannelTest::testBlock()
+{
+	AutoPtr<GateChannel> pChannel = new GateChannel;
+	AutoPtr<AsyncRingChannel> pAsync = new AsyncRingChannel(pChannel, 4, AsyncRingChannel::OVERFLOW_BLOCK);
+	Message msg;
+	pAsync->log(msg);
+	pChannel->waitEntered();
+
+	// the first message occupies its slot until it has been written
+	for (int i = 0; i < 3; ++i)
+	{
+		pAsync->log(msg);
+	}
+
+	Thread thread;
+	Releaser releaser(*pChannel);
+	thread.start(releaser);
+	pAsync->log(msg);
+	thread.join();
+	pAsync->log(msg);
+	pAsync->close();
+
+	assertTrue (pChannel->count() == 6);
+	AsyncRingChannel::Statistics stats = pAsync->statistics();
+	assertTrue (stats.logged == 6);
+	assertTrue (stats.written == 6);
+	assertTrue (stats.dropped == 0);
+	assertTrue (stats.blocked == 1);
+}
+
+
+void AsyncRingChannelTest::testDrop()
+{
+	AutoPtr<GateChannel> pChannel = new GateChannel;
+	AutoPtr<AsyncRingChannel> pAsync = new AsyncRingChannel(pChannel, 4, AsyncRingChannel::OVERFLOW_DROP);
+	Message msg;
+	pAsync->log(msg);
+	pChannel->waitEntered();
+	for (int i = 0; i < 10; ++i)
+	{
+		pAsync->log(msg);
+	}
+	pChannel->release();
+	pAsync->close();
+
+	assertTrue (pChannel->count() == 4);
+	AsyncRingChannel::Statistics stats = pAsync->statistics();
+	assertTrue (stats.logged == 4);
+	assertTrue (stats.written == 4);
+	assertTrue (stats.dropped == 7);
+	assertTrue (stats.blocked == 0);
+}
+
+
+void AsyncRingChannelTest::testCountAndDrop()
+{
+	AutoPtr<GateChannel> pChannel = new GateChannel;
+	AutoPtr<AsyncRingChannel> pAsync = new AsyncRingChannel(pChannel, 4, AsyncRingChannel::OVERFLOW_COUNT_AND_DROP);
+	Message msg;
+	pAsync->log(msg);
+	pChannel->waitEntered();
+	for (int i = 0; i < 10; ++i)
+	{
+		pAsync->log(msg);
+	}
+	pChannel->release();
+	pAsync->close();
+
+	// 4 messages and the report of the dropped messages
+	assertTrue (pChannel->count() == 5);
+	assertTrue (pChannel->report().find("7 log messages dropped") == 0);
+	AsyncRingChannel::Statistics stats = pAsync->statistics();
+	assertTrue (stats.written == 4);
+	assertTrue (stats.dropped == 7);
+}
+
+
+void AsyncRingChannelTest::testProperties()
+{
+	AutoPtr<AsyncRingChannel> pAsync = new AsyncRingChannel;
+	assertTrue (pAsync->getProperty("bufferSize") == "1024");
+	assertTrue (pAsync->getProperty("overflowPolicy") == "block");
+
+	pAsync->setProperty("bufferSize", "100");
+	assertTrue (pAsync->getBufferSize() == 100);
+	pAsync->setProperty("overflowPolicy", "drop");
+	assertTrue (pAsync->getOverflowPolicy() == AsyncRingChannel::OVERFLOW_DROP);
+	pAsync->setProperty("overflowPolicy", "countAndDrop");
+	assertTrue (pAsync->getProperty("overflowPolicy") == "countAndDrop");
+	pAsync->setProperty("priority", "high");
+
+	try
+	{
+		pAsync->setProperty("overflowPolicy", "wait");
+		fail("invalid policy - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+	try
+	{
+		pAsync->setProperty("bufferSize", "0");
+		fail("invalid size - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+}
+
+
+void AsyncRingChannelTest::setUp()
+{
+}
+
+
+void AsyncRingChannelTest::tearDown()
+{
+}
+
+
+CppUnit::Test* AsyncRingChannelTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("AsyncRingChannelTest");
+
+	CppUnit_addTest(pSuite, AsyncRingChannelTest, testLog);
+	CppUnit_addTest(pSuite, AsyncRingChannelTest, testOrder);
+	CppUnit_addTest(pSuite, AsyncRingChannelTest, testThreads);
+	CppUnit_addTest(pSuite, AsyncRingChannelTest, testBlock);
+	CppUnit_addTest(pSuite, AsyncRingChannelTest, testDrop);
+	CppUnit_addTest(pSuite, AsyncRingChannelTest, testCountAndDrop);
+	CppUnit_addTest(pSuite, AsyncRingChannelTest, testProperties);
+
+	return pSuite;
+}
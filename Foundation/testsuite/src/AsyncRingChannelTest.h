@@ -0,0 +1,44 @@
+//
+// AsyncRingChannelTest.h
+//
+// Definition of the AsyncRingChannelTest class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef AsyncRingChannelTest_INCLUDED
+#define AsyncRingChannelTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/CppUnit/TestCase.h"
+
+
+class AsyncRingChannelTest: public CppUnit::TestCase
+{
+public:
+	AsyncRingChannelTest(const std::string& name);
+	~AsyncRingChannelTest();
+
+	void testLog();
+	void testOrder();
+	void testThreads();
+	void testBlock();
+	void testDrop();
+	void testCountAndDrop();
+	void testProperties();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // AsyncRingChannelTest_INCLUDED
@@ -18,11 +18,34 @@
 #include "Poco/Thread.h"
 #include "Poco/Exception.h"
 #include "Poco/StdFunctionDelegate.h"
+#include "Poco/AtomicSnapshot.h"
+#include <atomic>
 
 
 using namespace Poco;
 
 
+namespace
+{
+	class Counted
+	{
+	public:
+		Counted(std::atomic<int>& live): _live(live)
+		{
+			++_live;
+		}
+
+		~Counted()
+		{
+			--_live;
+		}
+
+	private:
+		std::atomic<int>& _live;
+	};
+}
+
+
 #define LARGEINC 100
 
 
@@ -352,6 +375,79 @@ void BasicEventTest::testLambda()
 }
 
 
+void BasicEventTest::testConcurrentNotify()
+{
+	const int THREADS = 4;
+	const int EVENTS = 20000;
+
+	std::atomic<int> count(0);
+	std::atomic<int> churnCount(0);
+	auto f = StdFunctionDelegate<int>([&](const void*, int& args) { count += args; });
+	auto g = StdFunctionDelegate<int>([&](const void*, int& args) { churnCount += args; });
+	Simple += f;
+
+	Thread threads[THREADS];
+	for (int i = 0; i < THREADS; ++i)
+	{
+		threads[i].startFunc([&]()
+		{
+			for (int n = 0; n < EVENTS; ++n)
+			{
+				int arg = 1;
+				Simple.notify(this, arg);
+			}
+		});
+	}
+	// Changing the delegates while events are fired
+	// must neither block nor affect other delegates.
+	for (int n = 0; n < 1000; ++n)
+	{
+		Simple += g;
+		Simple -= g;
+	}
+	for (int i = 0; i < THREADS; ++i)
+	{
+		threads[i].join();
+	}
+	assertTrue (count == THREADS*EVENTS);
+	assertTrue (churnCount <= THREADS*EVENTS);
+
+	Simple -= f;
+	assertTrue (Simple.empty());
+	int arg = 1;
+	Simple.notify(this, arg);
+	assertTrue (count == THREADS*EVENTS);
+}
+
+
+void BasicEventTest::testSnapshotReclaim()
+{
+	std::atomic<int> live(0);
+	{
+		AtomicSnapshot<Counted> snapshot;
+		snapshot.publish(new Counted(live));
+		{
+			AtomicSnapshot<Counted>::ReadGuard guard(snapshot);
+			assertTrue (guard.get() != 0);
+
+			// Replaced objects that nobody reads any more must be deleted
+			// even though a reader still holds an older one.
+			for (int i = 0; i < 1000; ++i)
+			{
+				snapshot.publish(new Counted(live));
+				AtomicSnapshot<Counted>::ReadGuard other(snapshot);
+			}
+			assertTrue (live == 2);
+		}
+		assertTrue (live == 1);
+		snapshot.publish(0);
+		assertTrue (live == 0);
+		snapshot.publish(new Counted(live));
+	}
+	assertTrue (live == 0);
+}
+
+
 void BasicEventTest::onStaticVoid(const void* pSender)
 {
 	BasicEventTest* p = const_cast<BasicEventTest*>(reinterpret_cast<const BasicEventTest*>(pSender));
@@ -494,5 +590,7 @@ CppUnit::Test* BasicEventTest::suite()
 	CppUnit_addTest(pSuite, BasicEventTest, testAsyncNotify);
 	CppUnit_addTest(pSuite, BasicEventTest, testNullMutex);
 	CppUnit_addTest(pSuite, BasicEventTest, testLambda);
+	CppUnit_addTest(pSuite, BasicEventTest, testConcurrentNotify);
+	CppUnit_addTest(pSuite, BasicEventTest, testSnapshotReclaim);
 	return pSuite;
 }
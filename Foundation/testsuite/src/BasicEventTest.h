@@ -48,6 +48,8 @@ public:
 	void testAsyncNotify();
 	void testNullMutex();
 	void testLambda();
+	void testConcurrentNotify();
+	void testSnapshotReclaim();
 
 	void setUp();
 	void tearDown();
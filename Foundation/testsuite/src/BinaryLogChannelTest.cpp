@@ -0,0 +1,260 @@
+//
+// BinaryLogChannelTest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "BinaryLogChannelTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/BinaryLogChannel.h"
+#include "Poco/BinaryLogReader.h"
+#include "Poco/PatternFormatter.h"
+#include "Poco/TemporaryFile.h"
+#include "Poco/FileStream.h"
+#include "Poco/Message.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/AutoPtr.h"
+#include "Poco/Exception.h"
+
+
+using Poco::BinaryLogChannel;
+using Poco::BinaryLogReader;
+using Poco::PatternFormatter;
+using Poco::TemporaryFile;
+using Poco::FileOutputStream;
+using Poco::Message;
+using Poco::Timestamp;
+using Poco::AutoPtr;
+
+
+BinaryLogChannelTest::BinaryLogChannelTest(const std::string& rName): CppUnit::TestCase(rName)
+{
+}
+
+
+BinaryLogChannelTest::~BinaryLogChannelTest()
+{
+}
+
+
+void BinaryLogChannelTest::testLog()
+{
+	TemporaryFile file;
+	AutoPtr<BinaryLogChannel> pChannel = new BinaryLogChannel(file.path());
+	pChannel->open();
+	Message msg1("Source1", "first message", Message::PRIO_INFORMATION, __FILE__, 42);
+	msg1.setThread("Thread1");
+	msg1.setTid(7);
+	pChannel->log(msg1);
+	Message msg2("Source2", "second message", Message::PRIO_ERROR);
+	pChannel->log(msg2);
+	pChannel->close();
+
+	BinaryLogReader reader(file.path());
+	Message msg;
+	assertTrue (reader.read(msg));
+	assertTrue (msg.getSource() == "Source1");
+	assertTrue (msg.getText() == "first message");
+	assertTrue (msg.getPriority() == Message::PRIO_INFORMATION);
+	assertTrue (msg.getTime() == msg1.getTime());
+	assertTrue (msg.getThread() == "Thread1");
+	assertTrue (msg.getTid() == 7);
+	assertTrue (msg.getPid() == msg1.getPid());
+	assertTrue (std::string(msg.getSourceFile()) == __FILE__);
+	assertTrue (msg.getSourceLine() == 42);
+
+	assertTrue (reader.read(msg));
+	assertTrue (msg.getSource() == "Source2");
+	assertTrue (msg.getText() == "second message");
+	assertTrue (msg.getPriority() == Message::PRIO_ERROR);
+	assertTrue (msg.getSourceFile() == 0);
+
+	assertTrue (!reader.read(msg));
+}
+
+
+void BinaryLogChannelTest::testLogFormat()
+{
+	TemporaryFile file;
+	AutoPtr<BinaryLogChannel> pChannel = new BinaryLogChannel(file.path());
+	Message msg1("Source", "", Message::PRIO_WARNING);
+	std::string str("string");
+	pChannel->logf(msg1, "%s %s %d %u %ld %lu %Ld %LX %hd %c %b %.2hf %.3f", str, "literal", -1, 2u, -3L, 4UL, Poco::Int64(-5), Poco::UInt64(255), short(6), 'x', true, 1.5f, 2.25);
+	pChannel->logf(msg1, "no arguments");
+	pChannel->logf(msg1, "%d", 1);
+	pChannel->logf(msg1, "%d", 2);
+	pChannel->close();
+
+	BinaryLogReader reader(file.path());
+	Message msg;
+	assertTrue (reader.read(msg));
+	assertEqual ("string literal -1 2 -3 4 -5 FF 6 x 1 1.50 2.250", msg.getText());
+	assertTrue (msg.getSource() == "Source");
+	assertTrue (msg.getPriority() == Message::PRIO_WARNING);
+	assertTrue (reader.read(msg));
+	assertTrue (msg.getText() == "no arguments");
+	assertTrue (reader.read(msg));
+	assertTrue (msg.getText() == "1");
+	assertTrue (reader.read(msg));
+	assertTrue (msg.getText() == "2");
+	assertTrue (!reader.read(msg));
+
+	PatternFormatter formatter("%s [%p] %t");
+	std::string text;
+	formatter.format(msg, text);
+	assertTrue (text == "Source [Warning] 2");
+}
+
+
+void BinaryLogChannelTest::testGrowAndAppend()
+{
+	TemporaryFile file;
+	AutoPtr<BinaryLogChannel> pChannel = new BinaryLogChannel(file.path());
+	pChannel->setProperty("chunkSize", "4K");
+	Message msg("Source", "", Message::PRIO_INFORMATION);
+	for (int i = 0; i < 1000; ++i)
+	{
+		pChannel->logf(msg, "message %d", i);
+	}
+	assertTrue (pChannel->size() > 8192);
+	Poco::UInt64 size = pChannel->size();
+	pChannel->close();
+	assertTrue (file.getSize() == size);
+
+	pChannel->open();
+	assertTrue (pChannel->size() == size);
+	for (int i = 1000; i < 1100; ++i)
+	{
+		pChannel->logf(msg, "message %d", i);
+	}
+	pChannel->log(Message("Other", "last", Message::PRIO_DEBUG));
+	pChannel->close();
+
+	// "Source" and "message %d" are not defined again when appending;
+	// a message record takes 57 bytes, the definition of "Other" 14 bytes
+	// and the last message 61 bytes.
+	assertTrue (file.getSize() == size + 100*57 + 14 + 61);
+
+	BinaryLogReader reader(file.path());
+	Message msgRead;
+	for (int i = 0; i < 1100; ++i)
+	{
+		assertTrue (reader.read(msgRead));
+		assertTrue (msgRead.getText() == "message " + Poco::NumberFormatter::format(i));
+		assertTrue (msgRead.getSource() == "Source");
+	}
+	assertTrue (reader.read(msgRead));
+	assertTrue (msgRead.getText() == "last");
+	assertTrue (msgRead.getSource() == "Other");
+	assertTrue (!reader.read(msgRead));
+}
+
+
+void BinaryLogChannelTest::testInvalidFile()
+{
+	TemporaryFile file;
+	{
+		FileOutputStream ostr(file.path());
+		ostr << "This is not a binary log file.";
+	}
+
+	try
+	{
+		BinaryLogReader reader(file.path());
+		fail("not a binary log file - must throw");
+	}
+	catch (Poco::DataFormatException&)
+	{
+	}
+
+	AutoPtr<BinaryLogChannel> pChannel = new BinaryLogChannel(file.path());
+	try
+	{
+		pChannel->open();
+		fail("not a binary log file - must throw");
+	}
+	catch (Poco::DataFormatException&)
+	{
+	}
+}
+
+
+void BinaryLogChannelTest::testProperties()
+{
+	AutoPtr<BinaryLogChannel> pChannel = new BinaryLogChannel;
+	pChannel->setProperty("path", "test.blog");
+	assertTrue (pChannel->getProperty("path") == "test.blog");
+	assertTrue (pChannel->getProperty("chunkSize") == "1048576");
+	pChannel->setProperty("chunkSize", "64K");
+	assertTrue (pChannel->getProperty("chunkSize") == "65536");
+	try
+	{
+		pChannel->setProperty("chunkSize", "1000");
+		fail("chunk size too small - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+}
+
+
+void BinaryLogChannelTest::testChangePath()
+{
+	TemporaryFile file1;
+	TemporaryFile file2;
+	AutoPtr<BinaryLogChannel> pChannel = new BinaryLogChannel(file1.path());
+	pChannel->open();
+	pChannel->log(Message("Source", "first file", Message::PRIO_INFORMATION));
+	pChannel->setProperty("path", file2.path());
+	assertTrue (!file2.exists());
+	pChannel->log(Message("Source", "still first file", Message::PRIO_INFORMATION));
+	pChannel->close();
+	assertTrue (!file2.exists());
+
+	pChannel->open();
+	pChannel->log(Message("Source", "second file", Message::PRIO_INFORMATION));
+	pChannel->close();
+
+	Message msg;
+	BinaryLogReader reader1(file1.path());
+	assertTrue (reader1.read(msg));
+	assertTrue (msg.getText() == "first file");
+	assertTrue (reader1.read(msg));
+	assertTrue (msg.getText() == "still first file");
+	assertTrue (!reader1.read(msg));
+
+	BinaryLogReader reader2(file2.path());
+	assertTrue (reader2.read(msg));
+	assertTrue (msg.getText() == "second file");
+	assertTrue (!reader2.read(msg));
+}
+
+
+void BinaryLogChannelTest::setUp()
+{
+}
+
+
+void BinaryLogChannelTest::tearDown()
+{
+}
+
+
+CppUnit::Test* BinaryLogChannelTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("BinaryLogChannelTest");
+
+	CppUnit_addTest(pSuite, BinaryLogChannelTest, testLog);
+	CppUnit_addTest(pSuite, BinaryLogChannelTest, testLogFormat);
+	CppUnit_addTest(pSuite, BinaryLogChannelTest, testGrowAndAppend);
+	CppUnit_addTest(pSuite, BinaryLogChannelTest, testInvalidFile);
+	CppUnit_addTest(pSuite, BinaryLogChannelTest, testProperties);
+	CppUnit_addTest(pSuite, BinaryLogChannelTest, testChangePath);
+
+	return pSuite;
+}
@@ -0,0 +1,43 @@
+//
+// BinaryLogChannelTest.h
+//
+// Definition of the BinaryLogChannelTest class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef BinaryLogChannelTest_INCLUDED
+#define BinaryLogChannelTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/CppUnit/TestCase.h"
+
+
+class BinaryLogChannelTest: public CppUnit::TestCase
+{
+public:
+	BinaryLogChannelTest(const std::string& name);
+	~BinaryLogChannelTest();
+
+	void testLog();
+	void testLogFormat();
+	void testGrowAndAppend();
+	void testInvalidFile();
+	void testProperties();
+	void testChangePath();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // BinaryLogChannelTest_INCLUDED
@@ -0,0 +1,426 @@
+//
+// BoundedNotificationQueueTest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "BoundedNotificationQueueTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/BoundedNotificationQueue.h"
+#include "Poco/Notification.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/RunnableAdapter.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Random.h"
+#include <atomic>
+#include <vector>
+
+
+using Poco::BoundedNotificationQueue;
+using Poco::Notification;
+using Poco::Thread;
+using Poco::Runnable;
+using Poco::RunnableAdapter;
+using Poco::Stopwatch;
+
+
+namespace
+{
+	class QTestNotification: public Notification
+	{
+	public:
+		QTestNotification(const std::string& data): _data(data)
+		{
+		}
+		~QTestNotification()
+		{
+		}
+		const std::string& data() const
+		{
+			return _data;
+		}
+
+	private:
+		std::string _data;
+	};
+
+	class Waiter: public Runnable
+	{
+	public:
+		Waiter(BoundedNotificationQueue& queue):
+			_queue(queue),
+			_done(false)
+		{
+		}
+
+		void run()
+		{
+			Notification::Ptr pNf = _queue.waitDequeueNotification();
+			_result = pNf;
+			_done = true;
+		}
+
+		bool done() const
+		{
+			return _done;
+		}
+
+		Notification::Ptr result() const
+		{
+			return _result;
+		}
+
+	private:
+		BoundedNotificationQueue& _queue;
+		Notification::Ptr _result;
+		std::atomic<bool> _done;
+	};
+
+	class Producer: public Runnable
+	{
+	public:
+		Producer(BoundedNotificationQueue& queue, int count):
+			_queue(queue),
+			_count(count)
+		{
+		}
+
+		void run()
+		{
+			for (int i = 0; i < _count; ++i)
+			{
+				_queue.enqueueNotification(new Notification);
+			}
+		}
+
+	private:
+		BoundedNotificationQueue& _queue;
+		int _count;
+	};
+
+	class StopNotification: public Notification
+	{
+	};
+
+	class Consumer: public Runnable
+	{
+	public:
+		Consumer(BoundedNotificationQueue& queue, std::atomic<int>& received):
+			_queue(queue),
+			_received(received)
+		{
+		}
+
+		void run()
+		{
+			for (;;)
+			{
+				Notification::Ptr pNf = _queue.waitDequeueNotification();
+				if (!pNf || pNf.cast<StopNotification>()) break;
+				++_received;
+			}
+		}
+
+	private:
+		BoundedNotificationQueue& _queue;
+		std::atomic<int>& _received;
+	};
+}
+
+
+BoundedNotificationQueueTest::BoundedNotificationQueueTest(const std::string& rName):
+	CppUnit::TestCase(rName),
+	_queue(64)
+{
+}
+
+
+BoundedNotificationQueueTest::~BoundedNotificationQueueTest()
+{
+}
+
+
+void BoundedNotificationQueueTest::testQueueDequeue()
+{
+	BoundedNotificationQueue queue;
+	assertTrue (queue.empty());
+	assertTrue (queue.size() == 0);
+	Notification* pNf = queue.dequeueNotification();
+	assertNullPtr(pNf);
+	queue.enqueueNotification(new Notification);
+	assertTrue (!queue.empty());
+	assertTrue (queue.size() == 1);
+	pNf = queue.dequeueNotification();
+	assertNotNullPtr(pNf);
+	assertTrue (queue.empty());
+	assertTrue (queue.size() == 0);
+	pNf->release();
+
+	queue.enqueueNotification(new QTestNotification("first"));
+	queue.enqueueNotification(new QTestNotification("second"));
+	assertTrue (!queue.empty());
+	assertTrue (queue.size() == 2);
+	QTestNotification* pTNf = dynamic_cast<QTestNotification*>(queue.dequeueNotification());
+	assertNotNullPtr(pTNf);
+	assertTrue (pTNf->data() == "first");
+	pTNf->release();
+	assertTrue (!queue.empty());
+	assertTrue (queue.size() == 1);
+	pTNf = dynamic_cast<QTestNotification*>(queue.dequeueNotification());
+	assertNotNullPtr(pTNf);
+	assertTrue (pTNf->data() == "second");
+	pTNf->release();
+	assertTrue (queue.empty());
+	assertTrue (queue.size() == 0);
+
+	pNf = queue.dequeueNotification();
+	assertNullPtr(pNf);
+}
+
+
+void BoundedNotificationQueueTest::testCapacity()
+{
+	BoundedNotificationQueue queue(3);
+	assertTrue (queue.capacity() == 4);
+
+	Notification::Ptr pNf = new Notification;
+	for (int i = 0; i < 4; ++i)
+	{
+		assertTrue (queue.tryEnqueueNotification(pNf));
+	}
+	assertTrue (queue.size() == 4);
+	assertTrue (!queue.tryEnqueueNotification(pNf));
+	assertTrue (pNf->referenceCount() == 5);
+
+	// wrap around several times
+	for (int i = 0; i < 100; ++i)
+	{
+		Notification::Ptr pDeq = queue.dequeueNotification();
+		assertTrue (i >= 4 || pDeq == pNf);
+		assertTrue (i < 4 || pDeq->name() != pNf->name());
+		assertTrue (queue.tryEnqueueNotification(new QTestNotification("wrap")));
+	}
+	assertTrue (queue.size() == 4);
+	queue.clear();
+	assertTrue (queue.empty());
+	assertTrue (pNf->referenceCount() == 1);
+}
+
+
+void BoundedNotificationQueueTest::testWaitDequeue()
+{
+	BoundedNotificationQueue queue;
+	queue.enqueueNotification(new QTestNotification("third"));
+	queue.enqueueNotification(new QTestNotification("fourth"));
+	assertTrue (!queue.empty());
+	assertTrue (queue.size() == 2);
+	QTestNotification* pTNf = dynamic_cast<QTestNotification*>(queue.waitDequeueNotification(10));
+	assertNotNullPtr(pTNf);
+	assertTrue (pTNf->data() == "third");
+	pTNf->release();
+	assertTrue (!queue.empty());
+	assertTrue (queue.size() == 1);
+	pTNf = dynamic_cast<QTestNotification*>(queue.waitDequeueNotification(10));
+	assertNotNullPtr(pTNf);
+	assertTrue (pTNf->data() == "fourth");
+	pTNf->release();
+	assertTrue (queue.empty());
+	assertTrue (queue.size() == 0);
+
+	Stopwatch sw;
+	sw.start();
+	Notification* pNf = queue.waitDequeueNotification(100);
+	sw.stop();
+	assertNullPtr(pNf);
+	assertTrue (sw.elapsed() >= 90000);
+
+	Waiter waiter(queue);
+	Thread t;
+	t.start(waiter);
+	while (!queue.hasIdleThreads()) Thread::sleep(10);
+	queue.enqueueNotification(new QTestNotification("fifth"));
+	t.join();
+	assertTrue (waiter.done());
+	QTestNotification* pResult = dynamic_cast<QTestNotification*>(waiter.result().get());
+	assertNotNullPtr(pResult);
+	assertTrue (pResult->data() == "fifth");
+	assertTrue (!queue.hasIdleThreads());
+}
+
+
+void BoundedNotificationQueueTest::testWakeUpAll()
+{
+	BoundedNotificationQueue queue;
+	Waiter waiter1(queue);
+	Waiter waiter2(queue);
+	Thread t1;
+	Thread t2;
+	t1.start(waiter1);
+	t2.start(waiter2);
+	Thread::sleep(100);
+	assertTrue (!waiter1.done());
+	assertTrue (!waiter2.done());
+	queue.wakeUpAll();
+	t1.join();
+	t2.join();
+	assertTrue (waiter1.done());
+	assertTrue (waiter2.done());
+	assertTrue (waiter1.result().isNull());
+	assertTrue (waiter2.result().isNull());
+}
+
+
+void BoundedNotificationQueueTest::testThreads()
+{
+	const int NOTIFICATION_COUNT = 5000;
+
+	Thread t1("thread1");
+	Thread t2("thread2");
+	Thread t3("thread3");
+
+	RunnableAdapter<BoundedNotificationQueueTest> ra(*this, &BoundedNotificationQueueTest::work);
+	t1.start(ra);
+	t2.start(ra);
+	t3.start(ra);
+	for (int i = 0; i < NOTIFICATION_COUNT; ++i)
+	{
+		_queue.enqueueNotification(new Notification);
+	}
+	while (!_queue.empty()) Thread::sleep(50);
+	Thread::sleep(20);
+	_queue.wakeUpAll();
+	t1.join();
+	t2.join();
+	t3.join();
+	assertTrue (_handled.size() == NOTIFICATION_COUNT);
+	assertTrue (_handled.count("thread1") > 0);
+	assertTrue (_handled.count("thread2") > 0);
+	assertTrue (_handled.count("thread3") > 0);
+}
+
+
+void BoundedNotificationQueueTest::testBlockingEnqueue()
+{
+	const int COUNT = 10000;
+
+	BoundedNotificationQueue queue(8);
+	Producer producer1(queue, COUNT);
+	Producer producer2(queue, COUNT);
+	Thread t1;
+	Thread t2;
+	t1.start(producer1);
+	t2.start(producer2);
+
+	int received = 0;
+	while (received < 2*COUNT)
+	{
+		Notification::Ptr pNf = queue.waitDequeueNotification(1000);
+		assertTrue (!pNf.isNull());
+		++received;
+	}
+	t1.join();
+	t2.join();
+	assertTrue (queue.empty());
+}
+
+
+void BoundedNotificationQueueTest::testStress()
+{
+	const int PRODUCERS = 4;
+	const int CONSUMERS = 4;
+	const int COUNT = 20000;
+
+	// A small queue makes both producers and consumers park often.
+	BoundedNotificationQueue queue(4);
+	std::atomic<int> received(0);
+	std::vector<Producer*> producers;
+	std::vector<Consumer*> consumers;
+	std::vector<Thread*> threads;
+	for (int i = 0; i < CONSUMERS; ++i)
+	{
+		consumers.push_back(new Consumer(queue, received));
+		threads.push_back(new Thread);
+		threads.back()->start(*consumers.back());
+	}
+	for (int i = 0; i < PRODUCERS; ++i)
+	{
+		producers.push_back(new Producer(queue, COUNT));
+		threads.push_back(new Thread);
+		threads.back()->start(*producers.back());
+	}
+	for (int i = CONSUMERS; i < CONSUMERS + PRODUCERS; ++i)
+	{
+		assertTrue (threads[i]->tryJoin(30000));
+	}
+	for (int i = 0; i < CONSUMERS; ++i)
+	{
+		queue.enqueueNotification(new StopNotification);
+	}
+	bool joined = true;
+	for (int i = 0; i < CONSUMERS; ++i)
+	{
+		joined = threads[i]->tryJoin(30000) && joined;
+	}
+	if (!joined)
+	{
+		queue.wakeUpAll();
+		for (int i = 0; i < CONSUMERS; ++i) threads[i]->join();
+	}
+	for (std::size_t i = 0; i < threads.size(); ++i) delete threads[i];
+	for (std::size_t i = 0; i < producers.size(); ++i) delete producers[i];
+	for (std::size_t i = 0; i < consumers.size(); ++i) delete consumers[i];
+
+	assertTrue (joined);
+	assertTrue (received == PRODUCERS*COUNT);
+	assertTrue (queue.empty());
+}
+
+
+void BoundedNotificationQueueTest::setUp()
+{
+	_handled.clear();
+}
+
+
+void BoundedNotificationQueueTest::tearDown()
+{
+}
+
+
+void BoundedNotificationQueueTest::work()
+{
+	Poco::Random rnd;
+	Thread::sleep(50);
+	Notification* pNf = _queue.waitDequeueNotification();
+	while (pNf)
+	{
+		pNf->release();
+		_mutex.lock();
+		_handled.insert(Thread::current()->name());
+		_mutex.unlock();
+		Thread::sleep(rnd.next(5));
+		pNf = _queue.waitDequeueNotification();
+	}
+}
+
+
+CppUnit::Test* BoundedNotificationQueueTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("BoundedNotificationQueueTest");
+
+	CppUnit_addTest(pSuite, BoundedNotificationQueueTest, testQueueDequeue);
+	CppUnit_addTest(pSuite, BoundedNotificationQueueTest, testCapacity);
+	CppUnit_addTest(pSuite, BoundedNotificationQueueTest, testWaitDequeue);
+	CppUnit_addTest(pSuite, BoundedNotificationQueueTest, testWakeUpAll);
+	CppUnit_addTest(pSuite, BoundedNotificationQueueTest, testThreads);
+	CppUnit_addTest(pSuite, BoundedNotificationQueueTest, testBlockingEnqueue);
+	CppUnit_addTest(pSuite, BoundedNotificationQueueTest, testStress);
+
+	return pSuite;
+}
@@ -0,0 +1,53 @@
+//
+// BoundedNotificationQueueTest.h
+//
+// Definition of the BoundedNotificationQueueTest class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef BoundedNotificationQueueTest_INCLUDED
+#define BoundedNotificationQueueTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/CppUnit/TestCase.h"
+#include "Poco/BoundedNotificationQueue.h"
+#include "Poco/Mutex.h"
+#include <set>
+
+
+class BoundedNotificationQueueTest: public CppUnit::TestCase
+{
+public:
+	BoundedNotificationQueueTest(const std::string& name);
+	~BoundedNotificationQueueTest();
+
+	void testQueueDequeue();
+	void testCapacity();
+	void testWaitDequeue();
+	void testWakeUpAll();
+	void testThreads();
+	void testBlockingEnqueue();
+	void testStress();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+protected:
+	void work();
+
+private:
+	Poco::BoundedNotificationQueue _queue;
+	std::multiset<std::string>     _handled;
+	Poco::FastMutex                _mutex;
+};
+
+
+#endif // BoundedNotificationQueueTest_INCLUDED
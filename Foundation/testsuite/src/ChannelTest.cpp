@@ -80,6 +80,30 @@ void ChannelTest::testAsync()
 }
 
 
+void ChannelTest::testAsyncBounded()
+{
+	AutoPtr<TestChannel> pChannel = new TestChannel;
+	AutoPtr<AsyncChannel> pAsync = new AsyncChannel(pChannel);
+	pAsync->setProperty("queueSize", "4");
+	pAsync->open();
+	try
+	{
+		pAsync->setProperty("queueSize", "8");
+		fail("channel open - must throw");
+	}
+	catch (Poco::IllegalStateException&)
+	{
+	}
+	Message msg;
+	for (int i = 0; i < 100; ++i)
+	{
+		pAsync->log(msg);
+	}
+	pAsync->close();
+	assertTrue (pChannel->list().size() == 100);
+}
+
+
 void ChannelTest::testFormatting()
 {
 	AutoPtr<TestChannel> pChannel = new TestChannel;
@@ -130,6 +154,7 @@ CppUnit::Test* ChannelTest::suite()
 
 	CppUnit_addTest(pSuite, ChannelTest, testSplitter);
 	CppUnit_addTest(pSuite, ChannelTest, testAsync);
+	CppUnit_addTest(pSuite, ChannelTest, testAsyncBounded);
 	CppUnit_addTest(pSuite, ChannelTest, testFormatting);
 	CppUnit_addTest(pSuite, ChannelTest, testConsole);
 	CppUnit_addTest(pSuite, ChannelTest, testStream);
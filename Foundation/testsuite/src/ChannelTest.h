@@ -26,6 +26,7 @@ public:
 
 	void testSplitter();
 	void testAsync();
+	void testAsyncBounded();
 	void testFormatting();
 	void testConsole();
 	void testStream();
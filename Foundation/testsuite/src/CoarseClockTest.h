@@ -0,0 +1,43 @@
+//
+// CoarseClockTest.h
+//
+// Definition of the CoarseClockTest class.
+//
+// Copyright (c) 2026, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef CoarseClockTest_INCLUDED
+#define CoarseClockTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/CppUnit/TestCase.h"
+
+
+class CoarseClockTest: public CppUnit::TestCase
+{
+public:
+	CoarseClockTest(const std::string& name);
+	~CoarseClockTest();
+
+	void testMonotonic();
+	void testRecalibration();
+	void testStartStop();
+	void testNow();
+	void testMessage();
+	void benchmarkCoarseClock();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // CoarseClockTest_INCLUDED
@@ -0,0 +1,304 @@
+//
+// ConcurrentCacheTest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "ConcurrentCacheTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/ConcurrentCache.h"
+#include "Poco/Thread.h"
+#include "Poco/Random.h"
+
+
+using Poco::ConcurrentCache;
+using Poco::SharedPtr;
+using Poco::Thread;
+using Poco::Random;
+
+
+typedef ConcurrentCache<int, int> IntCache;
+
+
+ConcurrentCacheTest::ConcurrentCacheTest(const std::string& rName): CppUnit::TestCase(rName)
+{
+}
+
+
+ConcurrentCacheTest::~ConcurrentCacheTest()
+{
+}
+
+
+void ConcurrentCacheTest::testAddGet()
+{
+	ConcurrentCache<std::string, std::string> cache(100);
+	assertTrue (cache.size() == 0);
+	assertTrue (cache.get("a").isNull());
+	assertTrue (!cache.has("a"));
+
+	cache.add("a", "1");
+	cache.add("b", "2");
+	assertTrue (cache.size() == 2);
+	assertTrue (cache.has("a"));
+	assertTrue (*cache.get("a") == "1");
+	assertTrue (*cache.get("b") == "2");
+
+	cache.add("a", "3");
+	assertTrue (cache.size() == 2);
+	assertTrue (*cache.get("a") == "3");
+
+	SharedPtr<std::string> pValue = cache.get("b");
+	cache.remove("b");
+	assertTrue (!cache.has("b"));
+	assertTrue (cache.get("b").isNull());
+	assertTrue (*pValue == "2");
+	assertTrue (cache.size() == 1);
+
+	cache.clear();
+	assertTrue (cache.size() == 0);
+	assertTrue (cache.get("a").isNull());
+}
+
+
+void ConcurrentCacheTest::testShards()
+{
+	IntCache cache(1000, IntCache::POLICY_LRU, 0, 10);
+	assertTrue (cache.shards() == 16);
+	assertTrue (cache.capacity() == 1000);
+
+	IntCache small(3, IntCache::POLICY_LRU, 0, 16);
+	assertTrue (small.shards() == 2);
+
+	IntCache single(1, IntCache::POLICY_LRU, 0, 16);
+	assertTrue (single.shards() == 1);
+	single.add(1, 1);
+	single.add(2, 2);
+	assertTrue (single.size() == 1);
+	assertTrue (single.has(2));
+
+	for (int i = 0; i < 10000; ++i)
+	{
+		cache.add(i, i);
+	}
+	assertTrue (cache.size() <= 1008);
+	assertTrue (cache.size() > 900);
+}
+
+
+void ConcurrentCacheTest::testLRU()
+{
+	IntCache cache(3, IntCache::POLICY_LRU, 0, 1);
+	cache.add(1, 1);
+	cache.add(2, 2);
+	cache.add(3, 3);
+	assertTrue (*cache.get(1) == 1);
+	cache.add(4, 4);
+	assertTrue (cache.size() == 3);
+	assertTrue (cache.has(1));
+	assertTrue (!cache.has(2));
+	assertTrue (cache.has(3));
+	assertTrue (cache.has(4));
+
+	cache.add(3, 33);
+	cache.add(5, 5);
+	assertTrue (!cache.has(1));
+	assertTrue (*cache.get(3) == 33);
+	assertTrue (cache.has(4));
+	assertTrue (cache.has(5));
+}
+
+
+void ConcurrentCacheTest::testClock()
+{
+	IntCache cache(3, IntCache::POLICY_CLOCK, 0, 1);
+	cache.add(1, 1);
+	cache.add(2, 2);
+	cache.add(3, 3);
+	assertTrue (*cache.get(1) == 1);
+	assertTrue (*cache.get(3) == 3);
+	cache.add(4, 4);
+	assertTrue (cache.size() == 3);
+	assertTrue (cache.has(1));
+	assertTrue (!cache.has(2));
+	assertTrue (cache.has(3));
+	assertTrue (cache.has(4));
+
+	// 3 has lost its second chance, and 4 has not been used
+	cache.add(5, 5);
+	assertTrue (cache.has(1));
+	assertTrue (cache.has(3));
+	assertTrue (!cache.has(4));
+	assertTrue (cache.has(5));
+}
+
+
+void ConcurrentCacheTest::testTinyLFU()
+{
+	const int HOT = 50;
+
+	IntCache cache(100, IntCache::POLICY_TINYLFU, 0, 1);
+	for (int n = 0; n < 5; ++n)
+	{
+		for (int i = 0; i < HOT; ++i)
+		{
+			if (cache.get(i).isNull()) cache.add(i, i);
+		}
+	}
+
+	// A scan of keys that are used only once must
+	// not evict the frequently used keys.
+	for (int i = 1000; i < 3000; ++i)
+	{
+		if (cache.get(i).isNull()) cache.add(i, i);
+	}
+	assertTrue (cache.size() == 100);
+	int hot = 0;
+	for (int i = 0; i < HOT; ++i)
+	{
+		if (cache.has(i)) ++hot;
+	}
+	assertTrue (hot >= HOT - 2);
+
+	IntCache lru(100, IntCache::POLICY_LRU, 0, 1);
+	for (int n = 0; n < 5; ++n)
+	{
+		for (int i = 0; i < HOT; ++i)
+		{
+			if (lru.get(i).isNull()) lru.add(i, i);
+		}
+	}
+	for (int i = 1000; i < 3000; ++i)
+	{
+		if (lru.get(i).isNull()) lru.add(i, i);
+	}
+	for (int i = 0; i < HOT; ++i)
+	{
+		assertTrue (!lru.has(i));
+	}
+}
+
+
+void ConcurrentCacheTest::testExpire()
+{
+	IntCache cache(100, IntCache::POLICY_LRU, 1000, 1);
+	cache.add(1, 1);
+	cache.add(2, 2);
+	assertTrue (cache.has(1));
+	assertTrue (*cache.get(1) == 1);
+	Thread::sleep(200);
+	cache.add(2, 22);
+	Thread::sleep(900);
+	assertTrue (!cache.has(1));
+	assertTrue (cache.get(1).isNull());
+	assertTrue (*cache.get(2) == 22);
+	assertTrue (cache.size() == 2);
+
+	// the expired entry is removed with the next change
+	cache.add(3, 3);
+	assertTrue (cache.size() == 2);
+	assertTrue (cache.statistics().expirations == 1);
+	Thread::sleep(1100);
+	assertTrue (cache.get(2).isNull());
+	assertTrue (cache.get(3).isNull());
+}
+
+
+void ConcurrentCacheTest::testStatistics()
+{
+	IntCache cache(2, IntCache::POLICY_LRU, 0, 1);
+	cache.add(1, 1);
+	cache.add(2, 2);
+	cache.get(1);
+	cache.get(2);
+	cache.get(3);
+	cache.add(3, 3);
+
+	IntCache::Statistics stats = cache.statistics();
+	assertTrue (stats.hits == 2);
+	assertTrue (stats.misses == 1);
+	assertTrue (stats.evictions == 1);
+	assertTrue (stats.expirations == 0);
+	assertTrue (stats.size == 2);
+	assertEqualDelta (2.0/3, stats.hitRate(), 0.0001);
+
+	cache.resetStatistics();
+	stats = cache.statistics();
+	assertTrue (stats.hits == 0);
+	assertTrue (stats.misses == 0);
+	assertTrue (stats.evictions == 0);
+	assertTrue (stats.hitRate() == 0);
+	assertTrue (stats.size == 2);
+}
+
+
+void ConcurrentCacheTest::testConcurrent()
+{
+	const int THREADS = 4;
+	const int LOOKUPS = 50000;
+
+	IntCache::Policy policies[] = {IntCache::POLICY_LRU, IntCache::POLICY_CLOCK, IntCache::POLICY_TINYLFU};
+	for (int p = 0; p < 3; ++p)
+	{
+		IntCache cache(256, policies[p], 0, 4);
+		Thread threads[THREADS];
+		for (int t = 0; t < THREADS; ++t)
+		{
+			threads[t].startFunc([&cache, t]()
+			{
+				Random rnd;
+				rnd.seed(t);
+				for (int n = 0; n < LOOKUPS; ++n)
+				{
+					int key = rnd.next(1024);
+					if (n % 100 == 0) cache.remove(key);
+					SharedPtr<int> pValue = cache.get(key);
+					if (pValue)
+						poco_assert (*pValue == key);
+					else
+						cache.add(key, key);
+				}
+			});
+		}
+		for (int t = 0; t < THREADS; ++t)
+		{
+			threads[t].join();
+		}
+		IntCache::Statistics stats = cache.statistics();
+		assertTrue (stats.hits + stats.misses == THREADS*LOOKUPS);
+		assertTrue (stats.hits > 0);
+		assertTrue (cache.size() <= 256);
+	}
+}
+
+
+void ConcurrentCacheTest::setUp()
+{
+}
+
+
+void ConcurrentCacheTest::tearDown()
+{
+}
+
+
+CppUnit::Test* ConcurrentCacheTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("ConcurrentCacheTest");
+
+	CppUnit_addTest(pSuite, ConcurrentCacheTest, testAddGet);
+	CppUnit_addTest(pSuite, ConcurrentCacheTest, testShards);
+	CppUnit_addTest(pSuite, ConcurrentCacheTest, testLRU);
+	CppUnit_addTest(pSuite, ConcurrentCacheTest, testClock);
+	CppUnit_addTest(pSuite, ConcurrentCacheTest, testTinyLFU);
+	CppUnit_addTest(pSuite, ConcurrentCacheTest, testExpire);
+	CppUnit_addTest(pSuite, ConcurrentCacheTest, testStatistics);
+	CppUnit_addTest(pSuite, ConcurrentCacheTest, testConcurrent);
+
+	return pSuite;
+}
@@ -0,0 +1,43 @@
+//
+// ConcurrentCacheTest.h
+//
+// Definition of the ConcurrentCacheTest class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef ConcurrentCacheTest_INCLUDED
+#define ConcurrentCacheTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/CppUnit/TestCase.h"
+
+
+class ConcurrentCacheTest: public CppUnit::TestCase
+{
+public:
+	ConcurrentCacheTest(const std::string& name);
+	~ConcurrentCacheTest();
+
+	void testAddGet();
+	void testShards();
+	void testLRU();
+	void testClock();
+	void testTinyLFU();
+	void testExpire();
+	void testStatistics();
+	void testConcurrent();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+};
+
+
+#endif // ConcurrentCacheTest_INCLUDED
@@ -25,6 +25,7 @@
 #include "NumberFormatterTest.h"
 #include "NumberParserTest.h"
 #include "DynamicFactoryTest.h"
+#include "ArenaTest.h"
 #include "MemoryPoolTest.h"
 #include "AnyTest.h"
 #include "VarTest.h"
@@ -59,6 +60,7 @@ CppUnit::Test* CoreTestSuite::suite()
 	pSuite->addTest(NumberFormatterTest::suite());
 	pSuite->addTest(NumberParserTest::suite());
 	pSuite->addTest(DynamicFactoryTest::suite());
+	pSuite->addTest(ArenaTest::suite());
 	pSuite->addTest(MemoryPoolTest::suite());
 	pSuite->addTest(AnyTest::suite());
 	pSuite->addTest(VarTest::suite());
@@ -544,6 +544,134 @@ void FileChannelTest::testWrongPurgeOption()
 }
 
 
+void FileChannelTest::testGroupCommit()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<FileChannel> pChannel = new FileChannel(name);
+		pChannel->setProperty(FileChannel::PROP_BUFFERSIZE, "64 K");
+		pChannel->setProperty(FileChannel::PROP_FLUSHINTERVAL, "200");
+		pChannel->setProperty(FileChannel::PROP_SYNCINTERVAL, "100");
+		assertTrue (pChannel->getProperty(FileChannel::PROP_BUFFERSIZE) == "65536");
+		assertTrue (pChannel->getProperty(FileChannel::PROP_FLUSHINTERVAL) == "200");
+		assertTrue (pChannel->getProperty(FileChannel::PROP_SYNCINTERVAL) == "100");
+		pChannel->open();
+		Message msg("source", "This is a log file entry", Message::PRIO_INFORMATION);
+		for (int i = 0; i < 100; ++i)
+		{
+			pChannel->log(msg);
+		}
+		assertTrue (pChannel->size() == 100*(msg.getText().size() + 1));
+		File f(name);
+		assertTrue (f.getSize() < pChannel->size());
+
+		// timed flush
+		Thread::sleep(1000);
+		assertTrue (f.getSize() == pChannel->size());
+
+		pChannel->log(msg);
+		assertTrue (f.getSize() < pChannel->size());
+		pChannel->flush();
+		assertTrue (f.getSize() == pChannel->size());
+
+		pChannel->log(msg);
+		pChannel->close();
+		assertTrue (f.getSize() == 102*(msg.getText().size() + 1));
+
+		try
+		{
+			pChannel->setProperty(FileChannel::PROP_BUFFERSIZE, "64 X");
+			fail("invalid unit - must throw");
+		}
+		catch (InvalidArgumentException&)
+		{
+		}
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void FileChannelTest::testGroupCommitRotate()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<FileChannel> pChannel = new FileChannel(name);
+		pChannel->setProperty(FileChannel::PROP_ROTATION, "2 K");
+		pChannel->setProperty(FileChannel::PROP_ARCHIVE, "number");
+		pChannel->setProperty(FileChannel::PROP_BUFFERSIZE, "1 M");
+		pChannel->setProperty(FileChannel::PROP_FLUSHINTERVAL, "0");
+		pChannel->open();
+		Message msg("source", "This is a log file entry", Message::PRIO_INFORMATION);
+		for (int i = 0; i < 200; ++i)
+		{
+			pChannel->log(msg);
+		}
+		File f(name + ".0");
+		assertTrue (f.exists());
+		assertTrue (f.getSize() >= 2048);
+		assertTrue (f.getSize() % (msg.getText().size() + 1) == 0);
+		f = name + ".1";
+		assertTrue (f.exists());
+		assertTrue (f.getSize() >= 2048);
+		f = name + ".2";
+		assertTrue (!f.exists());
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void FileChannelTest::testGroupCommitAfterOpen()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<FileChannel> pChannel = new FileChannel(name);
+		pChannel->setProperty(FileChannel::PROP_FLUSHINTERVAL, "200");
+		pChannel->open();
+		pChannel->setProperty(FileChannel::PROP_BUFFERSIZE, "64 K");
+		Message msg("source", "This is a log file entry", Message::PRIO_INFORMATION);
+		pChannel->log(msg);
+		File f(name);
+		assertTrue (f.getSize() < pChannel->size());
+
+		// the timed flush must have been started by setting bufferSize
+		Thread::sleep(1000);
+		assertTrue (f.getSize() == pChannel->size());
+
+		// changing the interval restarts the timer
+		pChannel->setProperty(FileChannel::PROP_FLUSHINTERVAL, "100");
+		pChannel->log(msg);
+		Thread::sleep(1000);
+		assertTrue (f.getSize() == pChannel->size());
+
+		// unbuffered again
+		pChannel->setProperty(FileChannel::PROP_BUFFERSIZE, "0");
+		pChannel->log(msg);
+		assertTrue (f.getSize() == pChannel->size());
+		pChannel->close();
+		assertTrue (f.getSize() == 3*(msg.getText().size() + 1));
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
 void FileChannelTest::setUp()
 {
 }
@@ -647,6 +775,9 @@ CppUnit::Test* FileChannelTest::suite()
 	CppUnit_addTest(pSuite, FileChannelTest, testPurgeAge);
 	CppUnit_addTest(pSuite, FileChannelTest, testPurgeCount);
 	CppUnit_addTest(pSuite, FileChannelTest, testWrongPurgeOption);
+	CppUnit_addTest(pSuite, FileChannelTest, testGroupCommit);
+	CppUnit_addTest(pSuite, FileChannelTest, testGroupCommitRotate);
+	CppUnit_addTest(pSuite, FileChannelTest, testGroupCommitAfterOpen);
 
 	return pSuite;
 }
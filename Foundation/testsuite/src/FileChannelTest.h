@@ -44,6 +44,9 @@ public:
 	void testPurgeAge();
 	void testPurgeCount();
 	void testWrongPurgeOption();
+	void testGroupCommit();
+	void testGroupCommitRotate();
+	void testGroupCommitAfterOpen();
 
 	void setUp();
 	void tearDown();
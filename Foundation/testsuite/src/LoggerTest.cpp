@@ -13,6 +13,9 @@
 #include "Poco/CppUnit/TestSuite.h"
 #include "Poco/Logger.h"
 #include "Poco/AutoPtr.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/NumberFormatter.h"
 #include "TestChannel.h"
 
 
@@ -20,6 +23,47 @@ using Poco::Logger;
 using Poco::Channel;
 using Poco::Message;
 using Poco::AutoPtr;
+using Poco::Thread;
+using Poco::Runnable;
+using Poco::NumberFormatter;
+
+
+namespace
+{
+	int evaluated = 0;
+
+	int evaluate(int n)
+	{
+		++evaluated;
+		return n;
+	}
+
+	class LoggerGetter: public Runnable
+	{
+	public:
+		LoggerGetter(): _mismatches(0)
+		{
+		}
+
+		void run()
+		{
+			for (int i = 0; i < 2000; ++i)
+			{
+				std::string name = "Concurrent." + NumberFormatter::format(i % 200);
+				Logger& logger = Logger::get(name);
+				if (logger.name() != name) ++_mismatches;
+			}
+		}
+
+		int mismatches() const
+		{
+			return _mismatches;
+		}
+
+	private:
+		int _mismatches;
+	};
+}
 
 
 LoggerTest::LoggerTest(const std::string& rName): CppUnit::TestCase(rName)
@@ -289,6 +333,125 @@ void LoggerTest::testDump()
 }
 
 
+void LoggerTest::testLazyFormat()
+{
+	AutoPtr<TestChannel> pChannel = new TestChannel;
+	Logger& root = Logger::root();
+	root.setChannel(pChannel);
+	root.setLevel(Message::PRIO_WARNING);
+
+	evaluated = 0;
+	poco_information_f(root, "%d %d %d %d %d", evaluate(1), evaluate(2), evaluate(3), evaluate(4), evaluate(5));
+	poco_information_f2(root, "%d %d", evaluate(1), evaluate(2));
+	assertTrue (evaluated == 0);
+	assertTrue (pChannel->list().empty());
+
+	poco_warning_f(root, "%d %d %d %d %d", evaluate(1), evaluate(2), evaluate(3), evaluate(4), evaluate(5));
+	assertTrue (evaluated == 5);
+	assertTrue (pChannel->getLastMessage().getText() == "1 2 3 4 5");
+	assertTrue (pChannel->getLastMessage().getPriority() == Message::PRIO_WARNING);
+	assertTrue (pChannel->getLastMessage().getSourceLine() > 0);
+
+	poco_error_f(root, "%s", std::string("error"));
+	assertTrue (pChannel->getLastMessage().getText() == "error");
+
+	pChannel->clear();
+	root.information("%d %s", 1, std::string("not logged"));
+	assertTrue (pChannel->list().empty());
+	root.warning("%d %s", 2, std::string("logged"));
+	assertTrue (pChannel->getLastMessage().getText() == "2 logged");
+}
+
+
+void LoggerTest::testGetDestroy()
+{
+	Logger& root = Logger::root();
+	root.setLevel(Message::PRIO_ERROR);
+
+	std::vector<Logger*> loggers;
+	for (int i = 0; i < 500; ++i)
+	{
+		loggers.push_back(&Logger::get("Many." + NumberFormatter::format(i)));
+	}
+	for (int i = 0; i < 500; ++i)
+	{
+		assertTrue (&Logger::get("Many." + NumberFormatter::format(i)) == loggers[i]);
+	}
+	assertTrue (Logger::has("Many.499"));
+
+	Logger::destroy("Many.1");
+	assertTrue (!Logger::has("Many.1"));
+	Logger& logger = Logger::get("Many.1");
+	assertTrue (logger.name() == "Many.1");
+	assertTrue (Logger::has("Many.1").get() == &logger);
+
+	Logger::shutdown();
+	assertTrue (!Logger::has("Many.2"));
+	assertTrue (Logger::get("Many.2").getLevel() == Message::PRIO_INFORMATION);
+	assertTrue (&Logger::get("Many.2") == &Logger::get("Many.2"));
+}
+
+
+void LoggerTest::testConcurrentGet()
+{
+	LoggerGetter getter1;
+	LoggerGetter getter2;
+	LoggerGetter getter3;
+	LoggerGetter getter4;
+	Thread thread1;
+	Thread thread2;
+	Thread thread3;
+	Thread thread4;
+	thread1.start(getter1);
+	thread2.start(getter2);
+	thread3.start(getter3);
+	thread4.start(getter4);
+	thread1.join();
+	thread2.join();
+	thread3.join();
+	thread4.join();
+	assertTrue (getter1.mismatches() == 0);
+	assertTrue (getter2.mismatches() == 0);
+	assertTrue (getter3.mismatches() == 0);
+	assertTrue (getter4.mismatches() == 0);
+
+	std::vector<std::string> names;
+	Logger::names(names);
+	assertTrue (names.size() == 201); // including the root logger
+}
+
+
+void LoggerTest::testDestroyMany()
+{
+	// Loggers created and destroyed per connection or request must not
+	// make the index grow; dead entries are dropped when it is rebuilt.
+	Logger& stable = Logger::get("Stable");
+	LoggerGetter getter;
+	Thread thread;
+	thread.start(getter);
+	for (int i = 0; i < 5000; ++i)
+	{
+		std::string name = "Connection." + NumberFormatter::format(i);
+		assertTrue (Logger::get(name).name() == name);
+		if (i % 2 == 0 && i < 100) Logger::get("Kept." + NumberFormatter::format(i));
+		Logger::destroy(name);
+		assertTrue (!Logger::has(name));
+		assertTrue (&Logger::get("Stable") == &stable);
+	}
+	thread.join();
+	assertTrue (getter.mismatches() == 0);
+
+	for (int i = 0; i < 100; i += 2)
+	{
+		std::string name = "Kept." + NumberFormatter::format(i);
+		assertTrue (Logger::has(name));
+		assertTrue (Logger::get(name).name() == name);
+	}
+	assertTrue (Logger::get("Connection.10").name() == "Connection.10");
+	Logger::destroy("Connection.10");
+}
+
+
 void LoggerTest::setUp()
 {
 	Logger::shutdown();
@@ -308,6 +471,10 @@ CppUnit::Test* LoggerTest::suite()
 	CppUnit_addTest(pSuite, LoggerTest, testFormat);
 	CppUnit_addTest(pSuite, LoggerTest, testFormatAny);
 	CppUnit_addTest(pSuite, LoggerTest, testDump);
+	CppUnit_addTest(pSuite, LoggerTest, testLazyFormat);
+	CppUnit_addTest(pSuite, LoggerTest, testGetDestroy);
+	CppUnit_addTest(pSuite, LoggerTest, testConcurrentGet);
+	CppUnit_addTest(pSuite, LoggerTest, testDestroyMany);
 
 	return pSuite;
 }
@@ -28,6 +28,10 @@ public:
 	void testFormat();
 	void testFormatAny();
 	void testDump();
+	void testLazyFormat();
+	void testGetDestroy();
+	void testConcurrentGet();
+	void testDestroyMany();
 
 	void setUp();
 	void tearDown();
@@ -11,6 +11,8 @@
 #include "LoggingTestSuite.h"
 #include "LoggerTest.h"
 #include "ChannelTest.h"
+#include "AsyncRingChannelTest.h"
+#include "BinaryLogChannelTest.h"
 #include "PatternFormatterTest.h"
 #include "FileChannelTest.h"
 #include "SimpleFileChannelTest.h"
@@ -25,6 +27,8 @@ CppUnit::Test* LoggingTestSuite::suite()
 
 	pSuite->addTest(LoggerTest::suite());
 	pSuite->addTest(ChannelTest::suite());
+	pSuite->addTest(AsyncRingChannelTest::suite());
+	pSuite->addTest(BinaryLogChannelTest::suite());
 	pSuite->addTest(PatternFormatterTest::suite());
 	pSuite->addTest(FileChannelTest::suite());
 	pSuite->addTest(SimpleFileChannelTest::suite());
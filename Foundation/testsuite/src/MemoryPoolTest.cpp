@@ -13,6 +13,7 @@
 #include "Poco/CppUnit/TestSuite.h"
 #include "Poco/MemoryPool.h"
 #include "Poco/Stopwatch.h"
+#include "Poco/Thread.h"
 #include <vector>
 #include <cstring>
 #include <iostream>
@@ -219,6 +220,126 @@ void MemoryPoolTest::testFastMemoryPool()
 }
 
 
+void MemoryPoolTest::testFastMemoryPoolMagazines()
+{
+	Poco::FastMemoryPool<int> pool(100, 10, 0, 8);
+	assertTrue (pool.magazineSize() == 8);
+	assertTrue (pool.allocated() == 100);
+	assertTrue (pool.available() == 100);
+	assertTrue (pool.cached() == 0);
+
+	// the first get() moves a batch of blocks into the magazine
+	int* p1 = new (pool.get()) int(1);
+	assertTrue (pool.cached() == 4);
+	assertTrue (pool.available() == 99);
+
+	std::vector<int*> ints;
+	for (int i = 0; i < 20; ++i)
+	{
+		ints.push_back(new (pool.get()) int(i));
+	}
+	assertTrue (pool.available() == 79);
+	for (int i = 0; i < 20; ++i)
+	{
+		assertTrue (*ints[i] == i);
+		pool.release(ints[i]);
+		assertTrue (pool.cached() <= 8);
+	}
+	pool.release(p1);
+	assertTrue (pool.available() == 100);
+	assertTrue (pool.allocated() == 100);
+	assertTrue (pool.stolen() == 0);
+
+	Poco::FastMemoryPool<int> uncached(100, 10, 0, 0);
+	int* p2 = new (uncached.get()) int(2);
+	assertTrue (uncached.cached() == 0);
+	assertTrue (uncached.available() == 99);
+	uncached.release(p2);
+	assertTrue (uncached.available() == 100);
+}
+
+
+namespace
+{
+	struct StealBlock
+	{
+		char data[16];
+	};
+}
+
+
+void MemoryPoolTest::testFastMemoryPoolThreads()
+{
+	// A pool that cannot grow beyond one bucket of two blocks.
+	Poco::FastMemoryPool<StealBlock> smallPool(2, 1, 1);
+	void* b1 = smallPool.get();
+	void* b2 = smallPool.get();
+	smallPool.release(static_cast<StealBlock*>(b1));
+	smallPool.release(static_cast<StealBlock*>(b2));
+	assertTrue (smallPool.cached() == 2);
+
+	int stolen = 0;
+	bool exhausted = false;
+	Poco::Thread thread;
+	thread.startFunc([&]()
+	{
+		void* s1 = smallPool.get();
+		void* s2 = smallPool.get();
+		if (s1 && s2) stolen = 2;
+		try
+		{
+			smallPool.get();
+		}
+		catch (std::bad_alloc&)
+		{
+			exhausted = true;
+		}
+		smallPool.release(static_cast<StealBlock*>(s1));
+		smallPool.release(static_cast<StealBlock*>(s2));
+	});
+	thread.join();
+	assertTrue (stolen == 2);
+	assertTrue (exhausted);
+	assertTrue (smallPool.stolen() == 2);
+	assertTrue (smallPool.available() == 2);
+
+	const int THREADS = 4;
+	const int BLOCKS = 1000;
+	Poco::FastMemoryPool<std::string> pool(100);
+	bool ok[THREADS] = {false};
+	Poco::Thread threads[THREADS];
+	for (int t = 0; t < THREADS; ++t)
+	{
+		threads[t].startFunc([&pool, &ok, t]()
+		{
+			bool good = true;
+			std::vector<std::string*> strings;
+			for (int n = 0; n < 20; ++n)
+			{
+				for (int i = 0; i < BLOCKS; ++i)
+				{
+					strings.push_back(new (pool.get()) std::string(std::to_string(t*BLOCKS + i)));
+				}
+				for (int i = 0; i < BLOCKS; ++i)
+				{
+					good = good && *strings[i] == std::to_string(t*BLOCKS + i);
+					pool.release(strings[i]);
+				}
+				strings.clear();
+			}
+			ok[t] = good;
+		});
+	}
+	for (int t = 0; t < THREADS; ++t)
+	{
+		threads[t].join();
+		assertTrue (ok[t]);
+	}
+	assertTrue (pool.available() == pool.allocated());
+	assertTrue (pool.allocated() <= THREADS*BLOCKS + 100*THREADS);
+}
+
+
 void MemoryPoolTest::memoryPoolBenchmark()
 {
 	Poco::Stopwatch sw;
@@ -288,6 +409,8 @@ CppUnit::Test* MemoryPoolTest::suite()
 
 	CppUnit_addTest(pSuite, MemoryPoolTest, testMemoryPool);
 	CppUnit_addTest(pSuite, MemoryPoolTest, testFastMemoryPool);
+	CppUnit_addTest(pSuite, MemoryPoolTest, testFastMemoryPoolMagazines);
+	CppUnit_addTest(pSuite, MemoryPoolTest, testFastMemoryPoolThreads);
 	//CppUnit_addTest(pSuite, MemoryPoolTest, memoryPoolBenchmark);
 
 	return pSuite;
@@ -26,6 +26,8 @@ public:
 
 	void testMemoryPool();
 	void testFastMemoryPool();
+	void testFastMemoryPoolMagazines();
+	void testFastMemoryPoolThreads();
 	void memoryPoolBenchmark();
 
 	void setUp();
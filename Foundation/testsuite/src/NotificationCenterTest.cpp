@@ -15,6 +15,7 @@
 #include "Poco/Observer.h"
 #include "Poco/NObserver.h"
 #include "Poco/AutoPtr.h"
+#include "Poco/Thread.h"
 
 
 using Poco::NotificationCenter;
@@ -22,6 +23,7 @@ using Poco::Observer;
 using Poco::NObserver;
 using Poco::Notification;
 using Poco::AutoPtr;
+using Poco::Thread;
 
 
 class TestNotification: public Notification
@@ -159,6 +161,45 @@ void NotificationCenterTest::testDefaultCenter()
 }
 
 
+void NotificationCenterTest::testConcurrentPost()
+{
+	const int THREADS = 4;
+	const int NOTIFICATIONS = 20000;
+
+	NotificationCenter nc;
+	nc.addObserver(NObserver<NotificationCenterTest, Notification>(*this, &NotificationCenterTest::handleCount));
+
+	Thread threads[THREADS];
+	for (int i = 0; i < THREADS; ++i)
+	{
+		threads[i].startFunc([&nc]()
+		{
+			for (int n = 0; n < NOTIFICATIONS; ++n)
+			{
+				nc.postNotification(new Notification);
+			}
+		});
+	}
+	for (int n = 0; n < 1000; ++n)
+	{
+		nc.addObserver(NObserver<NotificationCenterTest, Notification>(*this, &NotificationCenterTest::handleChurn));
+		nc.removeObserver(NObserver<NotificationCenterTest, Notification>(*this, &NotificationCenterTest::handleChurn));
+	}
+	for (int i = 0; i < THREADS; ++i)
+	{
+		threads[i].join();
+	}
+	assertTrue (_count == THREADS*NOTIFICATIONS);
+	assertTrue (_churnCount <= THREADS*NOTIFICATIONS);
+	assertTrue (nc.countObservers() == 1);
+
+	nc.removeObserver(NObserver<NotificationCenterTest, Notification>(*this, &NotificationCenterTest::handleCount));
+	assertTrue (!nc.hasObservers());
+	nc.postNotification(new Notification);
+	assertTrue (_count == THREADS*NOTIFICATIONS);
+}
+
+
 void NotificationCenterTest::handle1(Poco::Notification* pNf)
 {
 	poco_check_ptr (pNf);
@@ -197,6 +238,18 @@ void NotificationCenterTest::handleAuto(const AutoPtr<Notification>& pNf)
 }
 
 
+void NotificationCenterTest::handleCount(const AutoPtr<Notification>& pNf)
+{
+	++_count;
+}
+
+
+void NotificationCenterTest::handleChurn(const AutoPtr<Notification>& pNf)
+{
+	++_churnCount;
+}
+
+
 void NotificationCenterTest::setUp()
 {
 	_set.clear();
@@ -219,6 +272,7 @@ CppUnit::Test* NotificationCenterTest::suite()
 	CppUnit_addTest(pSuite, NotificationCenterTest, test5);
 	CppUnit_addTest(pSuite, NotificationCenterTest, testAuto);
 	CppUnit_addTest(pSuite, NotificationCenterTest, testDefaultCenter);
+	CppUnit_addTest(pSuite, NotificationCenterTest, testConcurrentPost);
 
 	return pSuite;
 }
@@ -18,6 +18,7 @@
 #include "Poco/CppUnit/TestCase.h"
 #include "Poco/Notification.h"
 #include "Poco/AutoPtr.h"
+#include "Poco/AtomicCounter.h"
 #include <set>
 
 
@@ -37,6 +38,7 @@ public:
 	void test5();
 	void testAuto();
 	void testDefaultCenter();
+	void testConcurrentPost();
 
 	void setUp();
 	void tearDown();
@@ -49,9 +51,13 @@ protected:
 	void handle3(Poco::Notification* pNf);
 	void handleTest(TestNotification* pNf);
 	void handleAuto(const Poco::AutoPtr<Poco::Notification>& pNf);
+	void handleCount(const Poco::AutoPtr<Poco::Notification>& pNf);
+	void handleChurn(const Poco::AutoPtr<Poco::Notification>& pNf);
 	
 private:
 	std::set<std::string> _set;
+	Poco::AtomicCounter _count;
+	Poco::AtomicCounter _churnCount;
 };
 
 
@@ -0,0 +1,335 @@
+//
+// ParallelTest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "ParallelTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/Parallel.h"
+#include "Poco/WorkStealingPool.h"
+#include "Poco/Random.h"
+#include "Poco/Exception.h"
+#include <vector>
+#include <string>
+#include <functional>
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+
+
+using Poco::WorkStealingPool;
+using Poco::Random;
+using Poco::parallelFor;
+using Poco::parallelReduce;
+using Poco::parallelSort;
+
+
+namespace
+{
+	std::vector<int> randomVector(std::size_t size)
+	{
+		Random rnd;
+		rnd.seed(42);
+		std::vector<int> vec(size);
+		for (std::size_t i = 0; i < size; ++i) vec[i] = static_cast<int>(rnd.next(1000000));
+		return vec;
+	}
+}
+
+
+ParallelTest::ParallelTest(const std::string& rName): CppUnit::TestCase(rName)
+{
+}
+
+
+ParallelTest::~ParallelTest()
+{
+}
+
+
+void ParallelTest::testFor()
+{
+	WorkStealingPool pool(4);
+	std::vector<int> vec(100000);
+	parallelFor(pool, std::size_t(0), vec.size(), [&vec](std::size_t i)
+	{
+		vec[i] += static_cast<int>(i);
+	});
+	for (std::size_t i = 0; i < vec.size(); ++i)
+	{
+		assertTrue (vec[i] == static_cast<int>(i));
+	}
+
+	std::atomic<int> count(0);
+	parallelFor(pool, 10, 10, [&count](int) { ++count; });
+	assertTrue (count == 0);
+	parallelFor(pool, 10, 5, [&count](int) { ++count; });
+	assertTrue (count == 0);
+	parallelFor(pool, -5, 5, [&count](int) { ++count; });
+	assertTrue (count == 10);
+
+	std::vector<int> squares(1000);
+	parallelFor(0, 1000, [&squares](int i)
+	{
+		squares[i] = i*i;
+	});
+	for (int i = 0; i < 1000; ++i)
+	{
+		assertTrue (squares[i] == i*i);
+	}
+}
+
+
+void ParallelTest::testForGrainSize()
+{
+	WorkStealingPool pool(3);
+	for (std::size_t grain = 1; grain < 40; grain += 7)
+	{
+		std::vector<std::atomic<int>> counts(1000);
+		for (std::size_t i = 0; i < counts.size(); ++i) counts[i] = 0;
+		parallelFor(pool, std::size_t(0), counts.size(), [&counts](std::size_t i)
+		{
+			++counts[i];
+		}, grain);
+		for (std::size_t i = 0; i < counts.size(); ++i)
+		{
+			assertTrue (counts[i] == 1);
+		}
+	}
+
+	assertTrue (Poco::Impl::parallelGrainSize(pool, 2400, 0) == 100);
+	assertTrue (Poco::Impl::parallelGrainSize(pool, 10, 0) == 1);
+	assertTrue (Poco::Impl::parallelGrainSize(pool, 2400, 7) == 7);
+}
+
+
+void ParallelTest::testForException()
+{
+	WorkStealingPool pool(4);
+	std::atomic<int> count(0);
+	try
+	{
+		parallelFor(pool, 0, 100000, [&count](int i)
+		{
+			++count;
+			if (i == 5000) throw Poco::InvalidArgumentException("test");
+		}, 100);
+		fail("must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+	assertTrue (count < 100000);
+
+	try
+	{
+		parallelFor(pool, 0, 1000, [](int)
+		{
+			throw std::runtime_error("test");
+		});
+		fail("must throw");
+	}
+	catch (std::runtime_error&)
+	{
+	}
+
+	// the pool is still usable
+	count = 0;
+	parallelFor(pool, 0, 1000, [&count](int) { ++count; });
+	assertTrue (count == 1000);
+}
+
+
+void ParallelTest::testForNested()
+{
+	WorkStealingPool pool(2);
+	std::vector<std::vector<int>> matrix(64, std::vector<int>(64));
+	parallelFor(pool, std::size_t(0), matrix.size(), [&pool, &matrix](std::size_t row)
+	{
+		parallelFor(pool, std::size_t(0), matrix[row].size(), [&matrix, row](std::size_t col)
+		{
+			matrix[row][col] = static_cast<int>(row*col);
+		}, 4);
+	}, 1);
+	for (std::size_t row = 0; row < matrix.size(); ++row)
+	{
+		for (std::size_t col = 0; col < matrix[row].size(); ++col)
+		{
+			assertTrue (matrix[row][col] == static_cast<int>(row*col));
+		}
+	}
+}
+
+
+void ParallelTest::testReduce()
+{
+	WorkStealingPool pool(4);
+	std::vector<Poco::Int64> vec(100001);
+	for (std::size_t i = 0; i < vec.size(); ++i) vec[i] = static_cast<Poco::Int64>(i);
+	Poco::Int64 sum = parallelReduce(pool, vec.begin(), vec.end(), Poco::Int64(0), std::plus<Poco::Int64>());
+	assertTrue (sum == Poco::Int64(100000)*100001/2);
+
+	sum = parallelReduce(pool, vec.begin(), vec.end(), Poco::Int64(10), std::plus<Poco::Int64>(), 1000);
+	assertTrue (sum == Poco::Int64(100000)*100001/2 + 10);
+
+	sum = parallelReduce(vec.begin(), vec.end());
+	assertTrue (sum == Poco::Int64(100000)*100001/2);
+
+	Poco::Int64 max = parallelReduce(vec.begin(), vec.end(), Poco::Int64(-1), [](Poco::Int64 a, Poco::Int64 b)
+	{
+		return std::max(a, b);
+	});
+	assertTrue (max == 100000);
+
+	assertTrue (parallelReduce(pool, vec.begin(), vec.begin(), Poco::Int64(42), std::plus<Poco::Int64>()) == 42);
+	assertTrue (parallelReduce(pool, vec.begin(), vec.begin() + 1, Poco::Int64(42), std::plus<Poco::Int64>()) == 42);
+
+	std::vector<int> ints(100000, 100000);
+	sum = parallelReduce(pool, ints.begin(), ints.end(), Poco::Int64(0), std::plus<Poco::Int64>(), 1000);
+	assertTrue (sum == Poco::Int64(100000)*100000);
+}
+
+
+void ParallelTest::testReduceOrder()
+{
+	WorkStealingPool pool(4);
+	std::vector<std::string> vec;
+	std::string expected = "<";
+	for (int i = 0; i < 1000; ++i)
+	{
+		vec.push_back(std::string(1, static_cast<char>('a' + i % 26)));
+		expected += vec.back();
+	}
+	std::string result = parallelReduce(pool, vec.begin(), vec.end(), std::string("<"), std::plus<std::string>(), 7);
+	assertTrue (result == expected);
+}
+
+
+void ParallelTest::testReduceException()
+{
+	WorkStealingPool pool(4);
+	std::vector<int> vec(10000, 1);
+	try
+	{
+		parallelReduce(pool, vec.begin(), vec.end(), 0, [](int a, int b) -> int
+		{
+			if (a > 5000) throw Poco::RangeException("test");
+			return a + b;
+		}, 6000);
+		fail("must throw");
+	}
+	catch (Poco::RangeException&)
+	{
+	}
+}
+
+
+void ParallelTest::testSort()
+{
+	WorkStealingPool pool(4);
+	const std::size_t sizes[] = {0, 1, 2, 100, 4095, 65536, 100003, 1000000};
+	for (std::size_t size: sizes)
+	{
+		std::vector<int> vec = randomVector(size);
+		std::vector<int> expected(vec);
+		std::sort(expected.begin(), expected.end());
+		parallelSort(pool, vec.begin(), vec.end(), std::less<int>());
+		assertTrue (vec == expected);
+	}
+
+	std::vector<int> vec = randomVector(100000);
+	std::vector<int> expected(vec);
+	std::sort(expected.begin(), expected.end());
+	parallelSort(pool, vec.begin(), vec.end(), std::less<int>(), 1000);
+	assertTrue (vec == expected);
+
+	vec = randomVector(100000);
+	parallelSort(vec.begin(), vec.end());
+	assertTrue (vec == expected);
+
+	// already sorted, and reversed
+	parallelSort(pool, vec.begin(), vec.end(), std::less<int>());
+	assertTrue (vec == expected);
+	std::reverse(vec.begin(), vec.end());
+	parallelSort(pool, vec.begin(), vec.end(), std::less<int>());
+	assertTrue (vec == expected);
+
+	WorkStealingPool single(1);
+	vec = randomVector(100000);
+	parallelSort(single, vec.begin(), vec.end(), std::less<int>());
+	assertTrue (vec == expected);
+}
+
+
+void ParallelTest::testSortCompare()
+{
+	std::vector<int> vec = randomVector(200000);
+	std::vector<int> expected(vec);
+	std::sort(expected.begin(), expected.end(), std::greater<int>());
+	parallelSort(vec.begin(), vec.end(), std::greater<int>());
+	assertTrue (vec == expected);
+
+	std::vector<std::string> strings;
+	for (int i = 0; i < 20000; ++i)
+	{
+		strings.push_back(std::to_string((i*7919) % 20000));
+	}
+	std::vector<std::string> expectedStrings(strings);
+	std::sort(expectedStrings.begin(), expectedStrings.end());
+	parallelSort(strings.begin(), strings.end());
+	assertTrue (strings == expectedStrings);
+}
+
+
+void ParallelTest::testSortException()
+{
+	WorkStealingPool pool(4);
+	std::vector<int> vec = randomVector(100000);
+	try
+	{
+		parallelSort(pool, vec.begin(), vec.end(), [](int a, int b) -> bool
+		{
+			if (a == b) throw Poco::LogicException("test");
+			return a < b;
+		});
+		fail("must throw");
+	}
+	catch (Poco::LogicException&)
+	{
+	}
+}
+
+
+void ParallelTest::setUp()
+{
+}
+
+
+void ParallelTest::tearDown()
+{
+}
+
+
+CppUnit::Test* ParallelTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("ParallelTest");
+
+	CppUnit_addTest(pSuite, ParallelTest, testFor);
+	CppUnit_addTest(pSuite, ParallelTest, testForGrainSize);
+	CppUnit_addTest(pSuite, ParallelTest, testForException);
+	CppUnit_addTest(pSuite, ParallelTest, testForNested);
+	CppUnit_addTest(pSuite, ParallelTest, testReduce);
+	CppUnit_addTest(pSuite, ParallelTest, testReduceOrder);
+	CppUnit_addTest(pSuite, ParallelTest, testReduceException);
+	CppUnit_addTest(pSuite, ParallelTest, testSort);
+	CppUnit_addTest(pSuite, ParallelTest, testSortCompare);
+	CppUnit_addTest(pSuite, ParallelTest, testSortException);
+
+	return pSuite;
+}
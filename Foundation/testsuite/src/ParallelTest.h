@@ -0,0 +1,45 @@
+//
+// ParallelTest.h
+//
+// Definition of the ParallelTest class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef ParallelTest_INCLUDED
+#define ParallelTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/CppUnit/TestCase.h"
+
+
+class ParallelTest: public CppUnit::TestCase
+{
+public:
+	ParallelTest(const std::string& name);
+	~ParallelTest();
+
+	void testFor();
+	void testForGrainSize();
+	void testForException();
+	void testForNested();
+	void testReduce();
+	void testReduceOrder();
+	void testReduceException();
+	void testSort();
+	void testSortCompare();
+	void testSortException();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+};
+
+
+#endif // ParallelTest_INCLUDED
@@ -110,6 +110,52 @@ void PatternFormatterTest::testPatternFormatter()
 }
 
 
+void PatternFormatterTest::testCachedTime()
+{
+	Message msg("TestSource", "Test message text", Message::PRIO_INFORMATION);
+	PatternFormatter fmt("%Y-%m-%d %H:%M:%S.%i %s %H:%M:%S.%F|%c");
+	PatternFormatter fmt2("%H:%M:%S");
+
+	std::string result;
+	msg.setTime(DateTime(2005, 1, 1, 14, 30, 15, 500, 250).timestamp());
+	fmt.format(msg, result);
+	assertTrue (result == "2005-01-01 14:30:15.500 TestSource 14:30:15.500250|5");
+
+	// same second
+	result.clear();
+	msg.setTime(DateTime(2005, 1, 1, 14, 30, 15, 7, 1).timestamp());
+	fmt.format(msg, result);
+	assertTrue (result == "2005-01-01 14:30:15.007 TestSource 14:30:15.007001|0");
+
+	result.clear();
+	fmt2.format(msg, result);
+	assertTrue (result == "14:30:15");
+
+	// next second
+	result.clear();
+	msg.setTime(DateTime(2005, 1, 1, 14, 30, 16, 7, 1).timestamp());
+	fmt.format(msg, result);
+	assertTrue (result == "2005-01-01 14:30:16.007 TestSource 14:30:16.007001|0");
+
+	// new pattern, same second
+	result.clear();
+	fmt.setProperty("pattern", "%d.%m.%Y %H:%M:%S");
+	fmt.format(msg, result);
+	assertTrue (result == "01.01.2005 14:30:16");
+
+	// before the epoch
+	result.clear();
+	msg.setTime(DateTime(1969, 12, 31, 23, 59, 59, 999, 0).timestamp());
+	fmt.format(msg, result);
+	assertTrue (result == "31.12.1969 23:59:59");
+
+	result.clear();
+	msg.setTime(DateTime(1970, 1, 1, 0, 0, 0, 1, 0).timestamp());
+	fmt.format(msg, result);
+	assertTrue (result == "01.01.1970 00:00:00");
+}
+
+
 void PatternFormatterTest::setUp()
 {
 }
@@ -125,6 +171,7 @@ CppUnit::Test* PatternFormatterTest::suite()
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("PatternFormatterTest");
 
 	CppUnit_addTest(pSuite, PatternFormatterTest, testPatternFormatter);
+	CppUnit_addTest(pSuite, PatternFormatterTest, testCachedTime);
 
 	return pSuite;
 }
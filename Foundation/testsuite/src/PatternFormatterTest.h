@@ -25,6 +25,7 @@ public:
 	~PatternFormatterTest();
 
 	void testPatternFormatter();
+	void testCachedTime();
 
 	void setUp();
 	void tearDown();
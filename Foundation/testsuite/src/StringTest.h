@@ -37,6 +37,8 @@ public:
 	void testIstring();
 	void testIcompare();
 	void testCILessThan();
+	void testCaseConversionLong();
+	void testIcompareLong();
 	void testTranslate();
 	void testTranslateInPlace();
 	void testReplace();
@@ -57,7 +59,9 @@ public:
 
 	void testIntToString();
 	void testFloatToString();
+	void testFloatToStringRoundTrip();
 	void benchmarkFloatToStr();
+	void benchmarkAscii();
 
 	void testJSONString();
 
@@ -20,6 +20,8 @@
 #include "ActiveMethodTest.h"
 #include "ActiveDispatcherTest.h"
 #include "ConditionTest.h"
+#include "WorkStealingPoolTest.h"
+#include "ParallelTest.h"
 
 
 CppUnit::Test* ThreadingTestSuite::suite()
@@ -37,6 +39,8 @@ CppUnit::Test* ThreadingTestSuite::suite()
 	pSuite->addTest(ActiveMethodTest::suite());
 	pSuite->addTest(ActiveDispatcherTest::suite());
 	pSuite->addTest(ConditionTest::suite());
+	pSuite->addTest(WorkStealingPoolTest::suite());
+	pSuite->addTest(ParallelTest::suite());
 
 	return pSuite;
 }
@@ -0,0 +1,302 @@
+//
+// TimingWheelTest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "TimingWheelTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/TimingWheel.h"
+#include "Poco/Notification.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/Random.h"
+#include <set>
+
+
+using Poco::TimingWheel;
+using Poco::Notification;
+using Poco::Clock;
+using Poco::Thread;
+using Poco::Runnable;
+
+
+namespace
+{
+	class WheelTestNotification: public Notification
+	{
+	public:
+		WheelTestNotification(int n): _n(n)
+		{
+		}
+
+		int n() const
+		{
+			return _n;
+		}
+
+	private:
+		int _n;
+	};
+
+	int n(const Notification::Ptr& pNf)
+	{
+		return pNf.cast<WheelTestNotification>()->n();
+	}
+
+	const Clock::ClockDiff MS = 1000;
+
+	class WakeUpRunnable: public Runnable
+	{
+	public:
+		WakeUpRunnable(TimingWheel& wheel): _wheel(wheel)
+		{
+		}
+
+		void run()
+		{
+			Thread::sleep(100);
+			_wheel.wakeUp();
+		}
+
+	private:
+		TimingWheel& _wheel;
+	};
+}
+
+
+TimingWheelTest::TimingWheelTest(const std::string& rName): CppUnit::TestCase(rName)
+{
+}
+
+
+TimingWheelTest::~TimingWheelTest()
+{
+}
+
+
+void TimingWheelTest::testExpire()
+{
+	// Clock values are relative to base; the wheel's origin is slightly
+	// later, so timers expire up to one tick after their time.
+	Clock base;
+	TimingWheel wheel;
+	assertTrue (wheel.empty());
+	assertTrue (wheel.resolution() == MS);
+
+	wheel.schedule(new WheelTestNotification(3), base + 30*MS);
+	wheel.schedule(new WheelTestNotification(1), base + 10*MS);
+	wheel.schedule(new WheelTestNotification(2), base + 20*MS);
+	wheel.schedule(new WheelTestNotification(0), Clock(0));
+	assertTrue (wheel.size() == 4);
+
+	TimingWheel::NotificationVec expired;
+	assertTrue (wheel.expire(expired, base) == 1);
+	assertTrue (n(expired[0]) == 0);
+	expired.clear();
+
+	assertTrue (wheel.expire(expired, base + 9*MS) == 0);
+	assertTrue (wheel.expire(expired, base + 11*MS) == 1);
+	assertTrue (n(expired[0]) == 1);
+	expired.clear();
+
+	assertTrue (wheel.expire(expired, base + 100*MS) == 2);
+	assertTrue (n(expired[0]) == 2);
+	assertTrue (n(expired[1]) == 3);
+	assertTrue (wheel.empty());
+
+	// timers in the past expire immediately
+	expired.clear();
+	wheel.schedule(new WheelTestNotification(4), base + 50*MS);
+	assertTrue (wheel.expire(expired, base + 100*MS) == 1);
+	assertTrue (n(expired[0]) == 4);
+}
+
+
+void TimingWheelTest::testCascade()
+{
+	Clock base;
+	TimingWheel wheel;
+
+	// one timer per level, plus one in the overflow list
+	const Clock::ClockDiff delays[] = {
+		5, 100, 5000, 300000, 20000000, 1000000000, 100000000000LL
+	};
+	const int count = sizeof(delays)/sizeof(delays[0]);
+	for (int i = count - 1; i >= 0; --i)
+	{
+		wheel.schedule(new WheelTestNotification(i), base + delays[i]*MS);
+	}
+
+	TimingWheel::NotificationVec expired;
+	for (int i = 0; i < count; ++i)
+	{
+		assertTrue (wheel.expire(expired, base + (delays[i] - 1)*MS) == 0);
+		assertTrue (wheel.size() == static_cast<std::size_t>(count - i));
+		assertTrue (wheel.expire(expired, base + (delays[i] + 1)*MS) == 1);
+		assertTrue (n(expired.back()) == i);
+	}
+	assertTrue (wheel.empty());
+}
+
+
+void TimingWheelTest::testCancel()
+{
+	Clock base;
+	TimingWheel wheel;
+
+	TimingWheel::TimerId id1 = wheel.schedule(new WheelTestNotification(1), base + 10*MS);
+	TimingWheel::TimerId id2 = wheel.schedule(new WheelTestNotification(2), base + 10*MS);
+	TimingWheel::TimerId id3 = wheel.schedule(new WheelTestNotification(3), base + 100000*MS);
+	assertTrue (id1 != 0 && id2 != 0 && id3 != 0);
+	assertTrue (id1 != id2 && id2 != id3);
+
+	assertTrue (wheel.cancel(id1));
+	assertTrue (!wheel.cancel(id1));
+	assertTrue (wheel.cancel(id3));
+	assertTrue (wheel.size() == 1);
+
+	// the entry of the cancelled timer is reused with a new id
+	TimingWheel::TimerId id4 = wheel.schedule(new WheelTestNotification(4), base + 20*MS);
+	assertTrue (id4 != id1 && id4 != id3);
+	assertTrue (!wheel.cancel(id1));
+	assertTrue (!wheel.cancel(id3));
+
+	TimingWheel::NotificationVec expired;
+	assertTrue (wheel.expire(expired, base + 1000000*MS) == 2);
+	assertTrue (n(expired[0]) == 2);
+	assertTrue (n(expired[1]) == 4);
+	assertTrue (!wheel.cancel(id2));
+	assertTrue (!wheel.cancel(0));
+}
+
+
+void TimingWheelTest::testClear()
+{
+	Clock base;
+	TimingWheel wheel;
+
+	TimingWheel::TimerId id = wheel.schedule(new WheelTestNotification(1), base + 10*MS);
+	wheel.schedule(new WheelTestNotification(2), base + 10000000*MS);
+	wheel.clear();
+	assertTrue (wheel.empty());
+	assertTrue (!wheel.cancel(id));
+
+	TimingWheel::NotificationVec expired;
+	assertTrue (wheel.expire(expired, base + 100000000*MS) == 0);
+
+	wheel.schedule(new WheelTestNotification(3), base + 200000000*MS);
+	assertTrue (wheel.expire(expired, base + 200000001*MS) == 1);
+	assertTrue (n(expired[0]) == 3);
+}
+
+
+void TimingWheelTest::testMany()
+{
+	Clock base;
+	TimingWheel wheel;
+	Poco::Random rnd;
+	rnd.seed(42);
+
+	const int count = 100000;
+	std::vector<TimingWheel::TimerId> ids;
+	std::vector<Clock::ClockDiff> delays;
+	for (int i = 0; i < count; ++i)
+	{
+		delays.push_back(static_cast<Clock::ClockDiff>(rnd.next(10000000)));
+		ids.push_back(wheel.schedule(new WheelTestNotification(i), base + delays[i]*MS));
+	}
+	std::set<int> cancelled;
+	for (int i = 0; i < count; i += 3)
+	{
+		assertTrue (wheel.cancel(ids[i]));
+		cancelled.insert(i);
+	}
+	assertTrue (wheel.size() == static_cast<std::size_t>(count - cancelled.size()));
+
+	TimingWheel::NotificationVec expired;
+	std::size_t total = 0;
+	for (Clock::ClockDiff t = 0; t <= 10000000; t += 1000)
+	{
+		expired.clear();
+		total += wheel.expire(expired, base + t*MS);
+		for (TimingWheel::NotificationVec::const_iterator it = expired.begin(); it != expired.end(); ++it)
+		{
+			int i = n(*it);
+			assertTrue (cancelled.find(i) == cancelled.end());
+			assertTrue (delays[i] <= t + 1);
+			assertTrue (delays[i] > t - 1001);
+		}
+	}
+	expired.clear();
+	total += wheel.expire(expired, base + 10000001*MS);
+	assertTrue (total == count - cancelled.size());
+	assertTrue (wheel.empty());
+}
+
+
+void TimingWheelTest::testWaitExpire()
+{
+	TimingWheel wheel;
+	Clock start;
+	Clock expiry = start + 200*MS;
+	wheel.schedule(new WheelTestNotification(1), expiry);
+
+	TimingWheel::NotificationVec expired;
+	assertTrue (wheel.waitExpire(expired, 50) == 0);
+	assertTrue (wheel.waitExpire(expired) == 1);
+	assertTrue (n(expired[0]) == 1);
+	assertTrue (Clock() >= expiry);
+
+	expired.clear();
+	wheel.schedule(new WheelTestNotification(2), Clock() + 100*MS);
+	assertTrue (wheel.waitExpire(expired, 1000) == 1);
+	assertTrue (n(expired[0]) == 2);
+}
+
+
+void TimingWheelTest::testWakeUp()
+{
+	TimingWheel wheel;
+	wheel.schedule(new WheelTestNotification(1), Clock() + 10000*MS);
+	WakeUpRunnable wakeUp(wheel);
+	Thread thread;
+	Clock start;
+	thread.start(wakeUp);
+	TimingWheel::NotificationVec expired;
+	assertTrue (wheel.waitExpire(expired) == 0);
+	assertTrue (start.elapsed() < 5000*MS);
+	thread.join();
+	assertTrue (wheel.size() == 1);
+}
+
+
+void TimingWheelTest::setUp()
+{
+}
+
+
+void TimingWheelTest::tearDown()
+{
+}
+
+
+CppUnit::Test* TimingWheelTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("TimingWheelTest");
+
+	CppUnit_addTest(pSuite, TimingWheelTest, testExpire);
+	CppUnit_addTest(pSuite, TimingWheelTest, testCascade);
+	CppUnit_addTest(pSuite, TimingWheelTest, testCancel);
+	CppUnit_addTest(pSuite, TimingWheelTest, testClear);
+	CppUnit_addTest(pSuite, TimingWheelTest, testMany);
+	CppUnit_addTest(pSuite, TimingWheelTest, testWaitExpire);
+	CppUnit_addTest(pSuite, TimingWheelTest, testWakeUp);
+
+	return pSuite;
+}
@@ -0,0 +1,44 @@
+//
+// TimingWheelTest.h
+//
+// Definition of the TimingWheelTest class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef TimingWheelTest_INCLUDED
+#define TimingWheelTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/CppUnit/TestCase.h"
+
+
+class TimingWheelTest: public CppUnit::TestCase
+{
+public:
+	TimingWheelTest(const std::string& name);
+	~TimingWheelTest();
+
+	void testExpire();
+	void testCascade();
+	void testCancel();
+	void testClear();
+	void testMany();
+	void testWaitExpire();
+	void testWakeUp();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // TimingWheelTest_INCLUDED
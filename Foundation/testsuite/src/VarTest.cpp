@@ -2761,6 +2761,98 @@ void VarTest::testIterator()
 }
 
 
+void VarTest::testSmallObject()
+{
+	std::string longString(100, 'x');
+
+	Var v1 = 42;
+	Var v2 = longString;
+	Var v3 = Poco::Timestamp(1000);
+	Var v4 = "abc";
+	DynamicStruct ds;
+	ds["a"] = 1;
+	ds["b"] = longString;
+	Var v5 = ds;
+
+	// assignments between small and large values
+	v1 = longString;
+	assertTrue (v1 == longString);
+	v1 = 1.5;
+	assertTrue (v1 == 1.5);
+	v1 = ds;
+	assertTrue (v1["b"] == longString);
+	v1 = v3;
+	assertTrue (v1.extract<Poco::Timestamp>() == Poco::Timestamp(1000));
+	v1 = v5;
+	assertTrue (v1["a"] == 1);
+	v1 = Var();
+	assertTrue (v1.isEmpty());
+	v1 = v4;
+	assertTrue (v1 == "abc");
+	v1 = v1;
+	assertTrue (v1 == "abc");
+
+	// assignments from values owned by the assigned Var
+	v1 = v1.extract<std::string>();
+	assertTrue (v1 == "abc");
+	v1 = longString;
+	v1 = v1.extract<std::string>();
+	assertTrue (v1 == longString);
+	std::vector<Var> vec;
+	vec.push_back(longString);
+	vec.push_back(7);
+	v1 = vec;
+	v1 = v1[0];
+	assertTrue (v1 == longString);
+	v1 = vec;
+	v1 = v1[1];
+	assertTrue (v1 == 7);
+	v1 = v5;
+	v1 = v1["b"];
+	assertTrue (v1 == longString);
+	v1 = v5;
+	v1 = v1["a"];
+	assertTrue (v1 == 1);
+
+	// swaps between small and large values
+	v1 = 42;
+	v1.swap(v2);
+	assertTrue (v1 == longString);
+	assertTrue (v2 == 42);
+	v2.swap(v3);
+	assertTrue (v2.extract<Poco::Timestamp>() == Poco::Timestamp(1000));
+	assertTrue (v3 == 42);
+	v1.swap(v5);
+	assertTrue (v1["b"] == longString);
+	assertTrue (v5 == longString);
+	Var empty;
+	v3.swap(empty);
+	assertTrue (v3.isEmpty());
+	assertTrue (empty == 42);
+
+	// copies
+	std::vector<Var> copies;
+	for (int i = 0; i < 100; ++i)
+	{
+		copies.push_back(i % 2 ? Var(i) : Var(longString));
+	}
+	std::vector<Var> copies2(copies);
+	for (int i = 0; i < 100; ++i)
+	{
+		if (i % 2)
+			assertTrue (copies2[i] == i);
+		else
+			assertTrue (copies2[i] == longString);
+	}
+
+	v4.clear();
+	assertTrue (v4.isEmpty());
+	v4 = 1;
+	v4.empty();
+	assertTrue (v4.isEmpty());
+}
+
+
 void VarTest::setUp()
 {
 }
@@ -2823,6 +2915,7 @@ CppUnit::Test* VarTest::suite()
 	CppUnit_addTest(pSuite, VarTest, testDate);
 	CppUnit_addTest(pSuite, VarTest, testEmpty);
 	CppUnit_addTest(pSuite, VarTest, testIterator);
+	CppUnit_addTest(pSuite, VarTest, testSmallObject);
 
 	return pSuite;
 }
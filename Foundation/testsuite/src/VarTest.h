@@ -74,6 +74,7 @@ public:
 	void testDate();
 	void testEmpty();
 	void testIterator();
+	void testSmallObject();
 
 
 	void setUp();
@@ -0,0 +1,302 @@
+//
+// WorkStealingPoolTest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "WorkStealingPoolTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/WorkStealingPool.h"
+#include "Poco/TaskManager.h"
+#include "Poco/Task.h"
+#include "Poco/ActiveMethod.h"
+#include "Poco/ActiveStarter.h"
+#include "Poco/Runnable.h"
+#include "Poco/Event.h"
+#include "Poco/Exception.h"
+#include <atomic>
+
+
+using Poco::WorkStealingPool;
+using Poco::TaskManager;
+using Poco::Task;
+using Poco::ActiveMethod;
+using Poco::ActiveResult;
+using Poco::WorkStealingStarter;
+using Poco::Runnable;
+using Poco::Event;
+
+
+namespace
+{
+	class CountingRunnable: public Runnable
+	{
+	public:
+		CountingRunnable(): _count(0)
+		{
+		}
+
+		void run()
+		{
+			++_count;
+		}
+
+		int count() const
+		{
+			return _count;
+		}
+
+	private:
+		std::atomic<int> _count;
+	};
+
+	class BlockingRunnable: public Runnable
+	{
+	public:
+		void run()
+		{
+			_started.set();
+			_event.wait();
+		}
+
+		void waitStarted()
+		{
+			_started.wait();
+		}
+
+		void release()
+		{
+			_event.set();
+		}
+
+	private:
+		Event _started;
+		Event _event;
+	};
+
+	void spawn(WorkStealingPool& pool, std::atomic<int>& count, int depth)
+	{
+		++count;
+		if (depth > 0)
+		{
+			pool.execute([&pool, &count, depth]() { spawn(pool, count, depth - 1); });
+			pool.execute([&pool, &count, depth]() { spawn(pool, count, depth - 1); });
+		}
+	}
+
+	class CountingTask: public Task
+	{
+	public:
+		CountingTask(const std::string& name, std::atomic<int>& count):
+			Task(name),
+			_count(count)
+		{
+		}
+
+		void runTask()
+		{
+			++_count;
+		}
+
+	private:
+		std::atomic<int>& _count;
+	};
+
+	class ActiveObject
+	{
+	public:
+		ActiveObject():
+			square(this, &ActiveObject::squareImpl)
+		{
+		}
+
+		ActiveMethod<int, int, ActiveObject, WorkStealingStarter<ActiveObject>> square;
+
+	protected:
+		int squareImpl(const int& n)
+		{
+			return n*n;
+		}
+	};
+}
+
+
+WorkStealingPoolTest::WorkStealingPoolTest(const std::string& rName): CppUnit::TestCase(rName)
+{
+}
+
+
+WorkStealingPoolTest::~WorkStealingPoolTest()
+{
+}
+
+
+void WorkStealingPoolTest::testStart()
+{
+	WorkStealingPool pool("test", 4);
+	assertTrue (pool.threads() == 4);
+	assertTrue (pool.queueCapacity() == 1024);
+	assertTrue (pool.name() == "test");
+	assertTrue (!pool.isWorker());
+
+	CountingRunnable runnable;
+	for (int i = 0; i < 1000; ++i)
+	{
+		pool.start(runnable);
+	}
+	pool.joinAll();
+	assertTrue (runnable.count() == 1000);
+	assertTrue (pool.executed() == 1000);
+}
+
+
+void WorkStealingPoolTest::testSubmit()
+{
+	WorkStealingPool pool(3);
+	std::vector<std::future<int>> results;
+	for (int i = 0; i < 100; ++i)
+	{
+		results.push_back(pool.submit([i]() { return i*i; }));
+	}
+	for (int i = 0; i < 100; ++i)
+	{
+		assertTrue (results[i].get() == i*i);
+	}
+
+	std::future<bool> isWorker = pool.submit([&pool]() { return pool.isWorker(); });
+	assertTrue (isWorker.get());
+}
+
+
+void WorkStealingPoolTest::testSubmitException()
+{
+	WorkStealingPool pool(2);
+	std::future<int> result = pool.submit([]() -> int { throw Poco::InvalidArgumentException("test"); });
+	try
+	{
+		result.get();
+		fail("must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+
+	std::future<void> ok = pool.submit([]() {});
+	ok.get();
+}
+
+
+void WorkStealingPoolTest::testNested()
+{
+	WorkStealingPool pool(4);
+	std::atomic<int> count(0);
+	pool.execute([&pool, &count]() { spawn(pool, count, 12); });
+	pool.joinAll();
+	assertTrue (count == (1 << 13) - 1);
+}
+
+
+void WorkStealingPoolTest::testQueueFull()
+{
+	WorkStealingPool pool(1, 4);
+	BlockingRunnable blocker;
+	pool.start(blocker);
+	blocker.waitStarted();
+
+	CountingRunnable runnable;
+	int accepted = 0;
+	try
+	{
+		for (int i = 0; i < 10; ++i)
+		{
+			pool.start(runnable);
+			++accepted;
+		}
+		fail("queue full - must throw");
+	}
+	catch (Poco::NoThreadAvailableException&)
+	{
+	}
+	assertTrue (accepted == 4);
+	blocker.release();
+	pool.joinAll();
+	assertTrue (runnable.count() == accepted);
+}
+
+
+void WorkStealingPoolTest::testStop()
+{
+	WorkStealingPool pool(2);
+	CountingRunnable runnable;
+	for (int i = 0; i < 100; ++i)
+	{
+		pool.start(runnable);
+	}
+	pool.stop();
+	assertTrue (runnable.count() == 100);
+
+	try
+	{
+		pool.start(runnable);
+		fail("stopped - must throw");
+	}
+	catch (Poco::IllegalStateException&)
+	{
+	}
+}
+
+
+void WorkStealingPoolTest::testTaskManager()
+{
+	WorkStealingPool pool(2);
+	TaskManager tm(pool);
+	std::atomic<int> count(0);
+	for (int i = 0; i < 10; ++i)
+	{
+		tm.start(new CountingTask("task", count));
+	}
+	tm.joinAll();
+	assertTrue (count == 10);
+}
+
+
+void WorkStealingPoolTest::testActiveMethod()
+{
+	ActiveObject activeObj;
+	ActiveResult<int> result = activeObj.square(7);
+	result.wait();
+	assertTrue (result.available());
+	assertTrue (result.data() == 49);
+}
+
+
+void WorkStealingPoolTest::setUp()
+{
+}
+
+
+void WorkStealingPoolTest::tearDown()
+{
+}
+
+
+CppUnit::Test* WorkStealingPoolTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("WorkStealingPoolTest");
+
+	CppUnit_addTest(pSuite, WorkStealingPoolTest, testStart);
+	CppUnit_addTest(pSuite, WorkStealingPoolTest, testSubmit);
+	CppUnit_addTest(pSuite, WorkStealingPoolTest, testSubmitException);
+	CppUnit_addTest(pSuite, WorkStealingPoolTest, testNested);
+	CppUnit_addTest(pSuite, WorkStealingPoolTest, testQueueFull);
+	CppUnit_addTest(pSuite, WorkStealingPoolTest, testStop);
+	CppUnit_addTest(pSuite, WorkStealingPoolTest, testTaskManager);
+	CppUnit_addTest(pSuite, WorkStealingPoolTest, testActiveMethod);
+
+	return pSuite;
+}
@@ -0,0 +1,43 @@
+//
+// WorkStealingPoolTest.h
+//
+// Definition of the WorkStealingPoolTest class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef WorkStealingPoolTest_INCLUDED
+#define WorkStealingPoolTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/CppUnit/TestCase.h"
+
+
+class WorkStealingPoolTest: public CppUnit::TestCase
+{
+public:
+	WorkStealingPoolTest(const std::string& name);
+	~WorkStealingPoolTest();
+
+	void testStart();
+	void testSubmit();
+	void testSubmitException();
+	void testNested();
+	void testQueueFull();
+	void testStop();
+	void testTaskManager();
+	void testActiveMethod();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+};
+
+
+#endif // WorkStealingPoolTest_INCLUDED
@@ -68,6 +68,18 @@ public:
 	Parser(const Handler::Ptr& pHandler = new ParseHandler, std::size_t bufSize = JSON_PARSE_BUFFER_SIZE);
 		/// Creates JSON Parser, using the given Handler and buffer size.
 
+	Parser(Poco::Arena* pArena, const Handler::Ptr& pHandler);
+		/// Creates JSON Parser, using the given Handler.
+		///
+		/// If pArena is not null, the parser allocates its internal
+		/// buffers from the given Arena instead of the heap: the token
+		/// buffer, the nesting stack and, when parsing from a stream,
+		/// the copy of the JSON document. This memory is released when
+		/// the Arena is reset, which must not happen while a parse()
+		/// is in progress. The Object and Array instances created by
+		/// a ParseHandler are reference counted and may outlive the
+		/// Arena, so they are always allocated from the heap.
+
 	virtual ~Parser();
 		/// Destroys JSON Parser.
 
@@ -110,6 +122,10 @@ public:
 	const Handler::Ptr& getHandler();
 		/// Returns the Handler.
 
+	Poco::Arena* getArena() const;
+		/// Returns the Arena used for the parser's internal
+		/// buffers, or null if they are allocated from the heap.
+
 	Dynamic::Var asVar() const;
 		/// Returns the result of parsing;
 
@@ -173,6 +189,12 @@ inline const Handler::Ptr& Parser::getHandler()
 }
 
 
+inline Poco::Arena* Parser::getArena() const
+{
+	return getArenaImpl();
+}
+
+
 inline Dynamic::Var Parser::result() const
 {
 	return resultImpl();
@@ -25,6 +25,7 @@
 #include "Poco/JSON/JSONException.h"
 #include "Poco/UTF8Encoding.h"
 #include "Poco/Dynamic/Var.h"
+#include "Poco/Arena.h"
 #include <string>
 
 
@@ -42,8 +43,11 @@ protected:
 	static const std::size_t JSON_PARSER_STACK_SIZE = 128;
 	static const int         JSON_UNLIMITED_DEPTH = -1;
 
-	ParserImpl(const Handler::Ptr& pHandler = new ParseHandler, std::size_t bufSize = JSON_PARSE_BUFFER_SIZE);
+	ParserImpl(const Handler::Ptr& pHandler = new ParseHandler, std::size_t bufSize = JSON_PARSE_BUFFER_SIZE, Poco::Arena* pArena = 0);
 		/// Creates JSON ParserImpl, using the given Handler and buffer size.
+		///
+		/// If pArena is not null, the parser's internal buffers
+		/// are allocated from the given Arena instead of the heap.
 
 	virtual ~ParserImpl();
 		/// Destroys JSON ParserImpl.
@@ -87,6 +91,10 @@ protected:
 	const Handler::Ptr& getHandlerImpl();
 		/// Returns the Handler.
 
+	Poco::Arena* getArenaImpl() const;
+		/// Returns the Arena used for the parser's internal
+		/// buffers, or null if they are allocated from the heap.
+
 	Dynamic::Var asVarImpl() const;
 		/// Returns the result of parsing;
 
@@ -101,11 +109,13 @@ private:
 	void handleObject();
 	void handle();
 	void handle(const std::string& json);
+	void handle(const char* json, std::size_t size);
 	void stripComments(std::string& json);
 	bool checkError();
 
 	json_stream*  _pJSON;
 	Handler::Ptr _pHandler;
+	Poco::Arena* _pArena;
 	int          _depth;
 	char         _decimalPoint;
 	bool         _allowNullByte;
@@ -174,6 +184,12 @@ inline const Handler::Ptr& ParserImpl::getHandlerImpl()
 }
 
 
+inline Poco::Arena* ParserImpl::getArenaImpl() const
+{
+	return _pArena;
+}
+
+
 inline Dynamic::Var ParserImpl::resultImpl() const
 {
 	return asVarImpl();
@@ -35,6 +35,12 @@ Parser::Parser(const Handler::Ptr& pHandler, std::size_t bufSize):
 }
 
 
+Parser::Parser(Poco::Arena* pArena, const Handler::Ptr& pHandler):
+	ParserImpl(pHandler, JSON_PARSE_BUFFER_SIZE, pArena)
+{
+}
+
+
 Parser::~Parser()
 {
 }
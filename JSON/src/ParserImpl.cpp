@@ -24,6 +24,8 @@
 #include <limits>
 #include <clocale>
 #include <istream>
+#include <algorithm>
+#include <cstring>
 #include "pdjson.h"
 
 
@@ -31,9 +33,98 @@ namespace Poco {
 namespace JSON {
 
 
-ParserImpl::ParserImpl(const Handler::Ptr& pHandler, std::size_t /*bufSize*/):
+namespace
+{
+	// pdjson's allocator callbacks have no context argument, so the
+	// Arena of the parse in progress is passed in a thread-local variable.
+	thread_local Poco::Arena* pCurrentArena = 0;
+
+	// Every block is preceded by its size, which arenaRealloc() needs
+	// to copy the contents of the old block.
+	const std::size_t ARENA_HEADER_SIZE = alignof(std::max_align_t);
+
+	void* arenaMalloc(std::size_t size)
+	{
+		try
+		{
+			char* p = static_cast<char*>(pCurrentArena->allocate(size + ARENA_HEADER_SIZE));
+			*reinterpret_cast<std::size_t*>(p) = size;
+			return p + ARENA_HEADER_SIZE;
+		}
+		catch (...)
+		{
+			// must not throw through the C parser; it reports the error
+			return 0;
+		}
+	}
+
+	void* arenaRealloc(void* ptr, std::size_t size)
+	{
+		void* pNew = arenaMalloc(size);
+		if (pNew && ptr)
+		{
+			std::size_t oldSize = *reinterpret_cast<std::size_t*>(static_cast<char*>(ptr) - ARENA_HEADER_SIZE);
+			std::memcpy(pNew, ptr, std::min(oldSize, size));
+		}
+		return pNew;
+	}
+
+	void arenaFree(void*)
+	{
+		// memory is released when the Arena is reset
+	}
+
+	json_allocator arenaAllocator = { arenaMalloc, arenaRealloc, arenaFree };
+
+	class ArenaScope
+		/// Makes the given Arena the current one for the pdjson
+		/// allocator callbacks, and restores the previous one
+		/// when destroyed.
+	{
+	public:
+		ArenaScope(Poco::Arena* pArena):
+			_pPrevArena(pCurrentArena)
+		{
+			pCurrentArena = pArena;
+		}
+
+		~ArenaScope()
+		{
+			pCurrentArena = _pPrevArena;
+		}
+
+	private:
+		Poco::Arena* _pPrevArena;
+	};
+
+	std::size_t readArena(std::istream& in, Poco::Arena& arena, char*& json)
+		/// Reads the entire stream into a buffer allocated
+		/// from the given Arena and returns its size.
+	{
+		std::size_t capacity = 4096;
+		std::size_t size = 0;
+		json = static_cast<char*>(arena.allocate(capacity, 1));
+		while (in.good())
+		{
+			if (size == capacity)
+			{
+				char* pNew = static_cast<char*>(arena.allocate(2*capacity, 1));
+				std::memcpy(pNew, json, size);
+				json = pNew;
+				capacity *= 2;
+			}
+			in.read(json + size, capacity - size);
+			size += static_cast<std::size_t>(in.gcount());
+		}
+		return size;
+	}
+}
+
+
+ParserImpl::ParserImpl(const Handler::Ptr& pHandler, std::size_t /*bufSize*/, Poco::Arena* pArena):
 	_pJSON(new json_stream),
 	_pHandler(pHandler),
+	_pArena(pArena),
 	_depth(JSON_UNLIMITED_DEPTH),
 	_decimalPoint('.'),
 	_allowNullByte(true),
@@ -50,12 +141,20 @@ ParserImpl::~ParserImpl()
 
 void ParserImpl::handle(const std::string& json)
 {
-	if (!_allowNullByte && json.find("\\u0000") != json.npos)
+	handle(json.data(), json.size());
+}
+
+
+void ParserImpl::handle(const char* json, std::size_t size)
+{
+	static const char NULL_BYTE[] = "\\u0000";
+	if (!_allowNullByte && std::search(json, json + size, NULL_BYTE, NULL_BYTE + sizeof(NULL_BYTE) - 1) != json + size)
 		throw JSONException("Null bytes in strings not allowed.");
 
+	ArenaScope arenaScope(_pArena);
 	try
 	{
-		json_open_buffer(_pJSON, json.data(), json.size());
+		json_open_buffer(_pJSON, json, size);
 		checkError();
 		//////////////////////////////////
 		// Underlying parser is capable of parsing multiple consecutive JSONs;
@@ -64,6 +163,8 @@ void ParserImpl::handle(const std::string& json)
 		// AFTER opening the buffer - otherwise it is overwritten by
 		// json_open*() call, which calls internal init()
 		json_set_streaming(_pJSON, false);
+		// same for the allocator
+		if (_pArena) json_set_allocator(_pJSON, &arenaAllocator);
 		/////////////////////////////////
 		handle(); checkError();
 		if (JSON_DONE != json_next(_pJSON))
@@ -94,6 +195,14 @@ Dynamic::Var ParserImpl::parseImpl(const std::string& json)
 
 Dynamic::Var ParserImpl::parseImpl(std::istream& in)
 {
+	if (_pArena && !_allowComments)
+	{
+		char* json = 0;
+		std::size_t size = readArena(in, *_pArena, json);
+		handle(json, size);
+		return asVarImpl();
+	}
+
 	std::ostringstream os;
 	StreamCopier::copyStream(in, os);
 	return parseImpl(os.str());
@@ -23,7 +23,9 @@
 #include "Poco/Dynamic/Struct.h"
 #include "Poco/DateTime.h"
 #include "Poco/DateTimeFormatter.h"
+#include "Poco/Arena.h"
 #include <set>
+#include <sstream>
 #include <iostream>
 
 
@@ -2168,6 +2170,54 @@ void JSONTest::testMove()
 }
 
 
+void JSONTest::testParseArena()
+{
+	// longer than pdjson's initial token buffer, so that it grows
+	std::string name(3000, 'x');
+	std::string json = "{ \"name\" : \"" + name + "\", \"children\" : [ [ [ \"Jonas\" ] ], \"Ellen\" ] }";
+
+	Poco::Arena arena;
+	Parser parser(&arena, new ParseHandler);
+	assertTrue (parser.getArena() == &arena);
+
+	for (int i = 0; i < 3; ++i)
+	{
+		assertTrue (arena.used() == 0);
+		std::istringstream istr(json);
+		Var result = i == 0 ? parser.parse(json) : parser.parse(istr);
+		assertTrue (arena.used() > name.size());
+
+		Object::Ptr object = result.extract<Object::Ptr>();
+		assertTrue (object->getValue<std::string>("name") == name);
+		Poco::JSON::Array::Ptr children = object->getArray("children");
+		assertTrue (children->size() == 2);
+		assertTrue (children->getArray(0)->getArray(0)->getElement<std::string>(0) == "Jonas");
+		assertTrue (children->getElement<std::string>(1) == "Ellen");
+
+		parser.reset();
+		arena.reset();
+
+		// the result does not depend on the Arena
+		assertTrue (object->getValue<std::string>("name") == name);
+	}
+
+	try
+	{
+		parser.parse("{ \"name\" : ");
+		fail ("must fail");
+	}
+	catch (JSONException&)
+	{
+	}
+	arena.reset();
+
+	Parser heapParser;
+	assertTrue (heapParser.getArena() == 0);
+	heapParser.parse(json);
+	assertTrue (arena.used() == 0);
+}
+
+
 CppUnit::Test* JSONTest::suite()
 {
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("JSONTest");
@@ -2218,6 +2268,7 @@ CppUnit::Test* JSONTest::suite()
 	CppUnit_addTest(pSuite, JSONTest, testEscapeUnicode);
 	CppUnit_addTest(pSuite, JSONTest, testCopy);
 	CppUnit_addTest(pSuite, JSONTest, testMove);
+	CppUnit_addTest(pSuite, JSONTest, testParseArena);
 
 	return pSuite;
 }
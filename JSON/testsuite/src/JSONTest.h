@@ -81,6 +81,7 @@ public:
 
 	void testCopy();
 	void testMove();
+	void testParseArena();
 
 	void setUp();
 	void tearDown();
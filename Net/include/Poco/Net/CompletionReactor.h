@@ -0,0 +1,243 @@
+//
+// CompletionReactor.h
+//
+// Library: Net
+// Package: Reactor
+// Module:  CompletionReactor
+//
+// Definition of the CompletionReactor class.
+//
+// Copyright (c) 2026, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Net_CompletionReactor_INCLUDED
+#define Net_CompletionReactor_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "Poco/Net/StreamSocket.h"
+#include "Poco/Net/ServerSocket.h"
+#include "Poco/Runnable.h"
+#include "Poco/Timespan.h"
+#include "Poco/Thread.h"
+#include <functional>
+#include <vector>
+#include <atomic>
+
+
+namespace Poco {
+namespace Net {
+
+
+class CompletionReactorImpl;
+
+
+class Net_API CompletionReactor: public Poco::Runnable
+	/// This class is a completion-based sibling of SocketReactor.
+	///
+	/// Where SocketReactor waits for sockets to become ready and
+	/// leaves the actual I/O to the event handlers, CompletionReactor
+	/// lets the caller submit the I/O operations themselves (accept,
+	/// receive and send), performs them asynchronously and invokes
+	/// a callback with the result of each operation once it has
+	/// completed.
+	///
+	/// On Linux, CompletionReactor is implemented using io_uring.
+	/// Operations submitted from within a callback (i.e., from the
+	/// thread running the reactor) are queued and passed to the
+	/// kernel in a single system call, together with waiting for the
+	/// next completions. A busy reactor therefore needs about one
+	/// system call per iteration, regardless of the number of
+	/// sockets and operations involved. Operations may also be
+	/// submitted from other threads; these are passed to the
+	/// kernel immediately.
+	///
+	/// Additionally, a set of fixed-size buffers can be registered
+	/// with the kernel with registerBuffers(), and used with
+	/// receiveFixed() and sendFixed(). This saves the kernel from
+	/// mapping the user memory for every single operation.
+	///
+	/// Every callback receives the result of the operation, which is
+	/// either the number of bytes transferred (zero, for a receive
+	/// operation, means that the peer has shut down the connection),
+	/// or a negative error code (the negated errno value).
+	/// Exceptions thrown by callbacks are passed to the ErrorHandler.
+	///
+	/// The buffers passed to receive() and send() must stay valid until
+	/// the respective callback has been invoked. The sockets are
+	/// kept alive by the reactor while an operation is in progress.
+	///
+	/// io_uring requires Linux 5.6 or newer. Support is enabled if
+	/// POCO_HAVE_IO_URING is defined when building the Net library
+	/// (the CMake and GNU make builds do this automatically if the kernel headers
+	/// are recent enough). Otherwise, or if the running kernel does not
+	/// support io_uring, the constructor throws a NotImplementedException.
+	/// Use isAvailable() to check in advance.
+	///
+	/// CompletionReactor is not a drop-in replacement for
+	/// SocketReactor; handlers must be written for the
+	/// completion model.
+{
+public:
+	typedef std::function<void(int)> Callback;
+		/// The callback for receive and send operations.
+		/// Receives the number of bytes transferred, or
+		/// a negative error code.
+
+	typedef std::function<void(const StreamSocket&, int)> AcceptCallback;
+		/// The callback for accept operations.
+		/// Receives the accepted socket and zero, or an
+		/// uninitialized socket and a negative error code.
+
+	enum
+	{
+		DEFAULT_QUEUE_DEPTH = 256
+	};
+
+	explicit CompletionReactor(int queueDepth = DEFAULT_QUEUE_DEPTH);
+		/// Creates the CompletionReactor, with a submission queue
+		/// holding up to queueDepth operations.
+		///
+		/// Throws a NotImplementedException if io_uring is not
+		/// supported.
+
+	CompletionReactor(int queueDepth, const Poco::Timespan& timeout);
+		/// Creates the CompletionReactor, using the given queue depth
+		/// and timeout.
+
+	virtual ~CompletionReactor();
+		/// Destroys the CompletionReactor.
+		///
+		/// Operations still in progress are cancelled, and the
+		/// destructor waits (for at most one second) until the kernel
+		/// has completed them. Their callbacks are not invoked.
+
+	static bool isAvailable();
+		/// Returns true if CompletionReactor is supported
+		/// on this system.
+
+	void run();
+		/// Runs the CompletionReactor. The reactor will run
+		/// until stop() is called (in a separate thread, or
+		/// from a callback).
+
+	void stop();
+		/// Stops the CompletionReactor.
+
+	void wakeUp();
+		/// Wakes up the reactor, if it is waiting for completions.
+
+	void setTimeout(const Poco::Timespan& timeout);
+		/// Sets the timeout.
+		///
+		/// If no operation completes for the given timeout
+		/// interval, onTimeout() is called.
+		///
+		/// The default timeout is 250 milliseconds.
+
+	const Poco::Timespan& getTimeout() const;
+		/// Returns the timeout.
+
+	void accept(const ServerSocket& socket, const AcceptCallback& callback);
+		/// Submits an operation accepting a connection on the
+		/// given listening socket.
+
+	void receive(const StreamSocket& socket, void* buffer, int length, const Callback& callback);
+		/// Submits an operation receiving up to length bytes
+		/// from the socket into the given buffer.
+
+	void send(const StreamSocket& socket, const void* buffer, int length, const Callback& callback);
+		/// Submits an operation sending length bytes from the
+		/// given buffer. As with StreamSocket::sendBytes(), fewer
+		/// bytes than requested may be sent.
+
+	void registerBuffers(int count, int size);
+		/// Allocates count buffers of the given size each, and
+		/// registers them with the kernel, for use with receiveFixed()
+		/// and sendFixed().
+		///
+		/// Can only be called once, before any fixed operation
+		/// has been submitted.
+
+	int bufferCount() const;
+		/// Returns the number of registered buffers.
+
+	int bufferSize() const;
+		/// Returns the size of each registered buffer.
+
+	char* buffer(int index) const;
+		/// Returns a pointer to the registered buffer
+		/// with the given index.
+
+	void receiveFixed(const StreamSocket& socket, int index, int length, const Callback& callback);
+		/// Submits an operation receiving up to length bytes from
+		/// the socket into the registered buffer with the given index.
+
+	void sendFixed(const StreamSocket& socket, int index, int length, const Callback& callback);
+		/// Submits an operation sending the first length bytes
+		/// of the registered buffer with the given index.
+
+protected:
+	virtual void onTimeout();
+		/// Called if the timeout expires and no operation has completed.
+		///
+		/// Can be overridden by subclasses. The default
+		/// implementation does nothing.
+
+	virtual void onBusy();
+		/// Called when the CompletionReactor is about to invoke
+		/// the callbacks of at least one completed operation.
+		///
+		/// Can be overridden by subclasses. The default
+		/// implementation does nothing.
+
+private:
+	struct Completion
+	{
+		Socket         socket;
+		Callback       callback;
+		AcceptCallback acceptCallback;
+		int            result;
+	};
+
+	typedef std::vector<Completion> CompletionList;
+
+	void dispatch(Completion& completion);
+	bool inReactorThread() const;
+
+	enum
+	{
+		DEFAULT_TIMEOUT = 250000
+	};
+
+	CompletionReactorImpl* _pImpl;
+	std::atomic<bool>      _stop;
+	Poco::Timespan         _timeout;
+	CompletionList         _completions;
+	std::atomic<bool>      _running;
+	Poco::Thread::TID      _tid;
+
+	CompletionReactor(const CompletionReactor&);
+	CompletionReactor& operator = (const CompletionReactor&);
+
+	friend class CompletionReactorImpl;
+};
+
+
+//
+// inlines
+//
+inline const Poco::Timespan& CompletionReactor::getTimeout() const
+{
+	return _timeout;
+}
+
+
+} } // namespace Poco::Net
+
+
+#endif // Net_CompletionReactor_INCLUDED
@@ -177,6 +177,23 @@ public:
 		///
 		/// Returns the number of bytes received.
 
+	int receiveBatch(DatagramBufVec& datagrams, int flags = 0);
+		/// Receives up to datagrams.size() datagrams with a
+		/// single system call, where supported (recvmmsg()
+		/// on Linux).
+		///
+		/// Returns the number of datagrams received, or a negative
+		/// value if the socket is non-blocking and no datagram
+		/// is available.
+		///
+		/// See SocketImpl::receiveBatch() for details.
+
+	int sendBatch(const DatagramBufVec& datagrams, int flags = 0);
+		/// Sends the given datagrams with as few system calls
+		/// as possible (sendmmsg() on Linux).
+		///
+		/// Returns the number of datagrams sent.
+
 	void setBroadcast(bool flag);
 		/// Sets the value of the SO_BROADCAST socket option.
 		///
@@ -23,6 +23,7 @@
 #include "Poco/Net/HTTPServerResponseImpl.h"
 #include "Poco/Net/SocketAddress.h"
 #include "Poco/AutoPtr.h"
+#include "Poco/Arena.h"
 #include <istream>
 
 
@@ -43,9 +44,16 @@ class Net_API HTTPServerRequestImpl: public HTTPServerRequest
 	/// handleRequest() method of HTTPRequestHandler.
 {
 public:
-	HTTPServerRequestImpl(HTTPServerResponseImpl& response, HTTPServerSession& session, HTTPServerParams* pParams);
+	HTTPServerRequestImpl(HTTPServerResponseImpl& response, HTTPServerSession& session, HTTPServerParams* pParams, Poco::Arena* pArena = 0);
 		/// Creates the HTTPServerRequestImpl, using the
 		/// given HTTPServerSession.
+		///
+		/// If pArena is not null, the stream object for reading
+		/// the request body is allocated from the given Arena
+		/// instead of the heap, and request handlers can obtain
+		/// the Arena with arena() to allocate their own
+		/// per-request data from it. The Arena must not be reset
+		/// before the HTTPServerRequestImpl has been destroyed.
 
 	~HTTPServerRequestImpl();
 		/// Destroys the HTTPServerRequestImpl.
@@ -84,12 +92,21 @@ public:
 		
 	HTTPServerSession& session();
 		/// Returns the underlying HTTPServerSession.
+
+	Poco::Arena* arena() const;
+		/// Returns the Arena given to the constructor,
+		/// or null if the request uses the heap.
 	
 private:
+	template <class S, typename... Args>
+	std::istream* createStream(Args&&... args);
+
+
 	HTTPServerResponseImpl&         _response;
 	HTTPServerSession&              _session;
 	std::istream*                   _pStream;
 	Poco::AutoPtr<HTTPServerParams> _pParams;
+	Poco::Arena*                    _pArena;
 	SocketAddress                   _clientAddress;
 	SocketAddress                   _serverAddress;
 };
@@ -136,6 +153,12 @@ inline HTTPServerSession& HTTPServerRequestImpl::session()
 }
 
 
+inline Poco::Arena* HTTPServerRequestImpl::arena() const
+{
+	return _pArena;
+}
+
+
 } } // namespace Poco::Net
 
 
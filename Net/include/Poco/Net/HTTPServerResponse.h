@@ -76,6 +76,25 @@ public:
 		/// cannot be found, or an OpenFileException if
 		/// the file cannot be opened.
 		
+	virtual void sendFile(const std::string& path, const std::string& mediaType, Poco::UInt64 offset, Poco::UInt64 length);
+		/// Sends the response header to the client, followed
+		/// by length bytes of the given file, starting at offset.
+		///
+		/// Sets the Content-Length and Content-Type headers;
+		/// the status and all other headers (e.g., Content-Range)
+		/// must be set by the caller.
+		///
+		/// The default implementation copies the requested part
+		/// of the file to the stream returned by send().
+		///
+		/// Must not be called after send(), sendBuffer()
+		/// or redirect() has been called.
+		///
+		/// Throws a FileNotFoundException if the file
+		/// cannot be found, an OpenFileException if
+		/// the file cannot be opened, or an InvalidArgumentException
+		/// if the range exceeds the size of the file.
+
 	virtual void sendBuffer(const void* pBuffer, std::size_t length) = 0;
 		/// Sends the response header to the client, followed
 		/// by the contents of the given buffer.
@@ -67,12 +67,40 @@ public:
 		/// Sends the response header to the client, followed
 		/// by the content of the given file.
 		///
+		/// If the status of the response is 200 OK and the request
+		/// has a Range header with a single byte range, only the
+		/// requested part of the file is sent, with status
+		/// 206 Partial Content and a Content-Range header, or a
+		/// 416 Requested Range Not Satisfiable response is sent if
+		/// the range lies beyond the end of the file. The range is
+		/// ignored if the request has an If-Range header that does
+		/// not match the Last-Modified date of the file.
+		///
+		/// On Linux, the file is sent with sendfile(), without
+		/// copying its content through user space.
+		///
 		/// Must not be called after send(), sendBuffer()
 		/// or redirect() has been called.
 		///
 		/// Throws a FileNotFoundException if the file
 		/// cannot be found, or an OpenFileException if
 		/// the file cannot be opened.
+
+	void sendFile(const std::string& path, const std::string& mediaType, Poco::UInt64 offset, Poco::UInt64 length);
+		/// Sends the response header to the client, followed
+		/// by length bytes of the given file, starting at offset.
+		///
+		/// Sets the Content-Length and Content-Type headers;
+		/// the status and all other headers (e.g., Content-Range)
+		/// must be set by the caller.
+		///
+		/// Must not be called after send(), sendBuffer()
+		/// or redirect() has been called.
+		///
+		/// Throws a FileNotFoundException if the file
+		/// cannot be found, an OpenFileException if
+		/// the file cannot be opened, or an InvalidArgumentException
+		/// if the range exceeds the size of the file.
 		
 	void sendBuffer(const void* pBuffer, std::size_t length);
 		/// Sends the response header to the client, followed
@@ -110,6 +138,16 @@ protected:
 	void attachRequest(HTTPServerRequestImpl* pRequest);
 	
 private:
+	enum RangeResult
+	{
+		RANGE_SATISFIABLE,
+		RANGE_NOT_SATISFIABLE,
+		RANGE_IGNORED
+	};
+
+	void sendFileRange(const std::string& path, const std::string& mediaType, Poco::UInt64 offset, Poco::UInt64 length);
+	static RangeResult parseRange(const std::string& range, Poco::UInt64 size, Poco::UInt64& offset, Poco::UInt64& length);
+
 	HTTPServerSession& _session;
 	HTTPServerRequestImpl* _pRequest;
 	std::ostream*      _pStream;
@@ -152,8 +152,11 @@ protected:
 	virtual int write(const char* buffer, std::streamsize length);
 		/// Writes data to the socket.
 
-	int receive(char* buffer, int length);
+	virtual int receive(char* buffer, int length);
 		/// Reads up to length bytes.
+		///
+		/// Can be overridden by subclasses that have
+		/// already read data from the socket themselves.
 		
 	int buffered() const;
 		/// Returns the number of bytes in the buffer.
@@ -47,7 +47,7 @@ public:
 	MultiSocketPoller(typename UDPHandlerImpl<S>::List& handlers, const UDPServerParams& serverParams):
 		_address(serverParams.address()),
 		_timeout(serverParams.timeout()),
-		_reader(handlers)
+		_reader(handlers, 0, serverParams.batchSize())
 		/// Creates the MutiSocketPoller.
 	{
 		poco_assert (_address.port() > 0 && _address.host().toString() != "0.0.0.0");
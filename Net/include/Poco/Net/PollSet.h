@@ -20,6 +20,7 @@
 
 #include "Poco/Net/Socket.h"
 #include <map>
+#include <vector>
 
 
 namespace Poco {
@@ -44,8 +45,47 @@ public:
 		POLL_ERROR = 0x04
 	};
 
+	enum Option
+		/// Registration options that can be OR'd into the mode
+		/// passed to add() and update().
+		///
+		/// The options are directly supported by the epoll
+		/// implementation only. The other implementations ignore
+		/// POLL_EDGE_TRIGGERED and POLL_EXCLUSIVE, and emulate
+		/// POLL_ONESHOT.
+	{
+		POLL_EDGE_TRIGGERED = 0x10,
+			/// Report a socket only when its state changes, rather than
+			/// for as long as the state persists (EPOLLET).
+			/// The caller must therefore read (or write) until the
+			/// operation would block before polling again.
+
+		POLL_ONESHOT = 0x20,
+			/// Report a socket at most once. It must be re-armed with
+			/// update() before it will be reported again (EPOLLONESHOT).
+
+		POLL_EXCLUSIVE = 0x40
+			/// If the socket is registered with several PollSets, wake up
+			/// only one (or a few) of the threads polling them, instead
+			/// of all of them (EPOLLEXCLUSIVE, Linux 4.5 or later).
+			/// Useful for a listening socket shared by several reactors.
+			/// Cannot be combined with POLL_ONESHOT.
+	};
+
 	typedef std::map<Poco::Net::Socket, int> SocketModeMap;
 
+	struct SocketEvent
+		/// A socket state change reported by
+		/// poll(SocketEventList&, const Poco::Timespan&).
+	{
+		poco_socket_t fd;
+			/// The native handle of the socket.
+		int mode;
+			/// An OR'd combination of POLL_READ, POLL_WRITE and POLL_ERROR.
+	};
+
+	typedef std::vector<SocketEvent> SocketEventList;
+
 	PollSet();
 		/// Creates an empty PollSet.
 
@@ -55,13 +95,15 @@ public:
 	void add(const Poco::Net::Socket& socket, int mode);
 		/// Adds the given socket to the set, for polling with
 		/// the given mode, which can be an OR'd combination of
-		/// POLL_READ, POLL_WRITE and POLL_ERROR.
+		/// POLL_READ, POLL_WRITE and POLL_ERROR, optionally
+		/// combined with any of the Option values.
 
 	void remove(const Poco::Net::Socket& socket);
 		/// Removes the given socket from the set.
 
 	void update(const Poco::Net::Socket& socket, int mode);
-		/// Updates the mode of the given socket.
+		/// Updates the mode (including options) of the given socket.
+		/// Also re-arms a socket added with POLL_ONESHOT.
 
 	bool has(const Socket& socket) const;
 		/// Returns true if socket is registered for polling.
@@ -78,6 +120,20 @@ public:
 		/// Returns a PollMap containing the sockets that have had
 		/// their state changed.
 
+	int poll(SocketEventList& events, const Poco::Timespan& timeout);
+		/// Waits until the state of at least one of the PollSet's sockets
+		/// changes accordingly to its mode, or the timeout expires.
+		/// Replaces the contents of events with the native handles of
+		/// the sockets that have had their state changed, together
+		/// with the modes that became ready, and returns the number
+		/// of entries stored.
+		///
+		/// The list is owned by the caller and is meant to be reused
+		/// across calls. Once it has grown to its working size, polling
+		/// does not allocate any memory. With epoll, the socket handle
+		/// is taken directly from the kernel event, so no lookup is
+		/// necessary either.
+
 private:
 	PollSetImpl* _pImpl;
 
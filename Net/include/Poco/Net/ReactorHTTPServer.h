@@ -0,0 +1,209 @@
+//
+// ReactorHTTPServer.h
+//
+// Library: Net
+// Package: HTTPServer
+// Module:  ReactorHTTPServer
+//
+// Definition of the ReactorHTTPServer class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Net_ReactorHTTPServer_INCLUDED
+#define Net_ReactorHTTPServer_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "Poco/Net/ServerSocket.h"
+#include "Poco/Net/SocketReactor.h"
+#include "Poco/Net/SocketNotification.h"
+#include "Poco/Net/HTTPRequestHandlerFactory.h"
+#include "Poco/Net/HTTPServerParams.h"
+#include "Poco/NotificationQueue.h"
+#include "Poco/ThreadPool.h"
+#include "Poco/Thread.h"
+#include "Poco/Event.h"
+#include "Poco/Runnable.h"
+#include "Poco/AutoPtr.h"
+#include "Poco/Mutex.h"
+#include <vector>
+#include <set>
+#include <atomic>
+
+
+namespace Poco {
+namespace Net {
+
+
+class Net_API ReactorHTTPServer: public Poco::Runnable
+	/// An HTTP server that keeps its connections in SocketReactors
+	/// while they are idle, instead of in threads.
+	///
+	/// HTTPServer serves every connection with a thread of its own
+	/// for as long as the connection is kept alive, so the number of
+	/// clients with persistent connections is limited by the number
+	/// of threads. ReactorHTTPServer instead reads requests with
+	/// non-blocking I/O in a small number of reactor threads, and only
+	/// passes a connection on to a worker thread when a complete request
+	/// header (and, if its Content-Length is small enough, the complete
+	/// request body) has been received. The worker thread then creates
+	/// the HTTPRequestHandler for the request, and hands the connection
+	/// back to its reactor after the response has been sent. An idle
+	/// connection therefore only costs the memory of its socket and
+	/// its receive buffer.
+	///
+	/// Worker threads are taken from a ThreadPool as needed, up to
+	/// HTTPServerParams::getMaxThreads() (or the capacity of the thread
+	/// pool, if zero), and returned after being idle for
+	/// HTTPServerParams::getThreadIdleTime(). Requests waiting for a
+	/// worker are queued; if HTTPServerParams::getMaxQueued() requests
+	/// are already waiting, a 503 Service Unavailable response
+	/// is sent and the connection is closed.
+	///
+	/// Request headers larger than 64 KB are answered with
+	/// 400 Bad Request. Request bodies that are not fully received
+	/// by the reactor (chunked, or larger than 64 KB together with
+	/// the header) are read by the request handler as usual.
+	///
+	/// Idle connections are closed after the timeout (for the
+	/// first request) or keep-alive timeout (for subsequent
+	/// requests) given in the HTTPServerParams. Every reactor
+	/// checks its connections for expired timeouts at least once
+	/// per reactor timeout (250 milliseconds), even if other
+	/// connections keep it busy.
+	///
+	/// Request handlers that take over the socket with
+	/// HTTPServerRequest::detachSocket() are supported;
+	/// the connection is not handed back to the reactor.
+{
+public:
+	ReactorHTTPServer(HTTPRequestHandlerFactory::Ptr pFactory, const ServerSocket& socket, HTTPServerParams::Ptr pParams, int reactors = 1);
+		/// Creates the ReactorHTTPServer, using the given ServerSocket,
+		/// which must be bound and in listening state, and the given
+		/// number of reactor threads.
+		///
+		/// The server takes ownership of the HTTPRequestHandlerFactory
+		/// and the HTTPServerParams.
+		///
+		/// Worker threads are taken from the default thread pool.
+
+	ReactorHTTPServer(HTTPRequestHandlerFactory::Ptr pFactory, Poco::ThreadPool& threadPool, const ServerSocket& socket, HTTPServerParams::Ptr pParams, int reactors = 1);
+		/// Creates the ReactorHTTPServer, taking worker threads
+		/// from the given thread pool.
+
+	~ReactorHTTPServer();
+		/// Stops and destroys the ReactorHTTPServer.
+
+	void start();
+		/// Starts the reactor threads.
+
+	void stop();
+		/// Stops the server.
+		///
+		/// No new connections are accepted, idle connections and
+		/// connections with queued requests are closed. Waits until
+		/// all requests currently handled have been completed.
+		///
+		/// Once the server has been stopped, it cannot be restarted.
+
+	const HTTPServerParams& params() const;
+		/// Returns the HTTPServerParams used by the server.
+
+	const ServerSocket& socket() const;
+		/// Returns the listening socket.
+
+	Poco::UInt16 port() const;
+		/// Returns the port the server socket listens on.
+
+	int totalConnections() const;
+		/// Returns the total number of accepted connections.
+
+	int currentConnections() const;
+		/// Returns the number of currently open connections,
+		/// idle or not.
+
+	int totalRequests() const;
+		/// Returns the total number of handled requests.
+
+	int queuedRequests() const;
+		/// Returns the number of requests waiting for a worker thread.
+
+	int refusedRequests() const;
+		/// Returns the number of requests refused because
+		/// the request queue was full.
+
+protected:
+	void run();
+		/// Runs a worker thread.
+
+private:
+	class Connection;
+	class Reactor;
+
+	typedef Poco::AutoPtr<Connection> ConnectionPtr;
+	typedef std::set<ConnectionPtr> ConnectionSet;
+
+	enum
+	{
+		MAX_REQUEST_SIZE = 65536
+	};
+
+	void init(int reactors);
+	void onAccept(ReadableNotification* pNotification);
+	void enqueue(Connection* pConnection);
+	void remove(Connection* pConnection);
+
+	ReactorHTTPServer();
+	ReactorHTTPServer(const ReactorHTTPServer&);
+	ReactorHTTPServer& operator = (const ReactorHTTPServer&);
+
+	HTTPRequestHandlerFactory::Ptr _pFactory;
+	HTTPServerParams::Ptr _pParams;
+	Poco::ThreadPool& _threadPool;
+	ServerSocket _socket;
+	std::vector<SocketReactor*> _reactors;
+	std::vector<Poco::Thread*> _threads;
+	std::size_t _next;
+	Poco::NotificationQueue _queue;
+	ConnectionSet _connections;
+	mutable Poco::FastMutex _mutex;
+	std::atomic<bool> _stopped;
+	std::atomic<int> _workers;
+	Poco::Event _workersDone;
+	std::atomic<int> _totalConnections;
+	std::atomic<int> _totalRequests;
+	std::atomic<int> _refusedRequests;
+	bool _started;
+};
+
+
+//
+// inlines
+//
+inline const HTTPServerParams& ReactorHTTPServer::params() const
+{
+	return *_pParams;
+}
+
+
+inline const ServerSocket& ReactorHTTPServer::socket() const
+{
+	return _socket;
+}
+
+
+inline Poco::UInt16 ReactorHTTPServer::port() const
+{
+	return _socket.address().port();
+}
+
+
+} } // namespace Poco::Net
+
+
+#endif // Net_ReactorHTTPServer_INCLUDED
@@ -0,0 +1,208 @@
+//
+// ShardedTCPServer.h
+//
+// Library: Net
+// Package: TCPServer
+// Module:  ShardedTCPServer
+//
+// Definition of the ShardedTCPServer class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Net_ShardedTCPServer_INCLUDED
+#define Net_ShardedTCPServer_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "Poco/Net/TCPServer.h"
+#include "Poco/Net/ServerSocket.h"
+#include "Poco/Net/SocketAddress.h"
+#include "Poco/Net/TCPServerConnectionFactory.h"
+#include "Poco/Net/TCPServerDispatcher.h"
+#include "Poco/Net/TCPServerParams.h"
+#include "Poco/Runnable.h"
+#include "Poco/Thread.h"
+#include "Poco/ThreadPool.h"
+#include <vector>
+#include <atomic>
+
+
+namespace Poco {
+namespace Net {
+
+
+class Net_API ShardedTCPServer
+	/// This class implements a TCP server that splits accepting
+	/// and serving connections across a number of shards.
+	///
+	/// Every shard has its own listening socket, bound to the same
+	/// address with the SO_REUSEPORT option set, its own accepting
+	/// thread, and its own TCPServerDispatcher and thread pool.
+	/// The kernel distributes incoming connections among the listening
+	/// sockets, and the thread of a shard accepts the connections
+	/// on its socket and hands them over to the shard's dispatcher,
+	/// which serves them in the shard's thread pool, as TCPServer does.
+	///
+	/// Unlike with TCPServer, accepting threads and connection queues
+	/// are not shared, so shards do not contend with each other.
+	/// Connections queued on a busy shard are not taken over by
+	/// other shards, though. ShardedTCPServer is therefore best
+	/// suited to large numbers of short-lived connections, with about
+	/// as many shards as there are CPU cores.
+	///
+	/// On platforms that do not support SO_REUSEPORT, the server
+	/// always has a single shard.
+{
+public:
+	struct Statistics
+		/// Connection statistics of a single shard.
+	{
+		int totalConnections;
+			/// The total number of connections served.
+
+		int currentConnections;
+			/// The number of connections currently being served.
+
+		int queuedConnections;
+			/// The number of connections waiting to be served.
+
+		int refusedConnections;
+			/// The number of connections rejected by the connection
+			/// filter, or because the connection queue was full.
+	};
+
+	ShardedTCPServer(TCPServerConnectionFactory::Ptr pFactory, const SocketAddress& address, int shards = 0, int backlog = 64, TCPServerParams::Ptr pParams = 0);
+		/// Creates the ShardedTCPServer with the given number of shards,
+		/// each listening on the given address.
+		///
+		/// If shards is zero, one shard for every CPU core is created.
+		/// Without SO_REUSEPORT support, a single shard is created.
+		/// If the port of the address is zero, the port chosen for the
+		/// first shard is used for all other shards.
+		///
+		/// The TCPServerParams, which are shared by all shards, control
+		/// the dispatcher of each shard. The thread pool of a shard
+		/// has up to TCPServerParams::getMaxThreads() threads (16
+		/// if no TCPServerParams are given, or the value is zero).
+		///
+		/// The server takes ownership of the TCPServerConnectionFactory
+		/// and the TCPServerParams object.
+
+	~ShardedTCPServer();
+		/// Stops and destroys the ShardedTCPServer.
+
+	void start();
+		/// Starts the threads of all shards.
+
+	void stop();
+		/// Stops the server.
+		///
+		/// No new connections will be accepted, and queued connections
+		/// are closed. Waits until all connections currently served
+		/// have been closed.
+		///
+		/// Once the server has been stopped, it cannot be restarted.
+
+	void setAffinity(bool flag);
+		/// If flag is true, the accepting thread of shard n is bound to
+		/// CPU n (modulo the number of CPUs) when the server is started.
+		///
+		/// Must be called before start().
+
+	int shards() const;
+		/// Returns the number of shards.
+
+	const ServerSocket& socket(int shard) const;
+		/// Returns the listening socket of the given shard.
+
+	Poco::UInt16 port() const;
+		/// Returns the port the server sockets listen on.
+
+	Statistics statistics(int shard) const;
+		/// Returns the connection statistics of the given shard.
+
+	int totalConnections() const;
+		/// Returns the total number of connections served by all shards.
+
+	int currentConnections() const;
+		/// Returns the number of connections currently served by all shards.
+
+	int queuedConnections() const;
+		/// Returns the number of connections queued by all shards.
+
+	int refusedConnections() const;
+		/// Returns the number of connections refused by all shards.
+
+	void setConnectionFilter(const TCPServerConnectionFilter::Ptr& pFilter);
+		/// Sets a TCPServerConnectionFilter, which is shared
+		/// by all shards and thus must be thread-safe.
+		///
+		/// The filter must be set before the server is started.
+
+	TCPServerConnectionFilter::Ptr getConnectionFilter() const;
+		/// Returns the TCPServerConnectionFilter set with setConnectionFilter(),
+		/// or null pointer if no filter has been set.
+
+private:
+	class Shard: public Poco::Runnable
+	{
+	public:
+		Shard(ShardedTCPServer& server, const ServerSocket& socket, const std::string& name, int maxThreads, TCPServerParams::Ptr pParams);
+		~Shard();
+		void run();
+
+		ShardedTCPServer&    server;
+		ServerSocket         socket;
+		Poco::Thread         thread;
+		Poco::ThreadPool     threadPool;
+		TCPServerDispatcher* pDispatcher;
+		std::atomic<int>     refusedConnections;
+	};
+
+	typedef std::vector<Shard*> ShardList;
+
+	void run(Shard& shard);
+
+	ShardedTCPServer();
+	ShardedTCPServer(const ShardedTCPServer&);
+	ShardedTCPServer& operator = (const ShardedTCPServer&);
+
+	TCPServerConnectionFactory::Ptr _pFactory;
+	TCPServerConnectionFilter::Ptr _pConnectionFilter;
+	ShardList _shards;
+	bool _affinity;
+	std::atomic<bool> _stopped;
+	bool _started;
+};
+
+
+//
+// inlines
+//
+inline int ShardedTCPServer::shards() const
+{
+	return static_cast<int>(_shards.size());
+}
+
+
+inline Poco::UInt16 ShardedTCPServer::port() const
+{
+	return _shards[0]->socket.address().port();
+}
+
+
+inline TCPServerConnectionFilter::Ptr ShardedTCPServer::getConnectionFilter() const
+{
+	return _pConnectionFilter;
+}
+
+
+} } // namespace Poco::Net
+
+
+#endif // Net_ShardedTCPServer_INCLUDED
@@ -364,6 +364,32 @@ namespace Net {
 
 typedef std::vector<SocketBuf> SocketBufVec;
 
+struct DatagramBuf
+	/// Describes a single datagram for SocketImpl::receiveBatch()
+	/// and SocketImpl::sendBatch().
+{
+	void* buffer;
+		/// The datagram payload.
+
+	int length;
+		/// The size of buffer (receiveBatch()), or the length of
+		/// the payload (sendBatch()). Set to the length of the
+		/// received datagram by receiveBatch().
+
+	struct sockaddr* pAddress;
+		/// Storage for the native address of the sender (receiveBatch()),
+		/// or the native address of the destination (sendBatch()).
+		/// May be null if the address is not needed, or the socket
+		/// is connected.
+
+	poco_socklen_t addressLength;
+		/// The size of the address storage (receiveBatch()), or the
+		/// length of the address (sendBatch()). Set to the length
+		/// of the sender's address by receiveBatch().
+};
+
+typedef std::vector<DatagramBuf> DatagramBufVec;
+
 struct AddressFamily
 	/// AddressFamily::Family replaces the previously used IPAddress::Family
 	/// enumeration and is now used for IPAddress::Family and SocketAddress::Family.
@@ -27,6 +27,11 @@
 
 
 namespace Poco {
+
+
+class FileInputStream;
+
+
 namespace Net {
 
 
@@ -175,6 +180,26 @@ public:
 		///
 		/// Always returns zero for platforms where not implemented.
 
+	virtual Poco::UInt64 sendFile(FileInputStream& fileInputStream, Poco::UInt64 offset, Poco::UInt64 count);
+		/// Sends count bytes of the given file, starting at
+		/// the given offset, through the socket.
+		///
+		/// On Linux, the file is sent with sendfile(), directly
+		/// from the page cache to the socket, without copying it
+		/// into user space. On other platforms, and for secure
+		/// sockets, the file is read into a buffer and sent
+		/// with sendBytes().
+		///
+		/// The position of the stream is not used, and is unspecified
+		/// after the call.
+		///
+		/// For a blocking socket, returns after all bytes have been
+		/// sent, or the end of the file has been reached. For a
+		/// non-blocking socket, returns as soon as the socket
+		/// cannot accept more data.
+		///
+		/// Returns the number of bytes sent.
+
 	virtual int receiveBytes(void* buffer, int length, int flags = 0);
 		/// Receives data from the socket and stores it
 		/// in buffer. Up to length bytes are received.
@@ -248,6 +273,27 @@ public:
 		///
 		/// Returns the number of bytes received.
 
+	virtual int receiveBatch(DatagramBufVec& datagrams, int flags = 0);
+		/// Receives up to datagrams.size() datagrams with a single
+		/// system call (recvmmsg() on Linux), storing each datagram
+		/// and the address of its sender in the next DatagramBuf.
+		///
+		/// Blocks (for a blocking socket) until at least one datagram
+		/// is available, and then receives all datagrams available,
+		/// up to datagrams.size() (but no more than 64 at a time).
+		///
+		/// Returns the number of datagrams received, or a negative value
+		/// if the socket is non-blocking and no datagram is available.
+		///
+		/// On platforms without recvmmsg(), a single datagram is received.
+
+	virtual int sendBatch(const DatagramBufVec& datagrams, int flags = 0);
+		/// Sends the given datagrams, using as few system calls as
+		/// possible (sendmmsg() on Linux).
+		///
+		/// Returns the number of datagrams sent, which, for a
+		/// non-blocking socket, may be less than datagrams.size().
+
 	virtual void sendUrgent(unsigned char data);
 		/// Sends one byte of urgent data through
 		/// the socket.
@@ -513,6 +559,13 @@ protected:
 		/// Throws an appropriate exception for the given error code.
 
 private:
+	enum
+	{
+		SENDFILE_CHUNK_SIZE = 0x7ffff000, /// maximum number of bytes sent by a single sendfile() call
+		COPY_BUFFER_SIZE    = 65536,      /// size of the buffer used if the file cannot be sent with sendfile()
+		MAX_BATCH_SIZE      = 64          /// maximum number of datagrams received or sent by a single recvmmsg()/sendmmsg() call
+	};
+
 	SocketImpl(const SocketImpl&);
 	SocketImpl& operator = (const SocketImpl&);
 
@@ -525,6 +578,7 @@ private:
 	friend class Socket;
 	friend class SecureSocketImpl;
 	friend class PollSetImpl;
+	friend class CompletionReactorImpl;
 };
 
 
@@ -64,6 +64,13 @@ public:
 	std::size_t countObservers() const;
 		/// Returns the number of subscribers;
 
+	const Socket& socket() const;
+		/// Returns the socket.
+
+	poco_socket_t descriptor() const;
+		/// Returns the native handle the socket had when
+		/// the SocketNotifier was created.
+
 protected:
 	~SocketNotifier();
 		/// Destroys the SocketNotifier.
@@ -76,6 +83,7 @@ private:
 	EventSet                 _events;
 	Poco::NotificationCenter _nc;
 	Socket                   _socket;
+	poco_socket_t            _fd;
 	MutexType                _mutex;
 };
 
@@ -108,6 +116,18 @@ inline std::size_t SocketNotifier::countObservers() const
 }
 
 
+inline const Socket& SocketNotifier::socket() const
+{
+	return _socket;
+}
+
+
+inline poco_socket_t SocketNotifier::descriptor() const
+{
+	return _fd;
+}
+
+
 } } // namespace Poco::Net
 
 
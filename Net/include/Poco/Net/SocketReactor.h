@@ -26,6 +26,8 @@
 #include "Poco/Observer.h"
 #include "Poco/AutoPtr.h"
 #include <map>
+#include <vector>
+#include <atomic>
 
 
 namespace Poco {
@@ -111,6 +113,13 @@ class Net_API SocketReactor: public Poco::Runnable
 	/// from another thread while the SocketReactor is running. Also,
 	/// it is safe to call addEventHandler() and removeEventHandler()
 	/// from event handlers.
+	///
+	/// When dispatching events, the SocketReactor looks up the
+	/// event handlers in a table indexed by socket descriptor,
+	/// without acquiring a lock. Changes to the table are made
+	/// under a lock, and notifiers removed from it are only
+	/// released once the reactor thread has finished the
+	/// current iteration of its event loop.
 {
 public:
 	SocketReactor();
@@ -149,6 +158,30 @@ public:
 	const Poco::Timespan& getTimeout() const;
 		/// Returns the timeout.
 
+	void setPollOptions(int options);
+		/// Sets the PollSet::Option values that are OR'd into the
+		/// mode of every socket the reactor registers with its PollSet.
+		/// Only affects sockets registered afterwards, so this should
+		/// be called before the first event handler is added.
+		///
+		/// With PollSet::POLL_EDGE_TRIGGERED, a socket is reported only
+		/// when new data arrives. After dispatching a ReadableNotification,
+		/// the reactor therefore keeps dispatching it for as long as the
+		/// socket remains readable, i.e. until reading would block.
+		/// To keep other sockets from starving, a socket is drained at
+		/// most 32 times per wake-up; if data is still left
+		/// after that, the socket is revisited in the next iteration
+		/// without waiting.
+		///
+		/// PollSet::POLL_EXCLUSIVE should be used for a listening socket
+		/// that is shared by several reactors, so that an incoming
+		/// connection wakes up only one of them.
+		///
+		/// PollSet::POLL_ONESHOT is not supported.
+
+	int getPollOptions() const;
+		/// Returns the PollSet::Option values used when registering sockets.
+
 	void addEventHandler(const Socket& socket, const Poco::AbstractObserver& observer);
 		/// Registers an event handler with the SocketReactor.
 		///
@@ -204,21 +237,48 @@ protected:
 		
 	void dispatch(SocketNotification* pNotification);
 		/// Dispatches the given notification to all observers.
+		///
+		/// Must only be called from the thread running the
+		/// reactor, e.g. from onTimeout() or onIdle().
 
 private:
 	typedef Poco::AutoPtr<SocketNotifier>     NotifierPtr;
 	typedef Poco::AutoPtr<SocketNotification> NotificationPtr;
-	typedef std::map<Socket, NotifierPtr>     EventHandlerMap;
-	typedef Poco::FastMutex                   MutexType;
-	typedef MutexType::ScopedLock             ScopedLock;
+	typedef std::map<Socket, NotifierPtr>        EventHandlerMap;
+	typedef PollSet::SocketEventList             SocketEventList;
+	typedef Poco::FastMutex                      MutexType;
+	typedef MutexType::ScopedLock                ScopedLock;
+
+	struct NotifierTable
+		/// The notifiers of all registered sockets,
+		/// indexed by socket descriptor.
+	{
+		explicit NotifierTable(std::size_t size);
+		~NotifierTable();
+
+		std::size_t                   size;
+		std::atomic<SocketNotifier*>* slots;
+	};
+
+	typedef std::vector<SocketNotifier*> NotifierList;
+	typedef std::vector<NotifierTable*>  NotifierTableList;
 
 	bool hasSocketHandlers();
-	void dispatch(NotifierPtr& pNotifier, SocketNotification* pNotification);
+	void dispatch(poco_socket_t fd, SocketNotification* pNotification);
+	void dispatchReadable(poco_socket_t fd);
+	void drain(SocketNotifier* pNotifier, poco_socket_t fd);
+	void dispatch(SocketNotifier* pNotifier, SocketNotification* pNotification);
 	NotifierPtr getNotifier(const Socket& socket, bool makeNew = false);
+	SocketNotifier* getNotifier(poco_socket_t fd) const;
+	void publish(SocketNotifier* pNotifier);
+	void unpublish(SocketNotifier* pNotifier);
+	void reclaim();
 
 	enum
 	{
-		DEFAULT_TIMEOUT = 250000
+		DEFAULT_TIMEOUT    = 250000,
+		DRAIN_LIMIT        = 32,
+		INITIAL_TABLE_SIZE = 64
 	};
 
 #ifdef POCO_ENABLE_CPP11
@@ -228,7 +288,15 @@ private:
 #endif
 	Poco::Timespan    _timeout;
 	EventHandlerMap   _handlers;
+	std::atomic<NotifierTable*> _pTable;
+	NotifierList      _retiredNotifiers;
+	NotifierTableList _retiredTables;
+	std::atomic<bool> _retired;
 	PollSet           _pollSet;
+	SocketEventList   _events;
+	SocketEventList   _pending;
+	SocketEventList   _deferred;
+	int               _pollOptions;
 	NotificationPtr   _pReadableNotification;
 	NotificationPtr   _pWritableNotification;
 	NotificationPtr   _pErrorNotification;
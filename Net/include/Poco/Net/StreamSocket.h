@@ -137,6 +137,18 @@ public:
 		/// Returns the number of bytes sent, which may be
 		/// less than the number of bytes specified.
 
+	Poco::UInt64 sendFile(FileInputStream& fileInputStream, Poco::UInt64 offset, Poco::UInt64 count);
+		/// Sends count bytes of the given file, starting at the
+		/// given offset, through the socket.
+		///
+		/// Where supported (currently on Linux), the file is sent
+		/// with sendfile(), without copying its content into user
+		/// space. See SocketImpl::sendFile() for details.
+		///
+		/// Returns the number of bytes sent, which, for a blocking
+		/// socket, is only less than count if the end of the file
+		/// has been reached.
+
 	int sendBytes(Poco::FIFOBuffer& buffer);
 		/// Sends the contents of the given buffer through
 		/// the socket. FIFOBuffer has writable/readable transition
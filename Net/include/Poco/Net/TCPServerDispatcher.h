@@ -24,8 +24,11 @@
 #include "Poco/Net/TCPServerParams.h"
 #include "Poco/Runnable.h"
 #include "Poco/NotificationQueue.h"
+#include "Poco/BoundedNotificationQueue.h"
 #include "Poco/ThreadPool.h"
+#include "Poco/WorkStealingPool.h"
 #include "Poco/Mutex.h"
+#include <memory>
 
 
 namespace Poco {
@@ -44,6 +47,18 @@ public:
 		/// If no TCPServerParams object is supplied, the TCPServerDispatcher
 		/// creates one.
 
+	TCPServerDispatcher(TCPServerConnectionFactory::Ptr pFactory, Poco::WorkStealingPool& pool, TCPServerParams::Ptr pParams);
+		/// Creates the TCPServerDispatcher, which handles connections
+		/// in tasks executed by the given WorkStealingPool.
+		///
+		/// Each task handles queued connections until the queue is
+		/// empty. At most TCPServerParams::getMaxThreads() tasks
+		/// (by default, the number of workers) are active at a time.
+		///
+		/// The dispatcher takes ownership of the TCPServerParams object.
+		/// If no TCPServerParams object is supplied, the TCPServerDispatcher
+		/// creates one.
+
 	void duplicate();
 		/// Increments the object's reference count.
 
@@ -100,6 +115,12 @@ private:
 	TCPServerDispatcher(const TCPServerDispatcher&);
 	TCPServerDispatcher& operator = (const TCPServerDispatcher&);
 
+	void handleConnection(Notification* pNf);
+	void dispatch();
+	void enqueueBounded(const StreamSocket& socket);
+	void startThread();
+	bool queueEmpty() const;
+
 	class ThreadCountWatcher
 	{
 	public:
@@ -110,7 +131,7 @@ private:
 		~ThreadCountWatcher()
 		{
 			FastMutex::ScopedLock lock(_pDisp->_mutex);
-			if (_pDisp->_currentThreads > 1 && _pDisp->_queue.empty())
+			if (_pDisp->_currentThreads > 1 && _pDisp->queueEmpty())
 			{
 				--_pDisp->_currentThreads;
 			}
@@ -133,8 +154,10 @@ private:
 	std::atomic<int>  _refusedConnections;
 	std::atomic<bool> _stopped;
 	Poco::NotificationQueue         _queue;
+	std::unique_ptr<Poco::BoundedNotificationQueue> _pBoundedQueue;
 	TCPServerConnectionFactory::Ptr _pConnectionFactory;
-	Poco::ThreadPool&               _threadPool;
+	Poco::ThreadPool*               _pThreadPool;
+	Poco::WorkStealingPool*         _pWorkStealingPool;
 	mutable Poco::FastMutex         _mutex;
 };
 
@@ -45,6 +45,7 @@ public:
 		///   - threadIdleTime:       10 seconds
 		///   - maxThreads:           0
 		///   - maxQueued:            64
+		///   - lockFreeQueue:        false
 
 	void setThreadIdleTime(const Poco::Timespan& idleTime);
 		/// Sets the maximum idle time for a thread before
@@ -92,6 +93,20 @@ public:
 		/// Returns the priority of TCP server threads
 		/// created by TCPServer.
 
+	void setLockFreeQueue(bool flag);
+		/// If flag is true, the TCPServerDispatcher queues connections
+		/// in a lock-free BoundedNotificationQueue with a capacity of
+		/// maxQueued connections, instead of a NotificationQueue.
+		/// This reduces contention between the thread accepting
+		/// connections and the connection threads.
+		///
+		/// Only applies to servers using a ThreadPool.
+		/// Must be set before the server is created.
+
+	bool getLockFreeQueue() const;
+		/// Returns true if the TCPServerDispatcher uses a
+		/// lock-free queue.
+
 protected:
 	virtual ~TCPServerParams();
 		/// Destroys the TCPServerParams.
@@ -101,6 +116,7 @@ private:
 	int _maxThreads;
 	int _maxQueued;
 	Poco::Thread::Priority _threadPriority;
+	bool _lockFreeQueue;
 };
 
 
@@ -131,6 +147,12 @@ inline Poco::Thread::Priority TCPServerParams::getThreadPriority() const
 }
 
 
+inline bool TCPServerParams::getLockFreeQueue() const
+{
+	return _lockFreeQueue;
+}
+
+
 } } // namespace Poco::Net
 
 
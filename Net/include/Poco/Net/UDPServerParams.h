@@ -36,7 +36,8 @@ public:
 		Poco::Timespan timeout = 250000,
 		std::size_t handlerBufListSize = 1000,
 		bool notifySender = false,
-		int  backlogThreshold = 10);
+		int  backlogThreshold = 10,
+		int  batchSize = 1);
 		/// Creates UDPServerParams.
 
 	~UDPServerParams();
@@ -64,6 +65,15 @@ public:
 		/// reports backlogs back to the client. Only meaningful
 		/// if notifySender() is true.
 
+	int batchSize() const;
+		/// Returns the maximum number of datagrams read
+		/// from a socket each time it becomes readable.
+		///
+		/// If greater than one, the datagrams are read with
+		/// a single system call (where supported, see
+		/// DatagramSocket::receiveBatch()) directly into
+		/// the buffers of a single handler.
+
 private:
 	UDPServerParams();
 
@@ -73,6 +83,7 @@ private:
 	std::size_t              _handlerBufListSize;
 	bool                     _notifySender;
 	int                      _backlogThreshold;
+	int                      _batchSize;
 };
 
 
@@ -116,6 +127,12 @@ inline int UDPServerParams::backlogThreshold() const
 }
 
 
+inline int UDPServerParams::batchSize() const
+{
+	return _batchSize;
+}
+
+
 } } // namespace Poco::Net
 
 
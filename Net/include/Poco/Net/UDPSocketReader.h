@@ -20,6 +20,7 @@
 
 #include "Poco/Net/Net.h"
 #include "Poco/Net/DatagramSocket.h"
+#include <vector>
 
 
 namespace Poco {
@@ -35,24 +36,32 @@ class UDPSocketReader
 	/// handler for handling (if any configured).
 	/// Depending on settings, data senders may be notified of the handler's
 	/// data and error backlogs.
+	///
+	/// If the batch size is greater than one, up to that many datagrams
+	/// are read with a single call to DatagramSocket::receiveBatch(),
+	/// directly into the buffers of the next handler.
 {
 public:
-	UDPSocketReader(typename UDPHandlerImpl<S>::List& handlers, int backlogThreshold = 0):
+	UDPSocketReader(typename UDPHandlerImpl<S>::List& handlers, int backlogThreshold = 0, int batchSize = 1):
 		_handlers(handlers),
 		_handler(_handlers.begin()),
-		_backlogThreshold(backlogThreshold)
+		_backlogThreshold(backlogThreshold),
+		_batchSize(batchSize)
 		/// Creates the UDPSocketReader.
 	{
 		poco_assert(_handler != _handlers.end());
+		poco_assert(_batchSize > 0);
 	}
 
 	UDPSocketReader(typename UDPHandlerImpl<S>::List& handlers, const UDPServerParams& serverParams):
 		_handlers(handlers),
 		_handler(_handlers.begin()),
-		_backlogThreshold(serverParams.backlogThreshold())
+		_backlogThreshold(serverParams.backlogThreshold()),
+		_batchSize(serverParams.batchSize())
 		/// Creates the UDPSocketReader.
 	{
 		poco_assert(_handler != _handlers.end());
+		poco_assert(_batchSize > 0);
 	}
 
 	~UDPSocketReader()
@@ -66,6 +75,12 @@ public:
 		/// for replying to sender and data or error backlog threshold is
 		/// exceeded, sender is notified of the current backlog size.
 	{
+		if (_batchSize > 1)
+		{
+			readBatch(sock);
+			return;
+		}
+
 		typedef typename UDPHandlerImpl<S>::MsgSizeT RT;
 		char* p = 0;
 		struct sockaddr* pSA = 0;
@@ -153,6 +168,61 @@ public:
 	}
 
 private:
+	void readBatch(DatagramSocket& sock)
+		/// Reads up to _batchSize datagrams with a single system call
+		/// into buffers obtained from the next handler. Buffers left
+		/// unused are returned to the handler.
+	{
+		typedef typename UDPHandlerImpl<S>::MsgSizeT RT;
+		poco_socket_t sockfd = sock.impl()->sockfd();
+		Poco::UInt16 off = UDPHandlerImpl<S>::offset();
+		nextHandler();
+		_batch.clear();
+		_datagrams.clear();
+		for (int i = 0; i < _batchSize; ++i)
+		{
+			char* p = handler().next(sockfd);
+			if (!p) break;
+			DatagramBuf datagram;
+			datagram.buffer        = p + off;
+			datagram.length        = static_cast<int>(S - off - 1);
+			datagram.pAddress      = reinterpret_cast<struct sockaddr*>(p + sizeof(RT) + sizeof(poco_socklen_t));
+			datagram.addressLength = SocketAddress::MAX_ADDRESS_LENGTH;
+			_batch.push_back(p);
+			_datagrams.push_back(datagram);
+		}
+		if (_batch.empty()) return;
+
+		std::size_t used = 0;
+		try
+		{
+			int n = sock.receiveBatch(_datagrams);
+			for (int i = 0; i < n; ++i, ++used)
+			{
+				char* p = _batch[i];
+				poco_socklen_t* pAL = reinterpret_cast<poco_socklen_t*>(p + sizeof(RT));
+				*pAL = _datagrams[i].addressLength;
+				RT ret = _datagrams[i].length;
+				Poco::Int32 data = handler().setData(p, ret);
+				p[off + ret] = 0; // for ascii convenience, zero-terminate
+				if (_backlogThreshold > 0 && data > _backlogThreshold && data != _dataBacklog[sockfd])
+				{
+					sock.sendTo(&data, sizeof(Poco::Int32), SocketAddress(_datagrams[i].pAddress, *pAL));
+					_dataBacklog[sockfd] = data;
+				}
+			}
+		}
+		catch (Poco::Exception& exc)
+		{
+			if (used < _batch.size()) setError(sockfd, _batch[used++], exc.displayText());
+		}
+		for (std::size_t i = used; i < _batch.size(); ++i)
+		{
+			handler().setIdle(_batch[i]);
+		}
+		handler().notify();
+	}
+
 	void nextHandler()
 		/// Re-points the handler iterator to the next handler in
 		/// round-robin fashion.
@@ -172,12 +242,16 @@ private:
 	typedef typename UDPHandlerImpl<S>::List::iterator HandlerIterator;
 	typedef std::map<poco_socket_t, Poco::Int32>       CounterMap;
 	typedef std::map<SocketAddress, Poco::Int32>       MsgCounterMap;
+	typedef std::vector<char*>                         BufferVec;
 
 	HandlerList&    _handlers;
 	HandlerIterator _handler;
 	CounterMap      _dataBacklog;
 	CounterMap      _errorBacklog;
 	int             _backlogThreshold;
+	int             _batchSize;
+	BufferVec       _batch;
+	DatagramBufVec  _datagrams;
 };
 
 
@@ -0,0 +1,292 @@
+//
+// ReactorBenchmark.cpp
+//
+// This sample compares level-triggered and edge-triggered SocketReactor
+// operation, and a listening socket shared by several reactors with and
+// without PollSet::POLL_EXCLUSIVE.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Net/SocketReactor.h"
+#include "Poco/Net/SocketNotification.h"
+#include "Poco/Net/StreamSocket.h"
+#include "Poco/Net/ServerSocket.h"
+#include "Poco/Net/SocketAddress.h"
+#include "Poco/Net/PollSet.h"
+#include "Poco/Observer.h"
+#include "Poco/Thread.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/NumberParser.h"
+#include "Poco/Exception.h"
+#include <iostream>
+#include <vector>
+#include <atomic>
+#if defined(POCO_OS_FAMILY_UNIX)
+#include <sys/resource.h>
+#endif
+
+
+using Poco::Net::SocketReactor;
+using Poco::Net::ReadableNotification;
+using Poco::Net::StreamSocket;
+using Poco::Net::ServerSocket;
+using Poco::Net::SocketAddress;
+using Poco::Net::PollSet;
+using Poco::Observer;
+using Poco::Thread;
+using Poco::Stopwatch;
+using Poco::NumberParser;
+
+
+namespace
+{
+	std::atomic<Poco::UInt64> bytesReceived(0);
+	std::atomic<Poco::UInt64> notifications(0);
+	std::atomic<int> connectionsAccepted(0);
+
+	double cpuSeconds()
+		/// Returns the CPU time (user and system) used by the process so far.
+	{
+#if defined(POCO_OS_FAMILY_UNIX)
+		struct rusage usage;
+		getrusage(RUSAGE_SELF, &usage);
+		return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec)/1000000.0;
+#else
+		return 0;
+#endif
+	}
+}
+
+
+class CountingReactor: public SocketReactor
+	/// A SocketReactor that counts its wake-ups.
+{
+public:
+	CountingReactor():
+		_wakeUps(0)
+	{
+	}
+
+	Poco::UInt64 wakeUps() const
+	{
+		return _wakeUps;
+	}
+
+protected:
+	void onBusy()
+	{
+		++_wakeUps;
+	}
+
+private:
+	std::atomic<Poco::UInt64> _wakeUps;
+};
+
+
+class SinkHandler
+	/// Reads and discards everything received on the socket,
+	/// in small pieces.
+{
+public:
+	SinkHandler(const StreamSocket& socket, SocketReactor& reactor):
+		_socket(socket),
+		_reactor(reactor)
+	{
+		_reactor.addEventHandler(_socket, Observer<SinkHandler, ReadableNotification>(*this, &SinkHandler::onReadable));
+	}
+
+	void onReadable(ReadableNotification* pNf)
+	{
+		pNf->release();
+		++notifications;
+		char buffer[1024];
+		int n = _socket.receiveBytes(buffer, sizeof(buffer));
+		if (n > 0)
+		{
+			bytesReceived += n;
+		}
+		else
+		{
+			_reactor.removeEventHandler(_socket, Observer<SinkHandler, ReadableNotification>(*this, &SinkHandler::onReadable));
+			delete this;
+		}
+	}
+
+private:
+	StreamSocket   _socket;
+	SocketReactor& _reactor;
+};
+
+
+class SharedAcceptor
+	/// Accepts connections on a non-blocking listening socket
+	/// that is shared by several reactors.
+{
+public:
+	SharedAcceptor(ServerSocket& socket, SocketReactor& reactor):
+		_socket(socket),
+		_reactor(reactor)
+	{
+		_reactor.addEventHandler(_socket, Observer<SharedAcceptor, ReadableNotification>(*this, &SharedAcceptor::onReadable));
+	}
+
+	~SharedAcceptor()
+	{
+		_reactor.removeEventHandler(_socket, Observer<SharedAcceptor, ReadableNotification>(*this, &SharedAcceptor::onReadable));
+	}
+
+	void onReadable(ReadableNotification* pNf)
+	{
+		pNf->release();
+		++notifications;
+		try
+		{
+			StreamSocket ss = _socket.acceptConnection();
+			++connectionsAccepted;
+		}
+		catch (Poco::Exception&)
+		{
+			// another reactor got the connection
+		}
+	}
+
+private:
+	ServerSocket   _socket;
+	SocketReactor& _reactor;
+};
+
+
+void report(const std::string& label, Poco::UInt64 wakeUps, double cpu, const Stopwatch& sw)
+{
+	std::cout << label
+		<< ": " << wakeUps << " wake-ups, "
+		<< notifications << " notifications, "
+		<< cpu << " s CPU, "
+		<< sw.elapsed()/1000 << " ms elapsed"
+		<< std::endl;
+}
+
+
+void benchmarkThroughput(const std::string& label, int options, int connections, int chunks, int chunkSize)
+{
+	bytesReceived = 0;
+	notifications = 0;
+
+	ServerSocket server(SocketAddress("127.0.0.1", 0));
+	CountingReactor reactor;
+	reactor.setPollOptions(options);
+	Thread thread;
+	thread.start(reactor);
+
+	std::vector<StreamSocket> clients;
+	for (int i = 0; i < connections; ++i)
+	{
+		StreamSocket client(SocketAddress("127.0.0.1", server.address().port()));
+		clients.push_back(client);
+		new SinkHandler(server.acceptConnection(), reactor);
+	}
+
+	double cpu = cpuSeconds();
+	Stopwatch sw;
+	sw.start();
+	std::vector<char> chunk(chunkSize, 'x');
+	for (int i = 0; i < chunks; ++i)
+	{
+		for (std::vector<StreamSocket>::iterator it = clients.begin(); it != clients.end(); ++it)
+		{
+			it->sendBytes(&chunk[0], chunkSize);
+		}
+	}
+	Poco::UInt64 total = Poco::UInt64(connections)*chunks*chunkSize;
+	while (bytesReceived < total) Thread::yield();
+	sw.stop();
+	cpu = cpuSeconds() - cpu;
+
+	for (std::vector<StreamSocket>::iterator it = clients.begin(); it != clients.end(); ++it)
+	{
+		it->close();
+	}
+	reactor.stop();
+	reactor.wakeUp();
+	thread.join();
+
+	report(label, reactor.wakeUps(), cpu, sw);
+}
+
+
+void benchmarkAccept(const std::string& label, int options, int reactors, int connections)
+{
+	connectionsAccepted = 0;
+	notifications = 0;
+
+	ServerSocket server(SocketAddress("127.0.0.1", 0));
+	server.setBlocking(false);
+	std::vector<CountingReactor*> reactorList;
+	std::vector<SharedAcceptor*> acceptorList;
+	std::vector<Thread*> threadList;
+	for (int i = 0; i < reactors; ++i)
+	{
+		CountingReactor* pReactor = new CountingReactor;
+		pReactor->setPollOptions(options);
+		reactorList.push_back(pReactor);
+		acceptorList.push_back(new SharedAcceptor(server, *pReactor));
+		threadList.push_back(new Thread);
+		threadList.back()->start(*pReactor);
+	}
+
+	double cpu = cpuSeconds();
+	Stopwatch sw;
+	sw.start();
+	for (int i = 0; i < connections; ++i)
+	{
+		StreamSocket client(SocketAddress("127.0.0.1", server.address().port()));
+		while (connectionsAccepted <= i) Thread::yield();
+	}
+	sw.stop();
+	cpu = cpuSeconds() - cpu;
+
+	Poco::UInt64 wakeUps = 0;
+	for (int i = 0; i < reactors; ++i)
+	{
+		reactorList[i]->stop();
+		reactorList[i]->wakeUp();
+		threadList[i]->join();
+		wakeUps += reactorList[i]->wakeUps();
+		delete acceptorList[i];
+		delete threadList[i];
+		delete reactorList[i];
+	}
+
+	report(label, wakeUps, cpu, sw);
+}
+
+
+int main(int argc, char** argv)
+{
+	int connections = argc > 1 ? NumberParser::parse(argv[1]) : 64;
+	int chunks      = argc > 2 ? NumberParser::parse(argv[2]) : 2000;
+	int chunkSize   = argc > 3 ? NumberParser::parse(argv[3]) : 4096;
+	int reactors    = argc > 4 ? NumberParser::parse(argv[4]) : 4;
+
+	try
+	{
+		std::cout << connections << " connections, " << chunks << " chunks of " << chunkSize << " bytes each" << std::endl;
+		benchmarkThroughput("level-triggered", 0, connections, chunks, chunkSize);
+		benchmarkThroughput("edge-triggered ", PollSet::POLL_EDGE_TRIGGERED, connections, chunks, chunkSize);
+
+		std::cout << std::endl << reactors << " reactors sharing a listening socket, " << connections*10 << " connections" << std::endl;
+		benchmarkAccept("shared         ", 0, reactors, connections*10);
+		benchmarkAccept("exclusive      ", PollSet::POLL_EXCLUSIVE, reactors, connections*10);
+	}
+	catch (Poco::Exception& exc)
+	{
+		std::cerr << exc.displayText() << std::endl;
+		return 1;
+	}
+	return 0;
+}
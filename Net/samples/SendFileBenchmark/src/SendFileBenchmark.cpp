@@ -0,0 +1,219 @@
+//
+// SendFileBenchmark.cpp
+//
+// This sample compares HTTPServerResponse::sendFile(), which sends
+// the file directly from the file descriptor to the socket with
+// sendfile() where available, with copying the file to the stream
+// returned by HTTPServerResponse::send().
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Net/HTTPServer.h"
+#include "Poco/Net/HTTPServerParams.h"
+#include "Poco/Net/HTTPRequestHandler.h"
+#include "Poco/Net/HTTPRequestHandlerFactory.h"
+#include "Poco/Net/HTTPServerRequest.h"
+#include "Poco/Net/HTTPServerResponse.h"
+#include "Poco/Net/ServerSocket.h"
+#include "Poco/Net/StreamSocket.h"
+#include "Poco/Net/SocketAddress.h"
+#include "Poco/TemporaryFile.h"
+#include "Poco/FileStream.h"
+#include "Poco/StreamCopier.h"
+#include "Poco/Buffer.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/NumberParser.h"
+#include "Poco/Exception.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#if defined(POCO_OS_FAMILY_UNIX)
+#include <sys/resource.h>
+#endif
+
+
+using Poco::Net::HTTPServer;
+using Poco::Net::HTTPServerParams;
+using Poco::Net::HTTPRequestHandler;
+using Poco::Net::HTTPRequestHandlerFactory;
+using Poco::Net::HTTPServerRequest;
+using Poco::Net::HTTPServerResponse;
+using Poco::Net::ServerSocket;
+using Poco::Net::StreamSocket;
+using Poco::Net::SocketAddress;
+using Poco::TemporaryFile;
+using Poco::FileInputStream;
+using Poco::FileOutputStream;
+using Poco::StreamCopier;
+using Poco::Stopwatch;
+using Poco::NumberParser;
+
+
+namespace
+{
+	double cpuSeconds()
+		/// Returns the CPU time (user and system) used by the process so far.
+	{
+#if defined(POCO_OS_FAMILY_UNIX)
+		struct rusage usage;
+		getrusage(RUSAGE_SELF, &usage);
+		return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec)/1000000.0;
+#else
+		return 0;
+#endif
+	}
+}
+
+
+class SendFileRequestHandler: public HTTPRequestHandler
+	/// Sends the file with HTTPServerResponse::sendFile().
+{
+public:
+	SendFileRequestHandler(const std::string& path):
+		_path(path)
+	{
+	}
+
+	void handleRequest(HTTPServerRequest& request, HTTPServerResponse& response)
+	{
+		response.sendFile(_path, "application/octet-stream");
+	}
+
+private:
+	std::string _path;
+};
+
+
+class StreamRequestHandler: public HTTPRequestHandler
+	/// Copies the file to the response stream.
+{
+public:
+	StreamRequestHandler(const std::string& path):
+		_path(path)
+	{
+	}
+
+	void handleRequest(HTTPServerRequest& request, HTTPServerResponse& response)
+	{
+		FileInputStream istr(_path);
+		istr.seekg(0, std::ios::end);
+		response.setContentLength64(istr.tellg());
+		istr.seekg(0, std::ios::beg);
+		response.setContentType("application/octet-stream");
+		StreamCopier::copyStream(istr, response.send());
+	}
+
+private:
+	std::string _path;
+};
+
+
+class RequestHandlerFactory: public HTTPRequestHandlerFactory
+{
+public:
+	RequestHandlerFactory(const std::string& path):
+		_path(path)
+	{
+	}
+
+	HTTPRequestHandler* createRequestHandler(const HTTPServerRequest& request)
+	{
+		if (request.getURI() == "/sendfile")
+			return new SendFileRequestHandler(_path);
+		else
+			return new StreamRequestHandler(_path);
+	}
+
+private:
+	std::string _path;
+};
+
+
+void benchmark(const std::string& name, const std::string& uri, const SocketAddress& address, int requests, int fileSize)
+	/// Requests the file repeatedly over a persistent connection.
+	/// The response is read with a plain StreamSocket into a large
+	/// buffer, to keep the cost of the client low.
+{
+	StreamSocket socket(address);
+	std::string request("GET " + uri + " HTTP/1.1\r\nHost: localhost\r\n\r\n");
+	Poco::Buffer<char> buffer(256*1024);
+
+	double cpu = cpuSeconds();
+	Stopwatch sw;
+	sw.start();
+	for (int i = 0; i < requests; ++i)
+	{
+		socket.sendBytes(request.data(), static_cast<int>(request.size()));
+		std::string header;
+		std::string::size_type headerEnd = std::string::npos;
+		Poco::Int64 body = 0;
+		while (headerEnd == std::string::npos)
+		{
+			int n = socket.receiveBytes(buffer.begin(), 4096);
+			if (n <= 0) throw Poco::IOException("Connection closed", uri);
+			header.append(buffer.begin(), n);
+			headerEnd = header.find("\r\n\r\n");
+			if (headerEnd != std::string::npos) body = header.size() - headerEnd - 4;
+		}
+		while (body < fileSize)
+		{
+			int n = socket.receiveBytes(buffer.begin(), static_cast<int>(buffer.size()));
+			if (n <= 0) throw Poco::IOException("Connection closed", uri);
+			body += n;
+		}
+	}
+	sw.stop();
+	cpu = cpuSeconds() - cpu;
+
+	double seconds = sw.elapsed()/1000000.0;
+	double mb = static_cast<double>(fileSize)*requests/(1024*1024);
+	std::cout << name << ": "
+		<< std::fixed << std::setprecision(0) << mb/seconds << " MB/s, "
+		<< std::setprecision(2) << seconds << " s elapsed, "
+		<< cpu << " s CPU (client and server)" << std::endl;
+}
+
+
+int main(int argc, char** argv)
+{
+	int fileSize = argc > 1 ? NumberParser::parse(argv[1]) : 16*1024*1024;
+	int requests = argc > 2 ? NumberParser::parse(argv[2]) : 50;
+
+	try
+	{
+		TemporaryFile tf;
+		{
+			FileOutputStream ostr(tf.path());
+			std::string block(65536, 'x');
+			for (int n = 0; n < fileSize; n += static_cast<int>(block.size()))
+			{
+				ostr.write(block.data(), std::min<int>(static_cast<int>(block.size()), fileSize - n));
+			}
+		}
+
+		ServerSocket svs(0);
+		HTTPServerParams::Ptr pParams = new HTTPServerParams;
+		pParams->setKeepAlive(true);
+		pParams->setMaxKeepAliveRequests(0);
+		HTTPServer srv(new RequestHandlerFactory(tf.path()), svs, pParams);
+		srv.start();
+
+		std::cout << requests << " requests for a file of " << fileSize << " bytes" << std::endl;
+		SocketAddress address("127.0.0.1", svs.address().port());
+		benchmark("stream  ", "/stream", address, requests, fileSize);
+		benchmark("sendfile", "/sendfile", address, requests, fileSize);
+
+		srv.stop();
+	}
+	catch (Poco::Exception& exc)
+	{
+		std::cerr << exc.displayText() << std::endl;
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,769 @@
+//
+// CompletionReactor.cpp
+//
+// Library: Net
+// Package: Reactor
+// Module:  CompletionReactor
+//
+// Copyright (c) 2026, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Net/CompletionReactor.h"
+#include "Poco/Net/SocketImpl.h"
+#include "Poco/Net/StreamSocketImpl.h"
+#include "Poco/Net/NetException.h"
+#include "Poco/ErrorHandler.h"
+#include "Poco/Exception.h"
+#include "Poco/Mutex.h"
+
+
+#if defined(POCO_HAVE_IO_URING)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+
+using Poco::Exception;
+using Poco::ErrorHandler;
+
+
+namespace Poco {
+namespace Net {
+
+
+namespace
+{
+	enum TransferType
+	{
+		TRANSFER_RECEIVE,
+		TRANSFER_SEND,
+		TRANSFER_RECEIVE_FIXED,
+		TRANSFER_SEND_FIXED
+	};
+}
+
+
+#if defined(POCO_HAVE_IO_URING)
+
+
+//
+// Linux implementation using io_uring
+//
+class CompletionReactorImpl
+{
+public:
+	typedef CompletionReactor::Callback       Callback;
+	typedef CompletionReactor::AcceptCallback AcceptCallback;
+	typedef CompletionReactor::Completion     Completion;
+	typedef CompletionReactor::CompletionList CompletionList;
+
+	CompletionReactorImpl(int queueDepth):
+		_ringfd(-1),
+		_pSQRing(0),
+		_sqRingSize(0),
+		_pCQRing(0),
+		_cqRingSize(0),
+		_pSQEs(0),
+		_sqesSize(0),
+		_timeoutArmed(false),
+		_completedSinceArm(false),
+		_bufferCount(0),
+		_bufferSize(0)
+	{
+		poco_assert (queueDepth > 0);
+
+		struct io_uring_params params;
+		std::memset(&params, 0, sizeof(params));
+		_ringfd = static_cast<int>(syscall(__NR_io_uring_setup, queueDepth, &params));
+		if (_ringfd < 0)
+		{
+			if (errno == ENOSYS) throw Poco::NotImplementedException("io_uring is not supported by the kernel");
+			SocketImpl::error();
+		}
+
+		_sqRingSize = params.sq_off.array + params.sq_entries*sizeof(unsigned);
+		_cqRingSize = params.cq_off.cqes + params.cq_entries*sizeof(struct io_uring_cqe);
+		if (params.features & IORING_FEAT_SINGLE_MMAP)
+		{
+			if (_cqRingSize > _sqRingSize) _sqRingSize = _cqRingSize;
+		}
+		_pSQRing = map(_sqRingSize, IORING_OFF_SQ_RING);
+		if (params.features & IORING_FEAT_SINGLE_MMAP)
+		{
+			_pCQRing = _pSQRing;
+		}
+		else
+		{
+			_pCQRing = map(_cqRingSize, IORING_OFF_CQ_RING);
+		}
+		_sqesSize = params.sq_entries*sizeof(struct io_uring_sqe);
+		_pSQEs = static_cast<struct io_uring_sqe*>(map(_sqesSize, IORING_OFF_SQES));
+
+		char* pSQ = static_cast<char*>(_pSQRing);
+		_pSQHead    = reinterpret_cast<unsigned*>(pSQ + params.sq_off.head);
+		_pSQTail    = reinterpret_cast<unsigned*>(pSQ + params.sq_off.tail);
+		_sqMask     = *reinterpret_cast<unsigned*>(pSQ + params.sq_off.ring_mask);
+		_sqEntries  = *reinterpret_cast<unsigned*>(pSQ + params.sq_off.ring_entries);
+		_pSQArray   = reinterpret_cast<unsigned*>(pSQ + params.sq_off.array);
+
+		char* pCQ = static_cast<char*>(_pCQRing);
+		_pCQHead    = reinterpret_cast<unsigned*>(pCQ + params.cq_off.head);
+		_pCQTail    = reinterpret_cast<unsigned*>(pCQ + params.cq_off.tail);
+		_cqMask     = *reinterpret_cast<unsigned*>(pCQ + params.cq_off.ring_mask);
+		_pCQEs      = reinterpret_cast<struct io_uring_cqe*>(pCQ + params.cq_off.cqes);
+	}
+
+	~CompletionReactorImpl()
+	{
+		try
+		{
+			cancelAll();
+		}
+		catch (...)
+		{
+			poco_unexpected();
+		}
+		if (_pSQEs) ::munmap(_pSQEs, _sqesSize);
+		if (_pCQRing && _pCQRing != _pSQRing) ::munmap(_pCQRing, _cqRingSize);
+		if (_pSQRing) ::munmap(_pSQRing, _sqRingSize);
+		if (_ringfd >= 0) ::close(_ringfd);
+	}
+
+	static bool isAvailable()
+	{
+		struct io_uring_params params;
+		std::memset(&params, 0, sizeof(params));
+		int fd = static_cast<int>(syscall(__NR_io_uring_setup, 1, &params));
+		if (fd < 0) return false;
+		::close(fd);
+		return true;
+	}
+
+	void accept(const ServerSocket& socket, const AcceptCallback& callback, bool flush)
+	{
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+
+			struct io_uring_sqe* pSQE = nextSQE();
+			pSQE->opcode = IORING_OP_ACCEPT;
+			pSQE->fd = socket.impl()->sockfd();
+			pSQE->user_data = addOperation(socket, Callback(), callback);
+			commitSQE();
+		}
+		if (flush) submit();
+	}
+
+	void transfer(TransferType type, const StreamSocket& socket, const void* buffer, int length, int index, const Callback& callback, bool flush)
+	{
+		poco_assert (length >= 0);
+
+		Poco::UInt8 opcode = IORING_OP_RECV;
+		switch (type)
+		{
+		case TRANSFER_RECEIVE:       opcode = IORING_OP_RECV; break;
+		case TRANSFER_SEND:          opcode = IORING_OP_SEND; break;
+		case TRANSFER_RECEIVE_FIXED: opcode = IORING_OP_READ_FIXED; break;
+		case TRANSFER_SEND_FIXED:    opcode = IORING_OP_WRITE_FIXED; break;
+		}
+
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+
+			struct io_uring_sqe* pSQE = nextSQE();
+			pSQE->opcode = opcode;
+			pSQE->fd = socket.impl()->sockfd();
+			pSQE->addr = reinterpret_cast<Poco::UInt64>(buffer);
+			pSQE->len = static_cast<Poco::UInt32>(length);
+			if (opcode == IORING_OP_SEND)
+				pSQE->msg_flags = MSG_NOSIGNAL;
+			if (index >= 0)
+				pSQE->buf_index = static_cast<Poco::UInt16>(index);
+			pSQE->user_data = addOperation(socket, callback, AcceptCallback());
+			commitSQE();
+		}
+		if (flush) submit();
+	}
+
+	void wakeUp()
+	{
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+
+			struct io_uring_sqe* pSQE = nextSQE();
+			pSQE->opcode = IORING_OP_NOP;
+			pSQE->user_data = WAKEUP_TAG;
+			commitSQE();
+		}
+		submit();
+	}
+
+	int wait(const Poco::Timespan& timeout, CompletionList& completions, bool& timedOut)
+	{
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+
+			if (!_timeoutArmed)
+			{
+				_timeout.tv_sec  = timeout.totalSeconds();
+				_timeout.tv_nsec = static_cast<long long>(timeout.useconds())*1000;
+				struct io_uring_sqe* pSQE = nextSQE();
+				pSQE->opcode = IORING_OP_TIMEOUT;
+				pSQE->addr = reinterpret_cast<Poco::UInt64>(&_timeout);
+				pSQE->len = 1;
+				pSQE->user_data = TIMEOUT_TAG;
+				commitSQE();
+				_timeoutArmed = true;
+				_completedSinceArm = false;
+			}
+		}
+
+		// Submit everything queued so far and wait for
+		// the next completion with a single system call.
+		int rc;
+		do
+		{
+			rc = enter(pending(), 1, IORING_ENTER_GETEVENTS);
+		}
+		while (rc < 0 && errno == EINTR);
+		if (rc < 0 && errno != EBUSY && errno != EAGAIN) SocketImpl::error();
+
+		return reap(completions, timedOut);
+	}
+
+	void registerBuffers(int count, int size)
+	{
+		poco_assert (count > 0 && size > 0);
+
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		if (_bufferCount > 0) throw Poco::InvalidAccessException("buffers already registered");
+
+		_buffers.resize(static_cast<std::size_t>(count)*size);
+		std::vector<struct iovec> iovecs(count);
+		for (int i = 0; i < count; ++i)
+		{
+			iovecs[i].iov_base = &_buffers[static_cast<std::size_t>(i)*size];
+			iovecs[i].iov_len  = size;
+		}
+		int rc = static_cast<int>(syscall(__NR_io_uring_register, _ringfd, IORING_REGISTER_BUFFERS, &iovecs[0], count));
+		if (rc < 0)
+		{
+			_buffers.clear();
+			SocketImpl::error();
+		}
+		_bufferCount = count;
+		_bufferSize = size;
+	}
+
+	int bufferCount() const
+	{
+		return _bufferCount;
+	}
+
+	int bufferSize() const
+	{
+		return _bufferSize;
+	}
+
+	char* buffer(int index) const
+	{
+		poco_assert (index >= 0 && index < _bufferCount);
+
+		return const_cast<char*>(&_buffers[static_cast<std::size_t>(index)*_bufferSize]);
+	}
+
+private:
+	struct Operation
+	{
+		Socket         socket;
+		Callback       callback;
+		AcceptCallback acceptCallback;
+	};
+
+	static const Poco::UInt64 WAKEUP_TAG  = ~Poco::UInt64(0);
+	static const Poco::UInt64 TIMEOUT_TAG = ~Poco::UInt64(0) - 1;
+	static const Poco::UInt64 CANCEL_TAG  = ~Poco::UInt64(0) - 2;
+	static const Poco::UInt64 DRAIN_TAG   = ~Poco::UInt64(0) - 3;
+
+	enum
+	{
+		DRAIN_TIMEOUT = 1 // seconds
+	};
+
+	void cancelAll()
+		/// Cancels all operations still in progress and waits until
+		/// the kernel has completed them, so that it no longer accesses
+		/// their buffers. Operations that cannot be cancelled and do not
+		/// complete within DRAIN_TIMEOUT seconds are abandoned.
+		/// The callbacks of the operations are not invoked.
+	{
+		std::vector<bool> inFlight(_operations.size(), true);
+		for (std::vector<std::size_t>::const_iterator it = _freeSlots.begin(); it != _freeSlots.end(); ++it)
+		{
+			inFlight[*it] = false;
+		}
+		std::size_t count = _operations.size() - _freeSlots.size();
+		if (count == 0) return;
+
+		for (std::size_t slot = 0; slot < inFlight.size(); ++slot)
+		{
+			if (inFlight[slot])
+			{
+				struct io_uring_sqe* pSQE = nextSQE();
+				pSQE->opcode = IORING_OP_ASYNC_CANCEL;
+				pSQE->addr = slot;
+				pSQE->user_data = CANCEL_TAG;
+				commitSQE();
+			}
+		}
+		_timeout.tv_sec  = DRAIN_TIMEOUT;
+		_timeout.tv_nsec = 0;
+		struct io_uring_sqe* pSQE = nextSQE();
+		pSQE->opcode = IORING_OP_TIMEOUT;
+		pSQE->addr = reinterpret_cast<Poco::UInt64>(&_timeout);
+		pSQE->len = 1;
+		pSQE->user_data = DRAIN_TAG;
+		commitSQE();
+
+		bool expired = false;
+		while (count > 0 && !expired)
+		{
+			int rc = enter(pending(), 1, IORING_ENTER_GETEVENTS);
+			if (rc < 0 && errno != EINTR && errno != EBUSY && errno != EAGAIN) break;
+
+			unsigned head = *_pCQHead;
+			unsigned tail = __atomic_load_n(_pCQTail, __ATOMIC_ACQUIRE);
+			for (; head != tail; ++head)
+			{
+				Poco::UInt64 tag = _pCQEs[head & _cqMask].user_data;
+				if (tag == DRAIN_TAG)
+				{
+					expired = true;
+				}
+				else if (tag < inFlight.size() && inFlight[tag])
+				{
+					inFlight[tag] = false;
+					--count;
+				}
+			}
+			__atomic_store_n(_pCQHead, head, __ATOMIC_RELEASE);
+		}
+	}
+
+	void* map(std::size_t size, Poco::UInt64 offset)
+	{
+		void* p = ::mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ringfd, offset);
+		if (p == MAP_FAILED)
+		{
+			int err = errno;
+			::close(_ringfd);
+			_ringfd = -1;
+			SocketImpl::error(err);
+		}
+		return p;
+	}
+
+	int enter(unsigned toSubmit, unsigned minComplete, unsigned flags)
+	{
+		return static_cast<int>(syscall(__NR_io_uring_enter, _ringfd, toSubmit, minComplete, flags, NULL, 0));
+	}
+
+	unsigned pending() const
+		/// Returns the number of queued, but not yet submitted entries.
+		/// If several threads submit concurrently, the kernel consumes
+		/// only what is actually there, so overestimating is harmless.
+	{
+		return *_pSQTail - __atomic_load_n(_pSQHead, __ATOMIC_ACQUIRE);
+	}
+
+	void submit()
+	{
+		int rc;
+		do
+		{
+			rc = enter(pending(), 0, 0);
+		}
+		while (rc < 0 && errno == EINTR);
+		if (rc < 0 && errno != EBUSY && errno != EAGAIN) SocketImpl::error();
+	}
+
+	struct io_uring_sqe* nextSQE()
+		/// Returns the next free submission queue entry.
+		/// Must be called with the mutex locked.
+	{
+		if (*_pSQTail - __atomic_load_n(_pSQHead, __ATOMIC_ACQUIRE) >= _sqEntries)
+		{
+			submit();
+			if (*_pSQTail - __atomic_load_n(_pSQHead, __ATOMIC_ACQUIRE) >= _sqEntries)
+				throw Poco::IOException("io_uring submission queue full");
+		}
+		struct io_uring_sqe* pSQE = &_pSQEs[*_pSQTail & _sqMask];
+		std::memset(pSQE, 0, sizeof(struct io_uring_sqe));
+		return pSQE;
+	}
+
+	void commitSQE()
+		/// Makes the entry obtained from nextSQE() visible to the kernel.
+		/// Must be called with the mutex locked.
+	{
+		unsigned tail = *_pSQTail;
+		_pSQArray[tail & _sqMask] = tail & _sqMask;
+		__atomic_store_n(_pSQTail, tail + 1, __ATOMIC_RELEASE);
+	}
+
+	Poco::UInt64 addOperation(const Socket& socket, const Callback& callback, const AcceptCallback& acceptCallback)
+		/// Stores the operation and returns its tag.
+		/// Must be called with the mutex locked.
+	{
+		std::size_t slot;
+		if (_freeSlots.empty())
+		{
+			slot = _operations.size();
+			_operations.push_back(Operation());
+		}
+		else
+		{
+			slot = _freeSlots.back();
+			_freeSlots.pop_back();
+		}
+		Operation& op = _operations[slot];
+		op.socket = socket;
+		op.callback = callback;
+		op.acceptCallback = acceptCallback;
+		return slot;
+	}
+
+	int reap(CompletionList& completions, bool& timedOut)
+	{
+		unsigned head = *_pCQHead;
+		unsigned tail = __atomic_load_n(_pCQTail, __ATOMIC_ACQUIRE);
+
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		for (; head != tail; ++head)
+		{
+			const struct io_uring_cqe& cqe = _pCQEs[head & _cqMask];
+			if (cqe.user_data == TIMEOUT_TAG)
+			{
+				_timeoutArmed = false;
+				if (cqe.res == -ETIME && !_completedSinceArm) timedOut = true;
+			}
+			else if (cqe.user_data != WAKEUP_TAG && cqe.user_data != CANCEL_TAG && cqe.user_data != DRAIN_TAG)
+			{
+				std::size_t slot = static_cast<std::size_t>(cqe.user_data);
+				Operation& op = _operations[slot];
+				completions.push_back(Completion());
+				Completion& completion = completions.back();
+				std::swap(completion.socket, op.socket);
+				std::swap(completion.callback, op.callback);
+				std::swap(completion.acceptCallback, op.acceptCallback);
+				completion.result = cqe.res;
+				op.socket = Socket();
+				op.callback = Callback();
+				op.acceptCallback = AcceptCallback();
+				_freeSlots.push_back(slot);
+				_completedSinceArm = true;
+			}
+		}
+		__atomic_store_n(_pCQHead, head, __ATOMIC_RELEASE);
+
+		return static_cast<int>(completions.size());
+	}
+
+	int                         _ringfd;
+	void*                       _pSQRing;
+	std::size_t                 _sqRingSize;
+	void*                       _pCQRing;
+	std::size_t                 _cqRingSize;
+	struct io_uring_sqe*        _pSQEs;
+	std::size_t                 _sqesSize;
+	unsigned*                   _pSQHead;
+	unsigned*                   _pSQTail;
+	unsigned*                   _pSQArray;
+	unsigned                    _sqMask;
+	unsigned                    _sqEntries;
+	unsigned*                   _pCQHead;
+	unsigned*                   _pCQTail;
+	unsigned                    _cqMask;
+	struct io_uring_cqe*        _pCQEs;
+	struct __kernel_timespec    _timeout;
+	bool                        _timeoutArmed;
+	bool                        _completedSinceArm;
+	std::vector<Operation>      _operations;
+	std::vector<std::size_t>    _freeSlots;
+	std::vector<char>           _buffers;
+	int                         _bufferCount;
+	int                         _bufferSize;
+	Poco::FastMutex             _mutex;
+};
+
+
+#else
+
+
+//
+// Fallback for platforms without io_uring
+//
+class CompletionReactorImpl
+{
+public:
+	typedef CompletionReactor::Callback       Callback;
+	typedef CompletionReactor::AcceptCallback AcceptCallback;
+	typedef CompletionReactor::CompletionList CompletionList;
+
+	CompletionReactorImpl(int)
+	{
+		throw Poco::NotImplementedException("CompletionReactor requires io_uring");
+	}
+
+	static bool isAvailable()
+	{
+		return false;
+	}
+
+	void accept(const ServerSocket&, const AcceptCallback&, bool)
+	{
+	}
+
+	void transfer(TransferType, const StreamSocket&, const void*, int, int, const Callback&, bool)
+	{
+	}
+
+	void wakeUp()
+	{
+	}
+
+	int wait(const Poco::Timespan&, CompletionList&, bool&)
+	{
+		return 0;
+	}
+
+	void registerBuffers(int, int)
+	{
+	}
+
+	int bufferCount() const
+	{
+		return 0;
+	}
+
+	int bufferSize() const
+	{
+		return 0;
+	}
+
+	char* buffer(int) const
+	{
+		return 0;
+	}
+};
+
+
+#endif
+
+
+CompletionReactor::CompletionReactor(int queueDepth):
+	_pImpl(new CompletionReactorImpl(queueDepth)),
+	_stop(false),
+	_timeout(DEFAULT_TIMEOUT),
+	_running(false),
+	_tid()
+{
+}
+
+
+CompletionReactor::CompletionReactor(int queueDepth, const Poco::Timespan& timeout):
+	_pImpl(new CompletionReactorImpl(queueDepth)),
+	_stop(false),
+	_timeout(timeout),
+	_running(false),
+	_tid()
+{
+}
+
+
+CompletionReactor::~CompletionReactor()
+{
+	delete _pImpl;
+}
+
+
+bool CompletionReactor::isAvailable()
+{
+	return CompletionReactorImpl::isAvailable();
+}
+
+
+void CompletionReactor::run()
+{
+	_tid = Poco::Thread::currentTid();
+	_running = true;
+	while (!_stop)
+	{
+		try
+		{
+			bool timedOut = false;
+			_completions.clear();
+			if (_pImpl->wait(_timeout, _completions, timedOut) > 0)
+			{
+				onBusy();
+				for (CompletionList::iterator it = _completions.begin(); it != _completions.end(); ++it)
+				{
+					dispatch(*it);
+				}
+			}
+			if (timedOut) onTimeout();
+		}
+		catch (Exception& exc)
+		{
+			ErrorHandler::handle(exc);
+		}
+		catch (std::exception& exc)
+		{
+			ErrorHandler::handle(exc);
+		}
+		catch (...)
+		{
+			ErrorHandler::handle();
+		}
+	}
+	_completions.clear();
+	_running = false;
+}
+
+
+void CompletionReactor::stop()
+{
+	_stop = true;
+	if (!inReactorThread()) wakeUp();
+}
+
+
+void CompletionReactor::wakeUp()
+{
+	_pImpl->wakeUp();
+}
+
+
+void CompletionReactor::setTimeout(const Poco::Timespan& timeout)
+{
+	_timeout = timeout;
+}
+
+
+void CompletionReactor::accept(const ServerSocket& socket, const AcceptCallback& callback)
+{
+	_pImpl->accept(socket, callback, !inReactorThread());
+}
+
+
+void CompletionReactor::receive(const StreamSocket& socket, void* buffer, int length, const Callback& callback)
+{
+	_pImpl->transfer(TRANSFER_RECEIVE, socket, buffer, length, -1, callback, !inReactorThread());
+}
+
+
+void CompletionReactor::send(const StreamSocket& socket, const void* buffer, int length, const Callback& callback)
+{
+	_pImpl->transfer(TRANSFER_SEND, socket, buffer, length, -1, callback, !inReactorThread());
+}
+
+
+void CompletionReactor::registerBuffers(int count, int size)
+{
+	_pImpl->registerBuffers(count, size);
+}
+
+
+int CompletionReactor::bufferCount() const
+{
+	return _pImpl->bufferCount();
+}
+
+
+int CompletionReactor::bufferSize() const
+{
+	return _pImpl->bufferSize();
+}
+
+
+char* CompletionReactor::buffer(int index) const
+{
+	return _pImpl->buffer(index);
+}
+
+
+void CompletionReactor::receiveFixed(const StreamSocket& socket, int index, int length, const Callback& callback)
+{
+	poco_assert (length <= bufferSize());
+
+	_pImpl->transfer(TRANSFER_RECEIVE_FIXED, socket, buffer(index), length, index, callback, !inReactorThread());
+}
+
+
+void CompletionReactor::sendFixed(const StreamSocket& socket, int index, int length, const Callback& callback)
+{
+	poco_assert (length <= bufferSize());
+
+	_pImpl->transfer(TRANSFER_SEND_FIXED, socket, buffer(index), length, index, callback, !inReactorThread());
+}
+
+
+void CompletionReactor::onTimeout()
+{
+}
+
+
+void CompletionReactor::onBusy()
+{
+}
+
+
+void CompletionReactor::dispatch(Completion& completion)
+{
+	try
+	{
+		if (completion.acceptCallback)
+		{
+			if (completion.result >= 0)
+			{
+				StreamSocket socket(new StreamSocketImpl(completion.result));
+				completion.acceptCallback(socket, 0);
+			}
+			else completion.acceptCallback(StreamSocket(), completion.result);
+		}
+		else if (completion.callback)
+		{
+			completion.callback(completion.result);
+		}
+	}
+	catch (Exception& exc)
+	{
+		ErrorHandler::handle(exc);
+	}
+	catch (std::exception& exc)
+	{
+		ErrorHandler::handle(exc);
+	}
+	catch (...)
+	{
+		ErrorHandler::handle();
+	}
+}
+
+
+bool CompletionReactor::inReactorThread() const
+{
+	return _running && Poco::Thread::currentTid() == _tid;
+}
+
+
+} } // namespace Poco::Net
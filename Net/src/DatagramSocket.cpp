@@ -153,4 +153,16 @@ int DatagramSocket::receiveFrom(SocketBufVec& buffers, struct sockaddr** ppSA, p
 }
 
 
+int DatagramSocket::receiveBatch(DatagramBufVec& datagrams, int flags)
+{
+	return impl()->receiveBatch(datagrams, flags);
+}
+
+
+int DatagramSocket::sendBatch(const DatagramBufVec& datagrams, int flags)
+{
+	return impl()->sendBatch(datagrams, flags);
+}
+
+
 } } // namespace Poco::Net
@@ -22,6 +22,8 @@
 #include "Poco/Net/HTTPServerParams.h"
 #include "Poco/Net/StreamSocket.h"
 #include "Poco/String.h"
+#include <new>
+#include <utility>
 
 
 using Poco::icompare;
@@ -31,11 +33,22 @@ namespace Poco {
 namespace Net {
 
 
-HTTPServerRequestImpl::HTTPServerRequestImpl(HTTPServerResponseImpl& response, HTTPServerSession& session, HTTPServerParams* pParams):
+template <class S, typename... Args>
+std::istream* HTTPServerRequestImpl::createStream(Args&&... args)
+{
+	if (_pArena)
+		return ::new (_pArena->allocate(sizeof(S), alignof(S))) S(std::forward<Args>(args)...);
+	else
+		return new S(std::forward<Args>(args)...);
+}
+
+
+HTTPServerRequestImpl::HTTPServerRequestImpl(HTTPServerResponseImpl& response, HTTPServerSession& session, HTTPServerParams* pParams, Poco::Arena* pArena):
 	_response(response),
 	_session(session),
 	_pStream(0),
-	_pParams(pParams, true)
+	_pParams(pParams, true),
+	_pArena(pArena)
 {
 	response.attachRequest(this);
 
@@ -47,23 +60,28 @@ HTTPServerRequestImpl::HTTPServerRequestImpl(HTTPServerResponseImpl& response, H
 	_serverAddress = session.serverAddress();
 	
 	if (getChunkedTransferEncoding())
-		_pStream = new HTTPChunkedInputStream(session);
+		_pStream = createStream<HTTPChunkedInputStream>(session);
 	else if (hasContentLength())
 #if defined(POCO_HAVE_INT64)
-		_pStream = new HTTPFixedLengthInputStream(session, getContentLength64());
+		_pStream = createStream<HTTPFixedLengthInputStream>(session, getContentLength64());
 #else
-		_pStream = new HTTPFixedLengthInputStream(session, getContentLength());
+		_pStream = createStream<HTTPFixedLengthInputStream>(session, getContentLength());
 #endif
 	else if (getMethod() == HTTPRequest::HTTP_GET || getMethod() == HTTPRequest::HTTP_HEAD || getMethod() == HTTPRequest::HTTP_DELETE)
-		_pStream = new HTTPFixedLengthInputStream(session, 0);
+		_pStream = createStream<HTTPFixedLengthInputStream>(session, 0);
 	else
-		_pStream = new HTTPInputStream(session);
+		_pStream = createStream<HTTPInputStream>(session);
 }
 
 
 HTTPServerRequestImpl::~HTTPServerRequestImpl()
 {
-	delete _pStream;
+	if (_pArena)
+	{
+		// the memory is released when the Arena is reset
+		if (_pStream) _pStream->~basic_istream();
+	}
+	else delete _pStream;
 }
 
 
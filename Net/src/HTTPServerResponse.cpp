@@ -13,6 +13,15 @@
 
 
 #include "Poco/Net/HTTPServerResponse.h"
+#include "Poco/File.h"
+#include "Poco/FileStream.h"
+#include "Poco/Buffer.h"
+#include "Poco/Exception.h"
+
+
+using Poco::File;
+using Poco::OpenFileException;
+using Poco::InvalidArgumentException;
 
 
 namespace Poco {
@@ -29,4 +38,32 @@ HTTPServerResponse::~HTTPServerResponse()
 }
 
 
+void HTTPServerResponse::sendFile(const std::string& path, const std::string& mediaType, Poco::UInt64 offset, Poco::UInt64 length)
+{
+	File f(path);
+	Poco::UInt64 size = f.getSize();
+	if (offset > size || length > size - offset)
+		throw InvalidArgumentException("File range exceeds file size", path);
+
+	Poco::FileInputStream istr(path);
+	if (!istr.good()) throw OpenFileException(path);
+	istr.seekg(static_cast<std::streamoff>(offset), std::ios::beg);
+
+	setContentType(mediaType);
+	setContentLength64(length);
+	std::ostream& ostr = send();
+
+	Poco::Buffer<char> buffer(8192);
+	while (length > 0 && istr.good())
+	{
+		std::streamsize n = static_cast<std::streamsize>(length < buffer.size() ? length : buffer.size());
+		istr.read(buffer.begin(), n);
+		n = istr.gcount();
+		if (n <= 0) break;
+		ostr.write(buffer.begin(), n);
+		length -= n;
+	}
+}
+
+
 } } // namespace Poco::Net
@@ -22,6 +22,8 @@
 #include "Poco/File.h"
 #include "Poco/Timestamp.h"
 #include "Poco/NumberFormatter.h"
+#include "Poco/NumberParser.h"
+#include "Poco/String.h"
 #include "Poco/StreamCopier.h"
 #include "Poco/CountingStream.h"
 #include "Poco/Exception.h"
@@ -33,8 +35,11 @@
 using Poco::File;
 using Poco::Timestamp;
 using Poco::NumberFormatter;
+using Poco::NumberParser;
 using Poco::StreamCopier;
 using Poco::OpenFileException;
+using Poco::ReadFileException;
+using Poco::InvalidArgumentException;
 using Poco::DateTimeFormatter;
 using Poco::DateTimeFormat;
 
@@ -112,26 +117,46 @@ void HTTPServerResponseImpl::sendFile(const std::string& path, const std::string
 	File f(path);
 	Timestamp dateTime    = f.getLastModified();
 	File::FileSize length = f.getSize();
-	set("Last-Modified", DateTimeFormatter::format(dateTime, DateTimeFormat::HTTP_FORMAT));
-#if defined(POCO_HAVE_INT64)	
-	setContentLength64(length);
-#else
-	setContentLength(static_cast<int>(length));
-#endif
-	setContentType(mediaType);
-	setChunkedTransferEncoding(false);
+	std::string lastModified = DateTimeFormatter::format(dateTime, DateTimeFormat::HTTP_FORMAT);
+	set("Last-Modified", lastModified);
+	set("Accept-Ranges", "bytes");
 
-	Poco::FileInputStream istr(path);
-	if (istr.good())
+	Poco::UInt64 offset = 0;
+	Poco::UInt64 count  = length;
+	if (_pRequest && getStatus() == HTTP_OK && _pRequest->has("Range") && _pRequest->get("If-Range", lastModified) == lastModified)
 	{
-		_pStream = new HTTPHeaderOutputStream(_session);
-		write(*_pStream);
-		if (_pRequest && _pRequest->getMethod() != HTTPRequest::HTTP_HEAD)
+		switch (parseRange(_pRequest->get("Range"), length, offset, count))
 		{
-			StreamCopier::copyStream(istr, *_pStream);
+		case RANGE_SATISFIABLE:
+			setStatusAndReason(HTTP_PARTIAL_CONTENT);
+			set("Content-Range", "bytes " + NumberFormatter::format(offset) + "-" + NumberFormatter::format(offset + count - 1) + "/" + NumberFormatter::format(static_cast<Poco::UInt64>(length)));
+			break;
+		case RANGE_NOT_SATISFIABLE:
+			setStatusAndReason(HTTP_REQUESTED_RANGE_NOT_SATISFIABLE);
+			set("Content-Range", "bytes */" + NumberFormatter::format(static_cast<Poco::UInt64>(length)));
+			setContentLength(0);
+			setChunkedTransferEncoding(false);
+			_pStream = new HTTPHeaderOutputStream(_session);
+			write(*_pStream);
+			return;
+		case RANGE_IGNORED:
+			break;
 		}
 	}
-	else throw OpenFileException(path);
+	sendFileRange(path, mediaType, offset, count);
+}
+
+
+void HTTPServerResponseImpl::sendFile(const std::string& path, const std::string& mediaType, Poco::UInt64 offset, Poco::UInt64 length)
+{
+	poco_assert (!_pStream);
+
+	File f(path);
+	Poco::UInt64 size = f.getSize();
+	if (offset > size || length > size - offset)
+		throw InvalidArgumentException("File range exceeds file size", path);
+
+	sendFileRange(path, mediaType, offset, length);
 }
 
 
@@ -166,6 +191,77 @@ void HTTPServerResponseImpl::redirect(const std::string& uri, HTTPStatus status)
 }
 
 
+void HTTPServerResponseImpl::sendFileRange(const std::string& path, const std::string& mediaType, Poco::UInt64 offset, Poco::UInt64 length)
+{
+#if defined(POCO_HAVE_INT64)
+	setContentLength64(length);
+#else
+	setContentLength(static_cast<int>(length));
+#endif
+	setContentType(mediaType);
+	setChunkedTransferEncoding(false);
+
+	Poco::FileInputStream istr(path);
+	if (istr.good())
+	{
+		_pStream = new HTTPHeaderOutputStream(_session);
+		write(*_pStream);
+		if (_pRequest && _pRequest->getMethod() != HTTPRequest::HTTP_HEAD && length > 0)
+		{
+			// The header must be on the wire before the file is
+			// sent directly to the socket, bypassing the stream.
+			_pStream->flush();
+			if (_session.socket().sendFile(istr, offset, length) < length)
+				throw ReadFileException("File is shorter than expected", path);
+		}
+	}
+	else throw OpenFileException(path);
+}
+
+
+HTTPServerResponseImpl::RangeResult HTTPServerResponseImpl::parseRange(const std::string& range, Poco::UInt64 size, Poco::UInt64& offset, Poco::UInt64& length)
+{
+	// Only a single byte range is supported; requests for
+	// multiple ranges get the complete file (RFC 7233, 3.1).
+	static const std::string BYTES_UNIT("bytes=");
+	if (icompare(range, 0, BYTES_UNIT.size(), BYTES_UNIT) != 0 || range.find(',') != std::string::npos)
+		return RANGE_IGNORED;
+
+	std::string spec = trim(range.substr(BYTES_UNIT.size()));
+	std::string::size_type pos = spec.find('-');
+	if (pos == std::string::npos) return RANGE_IGNORED;
+	std::string first = trim(spec.substr(0, pos));
+	std::string last  = trim(spec.substr(pos + 1));
+
+	Poco::UInt64 firstPos = 0;
+	Poco::UInt64 lastPos  = 0;
+	if (first.empty())
+	{
+		// suffix range: the last n bytes
+		if (!NumberParser::tryParseUnsigned64(last, lastPos)) return RANGE_IGNORED;
+		if (lastPos == 0 || size == 0) return RANGE_NOT_SATISFIABLE;
+		if (lastPos > size) lastPos = size;
+		offset = size - lastPos;
+		length = lastPos;
+		return RANGE_SATISFIABLE;
+	}
+	if (!NumberParser::tryParseUnsigned64(first, firstPos)) return RANGE_IGNORED;
+	if (last.empty())
+	{
+		lastPos = size > 0 ? size - 1 : 0;
+	}
+	else
+	{
+		if (!NumberParser::tryParseUnsigned64(last, lastPos) || lastPos < firstPos) return RANGE_IGNORED;
+		if (lastPos >= size) lastPos = size - 1;
+	}
+	if (firstPos >= size) return RANGE_NOT_SATISFIABLE;
+	offset = firstPos;
+	length = lastPos - firstPos + 1;
+	return RANGE_SATISFIABLE;
+}
+
+
 void HTTPServerResponseImpl::requireAuthentication(const std::string& realm)
 {
 	poco_assert (!_pStream);
@@ -75,17 +75,10 @@ public:
 	{
 		Poco::FastMutex::ScopedLock lock(_mutex);
 
-		SocketImpl* sockImpl = socket.impl();
-		poco_socket_t fd = sockImpl->sockfd();
+		poco_socket_t fd = socket.impl()->sockfd();
 		struct epoll_event ev;
-		ev.events = 0;
-		if (mode & PollSet::POLL_READ)
-			ev.events |= EPOLLIN;
-		if (mode & PollSet::POLL_WRITE)
-			ev.events |= EPOLLOUT;
-		if (mode & PollSet::POLL_ERROR)
-			ev.events |= EPOLLERR;
-		ev.data.ptr = socket.impl();
+		ev.events = eventsOf(mode);
+		ev.data.fd = fd;
 		int err = epoll_ctl(_epollfd, EPOLL_CTL_ADD, fd, &ev);
 
 		if (err)
@@ -94,8 +87,8 @@ public:
 			else SocketImpl::error();
 		}
 
-		if (_socketMap.find(sockImpl) == _socketMap.end())
-			_socketMap[sockImpl] = socket;
+		if (_socketMap.find(fd) == _socketMap.end())
+			_socketMap[fd] = socket;
 	}
 
 	void remove(const Socket& socket)
@@ -105,11 +98,11 @@ public:
 		poco_socket_t fd = socket.impl()->sockfd();
 		struct epoll_event ev;
 		ev.events = 0;
-		ev.data.ptr = 0;
+		ev.data.u64 = 0;
 		int err = epoll_ctl(_epollfd, EPOLL_CTL_DEL, fd, &ev);
 		if (err) SocketImpl::error();
 
-		_socketMap.erase(socket.impl());
+		_socketMap.erase(fd);
 	}
 
 	bool has(const Socket& socket) const
@@ -117,7 +110,7 @@ public:
 		Poco::FastMutex::ScopedLock lock(_mutex);
 		SocketImpl* sockImpl = socket.impl();
 		return sockImpl &&
-			(_socketMap.find(sockImpl) != _socketMap.end());
+			(_socketMap.find(sockImpl->sockfd()) != _socketMap.end());
 	}
 
 	bool empty() const
@@ -130,15 +123,16 @@ public:
 	{
 		poco_socket_t fd = socket.impl()->sockfd();
 		struct epoll_event ev;
-		ev.events = 0;
-		if (mode & PollSet::POLL_READ)
-			ev.events |= EPOLLIN;
-		if (mode & PollSet::POLL_WRITE)
-			ev.events |= EPOLLOUT;
-		if (mode & PollSet::POLL_ERROR)
-			ev.events |= EPOLLERR;
-		ev.data.ptr = socket.impl();
-		int err = epoll_ctl(_epollfd, EPOLL_CTL_MOD, fd, &ev);
+		ev.events = eventsOf(mode);
+		ev.data.fd = fd;
+		int err;
+		if (mode & PollSet::POLL_EXCLUSIVE)
+		{
+			// EPOLLEXCLUSIVE is not allowed with EPOLL_CTL_MOD
+			err = epoll_ctl(_epollfd, EPOLL_CTL_DEL, fd, &ev);
+			if (!err) err = epoll_ctl(_epollfd, EPOLL_CTL_ADD, fd, &ev);
+		}
+		else err = epoll_ctl(_epollfd, EPOLL_CTL_MOD, fd, &ev);
 		if (err)
 		{
 			SocketImpl::error();
@@ -167,6 +161,52 @@ public:
 			if(_socketMap.empty()) return result;
 		}
 
+		int rc = wait(timeout);
+
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		for (int i = 0; i < rc; i++)
+		{
+			std::map<poco_socket_t, Socket>::iterator it = _socketMap.find(_events[i].data.fd);
+			if (it != _socketMap.end())
+			{
+				int mode = modeOf(_events[i].events);
+				if (mode) result[it->second] |= mode;
+			}
+		}
+
+		return result;
+	}
+
+	int poll(PollSet::SocketEventList& events, const Poco::Timespan& timeout)
+	{
+		events.clear();
+
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+			if(_socketMap.empty()) return 0;
+		}
+
+		int rc = wait(timeout);
+
+		for (int i = 0; i < rc; i++)
+		{
+			int mode = modeOf(_events[i].events);
+			if (mode)
+			{
+				PollSet::SocketEvent ev;
+				ev.fd = _events[i].data.fd;
+				ev.mode = mode;
+				events.push_back(ev);
+			}
+		}
+
+		return static_cast<int>(events.size());
+	}
+
+private:
+	int wait(const Poco::Timespan& timeout)
+	{
 		Poco::Timespan remainingTime(timeout);
 		int rc;
 		do
@@ -185,30 +225,44 @@ public:
 		}
 		while (rc < 0 && SocketImpl::lastError() == POCO_EINTR);
 		if (rc < 0) SocketImpl::error();
+		return rc;
+	}
 
-		Poco::FastMutex::ScopedLock lock(_mutex);
-
-		for (int i = 0; i < rc; i++)
-		{
-			std::map<void*, Socket>::iterator it = _socketMap.find(_events[i].data.ptr);
-			if (it != _socketMap.end())
-			{
-				if (_events[i].events & EPOLLIN)
-					result[it->second] |= PollSet::POLL_READ;
-				if (_events[i].events & EPOLLOUT)
-					result[it->second] |= PollSet::POLL_WRITE;
-				if (_events[i].events & EPOLLERR)
-					result[it->second] |= PollSet::POLL_ERROR;
-			}
-		}
+	static Poco::UInt32 eventsOf(int mode)
+	{
+		Poco::UInt32 events = 0;
+		if (mode & PollSet::POLL_READ)
+			events |= EPOLLIN;
+		if (mode & PollSet::POLL_WRITE)
+			events |= EPOLLOUT;
+		if (mode & PollSet::POLL_ERROR)
+			events |= EPOLLERR;
+		if (mode & PollSet::POLL_EDGE_TRIGGERED)
+			events |= EPOLLET;
+		if (mode & PollSet::POLL_ONESHOT)
+			events |= EPOLLONESHOT;
+#if defined(EPOLLEXCLUSIVE)
+		if (mode & PollSet::POLL_EXCLUSIVE)
+			events |= EPOLLEXCLUSIVE;
+#endif
+		return events;
+	}
 
-		return result;
+	static int modeOf(Poco::UInt32 events)
+	{
+		int mode = 0;
+		if (events & EPOLLIN)
+			mode |= PollSet::POLL_READ;
+		if (events & EPOLLOUT)
+			mode |= PollSet::POLL_WRITE;
+		if (events & EPOLLERR)
+			mode |= PollSet::POLL_ERROR;
+		return mode;
 	}
 
-private:
 	mutable Poco::FastMutex         _mutex;
 	int                             _epollfd;
-	std::map<void*, Socket>         _socketMap;
+	std::map<poco_socket_t, Socket> _socketMap;
 	std::vector<struct epoll_event> _events;
 };
 
@@ -230,6 +284,7 @@ public:
 		_addMap[fd] = mode;
 		_removeSet.erase(fd);
 		_socketMap[fd] = socket;
+		setOneShot(fd, mode);
 	}
 
 	void remove(const Socket& socket)
@@ -240,6 +295,7 @@ public:
 		_removeSet.insert(fd);
 		_addMap.erase(fd);
 		_socketMap.erase(fd);
+		_oneShotSet.erase(fd);
 	}
 
 	bool has(const Socket& socket) const
@@ -261,6 +317,8 @@ public:
 		Poco::FastMutex::ScopedLock lock(_mutex);
 
 		poco_socket_t fd = socket.impl()->sockfd();
+		std::map<poco_socket_t, int>::iterator ita = _addMap.find(fd);
+		if (ita != _addMap.end()) ita->second = mode;
 		for (std::vector<pollfd>::iterator it = _pollfds.begin(); it != _pollfds.end(); ++it)
 		{
 			if (it->fd == fd)
@@ -272,6 +330,7 @@ public:
 					it->events |= POLLOUT;
 			}
 		}
+		setOneShot(fd, mode);
 	}
 
 	void clear()
@@ -281,12 +340,77 @@ public:
 		_socketMap.clear();
 		_addMap.clear();
 		_removeSet.clear();
+		_oneShotSet.clear();
 		_pollfds.clear();
 	}
 
 	PollSet::SocketModeMap poll(const Poco::Timespan& timeout)
 	{
 		PollSet::SocketModeMap result;
+
+		if (!wait(timeout)) return result;
+
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+
+			if (!_socketMap.empty())
+			{
+				for (std::vector<pollfd>::iterator it = _pollfds.begin(); it != _pollfds.end(); ++it)
+				{
+					std::map<poco_socket_t, Socket>::const_iterator its = _socketMap.find(it->fd);
+					if (its != _socketMap.end())
+					{
+						int mode = modeOf(it->revents);
+						if (mode)
+						{
+							result[its->second] |= mode;
+							disarmOneShot(*it);
+						}
+					}
+					it->revents = 0;
+				}
+			}
+		}
+
+		return result;
+	}
+
+	int poll(PollSet::SocketEventList& events, const Poco::Timespan& timeout)
+	{
+		events.clear();
+
+		if (!wait(timeout)) return 0;
+
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+
+			if (!_socketMap.empty())
+			{
+				for (std::vector<pollfd>::iterator it = _pollfds.begin(); it != _pollfds.end(); ++it)
+				{
+					int mode = it->revents ? modeOf(it->revents) : 0;
+					if (mode && _socketMap.find(it->fd) != _socketMap.end())
+					{
+						PollSet::SocketEvent ev;
+						ev.fd = it->fd;
+						ev.mode = mode;
+						events.push_back(ev);
+						disarmOneShot(*it);
+					}
+					it->revents = 0;
+				}
+			}
+		}
+
+		return static_cast<int>(events.size());
+	}
+
+private:
+	bool wait(const Poco::Timespan& timeout)
+		/// Applies pending additions and removals and polls the
+		/// registered sockets. Returns false if there was nothing
+		/// to poll.
+	{
 		{
 			Poco::FastMutex::ScopedLock lock(_mutex);
 
@@ -320,7 +444,7 @@ public:
 			_addMap.clear();
 		}
 
-		if (_pollfds.empty()) return result;
+		if (_pollfds.empty()) return false;
 
 		Poco::Timespan remainingTime(timeout);
 		int rc;
@@ -328,9 +452,9 @@ public:
 		{
 			Poco::Timestamp start;
 #ifdef _WIN32
-			rc = WSAPoll(&_pollfds[0], static_cast<ULONG>(_pollfds.size()), static_cast<INT>(timeout.totalMilliseconds()));
+			rc = WSAPoll(&_pollfds[0], static_cast<ULONG>(_pollfds.size()), static_cast<INT>(remainingTime.totalMilliseconds()));
 #else
-			rc = ::poll(&_pollfds[0], _pollfds.size(), timeout.totalMilliseconds());
+			rc = ::poll(&_pollfds[0], _pollfds.size(), remainingTime.totalMilliseconds());
 #endif
 			if (rc < 0 && SocketImpl::lastError() == POCO_EINTR)
 			{
@@ -345,33 +469,37 @@ public:
 		while (rc < 0 && SocketImpl::lastError() == POCO_EINTR);
 		if (rc < 0) SocketImpl::error();
 
-		{
-			Poco::FastMutex::ScopedLock lock(_mutex);
+		return true;
+	}
 
-			if (!_socketMap.empty())
-			{
-				for (std::vector<pollfd>::iterator it = _pollfds.begin(); it != _pollfds.end(); ++it)
-				{
-					std::map<poco_socket_t, Socket>::const_iterator its = _socketMap.find(it->fd);
-					if (its != _socketMap.end())
-					{
-						if (it->revents & POLLIN)
-							result[its->second] |= PollSet::POLL_READ;
-						if (it->revents & POLLOUT)
-							result[its->second] |= PollSet::POLL_WRITE;
-						if (it->revents & POLLERR)
-							result[its->second] |= PollSet::POLL_ERROR;
+	void setOneShot(poco_socket_t fd, int mode)
+	{
+		if (mode & PollSet::POLL_ONESHOT)
+			_oneShotSet.insert(fd);
+		else
+			_oneShotSet.erase(fd);
+	}
+
+	void disarmOneShot(pollfd& pfd)
+	{
+		if (!_oneShotSet.empty() && _oneShotSet.find(pfd.fd) != _oneShotSet.end())
+			pfd.events = 0;
+	}
+
+	static int modeOf(short revents)
+	{
+		int mode = 0;
+		if (revents & POLLIN)
+			mode |= PollSet::POLL_READ;
+		if (revents & POLLOUT)
+			mode |= PollSet::POLL_WRITE;
+		if (revents & POLLERR)
+			mode |= PollSet::POLL_ERROR;
 #ifdef _WIN32
-						if (it->revents & POLLHUP)
-							result[its->second] |= PollSet::POLL_READ;
+		if (revents & POLLHUP)
+			mode |= PollSet::POLL_READ;
 #endif
-					}
-					it->revents = 0;
-				}
-			}
-		}
-
-		return result;
+		return mode;
 	}
 
 private:
@@ -379,6 +507,7 @@ private:
 	std::map<poco_socket_t, Socket> _socketMap;
 	std::map<poco_socket_t, int>    _addMap;
 	std::set<poco_socket_t>         _removeSet;
+	std::set<poco_socket_t>         _oneShotSet;
 	std::vector<pollfd>             _pollfds;
 };
 
@@ -445,7 +574,7 @@ public:
 			for (PollSet::SocketModeMap::const_iterator it = _map.begin(); it != _map.end(); ++it)
 			{
 				poco_socket_t fd = it->first.impl()->sockfd();
-				if (fd != POCO_INVALID_SOCKET && it->second)
+				if (fd != POCO_INVALID_SOCKET && (it->second & (PollSet::POLL_READ | PollSet::POLL_WRITE | PollSet::POLL_ERROR)))
 				{
 					if (int(fd) > nfd) nfd = int(fd);
 
@@ -493,22 +622,29 @@ public:
 		{
 			Poco::FastMutex::ScopedLock lock(_mutex);
 
-			for (PollSet::SocketModeMap::const_iterator it = _map.begin(); it != _map.end(); ++it)
+			for (PollSet::SocketModeMap::iterator it = _map.begin(); it != _map.end(); ++it)
 			{
 				poco_socket_t fd = it->first.impl()->sockfd();
 				if (fd != POCO_INVALID_SOCKET)
 				{
+					int mode = 0;
 					if (FD_ISSET(fd, &fdRead))
 					{
-						result[it->first] |= PollSet::POLL_READ;
+						mode |= PollSet::POLL_READ;
 					}
 					if (FD_ISSET(fd, &fdWrite))
 					{
-						result[it->first] |= PollSet::POLL_WRITE;
+						mode |= PollSet::POLL_WRITE;
 					}
 					if (FD_ISSET(fd, &fdExcept))
 					{
-						result[it->first] |= PollSet::POLL_ERROR;
+						mode |= PollSet::POLL_ERROR;
+					}
+					if (mode)
+					{
+						result[it->first] |= mode;
+						if (it->second & PollSet::POLL_ONESHOT)
+							it->second &= ~(PollSet::POLL_READ | PollSet::POLL_WRITE | PollSet::POLL_ERROR);
 					}
 				}
 			}
@@ -517,6 +653,22 @@ public:
 		return result;
 	}
 
+	int poll(PollSet::SocketEventList& events, const Poco::Timespan& timeout)
+	{
+		events.clear();
+
+		PollSet::SocketModeMap sm = poll(timeout);
+		for (PollSet::SocketModeMap::const_iterator it = sm.begin(); it != sm.end(); ++it)
+		{
+			PollSet::SocketEvent ev;
+			ev.fd = it->first.impl()->sockfd();
+			ev.mode = it->second;
+			events.push_back(ev);
+		}
+
+		return static_cast<int>(events.size());
+	}
+
 private:
 	mutable Poco::FastMutex _mutex;
 	PollSet::SocketModeMap  _map;
@@ -580,4 +732,10 @@ PollSet::SocketModeMap PollSet::poll(const Poco::Timespan& timeout)
 }
 
 
+int PollSet::poll(SocketEventList& events, const Poco::Timespan& timeout)
+{
+	return _pImpl->poll(events, timeout);
+}
+
+
 } } // namespace Poco::Net
@@ -0,0 +1,739 @@
+//
+// ReactorHTTPServer.cpp
+//
+// Library: Net
+// Package: HTTPServer
+// Module:  ReactorHTTPServer
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Net/ReactorHTTPServer.h"
+#include "Poco/Net/HTTPServerSession.h"
+#include "Poco/Net/HTTPServerRequestImpl.h"
+#include "Poco/Net/HTTPServerResponseImpl.h"
+#include "Poco/Net/HTTPRequestHandler.h"
+#include "Poco/Net/HTTPBufferAllocator.h"
+#include "Poco/Net/NetException.h"
+#include "Poco/Notification.h"
+#include "Poco/Observer.h"
+#include "Poco/RefCountedObject.h"
+#include "Poco/NumberParser.h"
+#include "Poco/String.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Buffer.h"
+#include "Poco/ErrorHandler.h"
+#include "Poco/Exception.h"
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+
+using Poco::ErrorHandler;
+
+
+namespace Poco {
+namespace Net {
+
+
+namespace
+{
+	class ReactorHTTPServerSession: public HTTPServerSession
+		/// An HTTPServerSession that returns the data already
+		/// received by the reactor before reading from the socket.
+	{
+	public:
+		ReactorHTTPServerSession(const StreamSocket& socket, HTTPServerParams::Ptr pParams, const char* pData, std::size_t size):
+			HTTPServerSession(socket, pParams),
+			_pData(pData),
+			_size(size),
+			_pos(0)
+		{
+		}
+
+		~ReactorHTTPServerSession()
+		{
+			// The socket outlives the session, which
+			// would otherwise close it.
+			try
+			{
+				detachSocket();
+			}
+			catch (...)
+			{
+			}
+		}
+
+		std::size_t consumed() const
+		{
+			return _pos;
+		}
+
+	protected:
+		int receive(char* buffer, int length)
+		{
+			if (_pos < _size)
+			{
+				std::size_t n = std::min(static_cast<std::size_t>(length), _size - _pos);
+				std::memcpy(buffer, _pData + _pos, n);
+				_pos += n;
+				return static_cast<int>(n);
+			}
+			else return HTTPServerSession::receive(buffer, length);
+		}
+
+	private:
+		const char* _pData;
+		std::size_t _size;
+		std::size_t _pos;
+	};
+}
+
+
+//
+// ReactorHTTPServer::Connection
+//
+
+
+class ReactorHTTPServer::Connection: public Poco::RefCountedObject
+	/// A connection is registered with its reactor while
+	/// a request is being received, and handled by a worker
+	/// thread once the request is complete.
+{
+public:
+	Connection(ReactorHTTPServer& server, const StreamSocket& socket, SocketReactor& reactor):
+		_server(server),
+		_socket(socket),
+		_reactor(reactor),
+		_buffer(HTTPBufferAllocator::BUFFER_SIZE),
+		_used(0),
+		_scanPos(0),
+		_headSize(0),
+		_requestSize(0),
+		_requests(0),
+		_registered(false),
+		_detached(false),
+		_readable(*this, &Connection::onReadable),
+		_timeout(*this, &Connection::onTimeout)
+	{
+	}
+
+	void start()
+	{
+		_socket.setBlocking(false);
+		registerHandlers();
+	}
+
+	void close()
+	{
+		unregisterHandlers();
+		try
+		{
+			_socket.close();
+		}
+		catch (...)
+		{
+		}
+		_server.remove(this);
+	}
+
+	void onReadable(ReadableNotification* pNf)
+	{
+		pNf->release();
+		try
+		{
+			if (_used == _buffer.size())
+			{
+				_buffer.resize(std::min<std::size_t>(2*_buffer.size(), MAX_REQUEST_SIZE));
+			}
+			int n = _socket.receiveBytes(&_buffer[_used], static_cast<int>(_buffer.size() - _used));
+			if (n > 0)
+			{
+				_used += n;
+				_lastActivity.update();
+				if (requestComplete())
+				{
+					unregisterHandlers();
+					_server.enqueue(this);
+				}
+				else if (_used == MAX_REQUEST_SIZE)
+				{
+					sendError("400 Bad Request");
+					close();
+				}
+			}
+			else if (n == 0) close();
+		}
+		catch (Poco::Exception&)
+		{
+			close();
+		}
+	}
+
+	void onTimeout(TimeoutNotification* pNf)
+	{
+		pNf->release();
+		const Poco::Timespan& timeout = _requests == 0 ? _server._pParams->getTimeout() : _server._pParams->getKeepAliveTimeout();
+		if (_lastActivity.isElapsed(timeout.totalMicroseconds())) close();
+	}
+
+	void handleRequests()
+	{
+		// Called by a worker thread, while the connection
+		// is not registered with its reactor.
+		bool keepAlive = false;
+		try
+		{
+			_socket.setBlocking(true);
+			do
+			{
+				keepAlive = handleRequest();
+			}
+			while (keepAlive && !_server._stopped && requestComplete());
+		}
+		catch (Poco::Exception& exc)
+		{
+			ErrorHandler::handle(exc);
+			keepAlive = false;
+		}
+
+		if (_detached)
+		{
+			// The request handler has taken over the socket.
+			_server.remove(this);
+		}
+		else if (keepAlive && !_server._stopped)
+		{
+			_lastActivity.update();
+			_socket.setBlocking(false);
+			registerHandlers();
+			_reactor.wakeUp();
+		}
+		else close();
+	}
+
+	void sendError(const std::string& status)
+	{
+		std::string response("HTTP/1.1 ");
+		response += status;
+		response += "\r\nConnection: close\r\nContent-Length: 0\r\n\r\n";
+		try
+		{
+			_socket.sendBytes(response.data(), static_cast<int>(response.size()));
+		}
+		catch (...)
+		{
+		}
+	}
+
+protected:
+	~Connection()
+	{
+	}
+
+private:
+	bool requestComplete()
+		/// Returns true if the buffer contains a complete request
+		/// header, followed by the request body if the request
+		/// has a Content-Length that fits into the buffer.
+	{
+		if (_headSize == 0)
+		{
+			for (; _scanPos < _used; ++_scanPos)
+			{
+				if (_buffer[_scanPos] == '\n' && _scanPos > 0 &&
+					(_buffer[_scanPos - 1] == '\n' || (_scanPos > 1 && _buffer[_scanPos - 1] == '\r' && _buffer[_scanPos - 2] == '\n')))
+				{
+					_headSize = _scanPos + 1;
+					break;
+				}
+			}
+			if (_headSize == 0) return false;
+
+			_requestSize = _headSize;
+			Poco::Int64 length = contentLength();
+			if (length > 0 && _headSize + length <= MAX_REQUEST_SIZE)
+			{
+				_requestSize += static_cast<std::size_t>(length);
+			}
+		}
+		return _used >= _requestSize;
+	}
+
+	Poco::Int64 contentLength() const
+		/// Returns the value of the Content-Length header,
+		/// or -1 if there is none.
+	{
+		static const std::string CONTENT_LENGTH("Content-Length");
+		static const std::string TRANSFER_ENCODING("Transfer-Encoding");
+
+		Poco::Int64 length = -1;
+		std::string head(&_buffer[0], _headSize);
+		std::string::size_type pos = head.find('\n');
+		while (pos != std::string::npos)
+		{
+			std::string::size_type end = head.find('\n', pos + 1);
+			std::string::size_type colon = head.find(':', pos + 1);
+			if (end != std::string::npos && colon < end)
+			{
+				std::string name = Poco::trim(head.substr(pos + 1, colon - pos - 1));
+				if (Poco::icompare(name, TRANSFER_ENCODING) == 0)
+				{
+					return -1;
+				}
+				else if (Poco::icompare(name, CONTENT_LENGTH) == 0)
+				{
+					if (!Poco::NumberParser::tryParse64(Poco::trim(head.substr(colon + 1, end - colon - 1)), length)) return -1;
+				}
+			}
+			pos = end;
+		}
+		return length;
+	}
+
+	bool handleRequest()
+		/// Handles a single request and returns true if the
+		/// connection can be kept alive.
+	{
+		HTTPServerParams::Ptr pParams = _server._pParams;
+		ReactorHTTPServerSession session(_socket, pParams, &_buffer[0], _used);
+		++_requests;
+		bool canKeepAlive = pParams->getKeepAlive() && (pParams->getMaxKeepAliveRequests() <= 0 || _requests < pParams->getMaxKeepAliveRequests());
+		try
+		{
+			HTTPServerResponseImpl response(session);
+			HTTPServerRequestImpl request(response, session, pParams);
+			++_server._totalRequests;
+
+			Poco::Timestamp now;
+			response.setDate(now);
+			response.setVersion(request.getVersion());
+			response.setKeepAlive(canKeepAlive && request.getKeepAlive());
+			const std::string& server = pParams->getSoftwareVersion();
+			if (!server.empty())
+				response.set("Server", server);
+			try
+			{
+				std::unique_ptr<HTTPRequestHandler> pHandler(_server._pFactory->createRequestHandler(request));
+				if (pHandler.get())
+				{
+					if (request.getExpectContinue() && response.getStatus() == HTTPResponse::HTTP_OK)
+						response.sendContinue();
+
+					pHandler->handleRequest(request, response);
+					session.setKeepAlive(canKeepAlive && response.getKeepAlive());
+				}
+				else sendErrorResponse(session, HTTPResponse::HTTP_NOT_IMPLEMENTED);
+			}
+			catch (Poco::Exception&)
+			{
+				if (!response.sent())
+				{
+					try
+					{
+						sendErrorResponse(session, HTTPResponse::HTTP_INTERNAL_SERVER_ERROR);
+					}
+					catch (...)
+					{
+					}
+				}
+				throw;
+			}
+		}
+		catch (NoMessageException&)
+		{
+			return false;
+		}
+		catch (MessageException&)
+		{
+			sendErrorResponse(session, HTTPResponse::HTTP_BAD_REQUEST);
+			return false;
+		}
+		if (!session.connected())
+		{
+			_detached = true;
+			return false;
+		}
+		if (!session.getKeepAlive()) return false;
+
+		// Keep whatever the session has read beyond the request,
+		// followed by the data it has not yet consumed.
+		Poco::Buffer<char> rest(0);
+		session.drainBuffer(rest);
+		std::vector<char> buffer(rest.begin(), rest.end());
+		buffer.insert(buffer.end(), _buffer.begin() + session.consumed(), _buffer.begin() + _used);
+		_used = buffer.size();
+		if (buffer.size() < HTTPBufferAllocator::BUFFER_SIZE) buffer.resize(HTTPBufferAllocator::BUFFER_SIZE);
+		_buffer.swap(buffer);
+		_scanPos = 0;
+		_headSize = 0;
+		_requestSize = 0;
+		return true;
+	}
+
+	void sendErrorResponse(HTTPServerSession& session, HTTPResponse::HTTPStatus status)
+	{
+		HTTPServerResponseImpl response(session);
+		response.setVersion(HTTPMessage::HTTP_1_1);
+		response.setStatusAndReason(status);
+		response.setKeepAlive(false);
+		response.send();
+		session.setKeepAlive(false);
+	}
+
+	void registerHandlers()
+	{
+		_registered = true;
+		_reactor.addEventHandler(_socket, _timeout);
+		_reactor.addEventHandler(_socket, _readable);
+	}
+
+	void unregisterHandlers()
+	{
+		if (_registered)
+		{
+			_registered = false;
+			_reactor.removeEventHandler(_socket, _readable);
+			_reactor.removeEventHandler(_socket, _timeout);
+		}
+	}
+
+	ReactorHTTPServer&  _server;
+	StreamSocket        _socket;
+	SocketReactor&      _reactor;
+	std::vector<char>   _buffer;
+	std::size_t         _used;
+	std::size_t         _scanPos;
+	std::size_t         _headSize;
+	std::size_t         _requestSize;
+	int                 _requests;
+	bool                _registered;
+	bool                _detached;
+	Poco::Timestamp     _lastActivity;
+	Poco::Observer<Connection, ReadableNotification> _readable;
+	Poco::Observer<Connection, TimeoutNotification>  _timeout;
+};
+
+
+//
+// ReactorHTTPServer::Reactor
+//
+
+
+class ReactorHTTPServer::Reactor: public SocketReactor
+	/// A SocketReactor that dispatches the TimeoutNotification
+	/// at least once per timeout, even if it never runs out of
+	/// events, so that idle connections expire while others
+	/// keep the reactor busy.
+{
+public:
+	Reactor()
+	{
+	}
+
+protected:
+	void onTimeout()
+	{
+		_lastTimeout.update();
+		SocketReactor::onTimeout();
+	}
+
+	void onBusy()
+	{
+		if (_lastTimeout.isElapsed(getTimeout().totalMicroseconds()))
+		{
+			onTimeout();
+		}
+	}
+
+private:
+	Poco::Timestamp _lastTimeout;
+};
+
+
+namespace
+{
+	class RequestNotification: public Poco::Notification
+	{
+	public:
+		typedef Poco::AutoPtr<RequestNotification> Ptr;
+
+		RequestNotification(Poco::RefCountedObject* pConnection):
+			_pConnection(pConnection, true)
+		{
+		}
+
+		Poco::RefCountedObject* connection()
+		{
+			return _pConnection.get();
+		}
+
+	private:
+		Poco::AutoPtr<Poco::RefCountedObject> _pConnection;
+	};
+}
+
+
+//
+// ReactorHTTPServer
+//
+
+
+ReactorHTTPServer::ReactorHTTPServer(HTTPRequestHandlerFactory::Ptr pFactory, const ServerSocket& socket, HTTPServerParams::Ptr pParams, int reactors):
+	_pFactory(pFactory),
+	_pParams(pParams),
+	_threadPool(Poco::ThreadPool::defaultPool()),
+	_socket(socket),
+	_next(0),
+	_stopped(false),
+	_workers(0),
+	_totalConnections(0),
+	_totalRequests(0),
+	_refusedRequests(0),
+	_started(false)
+{
+	int toAdd = _pParams->getMaxThreads() - _threadPool.capacity();
+	if (toAdd > 0) _threadPool.addCapacity(toAdd);
+	init(reactors);
+}
+
+
+ReactorHTTPServer::ReactorHTTPServer(HTTPRequestHandlerFactory::Ptr pFactory, Poco::ThreadPool& threadPool, const ServerSocket& socket, HTTPServerParams::Ptr pParams, int reactors):
+	_pFactory(pFactory),
+	_pParams(pParams),
+	_threadPool(threadPool),
+	_socket(socket),
+	_next(0),
+	_stopped(false),
+	_workers(0),
+	_totalConnections(0),
+	_totalRequests(0),
+	_refusedRequests(0),
+	_started(false)
+{
+	init(reactors);
+}
+
+
+ReactorHTTPServer::~ReactorHTTPServer()
+{
+	try
+	{
+		stop();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+	for (std::vector<Poco::Thread*>::iterator it = _threads.begin(); it != _threads.end(); ++it)
+	{
+		delete *it;
+	}
+	for (std::vector<SocketReactor*>::iterator it = _reactors.begin(); it != _reactors.end(); ++it)
+	{
+		delete *it;
+	}
+}
+
+
+void ReactorHTTPServer::init(int reactors)
+{
+	poco_check_ptr (_pFactory);
+	poco_check_ptr (_pParams);
+	poco_assert (reactors > 0);
+
+	if (_pParams->getMaxThreads() == 0)
+		_pParams->setMaxThreads(_threadPool.capacity());
+
+	for (int i = 0; i < reactors; ++i)
+	{
+		_reactors.push_back(new Reactor);
+		_threads.push_back(new Poco::Thread("ReactorHTTPServer"));
+	}
+}
+
+
+void ReactorHTTPServer::start()
+{
+	poco_assert (!_started);
+
+	_started = true;
+	_reactors[0]->addEventHandler(_socket, Poco::Observer<ReactorHTTPServer, ReadableNotification>(*this, &ReactorHTTPServer::onAccept));
+	for (std::size_t i = 0; i < _reactors.size(); ++i)
+	{
+		_threads[i]->start(*_reactors[i]);
+	}
+}
+
+
+void ReactorHTTPServer::stop()
+{
+	if (!_started || _stopped.exchange(true)) return;
+
+	_reactors[0]->removeEventHandler(_socket, Poco::Observer<ReactorHTTPServer, ReadableNotification>(*this, &ReactorHTTPServer::onAccept));
+	for (std::size_t i = 0; i < _reactors.size(); ++i)
+	{
+		_reactors[i]->stop();
+		_reactors[i]->wakeUp();
+	}
+	for (std::size_t i = 0; i < _threads.size(); ++i)
+	{
+		_threads[i]->join();
+	}
+
+	while (_workers > 0)
+	{
+		_queue.wakeUpAll();
+		_workersDone.tryWait(100);
+	}
+	_queue.clear();
+
+	ConnectionSet connections;
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+		connections = _connections;
+	}
+	for (ConnectionSet::iterator it = connections.begin(); it != connections.end(); ++it)
+	{
+		ConnectionPtr pConnection(*it);
+		pConnection->close();
+	}
+}
+
+
+int ReactorHTTPServer::totalConnections() const
+{
+	return _totalConnections;
+}
+
+
+int ReactorHTTPServer::currentConnections() const
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	return static_cast<int>(_connections.size());
+}
+
+
+int ReactorHTTPServer::totalRequests() const
+{
+	return _totalRequests;
+}
+
+
+int ReactorHTTPServer::queuedRequests() const
+{
+	return _queue.size();
+}
+
+
+int ReactorHTTPServer::refusedRequests() const
+{
+	return _refusedRequests;
+}
+
+
+void ReactorHTTPServer::run()
+{
+	int idleTime = static_cast<int>(_pParams->getThreadIdleTime().totalMilliseconds());
+
+	for (;;)
+	{
+		try
+		{
+			Poco::AutoPtr<Notification> pNf = _queue.waitDequeueNotification(idleTime);
+			RequestNotification* pRNf = dynamic_cast<RequestNotification*>(pNf.get());
+			if (pRNf)
+			{
+				static_cast<Connection*>(pRNf->connection())->handleRequests();
+			}
+		}
+		catch (Poco::Exception& exc)
+		{
+			ErrorHandler::handle(exc);
+		}
+		catch (std::exception& exc)
+		{
+			ErrorHandler::handle(exc);
+		}
+		catch (...)
+		{
+			ErrorHandler::handle();
+		}
+		if (_stopped || (_workers > 1 && _queue.empty())) break;
+	}
+	// last access to this object, as stop() may return right after
+	_workersDone.set();
+	--_workers;
+}
+
+
+void ReactorHTTPServer::onAccept(ReadableNotification* pNotification)
+{
+	pNotification->release();
+	try
+	{
+		StreamSocket ss = _socket.acceptConnection();
+		ss.setNoDelay(true);
+		SocketReactor& reactor = *_reactors[_next];
+		if (++_next == _reactors.size()) _next = 0;
+		ConnectionPtr pConnection = new Connection(*this, ss, reactor);
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+			_connections.insert(pConnection);
+		}
+		++_totalConnections;
+		pConnection->start();
+	}
+	catch (Poco::Exception& exc)
+	{
+		ErrorHandler::handle(exc);
+	}
+}
+
+
+void ReactorHTTPServer::enqueue(Connection* pConnection)
+{
+	if (_queue.size() >= _pParams->getMaxQueued())
+	{
+		++_refusedRequests;
+		pConnection->sendError("503 Service Unavailable");
+		pConnection->close();
+	}
+	else
+	{
+		_queue.enqueueNotification(new RequestNotification(pConnection));
+		if (!_queue.hasIdleThreads())
+		{
+			if (++_workers <= _pParams->getMaxThreads())
+			{
+				try
+				{
+					_threadPool.startWithPriority(_pParams->getThreadPriority(), *this, "ReactorHTTPServer");
+					return;
+				}
+				catch (Poco::Exception&)
+				{
+					// the request is already queued and will
+					// be handled by one of the running workers
+				}
+			}
+			--_workers;
+		}
+	}
+}
+
+
+void ReactorHTTPServer::remove(Connection* pConnection)
+{
+	ConnectionPtr pGuard(pConnection, true);
+	Poco::FastMutex::ScopedLock lock(_mutex);
+	_connections.erase(pGuard);
+}
+
+
+} } // namespace Poco::Net
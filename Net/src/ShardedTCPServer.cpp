@@ -0,0 +1,289 @@
+//
+// ShardedTCPServer.cpp
+//
+// Library: Net
+// Package: TCPServer
+// Module:  ShardedTCPServer
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Net/ShardedTCPServer.h"
+#include "Poco/Net/StreamSocket.h"
+#include "Poco/Environment.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/Exception.h"
+#include "Poco/ErrorHandler.h"
+
+
+using Poco::ErrorHandler;
+
+
+namespace Poco {
+namespace Net {
+
+
+//
+// ShardedTCPServer::Shard
+//
+
+
+ShardedTCPServer::Shard::Shard(ShardedTCPServer& server, const ServerSocket& socket, const std::string& name, int maxThreads, TCPServerParams::Ptr pParams):
+	server(server),
+	socket(socket),
+	thread(name),
+	threadPool(name, 1, maxThreads),
+	pDispatcher(new TCPServerDispatcher(server._pFactory, threadPool, pParams)),
+	refusedConnections(0)
+{
+}
+
+
+ShardedTCPServer::Shard::~Shard()
+{
+	pDispatcher->release();
+}
+
+
+void ShardedTCPServer::Shard::run()
+{
+	server.run(*this);
+}
+
+
+//
+// ShardedTCPServer
+//
+
+
+ShardedTCPServer::ShardedTCPServer(TCPServerConnectionFactory::Ptr pFactory, const SocketAddress& address, int shards, int backlog, TCPServerParams::Ptr pParams):
+	_pFactory(pFactory),
+	_affinity(false),
+	_stopped(true),
+	_started(false)
+{
+	poco_check_ptr (pFactory);
+	poco_assert (shards >= 0);
+
+	if (shards == 0) shards = static_cast<int>(Environment::processorCount());
+	if (shards == 0) shards = 1;
+#if !defined(SO_REUSEPORT)
+	shards = 1;
+#endif
+
+	int maxThreads = pParams && pParams->getMaxThreads() > 0 ? pParams->getMaxThreads() : 16;
+	try
+	{
+		SocketAddress shardAddress(address);
+		for (int i = 0; i < shards; ++i)
+		{
+			ServerSocket socket;
+			socket.bind(shardAddress, true, true);
+			socket.listen(backlog);
+			if (i == 0) shardAddress = SocketAddress(address.host(), socket.address().port());
+			std::string name("ShardedTCPServer " + NumberFormatter::format(i) + ": " + socket.address().toString());
+			_shards.push_back(new Shard(*this, socket, name, maxThreads, pParams));
+		}
+	}
+	catch (...)
+	{
+		for (ShardList::iterator it = _shards.begin(); it != _shards.end(); ++it)
+		{
+			delete *it;
+		}
+		throw;
+	}
+}
+
+
+ShardedTCPServer::~ShardedTCPServer()
+{
+	try
+	{
+		stop();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+	for (ShardList::iterator it = _shards.begin(); it != _shards.end(); ++it)
+	{
+		delete *it;
+	}
+}
+
+
+void ShardedTCPServer::start()
+{
+	poco_assert (!_started);
+
+	_started = true;
+	_stopped = false;
+	int cpus = static_cast<int>(Environment::processorCount());
+	for (std::size_t i = 0; i < _shards.size(); ++i)
+	{
+		_shards[i]->thread.start(*_shards[i]);
+		if (_affinity && cpus > 0) _shards[i]->thread.setAffinity(static_cast<int>(i) % cpus);
+	}
+}
+
+
+void ShardedTCPServer::stop()
+{
+	if (!_stopped)
+	{
+		_stopped = true;
+		for (ShardList::iterator it = _shards.begin(); it != _shards.end(); ++it)
+		{
+			(*it)->thread.join();
+		}
+		for (ShardList::iterator it = _shards.begin(); it != _shards.end(); ++it)
+		{
+			(*it)->pDispatcher->stop();
+		}
+		for (ShardList::iterator it = _shards.begin(); it != _shards.end(); ++it)
+		{
+			(*it)->threadPool.joinAll();
+		}
+	}
+}
+
+
+void ShardedTCPServer::setAffinity(bool flag)
+{
+	poco_assert (!_started);
+
+	_affinity = flag;
+}
+
+
+const ServerSocket& ShardedTCPServer::socket(int shard) const
+{
+	poco_assert (shard >= 0 && shard < shards());
+
+	return _shards[shard]->socket;
+}
+
+
+ShardedTCPServer::Statistics ShardedTCPServer::statistics(int shard) const
+{
+	poco_assert (shard >= 0 && shard < shards());
+
+	const Shard& s = *_shards[shard];
+	Statistics stats;
+	stats.totalConnections   = s.pDispatcher->totalConnections();
+	stats.currentConnections = s.pDispatcher->currentConnections();
+	stats.queuedConnections  = s.pDispatcher->queuedConnections();
+	stats.refusedConnections = s.pDispatcher->refusedConnections() + s.refusedConnections;
+	return stats;
+}
+
+
+int ShardedTCPServer::totalConnections() const
+{
+	int n = 0;
+	for (ShardList::const_iterator it = _shards.begin(); it != _shards.end(); ++it)
+	{
+		n += (*it)->pDispatcher->totalConnections();
+	}
+	return n;
+}
+
+
+int ShardedTCPServer::currentConnections() const
+{
+	int n = 0;
+	for (ShardList::const_iterator it = _shards.begin(); it != _shards.end(); ++it)
+	{
+		n += (*it)->pDispatcher->currentConnections();
+	}
+	return n;
+}
+
+
+int ShardedTCPServer::queuedConnections() const
+{
+	int n = 0;
+	for (ShardList::const_iterator it = _shards.begin(); it != _shards.end(); ++it)
+	{
+		n += (*it)->pDispatcher->queuedConnections();
+	}
+	return n;
+}
+
+
+int ShardedTCPServer::refusedConnections() const
+{
+	int n = 0;
+	for (ShardList::const_iterator it = _shards.begin(); it != _shards.end(); ++it)
+	{
+		n += (*it)->pDispatcher->refusedConnections() + (*it)->refusedConnections;
+	}
+	return n;
+}
+
+
+void ShardedTCPServer::setConnectionFilter(const TCPServerConnectionFilter::Ptr& pConnectionFilter)
+{
+	poco_assert (!_started);
+
+	_pConnectionFilter = pConnectionFilter;
+}
+
+
+void ShardedTCPServer::run(Shard& shard)
+{
+	while (!_stopped)
+	{
+		Poco::Timespan timeout(250000);
+		try
+		{
+			if (shard.socket.poll(timeout, Socket::SELECT_READ))
+			{
+				try
+				{
+					StreamSocket ss = shard.socket.acceptConnection();
+
+					if (!_pConnectionFilter || _pConnectionFilter->accept(ss))
+					{
+						// enable nodelay per default: OSX really needs that
+#if defined(POCO_OS_FAMILY_UNIX)
+						if (ss.address().family() != AddressFamily::UNIX_LOCAL)
+#endif
+						{
+							ss.setNoDelay(true);
+						}
+						shard.pDispatcher->enqueue(ss);
+					}
+					else ++shard.refusedConnections;
+				}
+				catch (Poco::Exception& exc)
+				{
+					ErrorHandler::handle(exc);
+				}
+				catch (std::exception& exc)
+				{
+					ErrorHandler::handle(exc);
+				}
+				catch (...)
+				{
+					ErrorHandler::handle();
+				}
+			}
+		}
+		catch (Poco::Exception& exc)
+		{
+			ErrorHandler::handle(exc);
+			// possibly a resource issue since poll() failed;
+			// give some time to recover before trying again
+			Poco::Thread::sleep(50);
+		}
+	}
+}
+
+
+} } // namespace Poco::Net
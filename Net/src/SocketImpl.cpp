@@ -17,6 +17,9 @@
 #include "Poco/Net/StreamSocketImpl.h"
 #include "Poco/NumberFormatter.h"
 #include "Poco/Timestamp.h"
+#include "Poco/FileStream.h"
+#include "Poco/Buffer.h"
+#include <algorithm>
 #include <string.h> // FD_SET needs memset on some platforms, so we can't use <cstring>
 
 
@@ -51,6 +54,11 @@
 #endif
 
 
+#if POCO_OS == POCO_OS_LINUX
+#include <sys/sendfile.h>
+#endif
+
+
 using Poco::IOException;
 using Poco::TimeoutException;
 using Poco::InvalidArgumentException;
@@ -362,6 +370,71 @@ int SocketImpl::sendBytes(const SocketBufVec& buffers, int flags)
 }
 
 
+Poco::UInt64 SocketImpl::sendFile(FileInputStream& fileInputStream, Poco::UInt64 offset, Poco::UInt64 count)
+{
+	Poco::UInt64 sent = 0;
+#if POCO_OS == POCO_OS_LINUX
+	if (!secure())
+	{
+		checkBrokenTimeout(SELECT_WRITE);
+
+		int fd = fileInputStream.nativeHandle();
+		while (sent < count)
+		{
+			if (_sockfd == POCO_INVALID_SOCKET) throw InvalidSocketException();
+			off_t off = static_cast<off_t>(offset + sent);
+			std::size_t n = static_cast<std::size_t>(std::min<Poco::UInt64>(count - sent, SENDFILE_CHUNK_SIZE));
+			ssize_t rc = ::sendfile(_sockfd, fd, &off, n);
+			if (rc > 0)
+			{
+				sent += rc;
+			}
+			else if (rc == 0)
+			{
+				// end of file
+				return sent;
+			}
+			else
+			{
+				int err = lastError();
+				if (err == POCO_EINTR && _blocking)
+					continue;
+				else if (err == POCO_EAGAIN && !_blocking)
+					return sent;
+				else if ((err == EINVAL || err == ENOSYS) && sent == 0)
+					break; // not supported for this file; copy it instead
+				else if (err == POCO_EAGAIN || err == POCO_ETIMEDOUT)
+					throw TimeoutException(err);
+				else
+					error(err);
+			}
+		}
+		if (sent == count) return sent;
+	}
+#endif
+	Poco::Buffer<char> buffer(static_cast<std::size_t>(std::min<Poco::UInt64>(count, COPY_BUFFER_SIZE)));
+	while (sent < count)
+	{
+		fileInputStream.clear();
+		fileInputStream.seekg(static_cast<std::streamoff>(offset + sent), std::ios::beg);
+		std::streamsize n = static_cast<std::streamsize>(std::min<Poco::UInt64>(count - sent, buffer.size()));
+		fileInputStream.read(buffer.begin(), n);
+		n = fileInputStream.gcount();
+		if (n <= 0) break;
+		int pos = 0;
+		while (pos < n)
+		{
+			if (!_blocking && !poll(Poco::Timespan(0), SELECT_WRITE)) return sent;
+			int rc = sendBytes(buffer.begin() + pos, static_cast<int>(n - pos));
+			if (rc <= 0) return sent;
+			pos  += rc;
+			sent += rc;
+		}
+	}
+	return sent;
+}
+
+
 int SocketImpl::receiveBytes(void* buffer, int length, int flags)
 {
 	checkBrokenTimeout(SELECT_READ);
@@ -597,6 +670,137 @@ int SocketImpl::receiveFrom(SocketBufVec& buffers, struct sockaddr** pSA, poco_s
 }
 
 
+int SocketImpl::receiveBatch(DatagramBufVec& datagrams, int flags)
+{
+	if (datagrams.empty()) return 0;
+
+	checkBrokenTimeout(SELECT_READ);
+#if POCO_OS == POCO_OS_LINUX
+	struct mmsghdr msgs[MAX_BATCH_SIZE];
+	struct iovec iovs[MAX_BATCH_SIZE];
+	unsigned count = static_cast<unsigned>(std::min<std::size_t>(datagrams.size(), MAX_BATCH_SIZE));
+	for (unsigned i = 0; i < count; ++i)
+	{
+		iovs[i].iov_base = datagrams[i].buffer;
+		iovs[i].iov_len  = datagrams[i].length;
+		memset(&msgs[i].msg_hdr, 0, sizeof(msgs[i].msg_hdr));
+		msgs[i].msg_hdr.msg_name    = datagrams[i].pAddress;
+		msgs[i].msg_hdr.msg_namelen = datagrams[i].pAddress ? datagrams[i].addressLength : 0;
+		msgs[i].msg_hdr.msg_iov     = &iovs[i];
+		msgs[i].msg_hdr.msg_iovlen  = 1;
+		msgs[i].msg_len = 0;
+	}
+	int rc;
+	do
+	{
+		if (_sockfd == POCO_INVALID_SOCKET) throw InvalidSocketException();
+		rc = ::recvmmsg(_sockfd, msgs, count, flags | MSG_WAITFORONE, 0);
+	}
+	while (_blocking && rc < 0 && lastError() == POCO_EINTR);
+	if (rc < 0)
+	{
+		int err = lastError();
+		if (err == POCO_EAGAIN && !_blocking)
+			;
+		else if (err == POCO_EAGAIN || err == POCO_ETIMEDOUT)
+			throw TimeoutException(err);
+		else
+			error(err);
+		return rc;
+	}
+	for (int i = 0; i < rc; ++i)
+	{
+		datagrams[i].length = static_cast<int>(msgs[i].msg_len);
+		datagrams[i].addressLength = msgs[i].msg_hdr.msg_namelen;
+	}
+	return rc;
+#else
+	DatagramBuf& datagram = datagrams[0];
+	int rc;
+	if (datagram.pAddress)
+	{
+		poco_socklen_t* pSALen = &datagram.addressLength;
+		rc = receiveFrom(datagram.buffer, datagram.length, &datagram.pAddress, &pSALen, flags);
+	}
+	else rc = receiveBytes(datagram.buffer, datagram.length, flags);
+	if (rc < 0) return rc;
+	datagram.length = rc;
+	return 1;
+#endif
+}
+
+
+int SocketImpl::sendBatch(const DatagramBufVec& datagrams, int flags)
+{
+	checkBrokenTimeout(SELECT_WRITE);
+
+	std::size_t sent = 0;
+#if POCO_OS == POCO_OS_LINUX
+	struct mmsghdr msgs[MAX_BATCH_SIZE];
+	struct iovec iovs[MAX_BATCH_SIZE];
+	while (sent < datagrams.size())
+	{
+		unsigned count = static_cast<unsigned>(std::min<std::size_t>(datagrams.size() - sent, MAX_BATCH_SIZE));
+		for (unsigned i = 0; i < count; ++i)
+		{
+			const DatagramBuf& datagram = datagrams[sent + i];
+			iovs[i].iov_base = datagram.buffer;
+			iovs[i].iov_len  = datagram.length;
+			memset(&msgs[i].msg_hdr, 0, sizeof(msgs[i].msg_hdr));
+			msgs[i].msg_hdr.msg_name    = datagram.pAddress;
+			msgs[i].msg_hdr.msg_namelen = datagram.pAddress ? datagram.addressLength : 0;
+			msgs[i].msg_hdr.msg_iov     = &iovs[i];
+			msgs[i].msg_hdr.msg_iovlen  = 1;
+			msgs[i].msg_len = 0;
+		}
+		int rc;
+		do
+		{
+			if (_sockfd == POCO_INVALID_SOCKET) throw InvalidSocketException();
+			rc = ::sendmmsg(_sockfd, msgs, count, flags);
+		}
+		while (_blocking && rc < 0 && lastError() == POCO_EINTR);
+		if (rc < 0)
+		{
+			int err = lastError();
+			if (err == POCO_EAGAIN && !_blocking)
+				break;
+			else if (err == POCO_EAGAIN || err == POCO_ETIMEDOUT)
+				throw TimeoutException(err);
+			else
+				error(err);
+		}
+		sent += rc;
+		if (rc < static_cast<int>(count) && !_blocking) break;
+	}
+#else
+	for (; sent < datagrams.size(); ++sent)
+	{
+		const DatagramBuf& datagram = datagrams[sent];
+		int rc;
+		do
+		{
+			if (_sockfd == POCO_INVALID_SOCKET) throw InvalidSocketException();
+			if (datagram.pAddress)
+				rc = ::sendto(_sockfd, reinterpret_cast<const char*>(datagram.buffer), datagram.length, flags, datagram.pAddress, datagram.addressLength);
+			else
+				rc = ::send(_sockfd, reinterpret_cast<const char*>(datagram.buffer), datagram.length, flags);
+		}
+		while (_blocking && rc < 0 && lastError() == POCO_EINTR);
+		if (rc < 0)
+		{
+			int err = lastError();
+			if (err == POCO_EAGAIN && !_blocking)
+				break;
+			else
+				error(err);
+		}
+	}
+#endif
+	return static_cast<int>(sent);
+}
+
+
 void SocketImpl::sendUrgent(unsigned char data)
 {
 	if (_sockfd == POCO_INVALID_SOCKET) throw InvalidSocketException();
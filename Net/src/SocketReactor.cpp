@@ -33,6 +33,9 @@ namespace Net {
 SocketReactor::SocketReactor():
 	_stop(false),
 	_timeout(DEFAULT_TIMEOUT),
+	_pTable(new NotifierTable(INITIAL_TABLE_SIZE)),
+	_retired(false),
+	_pollOptions(0),
 	_pReadableNotification(new ReadableNotification(this)),
 	_pWritableNotification(new WritableNotification(this)),
 	_pErrorNotification(new ErrorNotification(this)),
@@ -47,6 +50,9 @@ SocketReactor::SocketReactor():
 SocketReactor::SocketReactor(const Poco::Timespan& timeout):
 	_stop(false),
 	_timeout(timeout),
+	_pTable(new NotifierTable(INITIAL_TABLE_SIZE)),
+	_retired(false),
+	_pollOptions(0),
 	_pReadableNotification(new ReadableNotification(this)),
 	_pWritableNotification(new WritableNotification(this)),
 	_pErrorNotification(new ErrorNotification(this)),
@@ -60,6 +66,14 @@ SocketReactor::SocketReactor(const Poco::Timespan& timeout):
 
 SocketReactor::~SocketReactor()
 {
+	NotifierTable* pTable = _pTable.load();
+	for (std::size_t i = 0; i < pTable->size; ++i)
+	{
+		SocketNotifier* pNotifier = pTable->slots[i].load();
+		if (pNotifier) pNotifier->release();
+	}
+	delete pTable;
+	reclaim();
 }
 
 
@@ -70,6 +84,7 @@ void SocketReactor::run()
 	{
 		try
 		{
+			reclaim();
 			if (!hasSocketHandlers())
 			{
 				onIdle();
@@ -80,22 +95,33 @@ void SocketReactor::run()
 			else
 			{
 				bool readable = false;
-				PollSet::SocketModeMap sm = _pollSet.poll(_timeout);
-				if (sm.size() > 0)
+				Poco::Timespan timeout = _pending.empty() ? _timeout : Poco::Timespan();
+				if (_pollSet.poll(_events, timeout) > 0 || !_pending.empty())
 				{
 					onBusy();
-					PollSet::SocketModeMap::iterator it = sm.begin();
-					PollSet::SocketModeMap::iterator end = sm.end();
+					_deferred.swap(_pending);
+					SocketEventList::const_iterator it = _events.begin();
+					SocketEventList::const_iterator end = _events.end();
 					for (; it != end; ++it)
 					{
-						if (it->second & PollSet::POLL_READ)
+						if (it->mode & PollSet::POLL_READ)
 						{
-							dispatch(it->first, _pReadableNotification);
+							dispatchReadable(it->fd);
 							readable = true;
 						}
-						if (it->second & PollSet::POLL_WRITE) dispatch(it->first, _pWritableNotification);
-						if (it->second & PollSet::POLL_ERROR) dispatch(it->first, _pErrorNotification);
+						if (it->mode & PollSet::POLL_WRITE) dispatch(it->fd, _pWritableNotification);
+						if (it->mode & PollSet::POLL_ERROR) dispatch(it->fd, _pErrorNotification);
 					}
+					for (it = _deferred.begin(), end = _deferred.end(); it != end; ++it)
+					{
+						SocketNotifier* pNotifier = getNotifier(it->fd);
+						if (pNotifier)
+						{
+							drain(pNotifier, it->fd);
+							readable = true;
+						}
+					}
+					_deferred.clear();
 				}
 				if (!readable) onTimeout();
 			}
@@ -114,6 +140,7 @@ void SocketReactor::run()
 		}
 	}
 	onShutdown();
+	reclaim();
 }
 
 
@@ -121,12 +148,13 @@ bool SocketReactor::hasSocketHandlers()
 {
 	if (!_pollSet.empty())
 	{
-		ScopedLock lock(_mutex);
-		for (EventHandlerMap::iterator it = _handlers.begin(); it != _handlers.end(); ++it)
+		NotifierTable* pTable = _pTable.load(std::memory_order_acquire);
+		for (std::size_t i = 0; i < pTable->size; ++i)
 		{
-			if (it->second->accepts(_pReadableNotification) ||
-				it->second->accepts(_pWritableNotification) ||
-				it->second->accepts(_pErrorNotification)) return true;
+			SocketNotifier* pNotifier = pTable->slots[i].load(std::memory_order_acquire);
+			if (pNotifier && (pNotifier->accepts(_pReadableNotification) ||
+				pNotifier->accepts(_pWritableNotification) ||
+				pNotifier->accepts(_pErrorNotification))) return true;
 		}
 	}
 
@@ -158,6 +186,20 @@ const Poco::Timespan& SocketReactor::getTimeout() const
 }
 
 
+void SocketReactor::setPollOptions(int options)
+{
+	poco_assert ((options & PollSet::POLL_ONESHOT) == 0);
+
+	_pollOptions = options;
+}
+
+
+int SocketReactor::getPollOptions() const
+{
+	return _pollOptions;
+}
+
+
 void SocketReactor::addEventHandler(const Socket& socket, const Poco::AbstractObserver& observer)
 {
 	NotifierPtr pNotifier = getNotifier(socket, true);
@@ -168,7 +210,7 @@ void SocketReactor::addEventHandler(const Socket& socket, const Poco::AbstractOb
 	if (pNotifier->accepts(_pReadableNotification)) mode |= PollSet::POLL_READ;
 	if (pNotifier->accepts(_pWritableNotification)) mode |= PollSet::POLL_WRITE;
 	if (pNotifier->accepts(_pErrorNotification))    mode |= PollSet::POLL_ERROR;
-	if (mode) _pollSet.add(socket, mode);
+	if (mode) _pollSet.add(socket, mode | _pollOptions);
 }
 
 
@@ -187,12 +229,105 @@ SocketReactor::NotifierPtr SocketReactor::getNotifier(const Socket& socket, bool
 
 	EventHandlerMap::iterator it = _handlers.find(socket);
 	if (it != _handlers.end()) return it->second;
-	else if (makeNew) return (_handlers[socket] = new SocketNotifier(socket));
+	else if (makeNew)
+	{
+		NotifierPtr pNotifier = new SocketNotifier(socket);
+		_handlers[socket] = pNotifier;
+		publish(pNotifier);
+		return pNotifier;
+	}
 
 	return 0;
 }
 
 
+SocketNotifier* SocketReactor::getNotifier(poco_socket_t fd) const
+{
+	NotifierTable* pTable = _pTable.load(std::memory_order_acquire);
+	std::size_t index = static_cast<std::size_t>(fd);
+	if (index < pTable->size)
+		return pTable->slots[index].load(std::memory_order_acquire);
+	else
+		return 0;
+}
+
+
+void SocketReactor::publish(SocketNotifier* pNotifier)
+{
+	// Called with _mutex held.
+	if (pNotifier->descriptor() == POCO_INVALID_SOCKET) return;
+
+	std::size_t index = static_cast<std::size_t>(pNotifier->descriptor());
+	NotifierTable* pTable = _pTable.load(std::memory_order_relaxed);
+	if (index >= pTable->size)
+	{
+		std::size_t size = pTable->size;
+		while (size <= index) size *= 2;
+		NotifierTable* pNewTable = new NotifierTable(size);
+		for (std::size_t i = 0; i < pTable->size; ++i)
+		{
+			pNewTable->slots[i].store(pTable->slots[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+		}
+		_pTable.store(pNewTable, std::memory_order_release);
+		_retiredTables.push_back(pTable);
+		_retired = true;
+		pTable = pNewTable;
+	}
+	pNotifier->duplicate();
+	SocketNotifier* pOldNotifier = pTable->slots[index].exchange(pNotifier, std::memory_order_acq_rel);
+	if (pOldNotifier)
+	{
+		// The descriptor has been reused before the handlers
+		// of the previous socket have been removed.
+		_retiredNotifiers.push_back(pOldNotifier);
+		_retired = true;
+	}
+}
+
+
+void SocketReactor::unpublish(SocketNotifier* pNotifier)
+{
+	// Called with _mutex held.
+	NotifierTable* pTable = _pTable.load(std::memory_order_relaxed);
+	std::size_t index = static_cast<std::size_t>(pNotifier->descriptor());
+	if (index < pTable->size)
+	{
+		SocketNotifier* pExpected = pNotifier;
+		if (pTable->slots[index].compare_exchange_strong(pExpected, 0, std::memory_order_acq_rel))
+		{
+			_retiredNotifiers.push_back(pNotifier);
+			_retired = true;
+		}
+	}
+}
+
+
+void SocketReactor::reclaim()
+{
+	// The reactor thread does not hold on to notifiers or tables
+	// across iterations of the event loop, so anything removed from
+	// the table before the start of the current iteration can go.
+	if (!_retired.load(std::memory_order_acquire)) return;
+
+	NotifierList notifiers;
+	NotifierTableList tables;
+	{
+		ScopedLock lock(_mutex);
+		notifiers.swap(_retiredNotifiers);
+		tables.swap(_retiredTables);
+		_retired = false;
+	}
+	for (NotifierList::iterator it = notifiers.begin(); it != notifiers.end(); ++it)
+	{
+		(*it)->release();
+	}
+	for (NotifierTableList::iterator it = tables.begin(); it != tables.end(); ++it)
+	{
+		delete *it;
+	}
+}
+
+
 void SocketReactor::removeEventHandler(const Socket& socket, const Poco::AbstractObserver& observer)
 {
 	NotifierPtr pNotifier = getNotifier(socket);
@@ -203,6 +338,7 @@ void SocketReactor::removeEventHandler(const Socket& socket, const Poco::Abstrac
 			{
 				ScopedLock lock(_mutex);
 				_handlers.erase(socket);
+				unpublish(pNotifier);
 			}
 			_pollSet.remove(socket);
 		}
@@ -244,27 +380,66 @@ void SocketReactor::dispatch(const Socket& socket, SocketNotification* pNotifica
 {
 	NotifierPtr pNotifier = getNotifier(socket);
 	if (!pNotifier) return;
+	dispatch(pNotifier.get(), pNotification);
+}
+
+
+void SocketReactor::dispatch(poco_socket_t fd, SocketNotification* pNotification)
+{
+	SocketNotifier* pNotifier = getNotifier(fd);
+	if (!pNotifier) return;
 	dispatch(pNotifier, pNotification);
 }
 
 
-void SocketReactor::dispatch(SocketNotification* pNotification)
+void SocketReactor::dispatchReadable(poco_socket_t fd)
 {
-	std::vector<NotifierPtr> delegates;
+	SocketNotifier* pNotifier = getNotifier(fd);
+	if (!pNotifier) return;
+	dispatch(pNotifier, _pReadableNotification);
+	if (_pollOptions & PollSet::POLL_EDGE_TRIGGERED) drain(pNotifier, fd);
+}
+
+
+void SocketReactor::drain(SocketNotifier* pNotifier, poco_socket_t fd)
+{
+	// With edge-triggered polling, a socket is not reported again
+	// until new data arrives, so keep dispatching until a read would block.
+	for (int n = 0; ; ++n)
 	{
-		ScopedLock lock(_mutex);
-		delegates.reserve(_handlers.size());
-		for (EventHandlerMap::iterator it = _handlers.begin(); it != _handlers.end(); ++it)
-			delegates.push_back(it->second);
+		if (getNotifier(fd) != pNotifier || !pNotifier->accepts(_pReadableNotification)) return;
+
+		const Socket& socket = pNotifier->socket();
+		if (socket.impl()->sockfd() == POCO_INVALID_SOCKET || !socket.poll(Poco::Timespan(), Socket::SELECT_READ)) return;
+
+		if (n == DRAIN_LIMIT)
+		{
+			PollSet::SocketEvent ev;
+			ev.fd = fd;
+			ev.mode = PollSet::POLL_READ;
+			_pending.push_back(ev);
+			return;
+		}
+		dispatch(pNotifier, _pReadableNotification);
 	}
-	for (std::vector<NotifierPtr>::iterator it = delegates.begin(); it != delegates.end(); ++it)
+}
+
+
+void SocketReactor::dispatch(SocketNotification* pNotification)
+{
+	// Handlers added while dispatching may end up in a new table
+	// and will not see the notification. Handlers removed while
+	// dispatching may still see it, but stay valid until reclaim().
+	NotifierTable* pTable = _pTable.load(std::memory_order_acquire);
+	for (std::size_t i = 0; i < pTable->size; ++i)
 	{
-		dispatch(*it, pNotification);
+		SocketNotifier* pNotifier = pTable->slots[i].load(std::memory_order_acquire);
+		if (pNotifier) dispatch(pNotifier, pNotification);
 	}
 }
 
 
-void SocketReactor::dispatch(NotifierPtr& pNotifier, SocketNotification* pNotification)
+void SocketReactor::dispatch(SocketNotifier* pNotifier, SocketNotification* pNotification)
 {
 	try
 	{
@@ -285,4 +460,23 @@ void SocketReactor::dispatch(NotifierPtr& pNotifier, SocketNotification* pNotifi
 }
 
 
+//
+// SocketReactor::NotifierTable
+//
+
+
+SocketReactor::NotifierTable::NotifierTable(std::size_t n):
+	size(n),
+	slots(new std::atomic<SocketNotifier*>[n])
+{
+	for (std::size_t i = 0; i < n; ++i) slots[i].store(0, std::memory_order_relaxed);
+}
+
+
+SocketReactor::NotifierTable::~NotifierTable()
+{
+	delete [] slots;
+}
+
+
 } } // namespace Poco::Net
@@ -83,6 +83,15 @@ TCPServer::TCPServer(TCPServerConnectionFactory::Ptr pFactory, Poco::ThreadPool&
 }
 
 
+TCPServer::TCPServer(TCPServerConnectionFactory::Ptr pFactory, Poco::WorkStealingPool& pool, const ServerSocket& socket, TCPServerParams::Ptr pParams):
+	_socket(socket),
+	_pDispatcher(new TCPServerDispatcher(pFactory, pool, pParams)),
+	_thread(threadName(socket)),
+	_stopped(true)
+{
+}
+
+
 TCPServer::~TCPServer()
 {
 	try
@@ -61,7 +61,8 @@ TCPServerDispatcher::TCPServerDispatcher(TCPServerConnectionFactory::Ptr pFactor
 	_refusedConnections(0),
 	_stopped(false),
 	_pConnectionFactory(pFactory),
-	_threadPool(threadPool)
+	_pThreadPool(&threadPool),
+	_pWorkStealingPool(0)
 {
 	poco_check_ptr (pFactory);
 
@@ -70,6 +71,32 @@ TCPServerDispatcher::TCPServerDispatcher(TCPServerConnectionFactory::Ptr pFactor
 	
 	if (_pParams->getMaxThreads() == 0)
 		_pParams->setMaxThreads(threadPool.capacity());
+
+	if (_pParams->getLockFreeQueue())
+		_pBoundedQueue.reset(new Poco::BoundedNotificationQueue(_pParams->getMaxQueued() > 0 ? _pParams->getMaxQueued() : 1));
+}
+
+
+TCPServerDispatcher::TCPServerDispatcher(TCPServerConnectionFactory::Ptr pFactory, Poco::WorkStealingPool& pool, TCPServerParams::Ptr pParams):
+	_rc(1),
+	_pParams(pParams),
+	_currentThreads(0),
+	_totalConnections(0),
+	_currentConnections(0),
+	_maxConcurrentConnections(0),
+	_refusedConnections(0),
+	_stopped(false),
+	_pConnectionFactory(pFactory),
+	_pThreadPool(0),
+	_pWorkStealingPool(&pool)
+{
+	poco_check_ptr (pFactory);
+
+	if (!_pParams)
+		_pParams = new TCPServerParams;
+
+	if (_pParams->getMaxThreads() == 0)
+		_pParams->setMaxThreads(pool.threads());
 }
 
 
@@ -100,31 +127,58 @@ void TCPServerDispatcher::run()
 	{
 		{
 			ThreadCountWatcher tcw(this);
-			try
+			AutoPtr<Notification> pNf = _pBoundedQueue ? _pBoundedQueue->waitDequeueNotification(idleTime) : _queue.waitDequeueNotification(idleTime);
+			if (pNf) handleConnection(pNf);
+		}
+		if (_stopped || (_currentThreads > 1 && queueEmpty())) break;
+	}
+}
+
+
+void TCPServerDispatcher::dispatch()
+{
+	AutoPtr<TCPServerDispatcher> guard(this, false); // ensure _rc is decreased when function exits
+
+	for (;;)
+	{
+		AutoPtr<Notification> pNf;
+		{
+			// Checking the queue and giving up the task must be atomic
+			// with respect to enqueue(), which only schedules a new task
+			// if fewer than the maximum number of tasks are active.
+			FastMutex::ScopedLock lock(_mutex);
+			if (!_stopped) pNf = _queue.dequeueNotification();
+			if (!pNf)
 			{
-				AutoPtr<Notification> pNf = _queue.waitDequeueNotification(idleTime);
-				if (pNf)
-				{
-					TCPConnectionNotification* pCNf = dynamic_cast<TCPConnectionNotification*>(pNf.get());
-					if (pCNf)
-					{
-						std::unique_ptr<TCPServerConnection> pConnection(_pConnectionFactory->createConnection(pCNf->socket()));
-						poco_check_ptr(pConnection.get());
-						beginConnection();
-						pConnection->start();
-						endConnection();
-					}
-				}
+				--_currentThreads;
+				break;
 			}
-			catch (Poco::Exception &exc) { ErrorHandler::handle(exc); }
-			catch (std::exception &exc)  { ErrorHandler::handle(exc); }
-			catch (...)                  { ErrorHandler::handle();    }
 		}
-		if (_stopped || (_currentThreads > 1 && _queue.empty())) break;
+		handleConnection(pNf);
 	}
 }
 
 
+void TCPServerDispatcher::handleConnection(Notification* pNf)
+{
+	try
+	{
+		TCPConnectionNotification* pCNf = dynamic_cast<TCPConnectionNotification*>(pNf);
+		if (pCNf)
+		{
+			std::unique_ptr<TCPServerConnection> pConnection(_pConnectionFactory->createConnection(pCNf->socket()));
+			poco_check_ptr(pConnection.get());
+			beginConnection();
+			pConnection->start();
+			endConnection();
+		}
+	}
+	catch (Poco::Exception &exc) { ErrorHandler::handle(exc); }
+	catch (std::exception &exc)  { ErrorHandler::handle(exc); }
+	catch (...)                  { ErrorHandler::handle();    }
+}
+
+
 namespace
 {
 	static const std::string threadName("TCPServerConnection");
@@ -133,27 +187,46 @@ namespace
 	
 void TCPServerDispatcher::enqueue(const StreamSocket& socket)
 {
+	if (_pBoundedQueue)
+	{
+		enqueueBounded(socket);
+		return;
+	}
+
 	FastMutex::ScopedLock lock(_mutex);
 
 	if (_queue.size() < _pParams->getMaxQueued())
 	{
 		_queue.enqueueNotification(new TCPConnectionNotification(socket));
-		if (!_queue.hasIdleThreads() && _currentThreads < _pParams->getMaxThreads())
+		if (_pWorkStealingPool)
 		{
-			try
+			if (_currentThreads < _pParams->getMaxThreads())
 			{
-				_threadPool.startWithPriority(_pParams->getThreadPriority(), *this, threadName);
 				++_currentThreads;
-				// Ensure this object lives at least until run() starts
-				// Small chance of leaking if threadpool is stopped before this
-				// work runs, but better than a dangling pointer and crash!
 				duplicate();
+				try
+				{
+					_pWorkStealingPool->execute([this]() { dispatch(); });
+				}
+				catch (Poco::Exception&)
+				{
+					// The pool is stopped or its queue is full. The connection
+					// stays queued if another task is active; otherwise nobody
+					// would ever pick it up, so it is refused. Tasks only give
+					// up while holding the mutex, so it is the only one queued.
+					--_currentThreads;
+					release();
+					if (_currentThreads == 0)
+					{
+						AutoPtr<Notification> pNf = _queue.dequeueNotification();
+						++_refusedConnections;
+					}
+				}
 			}
-			catch (Poco::Exception&)
-			{
-				// no problem here, connection is already queued
-				// and a new thread might be available later.
-			}
+		}
+		else if (!_queue.hasIdleThreads() && _currentThreads < _pParams->getMaxThreads())
+		{
+			startThread();
 		}
 	}
 	else
@@ -163,11 +236,53 @@ void TCPServerDispatcher::enqueue(const StreamSocket& socket)
 }
 
 
+void TCPServerDispatcher::enqueueBounded(const StreamSocket& socket)
+{
+	// The queue is lock-free; the mutex is only needed to start a thread.
+	if (_pBoundedQueue->size() >= _pParams->getMaxQueued() || !_pBoundedQueue->tryEnqueueNotification(new TCPConnectionNotification(socket)))
+	{
+		++_refusedConnections;
+	}
+	else if (!_pBoundedQueue->hasIdleThreads() && _currentThreads < _pParams->getMaxThreads())
+	{
+		FastMutex::ScopedLock lock(_mutex);
+		if (_currentThreads < _pParams->getMaxThreads()) startThread();
+	}
+}
+
+
+void TCPServerDispatcher::startThread()
+{
+	try
+	{
+		_pThreadPool->startWithPriority(_pParams->getThreadPriority(), *this, threadName);
+		++_currentThreads;
+		// Ensure this object lives at least until run() starts
+		// Small chance of leaking if threadpool is stopped before this
+		// work runs, but better than a dangling pointer and crash!
+		duplicate();
+	}
+	catch (Poco::Exception&)
+	{
+		// no problem here, connection is already queued
+		// and a new thread might be available later.
+	}
+}
+
+
 void TCPServerDispatcher::stop()
 {
 	_stopped = true;
-	_queue.clear();
-	_queue.wakeUpAll();
+	if (_pBoundedQueue)
+	{
+		_pBoundedQueue->clear();
+		_pBoundedQueue->wakeUpAll();
+	}
+	else
+	{
+		_queue.clear();
+		_queue.wakeUpAll();
+	}
 }
 
 
@@ -180,7 +295,10 @@ int TCPServerDispatcher::maxThreads() const
 {
 	FastMutex::ScopedLock lock(_mutex);
 	
-	return _threadPool.capacity();
+	if (_pWorkStealingPool)
+		return _pWorkStealingPool->threads();
+	else
+		return _pThreadPool->capacity();
 }
 
 
@@ -204,7 +322,13 @@ int TCPServerDispatcher::maxConcurrentConnections() const
 
 int TCPServerDispatcher::queuedConnections() const
 {
-	return _queue.size();
+	return _pBoundedQueue ? _pBoundedQueue->size() : _queue.size();
+}
+
+
+bool TCPServerDispatcher::queueEmpty() const
+{
+	return _pBoundedQueue ? _pBoundedQueue->empty() : _queue.empty();
 }
 
 
@@ -23,7 +23,8 @@ TCPServerParams::TCPServerParams():
 	_threadIdleTime(10000000),
 	_maxThreads(0),
 	_maxQueued(64),
-	_threadPriority(Poco::Thread::PRIO_NORMAL)
+	_threadPriority(Poco::Thread::PRIO_NORMAL),
+	_lockFreeQueue(false)
 {
 }
 
@@ -61,4 +62,10 @@ void TCPServerParams::setThreadPriority(Poco::Thread::Priority prio)
 }
 
 
+void TCPServerParams::setLockFreeQueue(bool flag)
+{
+	_lockFreeQueue = flag;
+}
+
+
 } } // namespace Poco::Net
@@ -0,0 +1,277 @@
+//
+// CompletionReactorTest.cpp
+//
+// Copyright (c) 2026, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "CompletionReactorTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/Net/CompletionReactor.h"
+#include "Poco/Net/StreamSocket.h"
+#include "Poco/Net/ServerSocket.h"
+#include "Poco/Net/SocketAddress.h"
+#include "Poco/Thread.h"
+#include "Poco/Stopwatch.h"
+#include <iostream>
+
+
+using Poco::Net::CompletionReactor;
+using Poco::Net::StreamSocket;
+using Poco::Net::ServerSocket;
+using Poco::Net::SocketAddress;
+using Poco::Thread;
+using Poco::Stopwatch;
+
+
+namespace
+{
+	class EchoConnection
+		/// Echoes everything received, using either a private
+		/// buffer or a registered buffer of the reactor.
+	{
+	public:
+		EchoConnection(CompletionReactor& reactor, const StreamSocket& socket, int index):
+			_reactor(reactor),
+			_socket(socket),
+			_index(index)
+		{
+			receive();
+		}
+
+	private:
+		void receive()
+		{
+			if (_index < 0)
+				_reactor.receive(_socket, _buffer, sizeof(_buffer), [this](int n) { onReceived(n); });
+			else
+				_reactor.receiveFixed(_socket, _index, _reactor.bufferSize(), [this](int n) { onReceived(n); });
+		}
+
+		void onReceived(int n)
+		{
+			if (n > 0)
+			{
+				if (_index < 0)
+					_reactor.send(_socket, _buffer, n, [this](int) { receive(); });
+				else
+					_reactor.sendFixed(_socket, _index, n, [this](int) { receive(); });
+			}
+			else delete this;
+		}
+
+		CompletionReactor& _reactor;
+		StreamSocket       _socket;
+		int                _index;
+		char               _buffer[256];
+	};
+
+	class EchoAcceptor
+	{
+	public:
+		EchoAcceptor(CompletionReactor& reactor, const ServerSocket& socket, bool fixed):
+			_reactor(reactor),
+			_socket(socket),
+			_fixed(fixed),
+			_connections(0)
+		{
+			accept();
+		}
+
+	private:
+		void accept()
+		{
+			_reactor.accept(_socket, [this](const StreamSocket& socket, int err)
+			{
+				if (err == 0)
+				{
+					new EchoConnection(_reactor, socket, _fixed ? _connections % _reactor.bufferCount() : -1);
+					++_connections;
+				}
+				accept();
+			});
+		}
+
+		CompletionReactor& _reactor;
+		ServerSocket       _socket;
+		bool               _fixed;
+		int                _connections;
+	};
+
+	class TimeoutReactor: public CompletionReactor
+	{
+	public:
+		TimeoutReactor():
+			CompletionReactor(16, Poco::Timespan(0, 100000)),
+			_timeouts(0)
+		{
+		}
+
+		int timeouts() const
+		{
+			return _timeouts;
+		}
+
+	protected:
+		void onTimeout()
+		{
+			++_timeouts;
+		}
+
+	private:
+		int _timeouts;
+	};
+
+	void echo(int port, const std::string& data)
+	{
+		StreamSocket ss;
+		ss.connect(SocketAddress("127.0.0.1", port));
+		int n = ss.sendBytes(data.data(), static_cast<int>(data.size()));
+		std::string received;
+		char buffer[256];
+		while (received.size() < data.size())
+		{
+			n = ss.receiveBytes(buffer, sizeof(buffer));
+			if (n <= 0) break;
+			received.append(buffer, n);
+		}
+		ss.close();
+		if (received != data) throw Poco::AssertionViolationException("echo mismatch");
+	}
+}
+
+
+CompletionReactorTest::CompletionReactorTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+CompletionReactorTest::~CompletionReactorTest()
+{
+}
+
+
+void CompletionReactorTest::testEcho()
+{
+	if (!CompletionReactor::isAvailable())
+	{
+		std::cout << "io_uring not available, skipping." << std::endl;
+		return;
+	}
+
+	ServerSocket ss(SocketAddress("127.0.0.1", 0));
+	CompletionReactor reactor;
+	EchoAcceptor acceptor(reactor, ss, false);
+	Thread thread;
+	thread.start(reactor);
+
+	echo(ss.address().port(), "hello");
+	echo(ss.address().port(), std::string(10000, 'x'));
+
+	reactor.stop();
+	thread.join();
+}
+
+
+void CompletionReactorTest::testFixedBuffers()
+{
+	if (!CompletionReactor::isAvailable())
+	{
+		std::cout << "io_uring not available, skipping." << std::endl;
+		return;
+	}
+
+	ServerSocket ss(SocketAddress("127.0.0.1", 0));
+	CompletionReactor reactor;
+	reactor.registerBuffers(4, 512);
+	assertTrue (reactor.bufferCount() == 4);
+	assertTrue (reactor.bufferSize() == 512);
+	assertTrue (reactor.buffer(1) == reactor.buffer(0) + 512);
+	EchoAcceptor acceptor(reactor, ss, true);
+	Thread thread;
+	thread.start(reactor);
+
+	echo(ss.address().port(), "HELLO");
+	echo(ss.address().port(), std::string(10000, 'y'));
+
+	reactor.stop();
+	thread.join();
+}
+
+
+void CompletionReactorTest::testTimeout()
+{
+	if (!CompletionReactor::isAvailable())
+	{
+		std::cout << "io_uring not available, skipping." << std::endl;
+		return;
+	}
+
+	TimeoutReactor reactor;
+	Thread thread;
+	thread.start(reactor);
+	Thread::sleep(550);
+	reactor.stop();
+	thread.join();
+	assertTrue (reactor.timeouts() >= 3);
+}
+
+
+void CompletionReactorTest::testCancelOnDestroy()
+{
+	if (!CompletionReactor::isAvailable())
+	{
+		std::cout << "io_uring not available, skipping." << std::endl;
+		return;
+	}
+
+	ServerSocket ss(SocketAddress("127.0.0.1", 0));
+	StreamSocket client(ss.address());
+	StreamSocket server = ss.acceptConnection();
+	char buffer[64];
+	bool called = false;
+	Stopwatch sw;
+	{
+		CompletionReactor reactor;
+		Thread thread;
+		thread.start(reactor);
+		// The peer never sends anything, so the
+		// receive is still in progress when the
+		// reactor is destroyed.
+		reactor.receive(server, buffer, sizeof(buffer), [&called](int) { called = true; });
+		Thread::sleep(100);
+		reactor.stop();
+		thread.join();
+		sw.start();
+	}
+	sw.stop();
+	assertTrue (!called);
+	assertTrue (sw.elapsed() < 1000000);
+}
+
+
+void CompletionReactorTest::setUp()
+{
+}
+
+
+void CompletionReactorTest::tearDown()
+{
+}
+
+
+CppUnit::Test* CompletionReactorTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("CompletionReactorTest");
+
+	CppUnit_addTest(pSuite, CompletionReactorTest, testEcho);
+	CppUnit_addTest(pSuite, CompletionReactorTest, testFixedBuffers);
+	CppUnit_addTest(pSuite, CompletionReactorTest, testTimeout);
+	CppUnit_addTest(pSuite, CompletionReactorTest, testCancelOnDestroy);
+
+	return pSuite;
+}
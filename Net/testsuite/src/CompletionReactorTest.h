@@ -0,0 +1,41 @@
+//
+// CompletionReactorTest.h
+//
+// Definition of the CompletionReactorTest class.
+//
+// Copyright (c) 2026, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef CompletionReactorTest_INCLUDED
+#define CompletionReactorTest_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "Poco/CppUnit/TestCase.h"
+
+
+class CompletionReactorTest: public CppUnit::TestCase
+{
+public:
+	CompletionReactorTest(const std::string& name);
+	~CompletionReactorTest();
+
+	void testEcho();
+	void testFixedBuffers();
+	void testTimeout();
+	void testCancelOnDestroy();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // CompletionReactorTest_INCLUDED
@@ -23,6 +23,8 @@
 
 
 using Poco::Net::Socket;
+using Poco::Net::DatagramBuf;
+using Poco::Net::DatagramBufVec;
 using Poco::Net::DatagramSocket;
 using Poco::Net::SocketAddress;
 using Poco::Net::IPAddress;
@@ -592,6 +594,59 @@ void DatagramSocketTest::testGatherScatterVariableUNIX()
 }
 
 
+void DatagramSocketTest::testBatch()
+{
+	DatagramSocket receiver(SocketAddress("127.0.0.1", 0), false);
+	DatagramSocket sender(SocketAddress("127.0.0.1", 0), false);
+	SocketAddress receiverAddress = receiver.address();
+
+	const int count = 100;
+	std::vector<std::string> messages;
+	DatagramBufVec out;
+	for (int i = 0; i < count; ++i)
+	{
+		messages.push_back("message " + std::to_string(i));
+	}
+	for (int i = 0; i < count; ++i)
+	{
+		DatagramBuf datagram;
+		datagram.buffer        = const_cast<char*>(messages[i].data());
+		datagram.length        = static_cast<int>(messages[i].size());
+		datagram.pAddress      = const_cast<struct sockaddr*>(receiverAddress.addr());
+		datagram.addressLength = receiverAddress.length();
+		out.push_back(datagram);
+	}
+	assertTrue (sender.sendBatch(out) == count);
+
+	const int batchSize = 16;
+	char buffers[batchSize][64];
+	char addresses[batchSize][SocketAddress::MAX_ADDRESS_LENGTH];
+	DatagramBufVec in(batchSize);
+	int received = 0;
+	receiver.setReceiveTimeout(Timespan(5, 0));
+	while (received < count)
+	{
+		for (int i = 0; i < batchSize; ++i)
+		{
+			in[i].buffer        = buffers[i];
+			in[i].length        = sizeof(buffers[i]);
+			in[i].pAddress      = reinterpret_cast<struct sockaddr*>(addresses[i]);
+			in[i].addressLength = sizeof(addresses[i]);
+		}
+		int n = receiver.receiveBatch(in);
+		assertTrue (n > 0 && n <= batchSize);
+		for (int i = 0; i < n; ++i, ++received)
+		{
+			assertTrue (std::string(buffers[i], in[i].length) == messages[received]);
+			assertTrue (SocketAddress(in[i].pAddress, in[i].addressLength) == sender.address());
+		}
+	}
+
+	receiver.setBlocking(false);
+	assertTrue (receiver.receiveBatch(in) < 0);
+}
+
+
 void DatagramSocketTest::setUp()
 {
 }
@@ -615,6 +670,7 @@ CppUnit::Test* DatagramSocketTest::suite()
 #endif
 	CppUnit_addTest(pSuite, DatagramSocketTest, testGatherScatterFixed);
 	CppUnit_addTest(pSuite, DatagramSocketTest, testGatherScatterVariable);
+	CppUnit_addTest(pSuite, DatagramSocketTest, testBatch);
 
 	return pSuite;
 }
@@ -31,6 +31,7 @@ public:
 	void testBroadcast();
 	void testGatherScatterFixed();
 	void testGatherScatterVariable();
+	void testBatch();
 
 	void setUp();
 	void tearDown();
@@ -20,8 +20,15 @@
 #include "Poco/Net/HTTPServerRequest.h"
 #include "Poco/Net/HTTPResponse.h"
 #include "Poco/Net/HTTPServerResponse.h"
+#include "Poco/Net/HTTPServerRequestImpl.h"
+#include "Poco/Net/HTTPServerResponseImpl.h"
+#include "Poco/Net/HTTPServerSession.h"
 #include "Poco/Net/ServerSocket.h"
+#include "Poco/Net/StreamSocket.h"
+#include "Poco/Arena.h"
 #include "Poco/StreamCopier.h"
+#include "Poco/TemporaryFile.h"
+#include "Poco/FileStream.h"
 #include <sstream>
 
 
@@ -37,7 +44,15 @@ using Poco::Net::HTTPResponse;
 using Poco::Net::HTTPServerResponse;
 using Poco::Net::HTTPMessage;
 using Poco::Net::ServerSocket;
+using Poco::Net::StreamSocket;
+using Poco::Net::SocketAddress;
+using Poco::Net::HTTPServerSession;
+using Poco::Net::HTTPServerRequestImpl;
+using Poco::Net::HTTPServerResponseImpl;
+using Poco::Arena;
 using Poco::StreamCopier;
+using Poco::TemporaryFile;
+using Poco::FileOutputStream;
 
 
 namespace
@@ -104,9 +119,52 @@ namespace
 		}
 	};
 	
+	class FileRequestHandler: public HTTPRequestHandler
+	{
+	public:
+		FileRequestHandler(const std::string& path):
+			_path(path)
+		{
+		}
+
+		void handleRequest(HTTPServerRequest& request, HTTPServerResponse& response)
+		{
+			response.sendFile(_path, "application/octet-stream");
+		}
+
+	private:
+		std::string _path;
+	};
+
+	class FileSliceRequestHandler: public HTTPRequestHandler
+	{
+	public:
+		FileSliceRequestHandler(const std::string& path):
+			_path(path)
+		{
+		}
+
+		void handleRequest(HTTPServerRequest& request, HTTPServerResponse& response)
+		{
+			response.sendFile(_path, "application/octet-stream", 1000, 70000);
+		}
+
+	private:
+		std::string _path;
+	};
+
 	class RequestHandlerFactory: public HTTPRequestHandlerFactory
 	{
 	public:
+		RequestHandlerFactory()
+		{
+		}
+
+		RequestHandlerFactory(const std::string& path):
+			_path(path)
+		{
+		}
+
 		HTTPRequestHandler* createRequestHandler(const HTTPServerRequest& request)
 		{
 			if (request.getURI() == "/echoBody")
@@ -119,10 +177,31 @@ namespace
 				return new AuthRequestHandler();
 			else if (request.getURI() == "/buffer")
 				return new BufferRequestHandler();
+			else if (request.getURI() == "/file")
+				return new FileRequestHandler(_path);
+			else if (request.getURI() == "/fileSlice")
+				return new FileSliceRequestHandler(_path);
 			else
 				return 0;
 		}
+
+	private:
+		std::string _path;
 	};
+
+	std::string createFile(const std::string& path, int size)
+	{
+		std::string data;
+		data.reserve(size);
+		for (int i = 0; i < size; ++i)
+		{
+			data += static_cast<char>('a' + (i*7) % 26);
+		}
+		FileOutputStream ostr(path);
+		ostr << data;
+		ostr.close();
+		return data;
+	}
 }
 
 
@@ -516,6 +595,181 @@ void HTTPServerTest::testBuffer()
 }
 
 
+void HTTPServerTest::testFile()
+{
+	TemporaryFile tf;
+	std::string data = createFile(tf.path(), 200000);
+
+	ServerSocket svs(0);
+	HTTPServerParams* pParams = new HTTPServerParams;
+	pParams->setKeepAlive(true);
+	HTTPServer srv(new RequestHandlerFactory(tf.path()), svs, pParams);
+	srv.start();
+
+	HTTPClientSession cs("127.0.0.1", svs.address().port());
+	cs.setKeepAlive(true);
+	for (int i = 0; i < 2; ++i)
+	{
+		HTTPRequest request("GET", "/file", HTTPMessage::HTTP_1_1);
+		cs.sendRequest(request);
+		HTTPResponse response;
+		std::string rbody;
+		StreamCopier::copyToString(cs.receiveResponse(response), rbody);
+		assertTrue (response.getStatus() == HTTPResponse::HTTP_OK);
+		assertTrue (response.getContentLength() == 200000);
+		assertTrue (response.get("Accept-Ranges") == "bytes");
+		assertTrue (response.has("Last-Modified"));
+		assertTrue (rbody == data);
+	}
+
+	HTTPRequest request("HEAD", "/file", HTTPMessage::HTTP_1_1);
+	cs.sendRequest(request);
+	HTTPResponse response;
+	std::string rbody;
+	StreamCopier::copyToString(cs.receiveResponse(response), rbody);
+	assertTrue (response.getStatus() == HTTPResponse::HTTP_OK);
+	assertTrue (response.getContentLength() == 200000);
+	assertTrue (rbody.empty());
+}
+
+
+void HTTPServerTest::testFileRange()
+{
+	TemporaryFile tf;
+	std::string data = createFile(tf.path(), 200000);
+
+	ServerSocket svs(0);
+	HTTPServerParams* pParams = new HTTPServerParams;
+	pParams->setKeepAlive(true);
+	HTTPServer srv(new RequestHandlerFactory(tf.path()), svs, pParams);
+	srv.start();
+
+	HTTPClientSession cs("127.0.0.1", svs.address().port());
+	cs.setKeepAlive(true);
+
+	HTTPRequest request("GET", "/file", HTTPMessage::HTTP_1_1);
+	request.set("Range", "bytes=100-199");
+	cs.sendRequest(request);
+	HTTPResponse response;
+	std::string rbody;
+	StreamCopier::copyToString(cs.receiveResponse(response), rbody);
+	assertTrue (response.getStatus() == HTTPResponse::HTTP_PARTIAL_CONTENT);
+	assertTrue (response.get("Content-Range") == "bytes 100-199/200000");
+	assertTrue (rbody == data.substr(100, 100));
+
+	request.set("Range", "bytes=150000-");
+	cs.sendRequest(request);
+	rbody.clear();
+	StreamCopier::copyToString(cs.receiveResponse(response), rbody);
+	assertTrue (response.getStatus() == HTTPResponse::HTTP_PARTIAL_CONTENT);
+	assertTrue (response.get("Content-Range") == "bytes 150000-199999/200000");
+	assertTrue (rbody == data.substr(150000));
+
+	request.set("Range", "bytes=-10");
+	cs.sendRequest(request);
+	rbody.clear();
+	StreamCopier::copyToString(cs.receiveResponse(response), rbody);
+	assertTrue (response.getStatus() == HTTPResponse::HTTP_PARTIAL_CONTENT);
+	assertTrue (response.get("Content-Range") == "bytes 199990-199999/200000");
+	assertTrue (rbody == data.substr(199990));
+
+	request.set("Range", "bytes=199000-300000");
+	cs.sendRequest(request);
+	rbody.clear();
+	StreamCopier::copyToString(cs.receiveResponse(response), rbody);
+	assertTrue (response.getStatus() == HTTPResponse::HTTP_PARTIAL_CONTENT);
+	assertTrue (response.get("Content-Range") == "bytes 199000-199999/200000");
+	assertTrue (rbody == data.substr(199000));
+
+	request.set("Range", "bytes=200000-");
+	cs.sendRequest(request);
+	rbody.clear();
+	StreamCopier::copyToString(cs.receiveResponse(response), rbody);
+	assertTrue (response.getStatus() == HTTPResponse::HTTP_REQUESTED_RANGE_NOT_SATISFIABLE);
+	assertTrue (response.get("Content-Range") == "bytes */200000");
+	assertTrue (rbody.empty());
+
+	request.set("Range", "bytes=0-9,20-29");
+	cs.sendRequest(request);
+	rbody.clear();
+	StreamCopier::copyToString(cs.receiveResponse(response), rbody);
+	assertTrue (response.getStatus() == HTTPResponse::HTTP_OK);
+	assertTrue (rbody == data);
+
+	request.set("Range", "bytes=0-9");
+	request.set("If-Range", "Thu, 01 Jan 1970 00:00:00 GMT");
+	cs.sendRequest(request);
+	rbody.clear();
+	StreamCopier::copyToString(cs.receiveResponse(response), rbody);
+	assertTrue (response.getStatus() == HTTPResponse::HTTP_OK);
+	assertTrue (rbody == data);
+}
+
+
+void HTTPServerTest::testFileSlice()
+{
+	TemporaryFile tf;
+	std::string data = createFile(tf.path(), 100000);
+
+	ServerSocket svs(0);
+	HTTPServerParams* pParams = new HTTPServerParams;
+	pParams->setKeepAlive(false);
+	HTTPServer srv(new RequestHandlerFactory(tf.path()), svs, pParams);
+	srv.start();
+
+	HTTPClientSession cs("127.0.0.1", svs.address().port());
+	HTTPRequest request("GET", "/fileSlice");
+	cs.sendRequest(request);
+	HTTPResponse response;
+	std::string rbody;
+	StreamCopier::copyToString(cs.receiveResponse(response), rbody);
+	assertTrue (response.getStatus() == HTTPResponse::HTTP_OK);
+	assertTrue (response.getContentLength() == 70000);
+	assertTrue (rbody == data.substr(1000, 70000));
+}
+
+
+void HTTPServerTest::testRequestArena()
+{
+	ServerSocket svs(SocketAddress("127.0.0.1", 0));
+	StreamSocket client;
+	client.connect(SocketAddress("127.0.0.1", svs.address().port()));
+	StreamSocket server = svs.acceptConnection();
+	HTTPServerParams::Ptr pParams = new HTTPServerParams;
+	HTTPServerSession session(server, pParams);
+
+	std::string body(1000, 'x');
+	Arena arena;
+	for (int i = 0; i < 3; ++i)
+	{
+		std::ostringstream ostr;
+		if (i == 1)
+			ostr << "POST /arena HTTP/1.1\r\nHost: localhost\r\nTransfer-Encoding: chunked\r\n\r\n" << std::hex << body.size() << "\r\n" << body << "\r\n0\r\n\r\n";
+		else
+			ostr << "POST /arena HTTP/1.1\r\nHost: localhost\r\nContent-Length: " << body.size() << "\r\n\r\n" << body;
+		std::string request = ostr.str();
+		client.sendBytes(request.data(), static_cast<int>(request.size()));
+
+		assertTrue (arena.used() == 0);
+		{
+			HTTPServerResponseImpl response(session);
+			HTTPServerRequestImpl req(response, session, pParams, &arena);
+			assertTrue (req.arena() == &arena);
+			assertTrue (arena.used() > 0);
+			assertTrue (req.getURI() == "/arena");
+
+			std::string data;
+			StreamCopier::copyToString(req.stream(), data);
+			assertTrue (data == body);
+
+			std::string* pData = arena.create<std::string>(data);
+			assertTrue (*pData == body);
+		}
+		arena.reset();
+	}
+}
+
+
 void HTTPServerTest::setUp()
 {
 }
@@ -544,6 +798,10 @@ CppUnit::Test* HTTPServerTest::suite()
 	CppUnit_addTest(pSuite, HTTPServerTest, testAuth);
 	CppUnit_addTest(pSuite, HTTPServerTest, testNotImpl);
 	CppUnit_addTest(pSuite, HTTPServerTest, testBuffer);
+	CppUnit_addTest(pSuite, HTTPServerTest, testFile);
+	CppUnit_addTest(pSuite, HTTPServerTest, testFileRange);
+	CppUnit_addTest(pSuite, HTTPServerTest, testFileSlice);
+	CppUnit_addTest(pSuite, HTTPServerTest, testRequestArena);
 
 	return pSuite;
 }
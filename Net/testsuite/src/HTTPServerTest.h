@@ -38,6 +38,10 @@ public:
 	void testAuth();
 	void testNotImpl();
 	void testBuffer();
+	void testFile();
+	void testFileRange();
+	void testFileSlice();
+	void testRequestArena();
 
 	void setUp();
 	void tearDown();
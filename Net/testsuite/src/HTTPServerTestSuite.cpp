@@ -10,6 +10,7 @@
 
 #include "HTTPServerTestSuite.h"
 #include "HTTPServerTest.h"
+#include "ReactorHTTPServerTest.h"
 
 
 CppUnit::Test* HTTPServerTestSuite::suite()
@@ -17,6 +18,7 @@ CppUnit::Test* HTTPServerTestSuite::suite()
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("HTTPServerTestSuite");
 
 	pSuite->addTest(HTTPServerTest::suite());
+	pSuite->addTest(ReactorHTTPServerTest::suite());
 
 	return pSuite;
 }
@@ -18,6 +18,7 @@
 #include "Poco/Net/NetException.h"
 #include "Poco/Net/PollSet.h"
 #include "Poco/Stopwatch.h"
+#include "Poco/Thread.h"
 
 
 using Poco::Net::Socket;
@@ -28,6 +29,7 @@ using Poco::Net::ConnectionRefusedException;
 using Poco::Net::PollSet;
 using Poco::Timespan;
 using Poco::Stopwatch;
+using Poco::Thread;
 
 
 PollSetTest::PollSetTest(const std::string& name): CppUnit::TestCase(name)
@@ -125,6 +127,102 @@ void PollSetTest::testPoll()
 }
 
 
+void PollSetTest::testPollEvents()
+{
+	EchoServer echoServer1;
+	EchoServer echoServer2;
+	StreamSocket ss1;
+	StreamSocket ss2;
+
+	ss1.connect(SocketAddress("127.0.0.1", echoServer1.port()));
+	ss2.connect(SocketAddress("127.0.0.1", echoServer2.port()));
+
+	PollSet ps;
+	PollSet::SocketEventList events;
+	ps.add(ss1, PollSet::POLL_READ);
+	ps.add(ss2, PollSet::POLL_READ);
+
+	// nothing readable
+	Timespan timeout(1000000);
+	Stopwatch sw;
+	sw.start();
+	assertTrue (ps.poll(events, timeout) == 0);
+	assertTrue (events.empty());
+	assertTrue (sw.elapsed() >= 900000);
+
+	// ss1 must be writable, if polled for
+	ps.update(ss1, PollSet::POLL_READ | PollSet::POLL_WRITE);
+	sw.restart();
+	assertTrue (ps.poll(events, timeout) == 1);
+	assertTrue (events[0].fd == ss1.impl()->sockfd());
+	assertTrue (events[0].mode == PollSet::POLL_WRITE);
+	assertTrue (sw.elapsed() < 100000);
+
+	ps.update(ss1, PollSet::POLL_READ);
+
+	ss1.sendBytes("hello", 5);
+	ss2.sendBytes("HELLO", 5);
+	Thread::sleep(100);
+	char buffer[256];
+	assertTrue (ps.poll(events, timeout) == 2);
+	for (PollSet::SocketEventList::const_iterator it = events.begin(); it != events.end(); ++it)
+	{
+		assertTrue (it->mode == PollSet::POLL_READ);
+		assertTrue (it->fd == ss1.impl()->sockfd() || it->fd == ss2.impl()->sockfd());
+	}
+	assertTrue (events[0].fd != events[1].fd);
+
+	int n = ss1.receiveBytes(buffer, sizeof(buffer));
+	assertTrue (n == 5);
+	assertTrue (std::string(buffer, n) == "hello");
+	n = ss2.receiveBytes(buffer, sizeof(buffer));
+	assertTrue (n == 5);
+	assertTrue (std::string(buffer, n) == "HELLO");
+
+	ps.remove(ss2);
+	ss2.sendBytes("HELLO", 5);
+	assertTrue (ps.poll(events, timeout) == 0);
+	assertTrue (events.empty());
+
+	n = ss2.receiveBytes(buffer, sizeof(buffer));
+	assertTrue (n == 5);
+
+	ss1.close();
+	ss2.close();
+}
+
+
+void PollSetTest::testPollOneShot()
+{
+	EchoServer echoServer;
+	StreamSocket ss;
+	ss.connect(SocketAddress("127.0.0.1", echoServer.port()));
+
+	PollSet ps;
+	PollSet::SocketEventList events;
+	ps.add(ss, PollSet::POLL_READ | PollSet::POLL_ONESHOT);
+
+	ss.sendBytes("hello", 5);
+	Timespan timeout(1000000);
+	assertTrue (ps.poll(events, timeout) == 1);
+	assertTrue (events[0].mode == PollSet::POLL_READ);
+
+	// still readable, but not reported again until re-armed
+	assertTrue (ps.poll(events, Timespan(100000)) == 0);
+
+	ps.update(ss, PollSet::POLL_READ | PollSet::POLL_ONESHOT);
+	assertTrue (ps.poll(events, timeout) == 1);
+	assertTrue (events[0].mode == PollSet::POLL_READ);
+
+	char buffer[256];
+	int n = ss.receiveBytes(buffer, sizeof(buffer));
+	assertTrue (n == 5);
+	assertTrue (std::string(buffer, n) == "hello");
+
+	ss.close();
+}
+
+
 void PollSetTest::setUp()
 {
 }
@@ -140,6 +238,8 @@ CppUnit::Test* PollSetTest::suite()
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("PollSetTest");
 
 	CppUnit_addTest(pSuite, PollSetTest, testPoll);
+	CppUnit_addTest(pSuite, PollSetTest, testPollEvents);
+	CppUnit_addTest(pSuite, PollSetTest, testPollOneShot);
 
 	return pSuite;
 }
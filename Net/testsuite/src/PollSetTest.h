@@ -25,6 +25,8 @@ public:
 	~PollSetTest();
 
 	void testPoll();
+	void testPollEvents();
+	void testPollOneShot();
 
 	void setUp();
 	void tearDown();
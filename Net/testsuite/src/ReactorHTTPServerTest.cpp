@@ -0,0 +1,388 @@
+//
+// ReactorHTTPServerTest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "ReactorHTTPServerTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/Net/ReactorHTTPServer.h"
+#include "Poco/Net/HTTPServerParams.h"
+#include "Poco/Net/HTTPRequestHandler.h"
+#include "Poco/Net/HTTPRequestHandlerFactory.h"
+#include "Poco/Net/HTTPClientSession.h"
+#include "Poco/Net/HTTPRequest.h"
+#include "Poco/Net/HTTPServerRequest.h"
+#include "Poco/Net/HTTPResponse.h"
+#include "Poco/Net/HTTPServerResponse.h"
+#include "Poco/Net/ServerSocket.h"
+#include "Poco/Net/StreamSocket.h"
+#include "Poco/Net/SocketAddress.h"
+#include "Poco/StreamCopier.h"
+#include "Poco/SharedPtr.h"
+#include <sstream>
+#include <vector>
+
+
+using Poco::Net::ReactorHTTPServer;
+using Poco::Net::HTTPServerParams;
+using Poco::Net::HTTPRequestHandler;
+using Poco::Net::HTTPRequestHandlerFactory;
+using Poco::Net::HTTPClientSession;
+using Poco::Net::HTTPRequest;
+using Poco::Net::HTTPServerRequest;
+using Poco::Net::HTTPResponse;
+using Poco::Net::HTTPServerResponse;
+using Poco::Net::HTTPMessage;
+using Poco::Net::ServerSocket;
+using Poco::Net::StreamSocket;
+using Poco::Net::SocketAddress;
+using Poco::StreamCopier;
+
+
+namespace
+{
+	class EchoBodyRequestHandler: public HTTPRequestHandler
+	{
+	public:
+		void handleRequest(HTTPServerRequest& request, HTTPServerResponse& response)
+		{
+			if (request.getChunkedTransferEncoding())
+				response.setChunkedTransferEncoding(true);
+			else if (request.getContentLength() != HTTPMessage::UNKNOWN_CONTENT_LENGTH)
+				response.setContentLength(request.getContentLength());
+
+			response.setContentType(request.getContentType());
+
+			std::istream& istr = request.stream();
+			std::ostream& ostr = response.send();
+			StreamCopier::copyStream(istr, ostr);
+		}
+	};
+
+	class EchoURIRequestHandler: public HTTPRequestHandler
+	{
+	public:
+		void handleRequest(HTTPServerRequest& request, HTTPServerResponse& response)
+		{
+			response.setContentLength(request.getURI().size());
+			response.send() << request.getURI();
+		}
+	};
+
+	class RequestHandlerFactory: public HTTPRequestHandlerFactory
+	{
+	public:
+		HTTPRequestHandler* createRequestHandler(const HTTPServerRequest& request)
+		{
+			if (request.getURI() == "/echoBody")
+				return new EchoBodyRequestHandler;
+			else if (request.getURI().compare(0, 5, "/uri/") == 0)
+				return new EchoURIRequestHandler;
+			else
+				return 0;
+		}
+	};
+
+	std::string receiveAll(StreamSocket& socket)
+	{
+		std::string result;
+		char buffer[1024];
+		int n = socket.receiveBytes(buffer, sizeof(buffer));
+		while (n > 0)
+		{
+			result.append(buffer, n);
+			n = socket.receiveBytes(buffer, sizeof(buffer));
+		}
+		return result;
+	}
+}
+
+
+ReactorHTTPServerTest::ReactorHTTPServerTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+ReactorHTTPServerTest::~ReactorHTTPServerTest()
+{
+}
+
+
+void ReactorHTTPServerTest::testIdentityRequest()
+{
+	ServerSocket svs(0);
+	HTTPServerParams* pParams = new HTTPServerParams;
+	pParams->setKeepAlive(false);
+	ReactorHTTPServer srv(new RequestHandlerFactory, svs, pParams);
+	srv.start();
+
+	HTTPClientSession cs("127.0.0.1", svs.address().port());
+	std::string body(5000, 'x');
+	HTTPRequest request("POST", "/echoBody");
+	request.setContentLength((int) body.length());
+	request.setContentType("text/plain");
+	cs.sendRequest(request) << body;
+	HTTPResponse response;
+	std::string rbody;
+	cs.receiveResponse(response) >> rbody;
+	assertTrue (response.getContentLength() == body.size());
+	assertTrue (response.getContentType() == "text/plain");
+	assertTrue (rbody == body);
+}
+
+
+void ReactorHTTPServerTest::testChunkedRequest()
+{
+	ServerSocket svs(0);
+	HTTPServerParams* pParams = new HTTPServerParams;
+	pParams->setKeepAlive(true);
+	ReactorHTTPServer srv(new RequestHandlerFactory, svs, pParams);
+	srv.start();
+
+	HTTPClientSession cs("127.0.0.1", svs.address().port());
+	cs.setKeepAlive(true);
+	std::string body(100000, 'x');
+	HTTPRequest request("POST", "/echoBody", HTTPMessage::HTTP_1_1);
+	request.setContentType("text/plain");
+	request.setChunkedTransferEncoding(true);
+	for (int i = 0; i < 2; ++i)
+	{
+		cs.sendRequest(request) << body;
+		HTTPResponse response;
+		std::string rbody;
+		cs.receiveResponse(response) >> rbody;
+		assertTrue (response.getContentLength() == HTTPMessage::UNKNOWN_CONTENT_LENGTH);
+		assertTrue (response.getChunkedTransferEncoding());
+		assertTrue (response.getKeepAlive());
+		assertTrue (rbody == body);
+	}
+	assertTrue (srv.totalConnections() == 1);
+	assertTrue (srv.totalRequests() == 2);
+}
+
+
+void ReactorHTTPServerTest::testIdentityRequestKeepAlive()
+{
+	ServerSocket svs(0);
+	ReactorHTTPServer srv(new RequestHandlerFactory, svs, new HTTPServerParams);
+	srv.start();
+
+	HTTPClientSession cs("127.0.0.1", svs.address().port());
+	cs.setKeepAlive(true);
+	std::string body(5000, 'x');
+	HTTPRequest request("POST", "/echoBody", HTTPMessage::HTTP_1_1);
+	request.setContentLength((int) body.length());
+	request.setContentType("text/plain");
+	cs.sendRequest(request) << body;
+	HTTPResponse response;
+	std::string rbody;
+	cs.receiveResponse(response) >> rbody;
+	assertTrue (response.getContentLength() == body.size());
+	assertTrue (response.getKeepAlive());
+	assertTrue (rbody == body);
+
+	body.assign(1000, 'y');
+	request.setContentLength((int) body.length());
+	request.setKeepAlive(false);
+	cs.sendRequest(request) << body;
+	cs.receiveResponse(response) >> rbody;
+	assertTrue (response.getContentLength() == body.size());
+	assertTrue (!response.getKeepAlive());
+	assertTrue (rbody == body);
+	assertTrue (srv.totalConnections() == 1);
+}
+
+
+void ReactorHTTPServerTest::testMaxKeepAlive()
+{
+	ServerSocket svs(0);
+	HTTPServerParams* pParams = new HTTPServerParams;
+	pParams->setKeepAlive(true);
+	pParams->setMaxKeepAliveRequests(4);
+	ReactorHTTPServer srv(new RequestHandlerFactory, svs, pParams);
+	srv.start();
+
+	HTTPClientSession cs("127.0.0.1", svs.address().port());
+	cs.setKeepAlive(true);
+	HTTPRequest request("POST", "/echoBody", HTTPMessage::HTTP_1_1);
+	request.setContentType("text/plain");
+	request.setChunkedTransferEncoding(true);
+	std::string body(5000, 'x');
+	for (int i = 0; i < 4; ++i)
+	{
+		cs.sendRequest(request) << body;
+		HTTPResponse response;
+		std::string rbody;
+		cs.receiveResponse(response) >> rbody;
+		assertTrue (response.getKeepAlive() == (i < 3));
+		assertTrue (rbody == body);
+	}
+}
+
+
+void ReactorHTTPServerTest::testPipelinedRequests()
+{
+	ServerSocket svs(0);
+	ReactorHTTPServer srv(new RequestHandlerFactory, svs, new HTTPServerParams);
+	srv.start();
+
+	StreamSocket ss(SocketAddress("127.0.0.1", svs.address().port()));
+	std::string requests(
+		"GET /uri/1 HTTP/1.1\r\nHost: localhost\r\n\r\n"
+		"GET /uri/2 HTTP/1.1\r\nHost: localhost\r\n\r\n"
+		"GET /uri/3 HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n\r\n");
+	ss.sendBytes(requests.data(), (int) requests.size());
+	std::string responses = receiveAll(ss);
+	std::string::size_type pos1 = responses.find("/uri/1");
+	std::string::size_type pos2 = responses.find("/uri/2");
+	std::string::size_type pos3 = responses.find("/uri/3");
+	assertTrue (pos1 != std::string::npos);
+	assertTrue (pos2 != std::string::npos && pos2 > pos1);
+	assertTrue (pos3 != std::string::npos && pos3 > pos2);
+	assertTrue (srv.totalRequests() == 3);
+}
+
+
+void ReactorHTTPServerTest::testIdleConnections()
+{
+	ServerSocket svs(0);
+	HTTPServerParams* pParams = new HTTPServerParams;
+	pParams->setMaxThreads(2);
+	ReactorHTTPServer srv(new RequestHandlerFactory, svs, pParams, 2);
+	srv.start();
+
+	// More keep-alive connections than worker threads.
+	std::vector<Poco::SharedPtr<HTTPClientSession> > sessions;
+	for (int i = 0; i < 20; ++i)
+	{
+		sessions.push_back(new HTTPClientSession("127.0.0.1", svs.address().port()));
+		sessions.back()->setKeepAlive(true);
+	}
+	for (int k = 0; k < 2; ++k)
+	{
+		for (std::size_t i = 0; i < sessions.size(); ++i)
+		{
+			HTTPRequest request("GET", "/uri/test", HTTPMessage::HTTP_1_1);
+			sessions[i]->sendRequest(request);
+			HTTPResponse response;
+			std::string rbody;
+			sessions[i]->receiveResponse(response) >> rbody;
+			assertTrue (response.getKeepAlive());
+			assertTrue (rbody == "/uri/test");
+		}
+	}
+	assertTrue (srv.totalConnections() == 20);
+	assertTrue (srv.currentConnections() == 20);
+	assertTrue (srv.totalRequests() == 40);
+
+	sessions.clear();
+	Poco::Thread::sleep(500);
+	assertTrue (srv.currentConnections() == 0);
+}
+
+
+void ReactorHTTPServerTest::testIdleTimeoutWhileBusy()
+{
+	ServerSocket svs(0);
+	HTTPServerParams* pParams = new HTTPServerParams;
+	pParams->setTimeout(Poco::Timespan(1, 0));
+	ReactorHTTPServer srv(new RequestHandlerFactory, svs, pParams, 1);
+	srv.start();
+
+	// An incomplete request that is never completed...
+	StreamSocket idle(SocketAddress("127.0.0.1", svs.address().port()));
+	std::string partial("GET /uri/1 HTTP/1.1\r\n");
+	idle.sendBytes(partial.data(), (int) partial.size());
+
+	// ...while another connection keeps the reactor busy,
+	// sending its request one byte at a time.
+	StreamSocket busy(SocketAddress("127.0.0.1", svs.address().port()));
+	std::string request("GET /uri/2 HTTP/1.1\r\nX-Pad: ");
+	busy.sendBytes(request.data(), (int) request.size());
+	for (int k = 0; k < 100 && srv.currentConnections() < 2; ++k) Poco::Thread::sleep(10);
+	assertTrue (srv.currentConnections() == 2);
+	int i = 0;
+	for (; i < 100 && srv.currentConnections() == 2; ++i)
+	{
+		busy.sendBytes("x", 1);
+		Poco::Thread::sleep(50);
+	}
+	assertTrue (srv.currentConnections() == 1);
+	assertTrue (i >= 15);
+
+	idle.setReceiveTimeout(Poco::Timespan(5, 0));
+	char buffer[256];
+	assertTrue (idle.receiveBytes(buffer, sizeof(buffer)) == 0);
+
+	request = "\r\nConnection: close\r\n\r\n";
+	busy.sendBytes(request.data(), (int) request.size());
+	std::string response = receiveAll(busy);
+	assertTrue (response.find("HTTP/1.1 200") == 0);
+	assertTrue (response.find("/uri/2") != std::string::npos);
+}
+
+
+void ReactorHTTPServerTest::testHeaderTooLarge()
+{
+	ServerSocket svs(0);
+	ReactorHTTPServer srv(new RequestHandlerFactory, svs, new HTTPServerParams);
+	srv.start();
+
+	StreamSocket ss(SocketAddress("127.0.0.1", svs.address().port()));
+	std::string request("GET /uri/1 HTTP/1.1\r\nX-Large: ");
+	request.append(65536 - request.size(), 'x');
+	ss.sendBytes(request.data(), (int) request.size());
+	std::string response = receiveAll(ss);
+	assertTrue (response.find("HTTP/1.1 400") == 0);
+}
+
+
+void ReactorHTTPServerTest::testNotImpl()
+{
+	ServerSocket svs(0);
+	ReactorHTTPServer srv(new RequestHandlerFactory, svs, new HTTPServerParams);
+	srv.start();
+
+	HTTPClientSession cs("127.0.0.1", svs.address().port());
+	HTTPRequest request("GET", "/notImpl");
+	cs.sendRequest(request);
+	HTTPResponse response;
+	std::string rbody;
+	cs.receiveResponse(response) >> rbody;
+	assertTrue (response.getStatus() == HTTPResponse::HTTP_NOT_IMPLEMENTED);
+	assertTrue (rbody.empty());
+}
+
+
+void ReactorHTTPServerTest::setUp()
+{
+}
+
+
+void ReactorHTTPServerTest::tearDown()
+{
+}
+
+
+CppUnit::Test* ReactorHTTPServerTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("ReactorHTTPServerTest");
+
+	CppUnit_addTest(pSuite, ReactorHTTPServerTest, testIdentityRequest);
+	CppUnit_addTest(pSuite, ReactorHTTPServerTest, testChunkedRequest);
+	CppUnit_addTest(pSuite, ReactorHTTPServerTest, testIdentityRequestKeepAlive);
+	CppUnit_addTest(pSuite, ReactorHTTPServerTest, testMaxKeepAlive);
+	CppUnit_addTest(pSuite, ReactorHTTPServerTest, testPipelinedRequests);
+	CppUnit_addTest(pSuite, ReactorHTTPServerTest, testIdleConnections);
+	CppUnit_addTest(pSuite, ReactorHTTPServerTest, testIdleTimeoutWhileBusy);
+	CppUnit_addTest(pSuite, ReactorHTTPServerTest, testHeaderTooLarge);
+	CppUnit_addTest(pSuite, ReactorHTTPServerTest, testNotImpl);
+
+	return pSuite;
+}
@@ -0,0 +1,46 @@
+//
+// ReactorHTTPServerTest.h
+//
+// Definition of the ReactorHTTPServerTest class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef ReactorHTTPServerTest_INCLUDED
+#define ReactorHTTPServerTest_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "Poco/CppUnit/TestCase.h"
+
+
+class ReactorHTTPServerTest: public CppUnit::TestCase
+{
+public:
+	ReactorHTTPServerTest(const std::string& name);
+	~ReactorHTTPServerTest();
+
+	void testIdentityRequest();
+	void testChunkedRequest();
+	void testIdentityRequestKeepAlive();
+	void testMaxKeepAlive();
+	void testPipelinedRequests();
+	void testIdleConnections();
+	void testIdleTimeoutWhileBusy();
+	void testHeaderTooLarge();
+	void testNotImpl();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // ReactorHTTPServerTest_INCLUDED
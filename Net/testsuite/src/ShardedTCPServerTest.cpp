@@ -0,0 +1,212 @@
+//
+// ShardedTCPServerTest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "ShardedTCPServerTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/Net/ShardedTCPServer.h"
+#include "Poco/Net/TCPServerConnection.h"
+#include "Poco/Net/TCPServerConnectionFactory.h"
+#include "Poco/Net/StreamSocket.h"
+#include "Poco/Net/SocketAddress.h"
+#include "Poco/Thread.h"
+#include <iostream>
+
+
+using Poco::Net::ShardedTCPServer;
+using Poco::Net::TCPServerConnectionFilter;
+using Poco::Net::TCPServerConnection;
+using Poco::Net::TCPServerConnectionFactoryImpl;
+using Poco::Net::StreamSocket;
+using Poco::Net::SocketAddress;
+using Poco::Thread;
+
+
+namespace
+{
+	class EchoConnection: public TCPServerConnection
+	{
+	public:
+		EchoConnection(const StreamSocket& s): TCPServerConnection(s)
+		{
+		}
+
+		void run()
+		{
+			StreamSocket& ss = socket();
+			try
+			{
+				char buffer[256];
+				int n = ss.receiveBytes(buffer, sizeof(buffer));
+				while (n > 0)
+				{
+					ss.sendBytes(buffer, n);
+					n = ss.receiveBytes(buffer, sizeof(buffer));
+				}
+			}
+			catch (Poco::Exception& exc)
+			{
+				std::cerr << "EchoConnection: " << exc.displayText() << std::endl;
+			}
+		}
+	};
+
+	class RejectFilter: public TCPServerConnectionFilter
+	{
+	public:
+		bool accept(const StreamSocket&)
+		{
+			return false;
+		}
+	};
+}
+
+
+ShardedTCPServerTest::ShardedTCPServerTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+ShardedTCPServerTest::~ShardedTCPServerTest()
+{
+}
+
+
+void ShardedTCPServerTest::testOneConnection()
+{
+	ShardedTCPServer srv(new TCPServerConnectionFactoryImpl<EchoConnection>(), SocketAddress("127.0.0.1", 0), 2);
+	assertTrue (srv.shards() >= 1);
+	for (int i = 0; i < srv.shards(); ++i)
+	{
+		assertTrue (srv.socket(i).address().port() == srv.port());
+	}
+	srv.start();
+	assertTrue (srv.currentConnections() == 0);
+	assertTrue (srv.totalConnections() == 0);
+
+	SocketAddress sa("127.0.0.1", srv.port());
+	StreamSocket ss1(sa);
+	std::string data("hello, world");
+	ss1.sendBytes(data.data(), (int) data.size());
+	char buffer[256];
+	int n = ss1.receiveBytes(buffer, sizeof(buffer));
+	assertTrue (n > 0);
+	assertTrue (std::string(buffer, n) == data);
+	assertTrue (srv.currentConnections() == 1);
+	assertTrue (srv.totalConnections() == 1);
+	ss1.close();
+	Thread::sleep(1000);
+	assertTrue (srv.currentConnections() == 0);
+	srv.stop();
+}
+
+
+void ShardedTCPServerTest::testMultiConnections()
+{
+	ShardedTCPServer srv(new TCPServerConnectionFactoryImpl<EchoConnection>(), SocketAddress("127.0.0.1", 0), 4);
+	srv.start();
+
+	SocketAddress sa("127.0.0.1", srv.port());
+	for (int i = 0; i < 32; ++i)
+	{
+		StreamSocket ss(sa);
+		std::string data("hello, world");
+		ss.sendBytes(data.data(), (int) data.size());
+		char buffer[256];
+		int n = ss.receiveBytes(buffer, sizeof(buffer));
+		assertTrue (std::string(buffer, n) == data);
+	}
+	srv.stop();
+
+	int total = 0;
+	for (int i = 0; i < srv.shards(); ++i)
+	{
+		ShardedTCPServer::Statistics stats = srv.statistics(i);
+		assertTrue (stats.currentConnections == 0);
+		assertTrue (stats.refusedConnections == 0);
+		total += stats.totalConnections;
+	}
+	assertTrue (total == 32);
+	assertTrue (srv.totalConnections() == 32);
+	assertTrue (srv.currentConnections() == 0);
+}
+
+
+void ShardedTCPServerTest::testConcurrentConnections()
+{
+	ShardedTCPServer srv(new TCPServerConnectionFactoryImpl<EchoConnection>(), SocketAddress("127.0.0.1", 0), 1);
+	srv.start();
+
+	SocketAddress sa("127.0.0.1", srv.port());
+	std::string data("hello, world");
+	char buffer[256];
+	StreamSocket ss1(sa);
+	ss1.setReceiveTimeout(Poco::Timespan(5, 0));
+	ss1.sendBytes(data.data(), (int) data.size());
+	int n = ss1.receiveBytes(buffer, sizeof(buffer));
+	assertTrue (std::string(buffer, n) == data);
+
+	// the first connection is still open and must not block the shard
+	StreamSocket ss2(sa);
+	ss2.setReceiveTimeout(Poco::Timespan(5, 0));
+	ss2.sendBytes(data.data(), (int) data.size());
+	n = ss2.receiveBytes(buffer, sizeof(buffer));
+	assertTrue (std::string(buffer, n) == data);
+	assertTrue (srv.currentConnections() == 2);
+	assertTrue (srv.totalConnections() == 2);
+
+	ss1.close();
+	ss2.close();
+	srv.stop();
+	assertTrue (srv.currentConnections() == 0);
+	assertTrue (srv.queuedConnections() == 0);
+}
+
+
+void ShardedTCPServerTest::testFilter()
+{
+	ShardedTCPServer srv(new TCPServerConnectionFactoryImpl<EchoConnection>(), SocketAddress("127.0.0.1", 0), 2);
+	srv.setConnectionFilter(new RejectFilter);
+	srv.start();
+
+	SocketAddress sa("127.0.0.1", srv.port());
+	StreamSocket ss(sa);
+
+	char buffer[256];
+	int n = ss.receiveBytes(buffer, sizeof(buffer));
+
+	assertTrue (n == 0);
+	assertTrue (srv.currentConnections() == 0);
+	assertTrue (srv.totalConnections() == 0);
+	assertTrue (srv.refusedConnections() == 1);
+}
+
+
+void ShardedTCPServerTest::setUp()
+{
+}
+
+
+void ShardedTCPServerTest::tearDown()
+{
+}
+
+
+CppUnit::Test* ShardedTCPServerTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("ShardedTCPServerTest");
+
+	CppUnit_addTest(pSuite, ShardedTCPServerTest, testOneConnection);
+	CppUnit_addTest(pSuite, ShardedTCPServerTest, testMultiConnections);
+	CppUnit_addTest(pSuite, ShardedTCPServerTest, testConcurrentConnections);
+	CppUnit_addTest(pSuite, ShardedTCPServerTest, testFilter);
+
+	return pSuite;
+}
@@ -17,6 +17,7 @@
 #include "Poco/Net/SocketAcceptor.h"
 #include "Poco/Net/ParallelSocketAcceptor.h"
 #include "Poco/Net/StreamSocket.h"
+#include "Poco/Net/DatagramSocket.h"
 #include "Poco/Net/ServerSocket.h"
 #include "Poco/Net/SocketAddress.h"
 #include "Poco/Observer.h"
@@ -30,8 +31,10 @@ using Poco::Net::SocketConnector;
 using Poco::Net::SocketAcceptor;
 using Poco::Net::ParallelSocketAcceptor;
 using Poco::Net::StreamSocket;
+using Poco::Net::DatagramSocket;
 using Poco::Net::ServerSocket;
 using Poco::Net::SocketAddress;
+using Poco::Net::PollSet;
 using Poco::Net::SocketNotification;
 using Poco::Net::ReadableNotification;
 using Poco::Net::WritableNotification;
@@ -362,6 +365,28 @@ namespace
 	};
 
 	DataServiceHandler::Data DataServiceHandler::_data;
+
+	class IdleServiceHandler
+	{
+	public:
+		IdleServiceHandler():
+			_socket(SocketAddress::IPv4)
+		{
+		}
+
+		void onReadable(ReadableNotification* pNf)
+		{
+			pNf->release();
+		}
+
+		const DatagramSocket& socket() const
+		{
+			return _socket;
+		}
+
+	private:
+		DatagramSocket _socket;
+	};
 }
 
 
@@ -414,6 +439,76 @@ void SocketReactorTest::testSetSocketReactor()
 }
 
 
+void SocketReactorTest::testSocketReactorEdgeTriggered()
+{
+	SocketAddress ssa;
+	ServerSocket ss(ssa);
+	SocketReactor reactor;
+	reactor.setPollOptions(PollSet::POLL_EDGE_TRIGGERED);
+	assertTrue (reactor.getPollOptions() == PollSet::POLL_EDGE_TRIGGERED);
+	SocketAcceptor<EchoServiceHandler> acceptor(ss, reactor);
+	SocketAddress sa("127.0.0.1", ss.address().port());
+	SocketConnector<ClientServiceHandler> connector(sa, reactor);
+	ClientServiceHandler::setOnce(true);
+	ClientServiceHandler::resetData();
+	reactor.run();
+	std::string data(ClientServiceHandler::data());
+	assertTrue (data.size() == 1024);
+	assertTrue (!ClientServiceHandler::readableError());
+	assertTrue (!ClientServiceHandler::writableError());
+	assertTrue (!ClientServiceHandler::timeoutError());
+}
+
+
+void SocketReactorTest::testConcurrentRegistration()
+{
+	SocketAddress ssa;
+	ServerSocket ss(ssa);
+	SocketReactor reactor;
+	SocketAcceptor<EchoServiceHandler> acceptor(ss, reactor);
+	Thread thread;
+	thread.start(reactor);
+
+	// Add and remove handlers for sockets the reactor never
+	// reports, growing and shrinking the descriptor table,
+	// while the reactor keeps echoing data.
+	SocketAddress sa("127.0.0.1", ss.address().port());
+	for (int i = 0; i < 20; ++i)
+	{
+		std::vector<IdleServiceHandler*> handlers;
+		for (int k = 0; k < 50; ++k)
+		{
+			IdleServiceHandler* pHandler = new IdleServiceHandler;
+			reactor.addEventHandler(pHandler->socket(), Observer<IdleServiceHandler, ReadableNotification>(*pHandler, &IdleServiceHandler::onReadable));
+			handlers.push_back(pHandler);
+		}
+
+		StreamSocket sock(sa);
+		sock.setReceiveTimeout(Poco::Timespan(5, 0));
+		assertTrue (sock.sendBytes("hello", 5) == 5);
+		char buffer[8];
+		int n = 0;
+		while (n < 5)
+		{
+			int rc = sock.receiveBytes(buffer + n, sizeof(buffer) - n);
+			assertTrue (rc > 0);
+			n += rc;
+		}
+		assertTrue (std::string(buffer, n) == "hello");
+
+		for (std::vector<IdleServiceHandler*>::iterator it = handlers.begin(); it != handlers.end(); ++it)
+		{
+			reactor.removeEventHandler((*it)->socket(), Observer<IdleServiceHandler, ReadableNotification>(**it, &IdleServiceHandler::onReadable));
+			assertTrue (!reactor.has((*it)->socket()));
+			delete *it;
+		}
+	}
+
+	reactor.stop();
+	thread.join();
+}
+
+
 void SocketReactorTest::testParallelSocketReactor()
 {
 	SocketAddress ssa;
@@ -574,6 +669,8 @@ CppUnit::Test* SocketReactorTest::suite()
 
 	CppUnit_addTest(pSuite, SocketReactorTest, testSocketReactor);
 	CppUnit_addTest(pSuite, SocketReactorTest, testSetSocketReactor);
+	CppUnit_addTest(pSuite, SocketReactorTest, testSocketReactorEdgeTriggered);
+	CppUnit_addTest(pSuite, SocketReactorTest, testConcurrentRegistration);
 	CppUnit_addTest(pSuite, SocketReactorTest, testParallelSocketReactor);
 	CppUnit_addTest(pSuite, SocketReactorTest, testSocketConnectorFail);
 	CppUnit_addTest(pSuite, SocketReactorTest, testSocketConnectorTimeout);
@@ -26,6 +26,8 @@ public:
 
 	void testSocketReactor();
 	void testSetSocketReactor();
+	void testSocketReactorEdgeTriggered();
+	void testConcurrentRegistration();
 	void testParallelSocketReactor();
 	void testSocketConnectorFail();
 	void testSocketConnectorTimeout();
@@ -18,6 +18,7 @@
 #include "Poco/Net/StreamSocket.h"
 #include "Poco/Net/ServerSocket.h"
 #include "Poco/Thread.h"
+#include "Poco/WorkStealingPool.h"
 #include <iostream>
 
 
@@ -31,6 +32,7 @@ using Poco::Net::StreamSocket;
 using Poco::Net::ServerSocket;
 using Poco::Net::SocketAddress;
 using Poco::Thread;
+using Poco::WorkStealingPool;
 
 
 namespace
@@ -277,6 +279,78 @@ void TCPServerTest::testFilter()
 }
 
 
+void TCPServerTest::testLockFreeQueue()
+{
+	TCPServerParams* pParams = new TCPServerParams;
+	pParams->setLockFreeQueue(true);
+	pParams->setMaxThreads(4);
+	TCPServer srv(new TCPServerConnectionFactoryImpl<EchoConnection>(), ServerSocket(0), pParams);
+	srv.start();
+	assertTrue (srv.currentThreads() == 0);
+	assertTrue (srv.queuedConnections() == 0);
+
+	SocketAddress sa("127.0.0.1", srv.socket().address().port());
+	StreamSocket ss1(sa);
+	StreamSocket ss2(sa);
+	std::string data("hello, world");
+	ss1.sendBytes(data.data(), (int) data.size());
+	ss2.sendBytes(data.data(), (int) data.size());
+
+	char buffer[256];
+	int n = ss1.receiveBytes(buffer, sizeof(buffer));
+	assertTrue (n > 0);
+	assertTrue (std::string(buffer, n) == data);
+
+	n = ss2.receiveBytes(buffer, sizeof(buffer));
+	assertTrue (n > 0);
+	assertTrue (std::string(buffer, n) == data);
+
+	assertTrue (srv.currentConnections() == 2);
+	assertTrue (srv.currentThreads() == 2);
+	assertTrue (srv.queuedConnections() == 0);
+	assertTrue (srv.totalConnections() == 2);
+	ss1.close();
+	ss2.close();
+	Thread::sleep(1000);
+	assertTrue (srv.currentConnections() == 0);
+	srv.stop();
+}
+
+
+void TCPServerTest::testWorkStealingPool()
+{
+	WorkStealingPool pool(2);
+	TCPServer srv(new TCPServerConnectionFactoryImpl<EchoConnection>(), pool, ServerSocket(0));
+	srv.start();
+	assertTrue (srv.maxThreads() == 2);
+
+	SocketAddress sa("127.0.0.1", srv.socket().address().port());
+	StreamSocket ss1(sa);
+	std::string data("hello, world");
+	ss1.sendBytes(data.data(), (int) data.size());
+	char buffer[256];
+	int n = ss1.receiveBytes(buffer, sizeof(buffer));
+	assertTrue (n > 0);
+	assertTrue (std::string(buffer, n) == data);
+
+	StreamSocket ss2(sa);
+	ss2.sendBytes(data.data(), (int) data.size());
+	n = ss2.receiveBytes(buffer, sizeof(buffer));
+	assertTrue (n > 0);
+	assertTrue (std::string(buffer, n) == data);
+	assertTrue (srv.currentConnections() == 2);
+	assertTrue (srv.currentThreads() == 2);
+	assertTrue (srv.totalConnections() == 2);
+
+	ss1.close();
+	ss2.close();
+	Thread::sleep(1000);
+	assertTrue (srv.currentConnections() == 0);
+	assertTrue (srv.currentThreads() == 0);
+	srv.stop();
+}
+
+
 void TCPServerTest::setUp()
 {
 }
@@ -296,6 +370,8 @@ CppUnit::Test* TCPServerTest::suite()
 	CppUnit_addTest(pSuite, TCPServerTest, testMultiConnections);
 	CppUnit_addTest(pSuite, TCPServerTest, testThreadCapacity);
 	CppUnit_addTest(pSuite, TCPServerTest, testFilter);
+	CppUnit_addTest(pSuite, TCPServerTest, testLockFreeQueue);
+	CppUnit_addTest(pSuite, TCPServerTest, testWorkStealingPool);
 
 	return pSuite;
 }
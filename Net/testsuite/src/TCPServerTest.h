@@ -29,6 +29,8 @@ public:
 	void testMultiConnections();
 	void testThreadCapacity();
 	void testFilter();
+	void testLockFreeQueue();
+	void testWorkStealingPool();
 
 	void setUp();
 	void tearDown();
@@ -14,6 +14,7 @@
 #include "Poco/Net/UDPServer.h"
 #include "Poco/Net/UDPClient.h"
 #include "Poco/Net/UDPHandler.h"
+#include "Poco/Net/UDPServerParams.h"
 #include "Poco/Net/DatagramSocket.h"
 #include "Poco/Net/SocketAddress.h"
 #include "Poco/Net/NetworkInterface.h"
@@ -29,6 +30,9 @@ using Poco::Net::UDPServer;
 using Poco::Net::UDPClient;
 using Poco::Net::UDPMultiServer;
 using Poco::Net::UDPHandler;
+using Poco::Net::UDPServerParams;
+using Poco::Net::DatagramBuf;
+using Poco::Net::DatagramBufVec;
 using Poco::Net::Socket;
 using Poco::Net::SocketBufVec;
 using Poco::Net::SocketAddress;
@@ -78,6 +82,27 @@ namespace
 
 	AtomicCounter TestUDPHandler::errors;
 
+	struct CountingUDPHandler : public Poco::Net::UDPHandler
+	{
+		CountingUDPHandler() : counter(0), errors(0) {}
+
+		void processData(char *buf)
+		{
+			if (std::string(payload(buf), payloadSize(buf)) == "hello") ++counter;
+			else ++errors;
+			std::memset(buf, 0, blockSize());
+		}
+
+		void processError(char *buf)
+		{
+			++errors;
+			std::memset(buf, 0, blockSize());
+		}
+
+		AtomicCounter counter;
+		AtomicCounter errors;
+	};
+
 	template<typename S>
 	bool server(int handlerCount, int reps, int port = 0)
 	{
@@ -159,6 +184,54 @@ void UDPServerTest::testServer()
 }
 
 
+void UDPServerTest::testServerBatch()
+{
+	Poco::Net::UDPHandler::List handlers;
+	handlers.push_back(new CountingUDPHandler());
+	handlers.push_back(new CountingUDPHandler());
+	UDPServerParams params(SocketAddress("127.0.0.1", 0), 1, 250000, 1000, false, 0, 32);
+	UDPServer server(handlers, params);
+	Poco::Thread::sleep(100);
+
+	DatagramSocket client(SocketAddress("127.0.0.1", 0), false);
+	SocketAddress serverAddress("127.0.0.1", server.port());
+	std::string msg("hello");
+	DatagramBufVec datagrams;
+	for (int i = 0; i < 50; ++i)
+	{
+		DatagramBuf datagram;
+		datagram.buffer        = const_cast<char*>(msg.data());
+		datagram.length        = static_cast<int>(msg.size());
+		datagram.pAddress      = const_cast<struct sockaddr*>(serverAddress.addr());
+		datagram.addressLength = serverAddress.length();
+		datagrams.push_back(datagram);
+	}
+
+	const int total = 1000;
+	for (int sent = 0; sent < total; sent += 50)
+	{
+		assertTrue (client.sendBatch(datagrams) == 50);
+		Poco::Thread::sleep(1);
+	}
+
+	int count = 0;
+	for (int wait = 0; wait < 500 && count < total; ++wait)
+	{
+		Poco::Thread::sleep(10);
+		count = 0;
+		for (Poco::Net::UDPHandler::Iterator it = handlers.begin(); it != handlers.end(); ++it)
+		{
+			count += dynamic_cast<CountingUDPHandler&>(*(*it)).counter.value();
+		}
+	}
+	assertTrue (count == total);
+	for (Poco::Net::UDPHandler::Iterator it = handlers.begin(); it != handlers.end(); ++it)
+	{
+		assertTrue (dynamic_cast<CountingUDPHandler&>(*(*it)).errors.value() == 0);
+	}
+}
+
+
 void UDPServerTest::setUp()
 {
 }
@@ -174,6 +247,7 @@ CppUnit::Test* UDPServerTest::suite()
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("UDPServerTest");
 
 	CppUnit_addTest(pSuite, UDPServerTest, testServer);
+	CppUnit_addTest(pSuite, UDPServerTest, testServerBatch);
 
 	return pSuite;
 }
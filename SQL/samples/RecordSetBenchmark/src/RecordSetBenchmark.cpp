@@ -0,0 +1,135 @@
+//
+// RecordSetBenchmark.cpp
+//
+// This sample measures the time needed to execute a query into a
+// RecordSet and to iterate over all of its rows and columns, reading
+// every field as a Dynamic::Var, using an in-memory SQLite database.
+//
+// The number of rows (default 20000) and the number of runs
+// (default 20) can be given on the command line. The fastest run
+// is reported.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/SQL/Session.h"
+#include "Poco/SQL/Statement.h"
+#include "Poco/SQL/RecordSet.h"
+#include "Poco/SQL/SQLite/Connector.h"
+#include "Poco/Dynamic/Var.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/Stopwatch.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <cstdlib>
+
+
+using namespace Poco::SQL::Keywords;
+using Poco::SQL::Session;
+using Poco::SQL::Statement;
+using Poco::SQL::RecordSet;
+using Poco::Dynamic::Var;
+using Poco::NumberFormatter;
+using Poco::Stopwatch;
+
+
+template <typename F>
+void benchmark(const std::string& what, int runs, F f)
+	/// Calls f() runs times and prints the fastest time.
+{
+	Poco::Timestamp::TimeDiff best = 0;
+	for (int n = 0; n < runs; ++n)
+	{
+		Stopwatch sw;
+		sw.start();
+		f();
+		sw.stop();
+		if (n == 0 || sw.elapsed() < best) best = sw.elapsed();
+	}
+
+	std::cout << std::setw(32) << std::left << what << std::setw(10) << std::right
+		<< std::fixed << std::setprecision(2) << best/1000.0 << " ms" << std::endl;
+}
+
+
+int main(int argc, char** argv)
+{
+	int rows = 20000;
+	int runs = 20;
+	if (argc > 1) rows = std::atoi(argv[1]);
+	if (argc > 2) runs = std::atoi(argv[2]);
+
+#ifdef POCO_NO_SOO
+	std::cout << "small object optimization disabled" << std::endl;
+#else
+	std::cout << "small object size: " << POCO_SMALL_OBJECT_SIZE << std::endl;
+#endif
+	std::cout << rows << " rows x 4 columns" << std::endl;
+
+	Poco::SQL::SQLite::Connector::registerConnector();
+	Session session("SQLite", ":memory:");
+	session << "CREATE TABLE Person (Name VARCHAR(30), Address VARCHAR, Age INTEGER(3), Score REAL)", now;
+
+	std::vector<std::string> names;
+	std::vector<std::string> addresses;
+	std::vector<int> ages;
+	std::vector<double> scores;
+	for (int i = 0; i < rows; ++i)
+	{
+		names.push_back("Name " + NumberFormatter::format(i));
+		addresses.push_back("Street " + NumberFormatter::format(i % 100));
+		ages.push_back(i % 100);
+		scores.push_back(i*0.25);
+	}
+	session.begin();
+	session << "INSERT INTO Person VALUES(?, ?, ?, ?)", use(names), use(addresses), use(ages), use(scores), now;
+	session.commit();
+
+	std::size_t fields = 0;
+	benchmark("execute", runs, [&session, &fields]()
+	{
+		RecordSet rs(session, "SELECT * FROM Person");
+		fields = rs.rowCount()*rs.columnCount();
+	});
+	benchmark("execute and iterate (value)", runs, [&session, &fields]()
+	{
+		RecordSet rs(session, "SELECT * FROM Person");
+		std::size_t rowCount = rs.rowCount();
+		std::size_t colCount = rs.columnCount();
+		std::size_t n = 0;
+		for (std::size_t row = 0; row < rowCount; ++row)
+		{
+			for (std::size_t col = 0; col < colCount; ++col)
+			{
+				Var v = rs.value(col, row);
+				if (!v.isEmpty()) ++n;
+			}
+		}
+		fields = n;
+	});
+	benchmark("execute and iterate (moveNext)", runs, [&session, &fields]()
+	{
+		RecordSet rs(session, "SELECT * FROM Person");
+		std::size_t colCount = rs.columnCount();
+		std::size_t n = 0;
+		bool more = rs.moveFirst();
+		while (more)
+		{
+			for (std::size_t col = 0; col < colCount; ++col)
+			{
+				Var v = rs[col];
+				if (!v.isEmpty()) ++n;
+			}
+			more = rs.moveNext();
+		}
+		fields = n;
+	});
+
+	return fields == static_cast<std::size_t>(rows)*4 ? 0 : 1;
+}
@@ -20,9 +20,10 @@
 
 #include "Poco/Util/Util.h"
 #include "Poco/Util/TimerTask.h"
-#include "Poco/TimedNotificationQueue.h"
+#include "Poco/TimingWheel.h"
 #include "Poco/Thread.h"
 #include "Poco/Runnable.h"
+#include <atomic>
 
 
 namespace Poco {
@@ -41,6 +42,11 @@ class Util_API Timer: protected Poco::Runnable
 	/// Timer is safe for multithreaded use - multiple threads can schedule
 	/// new tasks simultaneously.
 	///
+	/// Scheduled tasks are kept in a TimingWheel, so scheduling a task takes
+	/// constant time, regardless of the number of pending tasks. Tasks are
+	/// executed up to one millisecond after their scheduled time, and tasks
+	/// scheduled for the same millisecond are executed in no particular order.
+	///
 	/// Acknowledgement: The interface of this class has been inspired by
 	/// the java.util.Timer class from Java 1.3.
 {
@@ -162,8 +168,9 @@ private:
 	Timer(const Timer&);
 	Timer& operator = (const Timer&);
 	
-	Poco::TimedNotificationQueue _queue;
+	Poco::TimingWheel _wheel;
 	Poco::Thread _thread;
+	std::atomic<int> _interrupts;
 };
 
 
@@ -28,8 +28,8 @@ namespace Util {
 class TimerNotification: public Poco::Notification
 {
 public:
-	TimerNotification(Poco::TimedNotificationQueue& queue):
-		_queue(queue)
+	TimerNotification(Poco::TimingWheel& wheel):
+		_wheel(wheel)
 	{
 	}
 
@@ -39,21 +39,21 @@ public:
 
 	virtual bool execute() = 0;
 
-	Poco::TimedNotificationQueue& queue()
+	Poco::TimingWheel& wheel()
 	{
-		return _queue;
+		return _wheel;
 	}
 
 private:
-	Poco::TimedNotificationQueue& _queue;
+	Poco::TimingWheel& _wheel;
 };
 
 
 class StopNotification: public TimerNotification
 {
 public:
-	StopNotification(Poco::TimedNotificationQueue& queue):
-		TimerNotification(queue)
+	StopNotification(Poco::TimingWheel& wheel):
+		TimerNotification(wheel)
 	{
 	}
 
@@ -63,7 +63,7 @@ public:
 
 	bool execute()
 	{
-		queue().clear();
+		wheel().clear();
 		return false;
 	}
 };
@@ -72,8 +72,8 @@ public:
 class CancelNotification: public TimerNotification
 {
 public:
-	CancelNotification(Poco::TimedNotificationQueue& queue):
-		TimerNotification(queue)
+	CancelNotification(Poco::TimingWheel& wheel):
+		TimerNotification(wheel)
 	{
 	}
 
@@ -83,20 +83,7 @@ public:
 
 	bool execute()
 	{
-		// Check if there's a StopNotification pending.
-		Poco::AutoPtr<TimerNotification> pNf = static_cast<TimerNotification*>(queue().dequeueNotification());
-		while (pNf)
-		{
-			if (pNf.cast<StopNotification>())
-			{
-				queue().clear();
-				_finished.set();
-				return false;
-			}
-			pNf = static_cast<TimerNotification*>(queue().dequeueNotification());
-		}
-
-		queue().clear();
+		wheel().clear();
 		_finished.set();
 		return true;
 	}
@@ -114,8 +101,8 @@ private:
 class TaskNotification: public TimerNotification
 {
 public:
-	TaskNotification(Poco::TimedNotificationQueue& queue, TimerTask::Ptr pTask):
-		TimerNotification(queue),
+	TaskNotification(Poco::TimingWheel& wheel, TimerTask::Ptr pTask):
+		TimerNotification(wheel),
 		_pTask(pTask)
 	{
 	}
@@ -162,8 +149,8 @@ private:
 class PeriodicTaskNotification: public TaskNotification
 {
 public:
-	PeriodicTaskNotification(Poco::TimedNotificationQueue& queue, TimerTask::Ptr pTask, long interval):
-		TaskNotification(queue, pTask),
+	PeriodicTaskNotification(Poco::TimingWheel& wheel, TimerTask::Ptr pTask, long interval):
+		TaskNotification(wheel, pTask),
 		_interval(interval)
 	{
 	}
@@ -182,7 +169,7 @@ public:
 			Poco::Clock nextExecution;
 			nextExecution += static_cast<Poco::Clock::ClockDiff>(_interval)*1000;
 			if (nextExecution < now) nextExecution = now;
-			queue().enqueueNotification(this, nextExecution);
+			wheel().schedule(this, nextExecution);
 			duplicate();
 		}
 		return true;
@@ -196,8 +183,8 @@ private:
 class FixedRateTaskNotification: public TaskNotification
 {
 public:
-	FixedRateTaskNotification(Poco::TimedNotificationQueue& queue, TimerTask::Ptr pTask, long interval, Poco::Clock clock):
-		TaskNotification(queue, pTask),
+	FixedRateTaskNotification(Poco::TimingWheel& wheel, TimerTask::Ptr pTask, long interval, Poco::Clock clock):
+		TaskNotification(wheel, pTask),
 		_interval(interval),
 		_nextExecution(clock)
 	{
@@ -216,7 +203,7 @@ public:
 			Poco::Clock now;
 			_nextExecution += static_cast<Poco::Clock::ClockDiff>(_interval)*1000;
 			if (_nextExecution < now) _nextExecution = now;
-			queue().enqueueNotification(this, _nextExecution);
+			wheel().schedule(this, _nextExecution);
 			duplicate();
 		}
 		return true;
@@ -228,20 +215,23 @@ private:
 };
 
 
-Timer::Timer()
+Timer::Timer():
+	_interrupts(0)
 {
 	_thread.start(*this);
 }
 
 
-Timer::Timer(Poco::Thread::Priority priority)
+Timer::Timer(Poco::Thread::Priority priority):
+	_interrupts(0)
 {
 	_thread.setPriority(priority);
 	_thread.start(*this);
 }
 
 
-Timer::Timer(int prio, int policy)
+Timer::Timer(int prio, int policy):
+	_interrupts(0)
 {
 	_thread.setOSPriority(prio, policy);
 	_thread.start(*this);
@@ -252,7 +242,8 @@ Timer::~Timer()
 {
 	try
 	{
-		_queue.enqueueNotification(new StopNotification(_queue), Poco::Clock(0));
+		++_interrupts;
+		_wheel.schedule(new StopNotification(_wheel), Poco::Clock(0));
 		_thread.join();
 	}
 	catch (...)
@@ -264,8 +255,9 @@ Timer::~Timer()
 
 void Timer::cancel(bool wait)
 {
-	Poco::AutoPtr<CancelNotification> pNf = new CancelNotification(_queue);
-	_queue.enqueueNotification(pNf, Poco::Clock(0));
+	Poco::AutoPtr<CancelNotification> pNf = new CancelNotification(_wheel);
+	++_interrupts;
+	_wheel.schedule(pNf, Poco::Clock(0));
 	if (wait)
 	{
 		pNf->wait();
@@ -276,14 +268,14 @@ void Timer::cancel(bool wait)
 void Timer::schedule(TimerTask::Ptr pTask, Poco::Timestamp time)
 {
 	validateTask(pTask);
-	_queue.enqueueNotification(new TaskNotification(_queue, pTask), time);
+	_wheel.schedule(new TaskNotification(_wheel, pTask), time);
 }
 
 
 void Timer::schedule(TimerTask::Ptr pTask, Poco::Clock clock)
 {
 	validateTask(pTask);
-	_queue.enqueueNotification(new TaskNotification(_queue, pTask), clock);
+	_wheel.schedule(new TaskNotification(_wheel, pTask), clock);
 }
 
 
@@ -298,14 +290,14 @@ void Timer::schedule(TimerTask::Ptr pTask, long delay, long interval)
 void Timer::schedule(TimerTask::Ptr pTask, Poco::Timestamp time, long interval)
 {
 	validateTask(pTask);
-	_queue.enqueueNotification(new PeriodicTaskNotification(_queue, pTask, interval), time);
+	_wheel.schedule(new PeriodicTaskNotification(_wheel, pTask, interval), time);
 }
 
 
 void Timer::schedule(TimerTask::Ptr pTask, Poco::Clock clock, long interval)
 {
 	validateTask(pTask);
-	_queue.enqueueNotification(new PeriodicTaskNotification(_queue, pTask, interval), clock);
+	_wheel.schedule(new PeriodicTaskNotification(_wheel, pTask, interval), clock);
 }
 
 
@@ -324,24 +316,53 @@ void Timer::scheduleAtFixedRate(TimerTask::Ptr pTask, Poco::Timestamp time, long
 	Poco::Clock clock;
 	Poco::Timestamp::TimeDiff diff = time - tsNow;
 	clock += diff;
-	_queue.enqueueNotification(new FixedRateTaskNotification(_queue, pTask, interval, clock), clock);
+	_wheel.schedule(new FixedRateTaskNotification(_wheel, pTask, interval, clock), clock);
 }
 
 
 void Timer::scheduleAtFixedRate(TimerTask::Ptr pTask, Poco::Clock clock, long interval)
 {
 	validateTask(pTask);
-	_queue.enqueueNotification(new FixedRateTaskNotification(_queue, pTask, interval, clock), clock);
+	_wheel.schedule(new FixedRateTaskNotification(_wheel, pTask, interval, clock), clock);
 }
 
 
 void Timer::run()
 {
-	bool cont = true;
-	while (cont)
+	Poco::TimingWheel::NotificationVec expired;
+	for (;;)
 	{
-		Poco::AutoPtr<TimerNotification> pNf = static_cast<TimerNotification*>(_queue.waitDequeueNotification());
-		cont = pNf->execute();
+		expired.clear();
+		int interrupts = _interrupts.load();
+		_wheel.waitExpire(expired);
+
+		// Stop and cancel requests take precedence over
+		// tasks expiring at the same time.
+		bool cancelled = false;
+		for (Poco::TimingWheel::NotificationVec::iterator it = expired.begin(); it != expired.end(); ++it)
+		{
+			if (it->cast<StopNotification>())
+			{
+				static_cast<TimerNotification*>(it->get())->execute();
+				return;
+			}
+			else if (it->cast<CancelNotification>())
+			{
+				static_cast<TimerNotification*>(it->get())->execute();
+				cancelled = true;
+			}
+		}
+		if (!cancelled)
+		{
+			// A stop or cancel request made while the batch runs, possibly
+			// by one of its tasks, drops the remaining expired tasks. The
+			// request's own notification is handled by the next waitExpire().
+			for (Poco::TimingWheel::NotificationVec::iterator it = expired.begin(); it != expired.end(); ++it)
+			{
+				if (_interrupts.load() != interrupts) break;
+				static_cast<TimerNotification*>(it->get())->execute();
+			}
+		}
 	}
 }
 
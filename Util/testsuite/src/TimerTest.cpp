@@ -13,6 +13,7 @@
 #include "Poco/CppUnit/TestSuite.h"
 #include "Poco/Util/Timer.h"
 #include "Poco/Util/TimerTaskAdapter.h"
+#include <atomic>
 
 
 using Poco::Util::Timer;
@@ -22,6 +23,30 @@ using Poco::Timestamp;
 using Poco::Clock;
 
 
+namespace
+{
+	class CancellingTask: public TimerTask
+	{
+	public:
+		CancellingTask(Timer& timer, std::atomic<int>& runs):
+			_timer(timer),
+			_runs(runs)
+		{
+		}
+
+		void run()
+		{
+			++_runs;
+			_timer.cancel(false);
+		}
+
+	private:
+		Timer& _timer;
+		std::atomic<int>& _runs;
+	};
+}
+
+
 TimerTest::TimerTest(const std::string& name): CppUnit::TestCase(name)
 {
 }
@@ -260,6 +285,28 @@ void TimerTest::testCancelAllWaitStop()
 }
 
 
+void TimerTest::testCancelFromTask()
+{
+	std::atomic<int> runs(0);
+	{
+		Timer timer;
+
+		// All tasks expire together; the first one to run
+		// cancels the timer, so the others must not run.
+		Clock clock;
+		clock += 200000;
+		for (int i = 0; i < 5; ++i)
+		{
+			timer.schedule(new CancellingTask(timer, runs), clock);
+		}
+
+		Poco::Thread::sleep(500);
+	}
+
+	assertTrue (runs == 1);
+}
+
+
 void TimerTest::setUp()
 {
 }
@@ -290,6 +337,7 @@ CppUnit::Test* TimerTest::suite()
 	CppUnit_addTest(pSuite, TimerTest, testCancel);
 	CppUnit_addTest(pSuite, TimerTest, testCancelAllStop);
 	CppUnit_addTest(pSuite, TimerTest, testCancelAllWaitStop);
+	CppUnit_addTest(pSuite, TimerTest, testCancelFromTask);
 
 	return pSuite;
 }
@@ -0,0 +1 @@
+globtest/include/one.h
@@ -0,0 +1 @@
+globtest/include/two.h
@@ -0,0 +1 @@
+globtest/src/one.c
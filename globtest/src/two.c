@@ -0,0 +1 @@
+globtest/src/two.c
@@ -0,0 +1 @@
+globtest/testsuite/src/test.h